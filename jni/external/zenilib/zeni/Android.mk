@@ -8,12 +8,17 @@ LOCAL_C_INCLUDES += . $(LOCAL_PATH)/../../tinyxml $(LOCAL_PATH)/../../sdl_subst
 #LOCAL_CPP_EXTENSION := .cxx
 #LOCAL_SRC_FILES := zeni.cxx
 LOCAL_SRC_FILES := \
+  Archive.cpp \
   Camera.cpp \
   Collision.cpp \
+  Collision_World.cpp \
+  Collision_Batch.cpp \
+  Collision_Sweep.cpp \
   Color.cpp \
   Colors.cpp \
   Coordinate.cpp \
   File_Ops.cpp \
+  Frustum.cpp \
   Matrix4f.cpp \
   Quaternion.cpp \
   Quit_Event.cpp \
@@ -25,7 +30,7 @@ LOCAL_SRC_FILES := \
   Vector2f.cpp \
   Vector3f.cpp \
   XML.cpp
-LOCAL_LDLIBS    := -landroid -llog
+LOCAL_LDLIBS    := -landroid -llog -lz
 
 $(LOCAL_LIBRARIES_TYPE) := tinyxml
 
@@ -0,0 +1,374 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <zlib.h>
+
+#ifdef _WINDOWS
+#include <Windows.h>
+#elif !defined(ANDROID)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  static const char g_magic[4] = {'Z', 'A', 'R', 'C'};
+  static const Uint32 g_version = 1u;
+  static const size_t g_alignment = 16u;
+
+  struct Archive_Header {
+    char magic[4];
+    Uint32 version;
+    Uint32 num_entries;
+    Uint32 names_size;
+  };
+
+  struct Archive::Entry {
+    Uint32 hash;
+    Uint32 name_offset;
+    Uint32 name_length;
+    Uint32 offset;
+    Uint32 stored_size;
+    Uint32 size;
+    Uint32 compression;
+
+    bool operator<(const Entry &rhs) const {
+      return hash < rhs.hash;
+    }
+  };
+
+  /// FNV-1a
+  static Uint32 hash_path(const String &path) {
+    Uint32 hash = 2166136261u;
+    for(const char * c = path.c_str(); *c; ++c) {
+      hash ^= Uint8(*c);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  static size_t align(const size_t &offset) {
+    return (offset + g_alignment - 1u) / g_alignment * g_alignment;
+  }
+
+  Archive::Archive(const String &filename)
+    : m_filename(filename),
+    m_data(0),
+    m_size(0u),
+#ifdef _WINDOWS
+    m_file(INVALID_HANDLE_VALUE),
+    m_mapping(0)
+#elif defined(ANDROID)
+    m_asset(0)
+#else
+    m_file(-1)
+#endif
+  {
+#ifdef _WINDOWS
+    m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if(m_file == INVALID_HANDLE_VALUE)
+      throw Archive_Load_Failure();
+
+    m_size = size_t(GetFileSize(m_file, 0));
+    m_mapping = CreateFileMappingA(m_file, 0, PAGE_READONLY, 0, 0, 0);
+    if(!m_mapping) {
+      CloseHandle(m_file);
+      throw Archive_Load_Failure();
+    }
+
+    m_data = reinterpret_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if(!m_data) {
+      CloseHandle(m_mapping);
+      CloseHandle(m_file);
+      throw Archive_Load_Failure();
+    }
+#elif defined(ANDROID)
+    /// Uncompressed APK assets are mapped by the AAssetManager
+    m_asset = AAssetManager_open(File_Ops::get_AAssetManager(), filename.c_str(), AASSET_MODE_BUFFER);
+    if(!m_asset)
+      throw Archive_Load_Failure();
+
+    m_data = reinterpret_cast<const char *>(AAsset_getBuffer(m_asset));
+    m_size = size_t(AAsset_getLength(m_asset));
+    if(!m_data) {
+      AAsset_close(m_asset);
+      throw Archive_Load_Failure();
+    }
+#else
+    m_file = open(filename.c_str(), O_RDONLY);
+    if(m_file < 0)
+      throw Archive_Load_Failure();
+
+    struct stat status;
+    if(fstat(m_file, &status)) {
+      close(m_file);
+      throw Archive_Load_Failure();
+    }
+
+    m_size = size_t(status.st_size);
+    void * const data = m_size ? mmap(0, m_size, PROT_READ, MAP_PRIVATE, m_file, 0) : MAP_FAILED;
+    if(data == MAP_FAILED) {
+      close(m_file);
+      throw Archive_Load_Failure();
+    }
+    m_data = reinterpret_cast<const char *>(data);
+#endif
+
+    /// In 64 bits, so that a corrupt count cannot wrap around to something small
+    const Archive_Header * const header = reinterpret_cast<const Archive_Header *>(m_data);
+    if(m_size < sizeof(Archive_Header) ||
+       memcmp(header->magic, g_magic, sizeof(g_magic)) ||
+       header->version != g_version ||
+       Uint64(m_size) < Uint64(sizeof(Archive_Header)) + Uint64(header->num_entries) * sizeof(Entry) + header->names_size)
+    {
+      unmap();
+      throw Archive_Load_Failure();
+    }
+  }
+
+  Archive::~Archive() {
+    unmap();
+  }
+
+  void Archive::unmap() {
+#ifdef _WINDOWS
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+    CloseHandle(m_file);
+#elif defined(ANDROID)
+    AAsset_close(m_asset);
+#else
+    munmap(const_cast<char *>(m_data), m_size);
+    close(m_file);
+#endif
+  }
+
+  size_t Archive::get_num_entries() const {
+    return reinterpret_cast<const Archive_Header *>(m_data)->num_entries;
+  }
+
+  bool Archive::contains(const String &path) const {
+    return find(path) != 0;
+  }
+
+  bool Archive::get_entry(const String &path, size_t &offset, size_t &size, Compression &compression) const {
+    const Entry * const entry = find(path);
+    if(!entry)
+      return false;
+
+    offset = entry->offset;
+    size = entry->stored_size;
+    compression = Compression(entry->compression);
+
+    return true;
+  }
+
+  const char * Archive::get_data(const String &path, size_t &size) const {
+    const Entry * const entry = find(path);
+    if(!entry || entry->compression != STORED)
+      return 0;
+
+    size = entry->size;
+    return m_data + entry->offset;
+  }
+
+  bool Archive::load(const String &path, String &memory) const {
+    const Entry * const entry = find(path);
+    if(!entry)
+      return false;
+
+    const char * const data = m_data + entry->offset;
+
+    if(entry->compression == STORED) {
+      memory.assign(data, entry->size);
+      return true;
+    }
+
+    memory.resize(entry->size);
+    uLongf size = uLongf(entry->size);
+    if(entry->size &&
+       (uncompress(reinterpret_cast<Bytef *>(&memory[0]), &size, reinterpret_cast<const Bytef *>(data), uLong(entry->stored_size)) != Z_OK ||
+        size != uLongf(entry->size)))
+    {
+      ZENI_LOGE(("Failed to decompress '" + path + "' from '" + m_filename + "'.").c_str());
+      throw Archive_Load_Failure();
+    }
+
+    return true;
+  }
+
+  bool Archive::build(const String &filename, const std::vector<String> &paths, const bool &compress) {
+    std::vector<Entry> entries(paths.size());
+    std::vector<String> contents(paths.size());
+    String names;
+
+    for(size_t i = 0; i != paths.size(); ++i) {
+      std::ifstream fin(paths[i].c_str(), std::ios::binary);
+      if(!fin)
+        return false;
+
+      String &content = contents[i];
+      for(char c; fin.get(c); content += c);
+
+      const String path = normalize(paths[i]);
+
+      Entry &entry = entries[i];
+      entry.hash = hash_path(path);
+      entry.name_offset = Uint32(names.size());
+      entry.name_length = Uint32(path.size());
+      entry.size = Uint32(content.size());
+      entry.compression = STORED;
+
+      names += path;
+
+      if(compress && !content.empty()) {
+        uLongf compressed_size = compressBound(uLong(content.size()));
+        String compressed(compressed_size, '\0');
+        if(compress2(reinterpret_cast<Bytef *>(&compressed[0]), &compressed_size,
+                     reinterpret_cast<const Bytef *>(content.c_str()), uLong(content.size()), Z_BEST_COMPRESSION) == Z_OK &&
+           compressed_size < content.size())
+        {
+          compressed.resize(compressed_size);
+          content = compressed;
+          entry.compression = ZLIB;
+        }
+      }
+
+      entry.stored_size = Uint32(content.size());
+    }
+
+    size_t offset = align(sizeof(Archive_Header) + entries.size() * sizeof(Entry) + names.size());
+    for(size_t i = 0; i != entries.size(); ++i) {
+      entries[i].offset = Uint32(offset);
+      offset = align(offset + contents[i].size());
+    }
+
+    /// Contents are written in the original order; Only the table is sorted
+    std::vector<Entry> table(entries);
+    std::stable_sort(table.begin(), table.end());
+
+    Archive_Header header;
+    memcpy(header.magic, g_magic, sizeof(g_magic));
+    header.version = g_version;
+    header.num_entries = Uint32(table.size());
+    header.names_size = Uint32(names.size());
+
+    std::ofstream fout(filename.c_str(), std::ios::binary);
+    if(!fout)
+      return false;
+
+    fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if(!table.empty())
+      fout.write(reinterpret_cast<const char *>(&table[0]), std::streamsize(table.size() * sizeof(Entry)));
+    fout.write(names.c_str(), std::streamsize(names.size()));
+
+    static const char padding[g_alignment] = {0};
+    size_t written = sizeof(Archive_Header) + table.size() * sizeof(Entry) + names.size();
+    for(size_t i = 0; i != entries.size(); ++i) {
+      fout.write(padding, std::streamsize(entries[i].offset - written));
+      fout.write(contents[i].c_str(), std::streamsize(contents[i].size()));
+      written = entries[i].offset + contents[i].size();
+    }
+
+    return fout.good();
+  }
+
+  String Archive::normalize(const String &path) {
+    String normalized(path);
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+
+    size_t start = 0u;
+    while(normalized.size() >= start + 2u && normalized[start] == '.' && normalized[start + 1u] == '/')
+      start += 2u;
+
+    return normalized.substr(start);
+  }
+
+  const Archive::Entry * Archive::find(const String &path) const {
+    const Archive_Header * const header = reinterpret_cast<const Archive_Header *>(m_data);
+    const Entry * const begin = reinterpret_cast<const Entry *>(m_data + sizeof(Archive_Header));
+    const Entry * const end = begin + header->num_entries;
+    const char * const names = reinterpret_cast<const char *>(end);
+    const Uint64 names_size = header->names_size;
+
+    const String normalized = normalize(path);
+
+    Entry key;
+    key.hash = hash_path(normalized);
+
+    for(const Entry * entry = std::lower_bound(begin, end, key); entry != end && entry->hash == key.hash; ++entry) {
+      if(entry->name_length == normalized.size() &&
+         Uint64(entry->name_offset) + entry->name_length <= names_size &&
+         !memcmp(names + entry->name_offset, normalized.c_str(), normalized.size()) &&
+         Uint64(entry->offset) + entry->stored_size <= m_size &&
+         (entry->compression != STORED || entry->size == entry->stored_size))
+      {
+        return entry;
+      }
+    }
+
+    return 0;
+  }
+
+  Archive_Reader::Archive_Reader(const Archive &archive, const String &path)
+    : m_data(0),
+    m_size(0u),
+    m_position(0u)
+  {
+    m_data = archive.get_data(path, m_size);
+
+    if(!m_data) {
+      if(!archive.load(path, m_decompressed))
+        throw Archive_Entry_Not_Found();
+
+      m_data = m_decompressed.c_str();
+      m_size = m_decompressed.size();
+    }
+  }
+
+  size_t Archive_Reader::read(void * const &buffer, const size_t &size) {
+    const size_t count = std::min(size, m_size - m_position);
+    memcpy(buffer, m_data + m_position, count);
+    m_position += count;
+    return count;
+  }
+
+  bool Archive_Reader::seek(const long &offset, const int &origin) {
+    const long base = origin == SEEK_SET ? 0l : origin == SEEK_CUR ? long(m_position) : long(m_size);
+    const long position = base + offset;
+
+    if(position < 0l || position > long(m_size))
+      return false;
+
+    m_position = size_t(position);
+    return true;
+  }
+
+}
@@ -71,6 +71,10 @@ namespace Zeni {
     look_at(world_coord, horizon_plane.get_normal());
   }
 
+  Frustum Camera::get_frustum(const std::pair<Point2i, Point2i> &viewport) const {
+    return Frustum(*this, float(viewport.second.x - viewport.first.x) / (viewport.second.y - viewport.first.y));
+  }
+
 }
 
 #include <Zeni/Undefine.h>
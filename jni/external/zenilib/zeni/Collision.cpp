@@ -77,7 +77,7 @@ namespace Zeni {
       else if(LINE_TYPE::has_upper_bound() && uw > uu)
         return std::make_pair((closest_point + u).magnitude(), 1.0f);
 
-      const float t = uw / uu;
+      const float t = uu > 0.0f ? uw / uu : 0.0f;
       return std::make_pair((closest_point + t * u).magnitude(), t);
     }
 
@@ -132,7 +132,7 @@ namespace Zeni {
         sc_numer = 0.0f;
         sc_denom = 1.0f;
         tc_numer = vw;
-        tc_denom = vv;
+        tc_denom = vv > 0.0f ? vv : 1.0f;
       }
       
       Vector3f min_dist(w);
@@ -154,7 +154,7 @@ namespace Zeni {
       else if(LINE_TYPE1::has_upper_bound() && final_numer > uu)
         return std::make_pair((min_dist + u).magnitude(), 1.0f);
 
-      const float t = final_numer / uu;
+      const float t = uu > 0.0f ? final_numer / uu : 0.0f;
       return std::make_pair((min_dist + t * u).magnitude(), t);
     }
 
@@ -0,0 +1,560 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni.h>
+
+#include <Zeni/Float4.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <Zeni/Define.h>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  namespace Collision {
+
+    /* Begin Kernels
+     *
+     * Each kernel computes a batch of distances (before subtracting radii)
+     * and passes them to an output policy along with the radii to subtract.
+     */
+
+    class Batch_Distances {
+    public:
+      Batch_Distances(std::vector<float> &distances_, const size_t &size) : distances(distances_) {distances.resize((size + 3u) & ~size_t(3u));}
+      ~Batch_Distances() {}
+
+      void operator()(const size_t &index, const Float4 &distance, const Float4 &radii) {
+        float4_max(distance - radii, Float4(0.0f)).store(&distances[index]);
+      }
+
+      void finish(const size_t &size) {distances.resize(size);}
+
+    private:
+      std::vector<float> &distances;
+    };
+
+    class Batch_Hits {
+    public:
+      Batch_Hits(std::vector<size_t> &indices_, const size_t &size_) : indices(indices_), size(size_) {indices.clear();}
+
+      void operator()(const size_t &index, const Float4 &distance, const Float4 &radii) {
+        int bits = float4_mask_bits(float4_less(distance - radii, Float4(ZENI_COLLISION_EPSILON)));
+        for(size_t i = index; bits; ++i, bits >>= 1)
+          if((bits & 1) && i < size)
+            indices.push_back(i);
+      }
+
+      void finish(const size_t &) {}
+
+    private:
+      std::vector<size_t> &indices;
+      size_t size;
+    };
+
+    struct Batch_Point {
+      Batch_Point() {}
+      Batch_Point(const Point3f &point) : x(point.x), y(point.y), z(point.z) {}
+      Batch_Point(const Float4 &x_, const Float4 &y_, const Float4 &z_) : x(x_), y(y_), z(z_) {}
+
+      Float4 x, y, z;
+    };
+
+    inline Float4 batch_dot(const Batch_Point &lhs, const Batch_Point &rhs) {
+      return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+    }
+
+    inline Batch_Point operator-(const Batch_Point &lhs, const Batch_Point &rhs) {
+      return Batch_Point(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
+    }
+
+    inline Batch_Point operator+(const Batch_Point &lhs, const Batch_Point &rhs) {
+      return Batch_Point(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z);
+    }
+
+    inline Batch_Point operator*(const Float4 &lhs, const Batch_Point &rhs) {
+      return Batch_Point(lhs * rhs.x, lhs * rhs.y, lhs * rhs.z);
+    }
+
+    /// Distance from points to a line with interpolation values in [lower, upper]
+    inline Float4 batch_point_line(const Batch_Point &point,
+                                   const Batch_Point &end_point_a, const Batch_Point &direction, const Float4 &direction2,
+                                   const Float4 &lower, const Float4 &upper)
+    {
+      const Batch_Point w = point - end_point_a;
+      const Float4 safe_direction2 = float4_max(direction2, Float4(ZENI_COLLISION_EPSILON * ZENI_COLLISION_EPSILON));
+      const Float4 t = float4_clamp(batch_dot(direction, w) / safe_direction2, lower, upper);
+      const Batch_Point offset = w - t * direction;
+      return float4_sqrt(batch_dot(offset, offset));
+    }
+
+    /// Distance from Line_Segments (interpolation values in [0, 1]) to a line with interpolation values in [lower, upper]
+    inline Float4 batch_segment_line(const Batch_Point &end_point_a, const Batch_Point &direction, const Float4 &direction2,
+                                     const Batch_Point &line_a, const Batch_Point &line_direction, const Float4 &line_direction2,
+                                     const Float4 &lower, const Float4 &upper)
+    {
+      const Float4 zero(0.0f);
+      const Float4 one(1.0f);
+      const Float4 epsilon(ZENI_COLLISION_EPSILON);
+
+      const Batch_Point r = end_point_a - line_a;
+      const Float4 a = float4_max(direction2, epsilon * epsilon);
+      const Float4 e = float4_max(line_direction2, epsilon * epsilon);
+      const Float4 b = batch_dot(direction, line_direction);
+      const Float4 c = batch_dot(direction, r);
+      const Float4 f = batch_dot(line_direction, r);
+
+      /// Closest point on the unbounded line, or the start of the Line_Segment if they are parallel
+      const Float4 denom = a * e - b * b;
+      Float4 s = float4_select(float4_less(epsilon, denom), float4_clamp((b * f - c * e) / float4_max(denom, epsilon), zero, one), zero);
+
+      /// Clamp the line and find the closest point on the Line_Segment again
+      const Float4 t_unclamped = (b * s + f) / e;
+      const Float4 t = float4_clamp(t_unclamped, lower, upper);
+      s = float4_select(float4_less(t_unclamped, lower) , float4_clamp((b * lower - c) / a, zero, one),
+          float4_select(float4_less(upper, t_unclamped), float4_clamp((b * upper - c) / a, zero, one), s));
+
+      const Batch_Point offset = r + s * direction - t * line_direction;
+      return float4_sqrt(batch_dot(offset, offset));
+    }
+
+    /// Distance from Line_Segments to a Plane
+    inline Float4 batch_segment_plane(const Batch_Point &end_point_a, const Batch_Point &direction, const Plane &plane) {
+      const Batch_Point normal(Point3f(plane.get_normal()));
+      const Float4 distance_a = batch_dot(normal, end_point_a - Batch_Point(plane.get_point()));
+      const Float4 distance_b = distance_a + batch_dot(normal, direction);
+
+      const Float4 crosses = float4_less(distance_a * distance_b, Float4(0.0f));
+      return float4_select(crosses, Float4(0.0f), float4_min(float4_abs(distance_a), float4_abs(distance_b)));
+    }
+
+    /* End Kernels
+     */
+
+    template <typename LINE_TYPE>
+    static Float4 lower_bound_of() {
+      return Float4(LINE_TYPE::has_lower_bound() ? 0.0f : -FLT_MAX);
+    }
+
+    template <typename LINE_TYPE>
+    static Float4 upper_bound_of() {
+      return Float4(LINE_TYPE::has_upper_bound() ? 1.0f : FLT_MAX);
+    }
+
+    /** Sphere_Batch **/
+
+    template <typename OUTPUT>
+    static void sphere_batch_point(const size_t &size, const float * const x, const float * const y, const float * const z, const float * const radius,
+                                   const Point3f &point, const float &point_radius, OUTPUT output)
+    {
+      const Batch_Point rhs(point);
+      const Float4 rhs_radius(point_radius);
+
+      for(size_t i = 0; i < size; i += 4u) {
+        const Batch_Point center(Float4::load(x + i), Float4::load(y + i), Float4::load(z + i));
+        const Batch_Point offset = center - rhs;
+        output(i, float4_sqrt(batch_dot(offset, offset)), Float4::load(radius + i) + rhs_radius);
+      }
+
+      output.finish(size);
+    }
+
+    template <typename OUTPUT>
+    static void sphere_batch_plane(const size_t &size, const float * const x, const float * const y, const float * const z, const float * const radius,
+                                   const Plane &plane, OUTPUT output)
+    {
+      const Batch_Point normal(Point3f(plane.get_normal()));
+      const Batch_Point point(plane.get_point());
+
+      for(size_t i = 0; i < size; i += 4u) {
+        const Batch_Point center(Float4::load(x + i), Float4::load(y + i), Float4::load(z + i));
+        output(i, float4_abs(batch_dot(normal, center - point)), Float4::load(radius + i));
+      }
+
+      output.finish(size);
+    }
+
+    template <typename OUTPUT>
+    static void sphere_batch_line(const size_t &size, const float * const x, const float * const y, const float * const z, const float * const radius,
+                                  const Point3f &end_point_a, const Vector3f &direction, const float &line_radius,
+                                  const Float4 &lower, const Float4 &upper, OUTPUT output)
+    {
+      const Batch_Point a(end_point_a);
+      const Batch_Point u = Batch_Point(Point3f(direction));
+      const Float4 uu(direction * direction);
+      const Float4 rhs_radius(line_radius);
+
+      for(size_t i = 0; i < size; i += 4u) {
+        const Batch_Point center(Float4::load(x + i), Float4::load(y + i), Float4::load(z + i));
+        output(i, batch_point_line(center, a, u, uu, lower, upper), Float4::load(radius + i) + rhs_radius);
+      }
+
+      output.finish(size);
+    }
+
+    void Sphere_Batch::clear() {
+      m_size = 0u;
+      m_x.clear();
+      m_y.clear();
+      m_z.clear();
+      m_radius.clear();
+    }
+
+    void Sphere_Batch::reserve(const size_t &capacity) {
+      const size_t padded = (capacity + 3u) & ~size_t(3u);
+      m_x.reserve(padded);
+      m_y.reserve(padded);
+      m_z.reserve(padded);
+      m_radius.reserve(padded);
+    }
+
+    void Sphere_Batch::push_back(const Sphere &sphere) {
+      /// Pad to a multiple of four with empty Spheres at the origin
+      if(!(m_size & 3u)) {
+        m_x.resize(m_size + 4u, 0.0f);
+        m_y.resize(m_size + 4u, 0.0f);
+        m_z.resize(m_size + 4u, 0.0f);
+        m_radius.resize(m_size + 4u, 0.0f);
+      }
+
+      set(m_size++, sphere);
+    }
+
+    void Sphere_Batch::set(const size_t &index, const Sphere &sphere) {
+      m_x[index] = sphere.get_center().x;
+      m_y[index] = sphere.get_center().y;
+      m_z[index] = sphere.get_center().z;
+      m_radius[index] = sphere.get_radius();
+    }
+
+    Sphere Sphere_Batch::operator[](const size_t &index) const {
+      return Sphere(Point3f(m_x[index], m_y[index], m_z[index]), m_radius[index]);
+    }
+
+#define ZENI_SPHERE_BATCH_ARRAYS m_size, m_size ? &m_x[0] : 0, m_size ? &m_y[0] : 0, m_size ? &m_z[0] : 0, m_size ? &m_radius[0] : 0
+
+    void Sphere_Batch::shortest_distance(const Point3f &rhs, std::vector<float> &distances) const {
+      sphere_batch_point(ZENI_SPHERE_BATCH_ARRAYS, rhs, 0.0f, Batch_Distances(distances, m_size));
+    }
+    void Sphere_Batch::shortest_distance(const Sphere &rhs, std::vector<float> &distances) const {
+      sphere_batch_point(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_center(), rhs.get_radius(), Batch_Distances(distances, m_size));
+    }
+    void Sphere_Batch::shortest_distance(const Plane &rhs, std::vector<float> &distances) const {
+      sphere_batch_plane(ZENI_SPHERE_BATCH_ARRAYS, rhs, Batch_Distances(distances, m_size));
+    }
+    void Sphere_Batch::shortest_distance(const Line &rhs, std::vector<float> &distances) const {
+      sphere_batch_line(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                        lower_bound_of<Line>(), upper_bound_of<Line>(), Batch_Distances(distances, m_size));
+    }
+    void Sphere_Batch::shortest_distance(const Ray &rhs, std::vector<float> &distances) const {
+      sphere_batch_line(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                        lower_bound_of<Ray>(), upper_bound_of<Ray>(), Batch_Distances(distances, m_size));
+    }
+    void Sphere_Batch::shortest_distance(const Line_Segment &rhs, std::vector<float> &distances) const {
+      sphere_batch_line(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                        lower_bound_of<Line_Segment>(), upper_bound_of<Line_Segment>(), Batch_Distances(distances, m_size));
+    }
+    void Sphere_Batch::shortest_distance(const Capsule &rhs, std::vector<float> &distances) const {
+      sphere_batch_line(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_end_point_a(), rhs.get_end_point_b() - rhs.get_end_point_a(), rhs.get_radius(),
+                        lower_bound_of<Line_Segment>(), upper_bound_of<Line_Segment>(), Batch_Distances(distances, m_size));
+    }
+
+    void Sphere_Batch::intersects(const Point3f &rhs, std::vector<size_t> &indices) const {
+      sphere_batch_point(ZENI_SPHERE_BATCH_ARRAYS, rhs, 0.0f, Batch_Hits(indices, m_size));
+    }
+    void Sphere_Batch::intersects(const Sphere &rhs, std::vector<size_t> &indices) const {
+      sphere_batch_point(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_center(), rhs.get_radius(), Batch_Hits(indices, m_size));
+    }
+    void Sphere_Batch::intersects(const Plane &rhs, std::vector<size_t> &indices) const {
+      sphere_batch_plane(ZENI_SPHERE_BATCH_ARRAYS, rhs, Batch_Hits(indices, m_size));
+    }
+    void Sphere_Batch::intersects(const Line &rhs, std::vector<size_t> &indices) const {
+      sphere_batch_line(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                        lower_bound_of<Line>(), upper_bound_of<Line>(), Batch_Hits(indices, m_size));
+    }
+    void Sphere_Batch::intersects(const Ray &rhs, std::vector<size_t> &indices) const {
+      sphere_batch_line(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                        lower_bound_of<Ray>(), upper_bound_of<Ray>(), Batch_Hits(indices, m_size));
+    }
+    void Sphere_Batch::intersects(const Line_Segment &rhs, std::vector<size_t> &indices) const {
+      sphere_batch_line(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                        lower_bound_of<Line_Segment>(), upper_bound_of<Line_Segment>(), Batch_Hits(indices, m_size));
+    }
+    void Sphere_Batch::intersects(const Capsule &rhs, std::vector<size_t> &indices) const {
+      sphere_batch_line(ZENI_SPHERE_BATCH_ARRAYS, rhs.get_end_point_a(), rhs.get_end_point_b() - rhs.get_end_point_a(), rhs.get_radius(),
+                        lower_bound_of<Line_Segment>(), upper_bound_of<Line_Segment>(), Batch_Hits(indices, m_size));
+    }
+
+    void Sphere_Batch::intersects(const Sphere_Batch &rhs, std::vector<std::pair<size_t, size_t> > &pairs) const {
+      pairs.clear();
+
+      std::vector<size_t> indices;
+      for(size_t j = 0; j != rhs.m_size; ++j) {
+        intersects(rhs[j], indices);
+        for(std::vector<size_t>::const_iterator it = indices.begin(), iend = indices.end(); it != iend; ++it)
+          pairs.push_back(std::make_pair(*it, j));
+      }
+    }
+
+    void Sphere_Batch::cast(const Ray &rhs, std::vector<float> &interpolations) const {
+      interpolations.resize((m_size + 3u) & ~size_t(3u));
+
+      const Float4 zero(0.0f);
+      const Float4 miss(-1.0f);
+
+      const Batch_Point origin(rhs.get_end_point_a());
+      const Batch_Point direction(Point3f(rhs.get_direction()));
+      const Float4 a(std::max(rhs.get_direction2(), ZENI_COLLISION_EPSILON * ZENI_COLLISION_EPSILON));
+
+      for(size_t i = 0; i < m_size; i += 4u) {
+        const Batch_Point center(Float4::load(&m_x[i]), Float4::load(&m_y[i]), Float4::load(&m_z[i]));
+        const Float4 radius = Float4::load(&m_radius[i]);
+
+        /// Solve |origin + t * direction - center| = radius for the smaller t
+        const Batch_Point m = origin - center;
+        const Float4 b = batch_dot(m, direction);
+        const Float4 c = batch_dot(m, m) - radius * radius;
+        const Float4 discriminant = b * b - a * c;
+
+        const Float4 t = (zero - b - float4_sqrt(float4_max(discriminant, zero))) / a;
+
+        /// Masks may only come from comparisons, so select straight from them
+        float4_select(float4_less(c, zero), zero,
+          float4_select(float4_less(discriminant, zero), miss,
+            float4_select(float4_less(t, zero), miss, t))).store(&interpolations[i]);
+      }
+
+      interpolations.resize(m_size);
+    }
+
+#undef ZENI_SPHERE_BATCH_ARRAYS
+
+    /** Capsule_Batch **/
+
+    struct Capsule_Batch_Arrays {
+      size_t size;
+      const float * ax;
+      const float * ay;
+      const float * az;
+      const float * dx;
+      const float * dy;
+      const float * dz;
+      const float * radius;
+
+      Batch_Point load_a(const size_t &i) const {return Batch_Point(Float4::load(ax + i), Float4::load(ay + i), Float4::load(az + i));}
+      Batch_Point load_d(const size_t &i) const {return Batch_Point(Float4::load(dx + i), Float4::load(dy + i), Float4::load(dz + i));}
+    };
+
+    template <typename OUTPUT>
+    static void capsule_batch_point(const Capsule_Batch_Arrays &arrays, const Point3f &point, const float &point_radius, OUTPUT output) {
+      const Batch_Point rhs(point);
+      const Float4 rhs_radius(point_radius);
+      const Float4 zero(0.0f);
+      const Float4 one(1.0f);
+
+      for(size_t i = 0; i < arrays.size; i += 4u) {
+        const Batch_Point d = arrays.load_d(i);
+        output(i, batch_point_line(rhs, arrays.load_a(i), d, batch_dot(d, d), zero, one), Float4::load(arrays.radius + i) + rhs_radius);
+      }
+
+      output.finish(arrays.size);
+    }
+
+    template <typename OUTPUT>
+    static void capsule_batch_plane(const Capsule_Batch_Arrays &arrays, const Plane &plane, OUTPUT output) {
+      for(size_t i = 0; i < arrays.size; i += 4u)
+        output(i, batch_segment_plane(arrays.load_a(i), arrays.load_d(i), plane), Float4::load(arrays.radius + i));
+
+      output.finish(arrays.size);
+    }
+
+    template <typename OUTPUT>
+    static void capsule_batch_line(const Capsule_Batch_Arrays &arrays,
+                                   const Point3f &end_point_a, const Vector3f &direction, const float &line_radius,
+                                   const Float4 &lower, const Float4 &upper, OUTPUT output)
+    {
+      const Batch_Point a(end_point_a);
+      const Batch_Point u = Batch_Point(Point3f(direction));
+      const Float4 uu(direction * direction);
+      const Float4 rhs_radius(line_radius);
+
+      for(size_t i = 0; i < arrays.size; i += 4u) {
+        const Batch_Point d = arrays.load_d(i);
+        output(i, batch_segment_line(arrays.load_a(i), d, batch_dot(d, d), a, u, uu, lower, upper), Float4::load(arrays.radius + i) + rhs_radius);
+      }
+
+      output.finish(arrays.size);
+    }
+
+    void Capsule_Batch::clear() {
+      m_size = 0u;
+      m_ax.clear();
+      m_ay.clear();
+      m_az.clear();
+      m_dx.clear();
+      m_dy.clear();
+      m_dz.clear();
+      m_radius.clear();
+    }
+
+    void Capsule_Batch::reserve(const size_t &capacity) {
+      const size_t padded = (capacity + 3u) & ~size_t(3u);
+      m_ax.reserve(padded);
+      m_ay.reserve(padded);
+      m_az.reserve(padded);
+      m_dx.reserve(padded);
+      m_dy.reserve(padded);
+      m_dz.reserve(padded);
+      m_radius.reserve(padded);
+    }
+
+    void Capsule_Batch::push_back(const Capsule &capsule) {
+      /// Pad to a multiple of four with empty Capsules at the origin
+      if(!(m_size & 3u)) {
+        m_ax.resize(m_size + 4u, 0.0f);
+        m_ay.resize(m_size + 4u, 0.0f);
+        m_az.resize(m_size + 4u, 0.0f);
+        m_dx.resize(m_size + 4u, 0.0f);
+        m_dy.resize(m_size + 4u, 0.0f);
+        m_dz.resize(m_size + 4u, 0.0f);
+        m_radius.resize(m_size + 4u, 0.0f);
+      }
+
+      set(m_size++, capsule);
+    }
+
+    void Capsule_Batch::set(const size_t &index, const Capsule &capsule) {
+      const Point3f &a = capsule.get_end_point_a();
+      const Vector3f d = capsule.get_end_point_b() - a;
+
+      m_ax[index] = a.x;
+      m_ay[index] = a.y;
+      m_az[index] = a.z;
+      m_dx[index] = d.x;
+      m_dy[index] = d.y;
+      m_dz[index] = d.z;
+      m_radius[index] = capsule.get_radius();
+    }
+
+    Capsule Capsule_Batch::operator[](const size_t &index) const {
+      const Point3f a(m_ax[index], m_ay[index], m_az[index]);
+      return Capsule(a, a + Vector3f(m_dx[index], m_dy[index], m_dz[index]), m_radius[index]);
+    }
+
+#define ZENI_CAPSULE_BATCH_ARRAYS \
+      Capsule_Batch_Arrays arrays = {m_size, 0, 0, 0, 0, 0, 0, 0}; \
+      if(m_size) { \
+        arrays.ax = &m_ax[0]; \
+        arrays.ay = &m_ay[0]; \
+        arrays.az = &m_az[0]; \
+        arrays.dx = &m_dx[0]; \
+        arrays.dy = &m_dy[0]; \
+        arrays.dz = &m_dz[0]; \
+        arrays.radius = &m_radius[0]; \
+      }
+
+    void Capsule_Batch::shortest_distance(const Point3f &rhs, std::vector<float> &distances) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_point(arrays, rhs, 0.0f, Batch_Distances(distances, m_size));
+    }
+    void Capsule_Batch::shortest_distance(const Sphere &rhs, std::vector<float> &distances) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_point(arrays, rhs.get_center(), rhs.get_radius(), Batch_Distances(distances, m_size));
+    }
+    void Capsule_Batch::shortest_distance(const Plane &rhs, std::vector<float> &distances) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_plane(arrays, rhs, Batch_Distances(distances, m_size));
+    }
+    void Capsule_Batch::shortest_distance(const Line &rhs, std::vector<float> &distances) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_line(arrays, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                         lower_bound_of<Line>(), upper_bound_of<Line>(), Batch_Distances(distances, m_size));
+    }
+    void Capsule_Batch::shortest_distance(const Ray &rhs, std::vector<float> &distances) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_line(arrays, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                         lower_bound_of<Ray>(), upper_bound_of<Ray>(), Batch_Distances(distances, m_size));
+    }
+    void Capsule_Batch::shortest_distance(const Line_Segment &rhs, std::vector<float> &distances) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_line(arrays, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                         lower_bound_of<Line_Segment>(), upper_bound_of<Line_Segment>(), Batch_Distances(distances, m_size));
+    }
+    void Capsule_Batch::shortest_distance(const Capsule &rhs, std::vector<float> &distances) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_line(arrays, rhs.get_end_point_a(), rhs.get_end_point_b() - rhs.get_end_point_a(), rhs.get_radius(),
+                         lower_bound_of<Line_Segment>(), upper_bound_of<Line_Segment>(), Batch_Distances(distances, m_size));
+    }
+
+    void Capsule_Batch::intersects(const Point3f &rhs, std::vector<size_t> &indices) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_point(arrays, rhs, 0.0f, Batch_Hits(indices, m_size));
+    }
+    void Capsule_Batch::intersects(const Sphere &rhs, std::vector<size_t> &indices) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_point(arrays, rhs.get_center(), rhs.get_radius(), Batch_Hits(indices, m_size));
+    }
+    void Capsule_Batch::intersects(const Plane &rhs, std::vector<size_t> &indices) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_plane(arrays, rhs, Batch_Hits(indices, m_size));
+    }
+    void Capsule_Batch::intersects(const Line &rhs, std::vector<size_t> &indices) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_line(arrays, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                         lower_bound_of<Line>(), upper_bound_of<Line>(), Batch_Hits(indices, m_size));
+    }
+    void Capsule_Batch::intersects(const Ray &rhs, std::vector<size_t> &indices) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_line(arrays, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                         lower_bound_of<Ray>(), upper_bound_of<Ray>(), Batch_Hits(indices, m_size));
+    }
+    void Capsule_Batch::intersects(const Line_Segment &rhs, std::vector<size_t> &indices) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_line(arrays, rhs.get_end_point_a(), rhs.get_direction(), 0.0f,
+                         lower_bound_of<Line_Segment>(), upper_bound_of<Line_Segment>(), Batch_Hits(indices, m_size));
+    }
+    void Capsule_Batch::intersects(const Capsule &rhs, std::vector<size_t> &indices) const {
+      ZENI_CAPSULE_BATCH_ARRAYS
+      capsule_batch_line(arrays, rhs.get_end_point_a(), rhs.get_end_point_b() - rhs.get_end_point_a(), rhs.get_radius(),
+                         lower_bound_of<Line_Segment>(), upper_bound_of<Line_Segment>(), Batch_Hits(indices, m_size));
+    }
+
+#undef ZENI_CAPSULE_BATCH_ARRAYS
+
+    void Capsule_Batch::intersects(const Capsule_Batch &rhs, std::vector<std::pair<size_t, size_t> > &pairs) const {
+      pairs.clear();
+
+      std::vector<size_t> indices;
+      for(size_t j = 0; j != rhs.m_size; ++j) {
+        intersects(rhs[j], indices);
+        for(std::vector<size_t>::const_iterator it = indices.begin(), iend = indices.end(); it != iend; ++it)
+          pairs.push_back(std::make_pair(*it, j));
+      }
+    }
+
+  }
+
+}
+
+#include <Zeni/Undefine.h>
@@ -0,0 +1,502 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <Zeni/Define.h>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  namespace Collision {
+
+    /* Begin Sweep Helpers
+     *
+     * Sweeps of a Sphere reduce to a point moving against an object grown by
+     * the radius of the Sphere, which has a closed form solution.  Everything
+     * else falls back to conservative advancement, which steps forward by
+     * distance / speed until the objects touch.  Since the objects only
+     * translate, they can never close a gap faster than that, so long as the
+     * distance used never overestimates the true one.
+     */
+
+    static const int g_sweep_iterations = 64;
+
+    /// Find when a point moving from 'origin' by 'motion' first comes within 'radius' of 'center'
+    static bool sweep_point_sphere(const Point3f &origin, const Vector3f &motion,
+                                   const Point3f &center, const float &radius, float &time)
+    {
+      const Vector3f m = origin - center;
+      const float c = m * m - radius * radius;
+
+      if(c <= 0.0f) {
+        time = 0.0f;
+        return true;
+      }
+
+      const float a = motion * motion;
+      const float b = m * motion;
+      if(a < ZENI_COLLISION_EPSILON * ZENI_COLLISION_EPSILON || b >= 0.0f)
+        return false;
+
+      const float discriminant = b * b - a * c;
+      if(discriminant < 0.0f)
+        return false;
+
+      time = (-b - float(sqrt(discriminant))) / a;
+      return time <= 1.0f;
+    }
+
+    /// Find when a point moving from 'origin' by 'motion' first comes within 'radius' of a Line_Segment
+    static bool sweep_point_capsule(const Point3f &origin, const Vector3f &motion,
+                                    const Line_Segment &axis, const float &radius, float &time)
+    {
+      if(axis.nearest_point(origin).first <= radius) {
+        time = 0.0f;
+        return true;
+      }
+
+      bool hit = false;
+      float t;
+      time = 1.0f;
+
+      if(sweep_point_sphere(origin, motion, axis.get_end_point_a(), radius, t) && t <= time) {
+        time = t;
+        hit = true;
+      }
+      if(sweep_point_sphere(origin, motion, axis.get_end_point_b(), radius, t) && t <= time) {
+        time = t;
+        hit = true;
+      }
+
+      /// The curved side, found by removing the component along the axis
+      const Vector3f &d = axis.get_direction();
+      const float &dd = axis.get_direction2();
+      if(dd > ZENI_COLLISION_EPSILON * ZENI_COLLISION_EPSILON) {
+        const Vector3f w = origin - axis.get_end_point_a();
+        const Vector3f w_perp = w - ((w * d) / dd) * d;
+        const Vector3f m_perp = motion - ((motion * d) / dd) * d;
+
+        const float a = m_perp * m_perp;
+        const float b = w_perp * m_perp;
+        const float c = w_perp * w_perp - radius * radius;
+
+        if(a > ZENI_COLLISION_EPSILON * ZENI_COLLISION_EPSILON && b < 0.0f) {
+          const float discriminant = b * b - a * c;
+
+          if(discriminant >= 0.0f) {
+            t = (-b - float(sqrt(discriminant))) / a;
+
+            if(t >= 0.0f && t <= time) {
+              const float s = (w + t * motion) * d;
+              if(s >= 0.0f && s <= dd) {
+                time = t;
+                hit = true;
+              }
+            }
+          }
+        }
+      }
+
+      return hit;
+    }
+
+    static Point3f sweep_nearest_point(const Line_Segment &lhs, const Point3f &rhs) {
+      return lhs.get_end_point_a() + lhs.nearest_point(rhs).second * lhs.get_direction();
+    }
+
+    static Point3f sweep_nearest_point(const Line_Segment &lhs, const Line_Segment &rhs) {
+      return lhs.get_end_point_a() + lhs.nearest_point(rhs).second * lhs.get_direction();
+    }
+
+    static Line_Segment sweep_axis(const Capsule &capsule) {
+      return Line_Segment(capsule.get_end_point_a(), capsule.get_end_point_b());
+    }
+
+    /// Get the gap between the projections of a Line_Segment and a Parallelepiped onto a unit 'axis'
+    static float sweep_separation(const Point3f &end_point_a, const Point3f &end_point_b, const Parallelepiped &rhs, const Vector3f &axis) {
+      const float rhs_center = Vector3f(rhs.get_center()) * axis;
+      const float rhs_radius = 0.5f * (float(fabs(rhs.get_edge_a() * axis)) +
+                                       float(fabs(rhs.get_edge_b() * axis)) +
+                                       float(fabs(rhs.get_edge_c() * axis)));
+
+      const float projection_a = Vector3f(end_point_a) * axis;
+      const float projection_b = Vector3f(end_point_b) * axis;
+
+      return std::max(std::min(projection_a, projection_b) - (rhs_center + rhs_radius),
+                      (rhs_center - rhs_radius) - std::max(projection_a, projection_b));
+    }
+
+    /// Test whether a Line_Segment touches a Parallelepiped, using the face normals and the cross products of the Line_Segment with the edges
+    static bool sweep_overlaps(const Line_Segment &lhs, const Parallelepiped &rhs) {
+      const Point3f &end_point_a = lhs.get_end_point_a();
+      const Point3f &end_point_b = lhs.get_end_point_b();
+
+      if(sweep_separation(end_point_a, end_point_b, rhs, rhs.get_normal_a()) > 0.0f ||
+         sweep_separation(end_point_a, end_point_b, rhs, rhs.get_normal_b()) > 0.0f ||
+         sweep_separation(end_point_a, end_point_b, rhs, rhs.get_normal_c()) > 0.0f)
+        return false;
+
+      const Vector3f * const edges[3] = {&rhs.get_edge_a(), &rhs.get_edge_b(), &rhs.get_edge_c()};
+      for(int i = 0; i != 3; ++i) {
+        const Vector3f axis = lhs.get_direction() % *edges[i];
+        if(axis * axis > ZENI_COLLISION_EPSILON * ZENI_COLLISION_EPSILON &&
+           sweep_separation(end_point_a, end_point_b, rhs, axis.normalized()) > 0.0f)
+          return false;
+      }
+
+      return true;
+    }
+
+    static void sweep_consider(const Point3f &lhs, const Point3f &rhs,
+                               float &distance, Point3f &lhs_nearest, Point3f &rhs_nearest)
+    {
+      const float candidate = (lhs - rhs).magnitude();
+      if(candidate < distance) {
+        distance = candidate;
+        lhs_nearest = lhs;
+        rhs_nearest = rhs;
+      }
+    }
+
+    /** Get the exact distance from a Line_Segment to a Parallelepiped, and the nearest points on each
+     *
+     * Parallelepiped::shortest_distance clamps in the skewed coordinates of the
+     * Parallelepiped and can overestimate, which would let conservative
+     * advancement step past the contact.  Unless they overlap, the nearest
+     * points are either an end point and a face, or the Line_Segment and one
+     * of the twelve edges.
+     */
+    static float sweep_nearest(const Line_Segment &lhs, const Parallelepiped &rhs, Point3f &lhs_nearest, Point3f &rhs_nearest) {
+      if(sweep_overlaps(lhs, rhs)) {
+        lhs_nearest = sweep_nearest_point(lhs, rhs.get_center());
+        rhs_nearest = lhs_nearest;
+        return 0.0f;
+      }
+
+      const Vector3f edges[3] = {rhs.get_edge_a(), rhs.get_edge_b(), rhs.get_edge_c()};
+      float distance = FLT_MAX;
+
+      for(int i = 0; i != 3; ++i) {
+        const Vector3f &u = edges[(i + 1) % 3];
+        const Vector3f &v = edges[(i + 2) % 3];
+
+        for(int j = 0; j != 4; ++j) {
+          const Point3f origin = rhs.get_point() + float(j & 1) * u + float(j >> 1) * v;
+
+          /// Edges parallel to edges[i]
+          const Line_Segment edge(origin, origin + edges[i]);
+          const Point3f nearest = sweep_nearest_point(lhs, edge);
+          sweep_consider(nearest, sweep_nearest_point(edge, nearest), distance, lhs_nearest, rhs_nearest);
+        }
+
+        /// Faces spanned by u and v
+        const float uu = u * u;
+        const float uv = u * v;
+        const float vv = v * v;
+        const float denom = uu * vv - uv * uv;
+        if(denom <= ZENI_COLLISION_EPSILON * ZENI_COLLISION_EPSILON)
+          continue;
+
+        for(int j = 0; j != 4; ++j) {
+          const Point3f origin = rhs.get_point() + float(j & 1) * edges[i];
+          const Point3f &end_point = j & 2 ? lhs.get_end_point_b() : lhs.get_end_point_a();
+
+          const Vector3f w = end_point - origin;
+          const float wu = w * u;
+          const float wv = w * v;
+          const float s = (wu * vv - wv * uv) / denom;
+          const float t = (wv * uu - wu * uv) / denom;
+
+          if(s >= 0.0f && s <= 1.0f && t >= 0.0f && t <= 1.0f)
+            sweep_consider(end_point, origin + s * u + t * v, distance, lhs_nearest, rhs_nearest);
+        }
+      }
+
+      return distance;
+    }
+
+    template <typename TYPE>
+    static float sweep_distance(const Sphere &lhs, const TYPE &rhs) {
+      return lhs.shortest_distance(rhs);
+    }
+
+    template <typename TYPE>
+    static float sweep_distance(const Capsule &lhs, const TYPE &rhs) {
+      return lhs.shortest_distance(rhs);
+    }
+
+    /// The exact distance is only needed near contact; the gap along the face normals is a cheaper lower bound elsewhere
+    static float sweep_distance(const Line_Segment &lhs, const float &radius, const Parallelepiped &rhs) {
+      const float bound = std::max(sweep_separation(lhs.get_end_point_a(), lhs.get_end_point_b(), rhs, rhs.get_normal_a()),
+                          std::max(sweep_separation(lhs.get_end_point_a(), lhs.get_end_point_b(), rhs, rhs.get_normal_b()),
+                                   sweep_separation(lhs.get_end_point_a(), lhs.get_end_point_b(), rhs, rhs.get_normal_c()))) - radius;
+      if(bound > ZENI_COLLISION_EPSILON)
+        return bound;
+
+      Point3f lhs_nearest, rhs_nearest;
+      return std::max(0.0f, sweep_nearest(lhs, rhs, lhs_nearest, rhs_nearest) - radius);
+    }
+
+    static float sweep_distance(const Sphere &lhs, const Parallelepiped &rhs) {
+      return sweep_distance(Line_Segment(lhs.get_center(), lhs.get_center()), lhs.get_radius(), rhs);
+    }
+
+    static float sweep_distance(const Capsule &lhs, const Parallelepiped &rhs) {
+      return sweep_distance(sweep_axis(lhs), lhs.get_radius(), rhs);
+    }
+
+    /// Get the radius of a Sphere about the center of a Parallelepiped which contains it
+    static float sweep_bounding_radius(const Parallelepiped &rhs) {
+      const Vector3f &a = rhs.get_edge_a();
+      const Vector3f &b = rhs.get_edge_b();
+      const Vector3f &c = rhs.get_edge_c();
+
+      return 0.5f * float(sqrt(std::max(std::max((a + b + c).magnitude2(), (a + b - c).magnitude2()),
+                                        std::max((a - b + c).magnitude2(), (b + c - a).magnitude2()))));
+    }
+
+    /// Step 'swept' forward from 'time' until it touches 'rhs'; A near miss which runs out of iterations is a miss
+    template <typename SWEPT_TYPE, typename TYPE>
+    static bool sweep_advance(const SWEPT_TYPE &swept, const TYPE &rhs, float &time) {
+      const float speed = swept.get_motion().magnitude();
+
+      for(int i = 0; i != g_sweep_iterations; ++i) {
+        const float distance = sweep_distance(swept.at(time), rhs);
+        if(distance < ZENI_COLLISION_EPSILON)
+          return true;
+        if(speed < ZENI_COLLISION_EPSILON)
+          return false;
+
+        time += distance / speed;
+        if(time > 1.0f)
+          return false;
+      }
+
+      return sweep_distance(swept.at(time), rhs) < ZENI_COLLISION_EPSILON;
+    }
+
+    static Vector3f sweep_normal(const Vector3f &separation, const Vector3f &motion) {
+      if(separation * separation > ZENI_COLLISION_EPSILON * ZENI_COLLISION_EPSILON)
+        return separation.normalized();
+      if(motion * motion > ZENI_COLLISION_EPSILON * ZENI_COLLISION_EPSILON)
+        return -motion.normalized();
+      return Vector3f(0.0f, 0.0f, 1.0f);
+    }
+
+    /// Move the contact point of an Impact computed relative to an object moving by 'motion'
+    static Impact sweep_shifted(const Impact &impact, const Vector3f &motion) {
+      if(!impact.is_hit())
+        return impact;
+      return Impact(impact.get_time(), impact.get_contact() + impact.get_time() * motion, impact.get_normal());
+    }
+
+    /// As sweep_shifted, but also exchange which object is considered to be moving
+    static Impact sweep_reversed(const Impact &impact, const Vector3f &motion) {
+      if(!impact.is_hit())
+        return impact;
+      return Impact(impact.get_time(), impact.get_contact() + impact.get_time() * motion, -impact.get_normal());
+    }
+
+    /* End Sweep Helpers
+     */
+
+    Swept_Sphere::Swept_Sphere(const Sphere &sphere_, const Vector3f &motion_)
+      : sphere(sphere_),
+      motion(motion_)
+    {
+    }
+
+    Impact Swept_Sphere::time_of_impact(const Point3f &rhs) const {
+      float time;
+      if(!sweep_point_sphere(sphere.get_center(), motion, rhs, sphere.get_radius(), time))
+        return Impact();
+
+      return Impact(time, rhs, sweep_normal(at(time).get_center() - rhs, motion));
+    }
+
+    Impact Swept_Sphere::time_of_impact(const Sphere &rhs) const {
+      float time;
+      if(!sweep_point_sphere(sphere.get_center(), motion, rhs.get_center(), sphere.get_radius() + rhs.get_radius(), time))
+        return Impact();
+
+      const Vector3f normal = sweep_normal(at(time).get_center() - rhs.get_center(), motion);
+      return Impact(time, rhs.get_center() + rhs.get_radius() * normal, normal);
+    }
+
+    Impact Swept_Sphere::time_of_impact(const Plane &rhs) const {
+      const float distance = (sphere.get_center() - rhs.get_point()) * rhs.get_normal();
+      const Vector3f normal = distance < 0.0f ? -rhs.get_normal() : rhs.get_normal();
+      const float gap = float(fabs(distance)) - sphere.get_radius();
+
+      float time = 0.0f;
+      if(gap > 0.0f) {
+        const float approach = -(motion * normal);
+        if(approach <= gap)
+          return Impact();
+        time = gap / approach;
+      }
+
+      const Point3f center = at(time).get_center();
+      return Impact(time, center - ((center - rhs.get_point()) * normal) * normal, normal);
+    }
+
+    Impact Swept_Sphere::time_of_impact(const Line_Segment &rhs) const {
+      float time;
+      if(!sweep_point_capsule(sphere.get_center(), motion, rhs, sphere.get_radius(), time))
+        return Impact();
+
+      const Point3f center = at(time).get_center();
+      const Point3f contact = sweep_nearest_point(rhs, center);
+      return Impact(time, contact, sweep_normal(center - contact, motion));
+    }
+
+    Impact Swept_Sphere::time_of_impact(const Capsule &rhs) const {
+      const Line_Segment axis = sweep_axis(rhs);
+
+      float time;
+      if(!sweep_point_capsule(sphere.get_center(), motion, axis, sphere.get_radius() + rhs.get_radius(), time))
+        return Impact();
+
+      const Point3f center = at(time).get_center();
+      const Point3f nearest = sweep_nearest_point(axis, center);
+      const Vector3f normal = sweep_normal(center - nearest, motion);
+      return Impact(time, nearest + rhs.get_radius() * normal, normal);
+    }
+
+    Impact Swept_Sphere::time_of_impact(const Parallelepiped &rhs) const {
+      /// Nothing can happen before the bounding Sphere is reached
+      float time;
+      if(!sweep_point_sphere(sphere.get_center(), motion, rhs.get_center(), sphere.get_radius() + sweep_bounding_radius(rhs), time) ||
+         !sweep_advance(*this, rhs, time))
+        return Impact();
+
+      const Point3f center = at(time).get_center();
+      Point3f nearest, contact;
+      sweep_nearest(Line_Segment(center, center), rhs, nearest, contact);
+      return Impact(time, contact, sweep_normal(center - contact, motion));
+    }
+
+    Impact Swept_Sphere::time_of_impact(const Swept_Sphere &rhs) const {
+      return sweep_shifted(Swept_Sphere(sphere, motion - rhs.motion).time_of_impact(rhs.sphere), rhs.motion);
+    }
+
+    Impact Swept_Sphere::time_of_impact(const Swept_Capsule &rhs) const {
+      return sweep_shifted(Swept_Sphere(sphere, motion - rhs.get_motion()).time_of_impact(rhs.get_capsule()), rhs.get_motion());
+    }
+
+    Sphere Swept_Sphere::at(const float &time) const {
+      return Sphere(sphere.get_center() + time * motion, sphere.get_radius());
+    }
+
+    Swept_Capsule::Swept_Capsule(const Capsule &capsule_, const Vector3f &motion_)
+      : capsule(capsule_),
+      motion(motion_)
+    {
+    }
+
+    Impact Swept_Capsule::time_of_impact(const Point3f &rhs) const {
+      return sweep_reversed(Swept_Sphere(Sphere(rhs, 0.0f), -motion).time_of_impact(capsule), motion);
+    }
+
+    Impact Swept_Capsule::time_of_impact(const Sphere &rhs) const {
+      return sweep_reversed(Swept_Sphere(rhs, -motion).time_of_impact(capsule), motion);
+    }
+
+    Impact Swept_Capsule::time_of_impact(const Plane &rhs) const {
+      const float distance_a = (capsule.get_end_point_a() - rhs.get_point()) * rhs.get_normal();
+      const float distance_b = (capsule.get_end_point_b() - rhs.get_point()) * rhs.get_normal();
+      const bool below = distance_a + distance_b < 0.0f;
+      const Vector3f normal = below ? -rhs.get_normal() : rhs.get_normal();
+
+      /// The end point nearer the Plane touches first, unless the Capsule already crosses it
+      const bool nearer_a = below ? distance_a >= distance_b : distance_a <= distance_b;
+      const float gap = (below ? -1.0f : 1.0f) * (nearer_a ? distance_a : distance_b) - capsule.get_radius();
+
+      float time = 0.0f;
+      if(gap > 0.0f) {
+        const float approach = -(motion * normal);
+        if(approach <= gap)
+          return Impact();
+        time = gap / approach;
+      }
+
+      const Point3f end_point = (nearer_a ? capsule.get_end_point_a() : capsule.get_end_point_b()) + time * motion;
+      return Impact(time, end_point - ((end_point - rhs.get_point()) * normal) * normal, normal);
+    }
+
+    Impact Swept_Capsule::time_of_impact(const Line_Segment &rhs) const {
+      float time = 0.0f;
+      if(!sweep_advance(*this, rhs, time))
+        return Impact();
+
+      const Point3f nearest = sweep_nearest_point(sweep_axis(at(time)), rhs);
+      const Point3f contact = sweep_nearest_point(rhs, nearest);
+      return Impact(time, contact, sweep_normal(nearest - contact, motion));
+    }
+
+    Impact Swept_Capsule::time_of_impact(const Capsule &rhs) const {
+      float time = 0.0f;
+      if(!sweep_advance(*this, rhs, time))
+        return Impact();
+
+      const Line_Segment axis = sweep_axis(at(time));
+      const Line_Segment rhs_axis = sweep_axis(rhs);
+      const Point3f nearest = sweep_nearest_point(axis, rhs_axis);
+      const Point3f rhs_nearest = sweep_nearest_point(rhs_axis, nearest);
+      const Vector3f normal = sweep_normal(nearest - rhs_nearest, motion);
+      return Impact(time, rhs_nearest + rhs.get_radius() * normal, normal);
+    }
+
+    Impact Swept_Capsule::time_of_impact(const Parallelepiped &rhs) const {
+      /// Nothing can happen before the bounding Sphere is reached
+      float time;
+      if(!sweep_point_capsule(rhs.get_center(), -motion, sweep_axis(capsule), capsule.get_radius() + sweep_bounding_radius(rhs), time) ||
+         !sweep_advance(*this, rhs, time))
+        return Impact();
+
+      Point3f nearest, contact;
+      sweep_nearest(sweep_axis(at(time)), rhs, nearest, contact);
+      return Impact(time, contact, sweep_normal(nearest - contact, motion));
+    }
+
+    Impact Swept_Capsule::time_of_impact(const Swept_Sphere &rhs) const {
+      return sweep_reversed(Swept_Sphere(rhs.get_sphere(), rhs.get_motion() - motion).time_of_impact(capsule), motion);
+    }
+
+    Impact Swept_Capsule::time_of_impact(const Swept_Capsule &rhs) const {
+      return sweep_shifted(Swept_Capsule(capsule, motion - rhs.motion).time_of_impact(rhs.capsule), rhs.motion);
+    }
+
+    Capsule Swept_Capsule::at(const float &time) const {
+      const Vector3f offset = time * motion;
+      return Capsule(capsule.get_end_point_a() + offset, capsule.get_end_point_b() + offset, capsule.get_radius());
+    }
+
+  }
+
+}
+
+#include <Zeni/Undefine.h>
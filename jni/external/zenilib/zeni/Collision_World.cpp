@@ -0,0 +1,616 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <Zeni/Define.h>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  namespace Collision {
+
+    /// Clip the line origin + t * direction, t in [t_min, t_max], against the slabs of a box
+    static bool slab_test(const Point3f &lower_bound, const Point3f &upper_bound,
+                          const Point3f &origin, const Vector3f &direction,
+                          float t_min, float t_max)
+    {
+      const float lower[3] = {lower_bound.x, lower_bound.y, lower_bound.z};
+      const float upper[3] = {upper_bound.x, upper_bound.y, upper_bound.z};
+      const float start[3] = {origin.x, origin.y, origin.z};
+      const float delta[3] = {direction.x, direction.y, direction.z};
+
+      for(int i = 0; i != 3; ++i) {
+        if(fabs(delta[i]) < ZENI_COLLISION_EPSILON) {
+          if(start[i] < lower[i] || start[i] > upper[i])
+            return false;
+        }
+        else {
+          float t_a = (lower[i] - start[i]) / delta[i];
+          float t_b = (upper[i] - start[i]) / delta[i];
+          if(t_a > t_b)
+            std::swap(t_a, t_b);
+
+          t_min = std::max(t_min, t_a);
+          t_max = std::min(t_max, t_b);
+          if(t_min > t_max)
+            return false;
+        }
+      }
+
+      return true;
+    }
+
+    Bounding_Box::Bounding_Box(const Sphere &sphere) {
+      const Vector3f radius(sphere.get_radius(), sphere.get_radius(), sphere.get_radius());
+      lower_bound = sphere.get_center() - radius;
+      upper_bound = sphere.get_center() + radius;
+    }
+
+    Bounding_Box::Bounding_Box(const Line_Segment &line_segment) {
+      const Point3f &a = line_segment.get_end_point_a();
+      const Point3f &b = line_segment.get_end_point_b();
+      lower_bound = Point3f(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+      upper_bound = Point3f(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+    }
+
+    Bounding_Box::Bounding_Box(const Capsule &capsule) {
+      *this = Bounding_Box(Line_Segment(capsule.get_end_point_a(), capsule.get_end_point_b())).expanded(capsule.get_radius());
+    }
+
+    Bounding_Box::Bounding_Box(const Parallelepiped &parallelepiped) {
+      const Vector3f edges[3] = {parallelepiped.get_edge_a(), parallelepiped.get_edge_b(), parallelepiped.get_edge_c()};
+
+      lower_bound = parallelepiped.get_point();
+      upper_bound = parallelepiped.get_point();
+
+      for(int i = 0; i != 3; ++i) {
+        (edges[i].x < 0.0f ? lower_bound.x : upper_bound.x) += edges[i].x;
+        (edges[i].y < 0.0f ? lower_bound.y : upper_bound.y) += edges[i].y;
+        (edges[i].z < 0.0f ? lower_bound.z : upper_bound.z) += edges[i].z;
+      }
+    }
+
+    bool Bounding_Box::intersects(const Sphere &rhs) const {
+      const Point3f &center = rhs.get_center();
+      const Vector3f offset = center - Point3f(std::min(std::max(center.x, lower_bound.x), upper_bound.x),
+                                               std::min(std::max(center.y, lower_bound.y), upper_bound.y),
+                                               std::min(std::max(center.z, lower_bound.z), upper_bound.z));
+
+      return offset * offset <= rhs.get_radius() * rhs.get_radius();
+    }
+
+    bool Bounding_Box::intersects(const Plane &rhs) const {
+      const Vector3f &normal = rhs.get_normal();
+      const Vector3f extents = (upper_bound - lower_bound) * 0.5f;
+      const Point3f center = lower_bound + extents;
+
+      const float radius = extents.x * fabs(normal.x) + extents.y * fabs(normal.y) + extents.z * fabs(normal.z);
+
+      return fabs(normal * (center - rhs.get_point())) <= radius;
+    }
+
+    bool Bounding_Box::intersects(const Line &rhs) const {
+      return slab_test(lower_bound, upper_bound, rhs.get_end_point_a(), rhs.get_direction(), -FLT_MAX, FLT_MAX);
+    }
+
+    bool Bounding_Box::intersects(const Ray &rhs) const {
+      return slab_test(lower_bound, upper_bound, rhs.get_end_point_a(), rhs.get_direction(), 0.0f, FLT_MAX);
+    }
+
+    bool Bounding_Box::intersects(const Line_Segment &rhs) const {
+      return slab_test(lower_bound, upper_bound, rhs.get_end_point_a(), rhs.get_direction(), 0.0f, 1.0f);
+    }
+
+    bool Bounding_Box::intersects(const Infinite_Cylinder &rhs) const {
+      return expanded(rhs.get_radius()).intersects(Line(rhs.get_end_point_a(), rhs.get_end_point_b()));
+    }
+
+    bool Bounding_Box::intersects(const Capsule &rhs) const {
+      return expanded(rhs.get_radius()).intersects(Line_Segment(rhs.get_end_point_a(), rhs.get_end_point_b()));
+    }
+
+    bool Bounding_Box::intersects(const Parallelepiped &rhs) const {
+      return intersects(Bounding_Box(rhs));
+    }
+
+    World::World(const Broadphase &broadphase, const float &margin)
+      : m_broadphase(broadphase),
+      m_margin(margin),
+      m_size(0u),
+      m_root(-1),
+      m_free_node(-1),
+      m_sweep_dirty(false)
+    {
+    }
+
+    World::~World() {
+      clear();
+    }
+
+    void World::remove(const Proxy &proxy) {
+      Proxy_Data &data = m_proxies[proxy];
+
+      delete data.shape;
+      data.shape = 0;
+      data.user_data = 0;
+
+      if(m_broadphase == DYNAMIC_AABB_TREE) {
+        remove_leaf(data.node);
+        free_node(data.node);
+        data.node = -1;
+      }
+      else
+        m_sweep.erase(std::find(m_sweep.begin(), m_sweep.end(), proxy));
+
+      m_free_proxies.push_back(proxy);
+      --m_size;
+    }
+
+    void World::clear() {
+      for(std::vector<Proxy_Data>::iterator it = m_proxies.begin(), iend = m_proxies.end(); it != iend; ++it)
+        delete it->shape;
+
+      m_proxies.clear();
+      m_free_proxies.clear();
+      m_nodes.clear();
+      m_root = -1;
+      m_free_node = -1;
+      m_sweep.clear();
+      m_sweep_dirty = false;
+      m_size = 0u;
+    }
+
+    void World::find_candidate_pairs(std::vector<Proxy_Pair> &pairs) const {
+      pairs.clear();
+
+      if(m_broadphase == SWEEP_AND_PRUNE) {
+        update_sweep();
+
+        for(std::vector<Proxy>::const_iterator it = m_sweep.begin(), iend = m_sweep.end(); it != iend; ++it) {
+          const Bounding_Box &bounding_box = m_proxies[*it].bounding_box;
+          const float upper_x = bounding_box.get_upper_bound().x;
+
+          for(std::vector<Proxy>::const_iterator jt = it + 1; jt != iend; ++jt) {
+            const Bounding_Box &other = m_proxies[*jt].bounding_box;
+            if(other.get_lower_bound().x > upper_x)
+              break;
+
+            if(bounding_box.intersects(other))
+              pairs.push_back(std::make_pair(std::min(*it, *jt), std::max(*it, *jt)));
+          }
+        }
+
+        return;
+      }
+
+      if(m_root == -1)
+        return;
+
+      std::vector<int> stack;
+
+      for(Proxy proxy = 0; proxy != m_proxies.size(); ++proxy) {
+        const Proxy_Data &data = m_proxies[proxy];
+        if(!data.shape)
+          continue;
+
+        stack.push_back(m_root);
+        while(!stack.empty()) {
+          const Node &node = m_nodes[size_t(stack.back())];
+          stack.pop_back();
+
+          if(!node.bounding_box.intersects(data.bounding_box))
+            continue;
+
+          if(node.is_leaf()) {
+            /// Each pair is found from both ends; Keep one
+            if(node.proxy > proxy)
+              pairs.push_back(std::make_pair(proxy, node.proxy));
+          }
+          else {
+            stack.push_back(node.child_a);
+            stack.push_back(node.child_b);
+          }
+        }
+      }
+    }
+
+    void World::find_colliding_pairs(std::vector<Proxy_Pair> &pairs) const {
+      find_candidate_pairs(pairs);
+
+      std::vector<Proxy_Pair>::iterator dest = pairs.begin();
+      for(std::vector<Proxy_Pair>::const_iterator it = pairs.begin(), iend = pairs.end(); it != iend; ++it) {
+        if(m_proxies[it->first].shape->intersects(*m_proxies[it->second].shape))
+          *dest++ = *it;
+      }
+      pairs.erase(dest, pairs.end());
+    }
+
+    void World::query(const Bounding_Box &bounding_box, std::vector<Proxy> &proxies) const {
+      proxies.clear();
+
+      if(m_broadphase == SWEEP_AND_PRUNE) {
+        update_sweep();
+
+        for(std::vector<Proxy>::const_iterator it = m_sweep.begin(), iend = m_sweep.end(); it != iend; ++it) {
+          const Bounding_Box &other = m_proxies[*it].bounding_box;
+          if(other.get_lower_bound().x > bounding_box.get_upper_bound().x)
+            break;
+
+          if(other.intersects(bounding_box))
+            proxies.push_back(*it);
+        }
+
+        return;
+      }
+
+      if(m_root == -1)
+        return;
+
+      std::vector<int> stack(1, m_root);
+      while(!stack.empty()) {
+        const Node &node = m_nodes[size_t(stack.back())];
+        stack.pop_back();
+
+        if(!node.bounding_box.intersects(bounding_box))
+          continue;
+
+        if(node.is_leaf())
+          proxies.push_back(node.proxy);
+        else {
+          stack.push_back(node.child_a);
+          stack.push_back(node.child_b);
+        }
+      }
+    }
+
+    int World::get_tree_height() const {
+      return m_root == -1 ? 0 : m_nodes[size_t(m_root)].height + 1;
+    }
+
+    World::Proxy World::insert_Shape(Shape * const &shape, void * const &user_data) {
+      Proxy proxy;
+      if(m_free_proxies.empty()) {
+        try {
+          m_proxies.push_back(Proxy_Data());
+        }
+        catch(...) {
+          delete shape;
+          throw;
+        }
+        proxy = m_proxies.size() - 1u;
+      }
+      else {
+        proxy = m_free_proxies.back();
+        m_free_proxies.pop_back();
+      }
+
+      Proxy_Data &data = m_proxies[proxy];
+      data.shape = shape;
+      data.bounding_box = shape->get_bounding_box().expanded(m_margin + ZENI_COLLISION_EPSILON);
+      data.user_data = user_data;
+
+      if(m_broadphase == DYNAMIC_AABB_TREE) {
+        const int node = allocate_node();
+        m_nodes[size_t(node)].bounding_box = data.bounding_box;
+        m_nodes[size_t(node)].proxy = proxy;
+        m_proxies[proxy].node = node;
+        insert_leaf(node);
+      }
+      else {
+        m_sweep.push_back(proxy);
+        m_sweep_dirty = true;
+      }
+
+      ++m_size;
+
+      return proxy;
+    }
+
+    void World::move_Shape(const Proxy &proxy, Shape * const &shape) {
+      Proxy_Data &data = m_proxies[proxy];
+
+      if(data.shape != shape) {
+        delete data.shape;
+        data.shape = shape;
+      }
+
+      const Bounding_Box bounding_box = shape->get_bounding_box();
+      if(data.bounding_box.contains(bounding_box))
+        return;
+
+      data.bounding_box = bounding_box.expanded(m_margin + ZENI_COLLISION_EPSILON);
+
+      if(m_broadphase == DYNAMIC_AABB_TREE) {
+        remove_leaf(data.node);
+        m_nodes[size_t(data.node)].bounding_box = data.bounding_box;
+        insert_leaf(data.node);
+      }
+      else
+        m_sweep_dirty = true;
+    }
+
+    void World::query_Volume(const Volume &volume, std::vector<Proxy> &proxies) const {
+      proxies.clear();
+
+      if(m_broadphase == SWEEP_AND_PRUNE) {
+        /// Queries may be unbounded, so the sort order is of no use
+        for(std::vector<Proxy>::const_iterator it = m_sweep.begin(), iend = m_sweep.end(); it != iend; ++it) {
+          const Proxy_Data &data = m_proxies[*it];
+          if(volume.may_intersect(data.bounding_box) && volume.intersects(*data.shape))
+            proxies.push_back(*it);
+        }
+
+        return;
+      }
+
+      if(m_root == -1)
+        return;
+
+      std::vector<int> stack(1, m_root);
+      while(!stack.empty()) {
+        const Node &node = m_nodes[size_t(stack.back())];
+        stack.pop_back();
+
+        if(!volume.may_intersect(node.bounding_box))
+          continue;
+
+        if(node.is_leaf()) {
+          if(volume.intersects(*m_proxies[node.proxy].shape))
+            proxies.push_back(node.proxy);
+        }
+        else {
+          stack.push_back(node.child_a);
+          stack.push_back(node.child_b);
+        }
+      }
+    }
+
+    int World::allocate_node() {
+      int node;
+      if(m_free_node == -1) {
+        m_nodes.push_back(Node());
+        node = int(m_nodes.size() - 1u);
+      }
+      else {
+        node = m_free_node;
+        m_free_node = m_nodes[size_t(node)].parent;
+      }
+
+      Node &n = m_nodes[size_t(node)];
+      n.parent = -1;
+      n.child_a = -1;
+      n.child_b = -1;
+      n.height = 0;
+      n.proxy = 0u;
+
+      return node;
+    }
+
+    void World::free_node(const int &node) {
+      m_nodes[size_t(node)].parent = m_free_node;
+      m_nodes[size_t(node)].height = -1;
+      m_free_node = node;
+    }
+
+    void World::insert_leaf(const int &leaf) {
+      if(m_root == -1) {
+        m_root = leaf;
+        m_nodes[size_t(leaf)].parent = -1;
+        return;
+      }
+
+      /// Descend toward the sibling that minimizes the increase in surface area
+      const Bounding_Box leaf_box = m_nodes[size_t(leaf)].bounding_box;
+      int index = m_root;
+      while(!m_nodes[size_t(index)].is_leaf()) {
+        const Node &node = m_nodes[size_t(index)];
+        const float area = node.bounding_box.surface_area();
+        const float combined_area = node.bounding_box.merged(leaf_box).surface_area();
+
+        const float cost = 2.0f * combined_area;
+        const float inheritance_cost = 2.0f * (combined_area - area);
+
+        const Node &child_a = m_nodes[size_t(node.child_a)];
+        const Node &child_b = m_nodes[size_t(node.child_b)];
+        const float cost_a = child_a.bounding_box.merged(leaf_box).surface_area() -
+                             (child_a.is_leaf() ? 0.0f : child_a.bounding_box.surface_area()) +
+                             inheritance_cost;
+        const float cost_b = child_b.bounding_box.merged(leaf_box).surface_area() -
+                             (child_b.is_leaf() ? 0.0f : child_b.bounding_box.surface_area()) +
+                             inheritance_cost;
+
+        if(cost < cost_a && cost < cost_b)
+          break;
+
+        index = cost_a < cost_b ? node.child_a : node.child_b;
+      }
+
+      const int sibling = index;
+      const int old_parent = m_nodes[size_t(sibling)].parent;
+      const int new_parent = allocate_node();
+
+      Node &parent = m_nodes[size_t(new_parent)];
+      parent.parent = old_parent;
+      parent.bounding_box = leaf_box.merged(m_nodes[size_t(sibling)].bounding_box);
+      parent.height = m_nodes[size_t(sibling)].height + 1;
+      parent.child_a = sibling;
+      parent.child_b = leaf;
+
+      if(old_parent == -1)
+        m_root = new_parent;
+      else if(m_nodes[size_t(old_parent)].child_a == sibling)
+        m_nodes[size_t(old_parent)].child_a = new_parent;
+      else
+        m_nodes[size_t(old_parent)].child_b = new_parent;
+
+      m_nodes[size_t(sibling)].parent = new_parent;
+      m_nodes[size_t(leaf)].parent = new_parent;
+
+      for(index = new_parent; index != -1; index = m_nodes[size_t(index)].parent) {
+        index = balance(index);
+
+        Node &node = m_nodes[size_t(index)];
+        const Node &child_a = m_nodes[size_t(node.child_a)];
+        const Node &child_b = m_nodes[size_t(node.child_b)];
+        node.height = 1 + std::max(child_a.height, child_b.height);
+        node.bounding_box = child_a.bounding_box.merged(child_b.bounding_box);
+      }
+    }
+
+    void World::remove_leaf(const int &leaf) {
+      if(leaf == m_root) {
+        m_root = -1;
+        return;
+      }
+
+      const int parent = m_nodes[size_t(leaf)].parent;
+      const int grandparent = m_nodes[size_t(parent)].parent;
+      const int sibling = m_nodes[size_t(parent)].child_a == leaf ? m_nodes[size_t(parent)].child_b : m_nodes[size_t(parent)].child_a;
+
+      free_node(parent);
+      m_nodes[size_t(sibling)].parent = grandparent;
+
+      if(grandparent == -1) {
+        m_root = sibling;
+        return;
+      }
+
+      if(m_nodes[size_t(grandparent)].child_a == parent)
+        m_nodes[size_t(grandparent)].child_a = sibling;
+      else
+        m_nodes[size_t(grandparent)].child_b = sibling;
+
+      for(int index = grandparent; index != -1; index = m_nodes[size_t(index)].parent) {
+        index = balance(index);
+
+        Node &node = m_nodes[size_t(index)];
+        const Node &child_a = m_nodes[size_t(node.child_a)];
+        const Node &child_b = m_nodes[size_t(node.child_b)];
+        node.height = 1 + std::max(child_a.height, child_b.height);
+        node.bounding_box = child_a.bounding_box.merged(child_b.bounding_box);
+      }
+    }
+
+    int World::balance(const int &index_a) {
+      Node &a = m_nodes[size_t(index_a)];
+      if(a.is_leaf() || a.height < 2)
+        return index_a;
+
+      const int index_b = a.child_a;
+      const int index_c = a.child_b;
+      Node &b = m_nodes[size_t(index_b)];
+      Node &c = m_nodes[size_t(index_c)];
+
+      const int imbalance = c.height - b.height;
+
+      /// Rotate the taller child up into a's place
+      if(imbalance > 1 || imbalance < -1) {
+        const int index_up = imbalance > 1 ? index_c : index_b;
+        Node &up = imbalance > 1 ? c : b;
+        Node &other = imbalance > 1 ? b : c;
+
+        const int index_f = up.child_a;
+        const int index_g = up.child_b;
+        Node &f = m_nodes[size_t(index_f)];
+        Node &g = m_nodes[size_t(index_g)];
+
+        up.child_a = index_a;
+        up.parent = a.parent;
+        a.parent = index_up;
+
+        if(up.parent == -1)
+          m_root = index_up;
+        else if(m_nodes[size_t(up.parent)].child_a == index_a)
+          m_nodes[size_t(up.parent)].child_a = index_up;
+        else
+          m_nodes[size_t(up.parent)].child_b = index_up;
+
+        /// The taller grandchild stays with 'up'; The shorter replaces 'up' under a
+        const bool keep_f = f.height > g.height;
+        const int index_kept = keep_f ? index_f : index_g;
+        const int index_moved = keep_f ? index_g : index_f;
+        Node &kept = keep_f ? f : g;
+        Node &moved = keep_f ? g : f;
+
+        up.child_b = index_kept;
+        if(imbalance > 1)
+          a.child_b = index_moved;
+        else
+          a.child_a = index_moved;
+        moved.parent = index_a;
+
+        a.bounding_box = other.bounding_box.merged(moved.bounding_box);
+        a.height = 1 + std::max(other.height, moved.height);
+        up.bounding_box = a.bounding_box.merged(kept.bounding_box);
+        up.height = 1 + std::max(a.height, kept.height);
+
+        return index_up;
+      }
+
+      return index_a;
+    }
+
+    void World::update_sweep() const {
+      if(!m_sweep_dirty)
+        return;
+
+      m_sweep_dirty = false;
+
+      /// Insertion sort exploits frame-to-frame coherence, but give up on it if too much has changed
+      const size_t max_shifts = 8u * m_sweep.size() + 64u;
+      size_t shifts = 0u;
+
+      for(size_t i = 1u; i < m_sweep.size(); ++i) {
+        const Proxy proxy = m_sweep[i];
+        const float key = m_proxies[proxy].bounding_box.get_lower_bound().x;
+
+        size_t j = i;
+        for(; j && m_proxies[m_sweep[j - 1u]].bounding_box.get_lower_bound().x > key; --j)
+          m_sweep[j] = m_sweep[j - 1u];
+        m_sweep[j] = proxy;
+
+        shifts += i - j;
+        if(shifts > max_shifts) {
+          std::vector<std::pair<float, Proxy> > keyed;
+          keyed.reserve(m_sweep.size());
+          for(std::vector<Proxy>::const_iterator it = m_sweep.begin(), iend = m_sweep.end(); it != iend; ++it)
+            keyed.push_back(std::make_pair(m_proxies[*it].bounding_box.get_lower_bound().x, *it));
+
+          std::sort(keyed.begin(), keyed.end());
+
+          for(size_t k = 0u; k != keyed.size(); ++k)
+            m_sweep[k] = keyed[k].second;
+
+          break;
+        }
+      }
+    }
+
+  }
+
+}
+
+#include <Zeni/Undefine.h>
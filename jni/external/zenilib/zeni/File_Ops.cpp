@@ -20,6 +20,7 @@
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <vector>
 
 #ifdef _WINDOWS
 #include <io.h>
@@ -29,6 +30,7 @@
 #include <sys/errno.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <pthread.h>
 #include <pwd.h>
 #include <unistd.h>
 #endif
@@ -57,6 +59,21 @@ namespace Zeni {
 
   template class Singleton<File_Ops>;
 
+  static class Mounted_Archives {
+  public:
+    ~Mounted_Archives() {
+      clear();
+    }
+
+    void clear() {
+      for(std::vector<Archive *>::iterator it = archives.begin(), iend = archives.end(); it != iend; ++it)
+        delete *it;
+      archives.clear();
+    }
+
+    std::vector<Archive *> archives;
+  } g_mounted_archives;
+
   File_Ops * File_Ops::create() {
     return new File_Ops;
   }
@@ -132,8 +149,120 @@ namespace Zeni {
 #endif
 
   FILE * File_Ops::get_asset_FILE(const String &filename, off_t * const &start_, off_t * const &length_) {
-    ZENI_LOGI(("Loading asset from file '" + filename + "'.").c_str());
+    off_t start, length;
+    FILE * file;
+
+    if(const Archive * const archive = find_Archive(filename)) {
+      ZENI_LOGI(("Loading asset '" + filename + "' from archive '" + archive->get_filename() + "'.").c_str());
+
+      size_t offset, size;
+      Archive::Compression compression;
+      archive->get_entry(filename, offset, size, compression);
+
+      if(compression == Archive::STORED) {
+        /// Read the entry in place
+        file = get_loose_FILE(archive->get_filename(), start, length);
+
+        start += off_t(offset);
+        length = off_t(size);
+
+        if(fseek(file, start, SEEK_SET)) {
+          fclose(file);
+          ZENI_LOGE("!fseek, throwing Error");
+          throw File_Ops_Asset_Load_Failure();
+        }
+      }
+      else {
+        String memory;
+        archive->load(filename, memory);
+
+        file = tmpfile();
+        if(!file) {
+          ZENI_LOGE("!tmpfile, throwing Error");
+          throw File_Ops_Asset_Load_Failure();
+        }
+
+        if((!memory.empty() && !fwrite(memory.c_str(), memory.size(), 1u, file)) || fseek(file, 0, SEEK_SET)) {
+          fclose(file);
+          ZENI_LOGE("Writing to tmpfile failed, throwing Error");
+          throw File_Ops_Asset_Load_Failure();
+        }
+
+        start = 0;
+        length = off_t(memory.size());
+      }
+    }
+    else {
+      ZENI_LOGI(("Loading asset from file '" + filename + "'.").c_str());
+
+      file = get_loose_FILE(filename, start, length);
+    }
+
+    if(start_)
+      *start_ = start;
+    if(length_)
+      *length_ = length;
+
+    return file;
+  }
+
+  String & File_Ops::load_asset(String &memory, const String &filename) {
+    if(const Archive * const archive = find_Archive(filename)) {
+      ZENI_LOGI(("Loading asset '" + filename + "' from archive '" + archive->get_filename() + "'.").c_str());
+
+      archive->load(filename, memory);
+      return memory;
+    }
+
+    off_t length;
+    FILE * const file = get_asset_FILE(filename, 0, &length);
 
+    try {
+      memory.resize(length, '\0');
+
+      if(length && !fread(&memory[0], length, 1u, file)) {
+        ZENI_LOGE("Loading from fd failed, throwing Error");
+        throw File_Ops_Asset_Load_Failure();
+      }
+    }
+    catch(...) {
+      fclose(file);
+      throw;
+    }
+
+    fclose(file);
+
+    return memory;
+  }
+
+  void File_Ops::mount_Archive(const String &filename) {
+    Archive * const archive = new Archive(filename);
+
+    try {
+      g_mounted_archives.archives.push_back(archive);
+    }
+    catch(...) {
+      delete archive;
+      throw;
+    }
+  }
+
+  void File_Ops::unmount_Archives() {
+    g_mounted_archives.clear();
+  }
+
+  const Archive * File_Ops::find_Archive(const String &filename) {
+    const std::vector<Archive *> &archives = g_mounted_archives.archives;
+
+    for(std::vector<Archive *>::const_reverse_iterator it = archives.rbegin(), iend = archives.rend(); it != iend; ++it) {
+      if((*it)->contains(filename))
+        return *it;
+    }
+
+    return 0;
+  }
+
+  FILE * File_Ops::get_loose_FILE(const String &filename, off_t &start, off_t &length) {
 #ifdef ANDROID
     AAsset* asset = AAssetManager_open(File_Ops::get_AAssetManager(), filename.c_str(), AASSET_MODE_UNKNOWN);
     if(!asset) {
@@ -142,7 +271,6 @@ namespace Zeni {
     }
 
     // open asset as file descriptor
-    off_t start, length;
     int fd = AAsset_openFileDescriptor(asset, &start, &length);
     AAsset_close(asset);
     if(fd < 0) {
@@ -165,8 +293,8 @@ namespace Zeni {
       throw File_Ops_Asset_Load_Failure();
     }
 
-    off_t start = 0;
-    off_t length = ftell(file);
+    start = 0;
+    length = ftell(file);
 #endif
 
     if(fseek(file, start, SEEK_SET)) {
@@ -179,43 +307,9 @@ namespace Zeni {
     length -= start;
 #endif
 
-    if(start_)
-      *start_ = start;
-    if(length_)
-      *length_ = length;
-
     return file;
   }
 
-  String & File_Ops::load_asset(String &memory, const String &filename) {
-    off_t length;
-    FILE * const file = get_asset_FILE(filename, 0, &length);
-
-    try {
-      memory.resize(length, '\0');
-
-      for(String::iterator it = memory.begin(), iend = memory.end(); it != iend; ++it) {
-        int c;
-        c = fgetc(file);
-        if(c != EOF)
-          *it = char(c);
-        else {
-          fclose(file);
-          ZENI_LOGE("Loading from fd failed, throwing Error");
-          throw File_Ops_Asset_Load_Failure();
-        }
-      }
-    }
-    catch(...) {
-      fclose(file);
-      throw;
-    }
-
-    fclose(file);
-
-    return memory;
-  }
-
   const String & File_Ops::get_username() {
     return m_username;
   }
@@ -273,6 +367,25 @@ namespace Zeni {
     return fout.good();
   }
 
+  String File_Ops::get_temporary_path(const String &file_path) {
+    char suffix[64];
+#ifdef _WINDOWS
+    sprintf_s(suffix, ".%lu.%lu.tmp", (unsigned long)(GetCurrentProcessId()), (unsigned long)(GetCurrentThreadId()));
+#else
+    sprintf(suffix, ".%lu.%lu.tmp", (unsigned long)(getpid()), (unsigned long)(pthread_self()));
+#endif
+
+    return file_path + suffix;
+  }
+
+  bool File_Ops::replace_file(const String &from, const String &to) {
+#ifdef _WINDOWS
+    return MoveFileEx(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return !rename(from.c_str(), to.c_str());
+#endif
+  }
+
   void File_Ops::preinit(const String &unique_app_identifier_) {
     String &unique_app_identifier = get_unique_app_identifier();
 
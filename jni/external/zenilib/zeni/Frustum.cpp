@@ -0,0 +1,239 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni.h>
+
+#include <Zeni/Float4.h>
+
+#include <cfloat>
+#include <cmath>
+
+#include <Zeni/Define.h>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  Frustum::Frustum() {
+    for(int i = 0; i != 6; ++i) {
+      m_normal_x[i] = 0.0f;
+      m_normal_y[i] = 0.0f;
+      m_normal_z[i] = 0.0f;
+      m_distance[i] = FLT_MAX;
+    }
+  }
+
+  Frustum::Frustum(const Camera &camera, const float &aspect_ratio) {
+    const Point3f position = camera.get_tunneled_position();
+    const Vector3f forward = camera.get_forward();
+    const Vector3f up = camera.get_up();
+    const Vector3f left = camera.get_left();
+
+    const float half_fov_y = 0.5f * camera.get_tunneled_fov_rad();
+    const float half_fov_x = float(atan(aspect_ratio * tan(half_fov_y)));
+    const float sin_y = float(sin(half_fov_y));
+    const float cos_y = float(cos(half_fov_y));
+    const float sin_x = float(sin(half_fov_x));
+    const float cos_x = float(cos(half_fov_x));
+
+    const Vector3f normals[6] = {
+      forward,
+      -forward,
+      sin_x * forward - cos_x * left,
+      sin_x * forward + cos_x * left,
+      sin_y * forward - cos_y * up,
+      sin_y * forward + cos_y * up
+    };
+
+    const float along = forward * Vector3f(position);
+
+    for(int i = 0; i != 6; ++i) {
+      m_normal_x[i] = normals[i].i;
+      m_normal_y[i] = normals[i].j;
+      m_normal_z[i] = normals[i].k;
+      m_distance[i] = -(normals[i] * Vector3f(position));
+    }
+
+    m_distance[0] = -(along + camera.get_tunneled_near_clip());
+    m_distance[1] = along + camera.get_tunneled_far_clip();
+  }
+
+  Frustum Frustum::transformed(const Matrix4f &object_to_world) const {
+    Frustum frustum;
+
+    for(int i = 0; i != 6; ++i) {
+      const float &x = m_normal_x[i];
+      const float &y = m_normal_y[i];
+      const float &z = m_normal_z[i];
+
+      float normal_x = x * object_to_world[0][0] + y * object_to_world[1][0] + z * object_to_world[2][0];
+      float normal_y = x * object_to_world[0][1] + y * object_to_world[1][1] + z * object_to_world[2][1];
+      float normal_z = x * object_to_world[0][2] + y * object_to_world[1][2] + z * object_to_world[2][2];
+      float distance = x * object_to_world[0][3] + y * object_to_world[1][3] + z * object_to_world[2][3] + m_distance[i];
+
+      const float length = float(sqrt(normal_x * normal_x + normal_y * normal_y + normal_z * normal_z));
+      if(length > 0.0f) {
+        normal_x /= length;
+        normal_y /= length;
+        normal_z /= length;
+        distance /= length;
+      }
+
+      frustum.m_normal_x[i] = normal_x;
+      frustum.m_normal_y[i] = normal_y;
+      frustum.m_normal_z[i] = normal_z;
+      frustum.m_distance[i] = distance;
+    }
+
+    return frustum;
+  }
+
+  Frustum::Containment Frustum::contains(const Point3f &point) const {
+    for(int i = 0; i != 6; ++i)
+      if(signed_distance(i, point) < 0.0f)
+        return OUTSIDE;
+
+    return INSIDE;
+  }
+
+  Frustum::Containment Frustum::contains(const Collision::Sphere &sphere) const {
+    const float &radius = sphere.get_radius();
+    Containment containment = INSIDE;
+
+    for(int i = 0; i != 6; ++i) {
+      const float distance = signed_distance(i, sphere.get_center());
+      if(distance < -radius)
+        return OUTSIDE;
+      if(distance < radius)
+        containment = INTERSECTING;
+    }
+
+    return containment;
+  }
+
+  Frustum::Containment Frustum::contains(const Point3f &lower_bound, const Point3f &upper_bound) const {
+    const Point3f center = lower_bound.interpolate_to(0.5f, upper_bound);
+    const Vector3f half_extent = 0.5f * (upper_bound - lower_bound);
+    Containment containment = INSIDE;
+
+    for(int i = 0; i != 6; ++i) {
+      const float distance = signed_distance(i, center);
+      const float radius = box_radius(i, half_extent);
+      if(distance < -radius)
+        return OUTSIDE;
+      if(distance < radius)
+        containment = INTERSECTING;
+    }
+
+    return containment;
+  }
+
+  void Frustum::cull_spheres(const Point3f * const centers, const float * const radii, const size_t &count, bool * const visible) const {
+    Float4 normal_x[6], normal_y[6], normal_z[6], distance[6];
+    for(int i = 0; i != 6; ++i) {
+      normal_x[i] = Float4(m_normal_x[i]);
+      normal_y[i] = Float4(m_normal_y[i]);
+      normal_z[i] = Float4(m_normal_z[i]);
+      distance[i] = Float4(m_distance[i]);
+    }
+
+    const Float4 zero(0.0f);
+    size_t index = 0;
+
+    for(; index + 4 <= count; index += 4) {
+      const Point3f * const c = centers + index;
+      const Float4 x(c[0].x, c[1].x, c[2].x, c[3].x);
+      const Float4 y(c[0].y, c[1].y, c[2].y, c[3].y);
+      const Float4 z(c[0].z, c[1].z, c[2].z, c[3].z);
+      const Float4 radius = Float4::load(radii + index);
+
+      int outside = 0;
+      for(int i = 0; i != 6; ++i)
+        outside |= float4_mask_bits(float4_less(normal_x[i] * x + normal_y[i] * y + normal_z[i] * z + distance[i] + radius, zero));
+
+      for(int j = 0; j != 4; ++j)
+        visible[index + j] = !(outside & (1 << j));
+    }
+
+    for(; index != count; ++index)
+      visible[index] = contains(Collision::Sphere(centers[index], radii[index])) != OUTSIDE;
+  }
+
+  void Frustum::cull_boxes(const Point3f * const lower_bounds, const Point3f * const upper_bounds, const size_t &count, bool * const visible) const {
+    Float4 normal_x[6], normal_y[6], normal_z[6], distance[6];
+    Float4 abs_x[6], abs_y[6], abs_z[6];
+    for(int i = 0; i != 6; ++i) {
+      normal_x[i] = Float4(m_normal_x[i]);
+      normal_y[i] = Float4(m_normal_y[i]);
+      normal_z[i] = Float4(m_normal_z[i]);
+      distance[i] = Float4(m_distance[i]);
+      abs_x[i] = float4_abs(normal_x[i]);
+      abs_y[i] = float4_abs(normal_y[i]);
+      abs_z[i] = float4_abs(normal_z[i]);
+    }
+
+    const Float4 zero(0.0f);
+    const Float4 half(0.5f);
+    size_t index = 0;
+
+    for(; index + 4 <= count; index += 4) {
+      const Point3f * const l = lower_bounds + index;
+      const Point3f * const u = upper_bounds + index;
+      const Float4 lower_x(l[0].x, l[1].x, l[2].x, l[3].x);
+      const Float4 lower_y(l[0].y, l[1].y, l[2].y, l[3].y);
+      const Float4 lower_z(l[0].z, l[1].z, l[2].z, l[3].z);
+      const Float4 upper_x(u[0].x, u[1].x, u[2].x, u[3].x);
+      const Float4 upper_y(u[0].y, u[1].y, u[2].y, u[3].y);
+      const Float4 upper_z(u[0].z, u[1].z, u[2].z, u[3].z);
+
+      const Float4 x = half * (lower_x + upper_x);
+      const Float4 y = half * (lower_y + upper_y);
+      const Float4 z = half * (lower_z + upper_z);
+      const Float4 extent_x = half * (upper_x - lower_x);
+      const Float4 extent_y = half * (upper_y - lower_y);
+      const Float4 extent_z = half * (upper_z - lower_z);
+
+      int outside = 0;
+      for(int i = 0; i != 6; ++i) {
+        const Float4 radius = abs_x[i] * extent_x + abs_y[i] * extent_y + abs_z[i] * extent_z;
+        outside |= float4_mask_bits(float4_less(normal_x[i] * x + normal_y[i] * y + normal_z[i] * z + distance[i] + radius, zero));
+      }
+
+      for(int j = 0; j != 4; ++j)
+        visible[index + j] = !(outside & (1 << j));
+    }
+
+    for(; index != count; ++index)
+      visible[index] = contains(lower_bounds[index], upper_bounds[index]) != OUTSIDE;
+  }
+
+  float Frustum::signed_distance(const int &plane, const Point3f &point) const {
+    return m_normal_x[plane] * point.x + m_normal_y[plane] * point.y + m_normal_z[plane] * point.z + m_distance[plane];
+  }
+
+  float Frustum::box_radius(const int &plane, const Vector3f &half_extent) const {
+    return float(fabs(m_normal_x[plane])) * half_extent.i +
+           float(fabs(m_normal_y[plane])) * half_extent.j +
+           float(fabs(m_normal_z[plane])) * half_extent.k;
+  }
+
+}
+
+#include <Zeni/Undefine.h>
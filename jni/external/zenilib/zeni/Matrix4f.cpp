@@ -17,6 +17,8 @@
 
 #include <zeni.h>
 
+#include <Zeni/Float4.h>
+
 #include <cmath>
 #include <iostream>
 
@@ -97,26 +99,42 @@ namespace Zeni {
 
   Matrix4f Matrix4f::inverted() const
   {
-    const float det_M = determinant();
-
 #define m(i,j) (m_matrix[j][i])
 
-    const float m00 = (m(1,2)*m(2,3)*m(3,1) - m(1,3)*m(2,2)*m(3,1) + m(1,3)*m(2,1)*m(3,2) - m(1,1)*m(2,3)*m(3,2) - m(1,2)*m(2,1)*m(3,3) + m(1,1)*m(2,2)*m(3,3)) / det_M;
-    const float m01 = (m(0,3)*m(2,2)*m(3,1) - m(0,2)*m(2,3)*m(3,1) - m(0,3)*m(2,1)*m(3,2) + m(0,1)*m(2,3)*m(3,2) + m(0,2)*m(2,1)*m(3,3) - m(0,1)*m(2,2)*m(3,3)) / det_M;
-    const float m02 = (m(0,2)*m(1,3)*m(3,1) - m(0,3)*m(1,2)*m(3,1) + m(0,3)*m(1,1)*m(3,2) - m(0,1)*m(1,3)*m(3,2) - m(0,2)*m(1,1)*m(3,3) + m(0,1)*m(1,2)*m(3,3)) / det_M;
-    const float m03 = (m(0,3)*m(1,2)*m(2,1) - m(0,2)*m(1,3)*m(2,1) - m(0,3)*m(1,1)*m(2,2) + m(0,1)*m(1,3)*m(2,2) + m(0,2)*m(1,1)*m(2,3) - m(0,1)*m(1,2)*m(2,3)) / det_M;
-    const float m10 = (m(1,3)*m(2,2)*m(3,0) - m(1,2)*m(2,3)*m(3,0) - m(1,3)*m(2,0)*m(3,2) + m(1,0)*m(2,3)*m(3,2) + m(1,2)*m(2,0)*m(3,3) - m(1,0)*m(2,2)*m(3,3)) / det_M;
-    const float m11 = (m(0,2)*m(2,3)*m(3,0) - m(0,3)*m(2,2)*m(3,0) + m(0,3)*m(2,0)*m(3,2) - m(0,0)*m(2,3)*m(3,2) - m(0,2)*m(2,0)*m(3,3) + m(0,0)*m(2,2)*m(3,3)) / det_M;
-    const float m12 = (m(0,3)*m(1,2)*m(3,0) - m(0,2)*m(1,3)*m(3,0) - m(0,3)*m(1,0)*m(3,2) + m(0,0)*m(1,3)*m(3,2) + m(0,2)*m(1,0)*m(3,3) - m(0,0)*m(1,2)*m(3,3)) / det_M;
-    const float m13 = (m(0,2)*m(1,3)*m(2,0) - m(0,3)*m(1,2)*m(2,0) + m(0,3)*m(1,0)*m(2,2) - m(0,0)*m(1,3)*m(2,2) - m(0,2)*m(1,0)*m(2,3) + m(0,0)*m(1,2)*m(2,3)) / det_M;
-    const float m20 = (m(1,1)*m(2,3)*m(3,0) - m(1,3)*m(2,1)*m(3,0) + m(1,3)*m(2,0)*m(3,1) - m(1,0)*m(2,3)*m(3,1) - m(1,1)*m(2,0)*m(3,3) + m(1,0)*m(2,1)*m(3,3)) / det_M;
-    const float m21 = (m(0,3)*m(2,1)*m(3,0) - m(0,1)*m(2,3)*m(3,0) - m(0,3)*m(2,0)*m(3,1) + m(0,0)*m(2,3)*m(3,1) + m(0,1)*m(2,0)*m(3,3) - m(0,0)*m(2,1)*m(3,3)) / det_M;
-    const float m22 = (m(0,1)*m(1,3)*m(3,0) - m(0,3)*m(1,1)*m(3,0) + m(0,3)*m(1,0)*m(3,1) - m(0,0)*m(1,3)*m(3,1) - m(0,1)*m(1,0)*m(3,3) + m(0,0)*m(1,1)*m(3,3)) / det_M;
-    const float m23 = (m(0,3)*m(1,1)*m(2,0) - m(0,1)*m(1,3)*m(2,0) - m(0,3)*m(1,0)*m(2,1) + m(0,0)*m(1,3)*m(2,1) + m(0,1)*m(1,0)*m(2,3) - m(0,0)*m(1,1)*m(2,3)) / det_M;
-    const float m30 = (m(1,2)*m(2,1)*m(3,0) - m(1,1)*m(2,2)*m(3,0) - m(1,2)*m(2,0)*m(3,1) + m(1,0)*m(2,2)*m(3,1) + m(1,1)*m(2,0)*m(3,2) - m(1,0)*m(2,1)*m(3,2)) / det_M;
-    const float m31 = (m(0,1)*m(2,2)*m(3,0) - m(0,2)*m(2,1)*m(3,0) + m(0,2)*m(2,0)*m(3,1) - m(0,0)*m(2,2)*m(3,1) - m(0,1)*m(2,0)*m(3,2) + m(0,0)*m(2,1)*m(3,2)) / det_M;
-    const float m32 = (m(0,2)*m(1,1)*m(3,0) - m(0,1)*m(1,2)*m(3,0) - m(0,2)*m(1,0)*m(3,1) + m(0,0)*m(1,2)*m(3,1) + m(0,1)*m(1,0)*m(3,2) - m(0,0)*m(1,1)*m(3,2)) / det_M;
-    const float m33 = (m(0,1)*m(1,2)*m(2,0) - m(0,2)*m(1,1)*m(2,0) + m(0,2)*m(1,0)*m(2,1) - m(0,0)*m(1,2)*m(2,1) - m(0,1)*m(1,0)*m(2,2) + m(0,0)*m(1,1)*m(2,2)) / det_M;
+    /** 2x2 minors of the upper and lower row pairs (Laplace expansion),
+     *  leaving a single division for the whole inverse
+     */
+    const float a0 = m(0,0)*m(1,1) - m(0,1)*m(1,0);
+    const float a1 = m(0,0)*m(1,2) - m(0,2)*m(1,0);
+    const float a2 = m(0,0)*m(1,3) - m(0,3)*m(1,0);
+    const float a3 = m(0,1)*m(1,2) - m(0,2)*m(1,1);
+    const float a4 = m(0,1)*m(1,3) - m(0,3)*m(1,1);
+    const float a5 = m(0,2)*m(1,3) - m(0,3)*m(1,2);
+    const float b0 = m(2,0)*m(3,1) - m(2,1)*m(3,0);
+    const float b1 = m(2,0)*m(3,2) - m(2,2)*m(3,0);
+    const float b2 = m(2,0)*m(3,3) - m(2,3)*m(3,0);
+    const float b3 = m(2,1)*m(3,2) - m(2,2)*m(3,1);
+    const float b4 = m(2,1)*m(3,3) - m(2,3)*m(3,1);
+    const float b5 = m(2,2)*m(3,3) - m(2,3)*m(3,2);
+
+    const float inv_det_M = 1.0f / (a0*b5 - a1*b4 + a2*b3 + a3*b2 - a4*b1 + a5*b0);
+
+    const float m00 = (+ m(1,1)*b5 - m(1,2)*b4 + m(1,3)*b3) * inv_det_M;
+    const float m01 = (- m(0,1)*b5 + m(0,2)*b4 - m(0,3)*b3) * inv_det_M;
+    const float m02 = (+ m(3,1)*a5 - m(3,2)*a4 + m(3,3)*a3) * inv_det_M;
+    const float m03 = (- m(2,1)*a5 + m(2,2)*a4 - m(2,3)*a3) * inv_det_M;
+    const float m10 = (- m(1,0)*b5 + m(1,2)*b2 - m(1,3)*b1) * inv_det_M;
+    const float m11 = (+ m(0,0)*b5 - m(0,2)*b2 + m(0,3)*b1) * inv_det_M;
+    const float m12 = (- m(3,0)*a5 + m(3,2)*a2 - m(3,3)*a1) * inv_det_M;
+    const float m13 = (+ m(2,0)*a5 - m(2,2)*a2 + m(2,3)*a1) * inv_det_M;
+    const float m20 = (+ m(1,0)*b4 - m(1,1)*b2 + m(1,3)*b0) * inv_det_M;
+    const float m21 = (- m(0,0)*b4 + m(0,1)*b2 - m(0,3)*b0) * inv_det_M;
+    const float m22 = (+ m(3,0)*a4 - m(3,1)*a2 + m(3,3)*a0) * inv_det_M;
+    const float m23 = (- m(2,0)*a4 + m(2,1)*a2 - m(2,3)*a0) * inv_det_M;
+    const float m30 = (- m(1,0)*b3 + m(1,1)*b1 - m(1,2)*b0) * inv_det_M;
+    const float m31 = (+ m(0,0)*b3 - m(0,1)*b1 + m(0,2)*b0) * inv_det_M;
+    const float m32 = (- m(3,0)*a3 + m(3,1)*a1 - m(3,2)*a0) * inv_det_M;
+    const float m33 = (+ m(2,0)*a3 - m(2,1)*a1 + m(2,2)*a0) * inv_det_M;
 
 #undef m
 
@@ -152,34 +170,58 @@ namespace Zeni {
 
   float Matrix4f::determinant() const
   {
-#define m(i,j) m_matrix[j][i]
-#define term(a,b,c,d) m(0,a)*m(1,b)*m(2,c)*m(3,d)
+#define m(i,j) (m_matrix[j][i])
 
     return
-      + term(0,1,2,3) - term(0,1,3,2)
-      - term(0,2,1,3) + term(0,2,3,1)
-      + term(0,3,1,2) + term(0,3,2,1)
+      + (m(0,0)*m(1,1) - m(0,1)*m(1,0)) * (m(2,2)*m(3,3) - m(2,3)*m(3,2))
+      - (m(0,0)*m(1,2) - m(0,2)*m(1,0)) * (m(2,1)*m(3,3) - m(2,3)*m(3,1))
+      + (m(0,0)*m(1,3) - m(0,3)*m(1,0)) * (m(2,1)*m(3,2) - m(2,2)*m(3,1))
+      + (m(0,1)*m(1,2) - m(0,2)*m(1,1)) * (m(2,0)*m(3,3) - m(2,3)*m(3,0))
+      - (m(0,1)*m(1,3) - m(0,3)*m(1,1)) * (m(2,0)*m(3,2) - m(2,2)*m(3,0))
+      + (m(0,2)*m(1,3) - m(0,3)*m(1,2)) * (m(2,0)*m(3,1) - m(2,1)*m(3,0));
+
+#undef m
+  }
 
-      - term(1,0,2,3) + term(1,0,3,2)
-      + term(1,2,0,3) - term(1,2,3,0)
-      - term(1,3,0,2) + term(1,3,2,0)
+  Matrix4f Matrix4f::operator*(const Matrix4f &rhs) const {
+    const Float4 column0 = Float4::load(m_matrix[0]);
+    const Float4 column1 = Float4::load(m_matrix[1]);
+    const Float4 column2 = Float4::load(m_matrix[2]);
+    const Float4 column3 = Float4::load(m_matrix[3]);
 
-      + term(2,0,1,3) - term(2,0,3,1)
-      - term(2,1,0,3) + term(2,1,3,0)
-      + term(2,3,0,1) - term(2,3,1,0)
+    Matrix4f matrix;
 
-      - term(3,0,1,2) + term(3,0,2,1)
-      + term(3,1,0,2) - term(3,1,2,0)
-      - term(3,2,0,1) + term(3,2,1,0);
+    for(int j = 0; j < 4; ++j)
+      (column0 * Float4(rhs.m_matrix[j][0]) +
+       column1 * Float4(rhs.m_matrix[j][1]) +
+       column2 * Float4(rhs.m_matrix[j][2]) +
+       column3 * Float4(rhs.m_matrix[j][3])).store(matrix.m_matrix[j]);
 
-#undef term
-#undef m
+    return matrix;
   }
   
   Vector3f Matrix4f::operator*(const Vector3f &vector) const {
-    return Vector3f(m_matrix[0][0] * vector.i + m_matrix[1][0] * vector.j + m_matrix[2][0] * vector.k + m_matrix[3][0],
-                    m_matrix[0][1] * vector.i + m_matrix[1][1] * vector.j + m_matrix[2][1] * vector.k + m_matrix[3][1],
-                    m_matrix[0][2] * vector.i + m_matrix[1][2] * vector.j + m_matrix[2][2] * vector.k + m_matrix[3][2]);
+    float result[4];
+
+    (Float4::load(m_matrix[0]) * Float4(vector.i) +
+     Float4::load(m_matrix[1]) * Float4(vector.j) +
+     Float4::load(m_matrix[2]) * Float4(vector.k) +
+     Float4::load(m_matrix[3])).store(result);
+
+    return Vector3f(result[0], result[1], result[2]);
+  }
+
+  void transform_points(const Matrix4f &matrix, const Point3f * const in, Point3f * const out, const size_t &count) {
+    float column[4][4];
+    for(int i = 0; i < 4; ++i)
+      for(int j = 0; j < 4; ++j)
+        column[j][i] = matrix[i][j];
+
+    if(sizeof(Point3f) == 3 * sizeof(float))
+      float4_transform3(column, reinterpret_cast<const float *>(in), reinterpret_cast<float *>(out), count);
+    else
+      for(size_t i = 0; i != count; ++i)
+        out[i] = Point3f(matrix * Vector3f(in[i]));
   }
 
   std::ostream & serialize(std::ostream &os, const Matrix4f &value) {
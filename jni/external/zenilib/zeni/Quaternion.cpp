@@ -17,6 +17,8 @@
 
 #include <zeni.h>
 
+#include <Zeni/Float4.h>
+
 #include <cmath>
 
 #include <Zeni/Define.h>
@@ -148,6 +150,21 @@ namespace Zeni {
     return Quaternion(time * mplier, space * mplier);
   }
 
+  void rotate_vectors(const Quaternion &rotation, const Vector3f_Packed * const in, Vector3f_Packed * const out, const size_t &count) {
+    const Matrix4f matrix = rotation.get_matrix();
+
+    float column[4][4];
+    for(int i = 0; i < 4; ++i)
+      for(int j = 0; j < 4; ++j)
+        column[j][i] = matrix[i][j];
+
+    if(sizeof(Vector3f_Packed) == 3 * sizeof(float))
+      float4_transform3(column, reinterpret_cast<const float *>(in), reinterpret_cast<float *>(out), count);
+    else
+      for(size_t i = 0; i != count; ++i)
+        out[i] = rotation * Vector3f(in[i]);
+  }
+
   std::ostream & serialize(std::ostream &os, const Quaternion &value) {
     return serialize(serialize(os, value.time), value.space);
   }
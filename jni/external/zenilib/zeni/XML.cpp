@@ -314,19 +314,27 @@ namespace Zeni {
   bool XML_Document::try_load(const String &filename) {
     TiXmlDocument next;
 
-    if(!next.LoadFile(filename.c_str()))
+    if(File_Ops::find_Archive(filename)) {
+      String data;
+      File_Ops::load_asset(data, filename);
+
+      if(!next.Parse(data.c_str()))
+        return false;
+
+      next.SetValue(filename.c_str());
+    }
+    else if(!next.LoadFile(filename.c_str()))
       return false;
-    else {
-      delete m_root;
-      m_root = 0;
 
-      m_xml_file = next;
+    delete m_root;
+    m_root = 0;
 
-      TiXmlHandle root = &m_xml_file;
-      m_root = new XML_Element(root);
+    m_xml_file = next;
 
-      return true;
-    }
+    TiXmlHandle root = &m_xml_file;
+    m_root = new XML_Element(root);
+
+    return true;
   }
 
   bool XML_Document::try_save() {
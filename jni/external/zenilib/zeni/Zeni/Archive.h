@@ -0,0 +1,150 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Archive
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Packed, Memory-Mapped Collection of Assets
+ *
+ * An Archive packs many assets into one file so that they can be loaded
+ * without opening each one separately.  The file consists of a header, a
+ * table of entries sorted by the hash of their paths, the paths themselves,
+ * and finally the contents of each entry aligned to 16 bytes.  Entries may
+ * be stored as is or compressed with zlib.
+ *
+ * The whole Archive is memory-mapped, so entries which are stored as is can
+ * be read without being copied.
+ *
+ * \note Paths are compared after converting '\\' to '/' and removing any leading "./".
+ *
+ * \note Mount an Archive with File_Ops::mount_Archive to have loaders read from it.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Archive_Reader
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Seekable View of a Single Entry in an Archive
+ *
+ * Entries stored as is are read directly from the mapped Archive.
+ * Compressed entries are decompressed into memory owned by the Archive_Reader.
+ *
+ * \note The Archive must outlive its Archive_Readers.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_ARCHIVE_H
+#define ZENI_ARCHIVE_H
+
+#include <Zeni/Error.h>
+#include <Zeni/String.h>
+
+#include <vector>
+
+#ifdef ANDROID
+#include <android/asset_manager.h>
+#endif
+
+namespace Zeni {
+
+  class ZENI_DLL Archive {
+    // Undefined
+    Archive(const Archive &);
+    Archive & operator=(const Archive &);
+
+  public:
+    enum Compression {STORED = 0, ZLIB = 1};
+
+    Archive(const String &filename); ///< Map an Archive; May throw Archive_Load_Failure
+    ~Archive();
+
+    inline const String & get_filename() const; ///< Get the filename of the Archive
+    size_t get_num_entries() const; ///< Get the number of entries in the Archive
+
+    bool contains(const String &path) const; ///< Check to see if the Archive contains a file
+    bool get_entry(const String &path, size_t &offset, size_t &size, Compression &compression) const; ///< Get the location of a file within the Archive; Returns false if it is not present
+    const char * get_data(const String &path, size_t &size) const; ///< Get direct access to a stored file; Returns 0 if it is not present or is compressed
+    bool load(const String &path, String &memory) const; ///< Copy or decompress a file into memory; Returns false if it is not present
+
+    static bool build(const String &filename, const std::vector<String> &paths, const bool &compress = true); ///< Pack files into a new Archive, compressing those which shrink; Returns false on failure
+
+    static String normalize(const String &path); ///< Convert a path to the form used within Archives
+
+  private:
+    struct Entry;
+
+    const Entry * find(const String &path) const;
+    void unmap();
+
+    String m_filename;
+
+    const char * m_data;
+    size_t m_size;
+
+#ifdef _WINDOWS
+    void * m_file;
+    void * m_mapping;
+#elif defined(ANDROID)
+    AAsset * m_asset;
+#else
+    int m_file;
+#endif
+  };
+
+  class ZENI_DLL Archive_Reader {
+    // Undefined
+    Archive_Reader(const Archive_Reader &);
+    Archive_Reader & operator=(const Archive_Reader &);
+
+  public:
+    Archive_Reader(const Archive &archive, const String &path); ///< May throw Archive_Entry_Not_Found
+
+    inline const char * get_data() const; ///< Get the contents of the file
+    inline size_t get_size() const; ///< Get the size of the file
+
+    size_t read(void * const &buffer, const size_t &size); ///< Read up to 'size' bytes, returning the number read
+    bool seek(const long &offset, const int &origin); ///< Seek as with fseek; Returns false if the position would be out of bounds
+    inline long tell() const; ///< Get the current position
+
+  private:
+    String m_decompressed;
+    const char * m_data;
+    size_t m_size;
+    size_t m_position;
+  };
+
+  struct ZENI_DLL Archive_Load_Failure : public Error {
+    Archive_Load_Failure() : Error("Zeni Archive Failed to Load") {}
+  };
+
+  struct ZENI_DLL Archive_Entry_Not_Found : public Error {
+    Archive_Entry_Not_Found() : Error("Zeni Archive Entry Not Found") {}
+  };
+
+}
+
+#endif
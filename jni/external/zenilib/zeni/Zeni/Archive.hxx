@@ -0,0 +1,43 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_ARCHIVE_HXX
+#define ZENI_ARCHIVE_HXX
+
+#include <Zeni/Archive.h>
+
+namespace Zeni {
+
+  const String & Archive::get_filename() const {
+    return m_filename;
+  }
+
+  const char * Archive_Reader::get_data() const {
+    return m_data;
+  }
+
+  size_t Archive_Reader::get_size() const {
+    return m_size;
+  }
+
+  long Archive_Reader::tell() const {
+    return long(m_position);
+  }
+
+}
+
+#endif
@@ -46,6 +46,8 @@
 
 namespace Zeni {
 
+  class ZENI_DLL Frustum;
+
   class ZENI_DLL Camera {
   public:
     /// The Camera constructor is an alternative to using the numerous setter functions.
@@ -75,6 +77,7 @@ namespace Zeni {
     inline float get_tunneled_fov_rad() const; ///< Get the field of view (in the y-axis) in radians, shifted by tunnel vision
     inline Matrix4f get_view_matrix() const; ///< Equivalent to gluLookAt + tunnel_vision_factor
     inline Matrix4f get_projection_matrix(const std::pair<Point2i, Point2i> &viewport) const; ///< Equivalent to gluPerspective + tunnel_vision_factor
+    Frustum get_frustum(const std::pair<Point2i, Point2i> &viewport) const; ///< Get the viewing volume matching get_view_matrix and get_projection_matrix
 
     void adjust_yaw(const float &theta); ///< Adjust the orientation of the camera: left == positive;
     void adjust_pitch(const float &phi); ///< Adjust the orientation of the camera: up == positive;
@@ -0,0 +1,170 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Collision::Sphere_Batch
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Batch of Collision Spheres
+ *
+ * This class ZENI_DLL stores many Spheres as a structure of arrays so that
+ * one object can be tested against all of them in a single pass, four at a
+ * time where SSE is available.  Results match Sphere::shortest_distance and
+ * Sphere::intersects to within ZENI_COLLISION_EPSILON.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Collision::Capsule_Batch
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Batch of Collision Capsules
+ *
+ * This class ZENI_DLL stores many Capsules as a structure of arrays so that
+ * one object can be tested against all of them in a single pass, four at a
+ * time where SSE is available.  Results match Capsule::shortest_distance and
+ * Capsule::intersects to within ZENI_COLLISION_EPSILON.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_COLLISION_BATCH_H
+#define ZENI_COLLISION_BATCH_H
+
+#include <Zeni/Collision.h>
+
+#include <utility>
+#include <vector>
+
+namespace Zeni {
+  namespace Collision {
+
+    class ZENI_DLL Sphere_Batch {
+    public:
+      Sphere_Batch() : m_size(0u) {}
+
+      inline size_t size() const;
+      inline bool empty() const;
+      void clear();
+      void reserve(const size_t &capacity);
+
+      void push_back(const Sphere &sphere);
+      void set(const size_t &index, const Sphere &sphere);
+      Sphere operator[](const size_t &index) const;
+
+      /// Fill 'distances' with the distance from each Sphere
+      void shortest_distance(const Point3f &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Sphere &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Plane &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Line &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Ray &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Line_Segment &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Capsule &rhs, std::vector<float> &distances) const;
+
+      /// Fill 'indices' with the index of each Sphere which intersects
+      void intersects(const Point3f &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Sphere &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Plane &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Line &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Ray &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Line_Segment &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Capsule &rhs, std::vector<size_t> &indices) const;
+
+      void intersects(const Sphere_Batch &rhs, std::vector<std::pair<size_t, size_t> > &pairs) const; ///< Fill 'pairs' with <index in this, index in rhs> for each pair which intersects
+
+      void cast(const Ray &rhs, std::vector<float> &interpolations) const; ///< Fill 'interpolations' with the interpolation value along rhs at which it first touches each Sphere, or -1.0f if it misses
+
+    private:
+      size_t m_size;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+      std::vector<float> m_x;
+      std::vector<float> m_y;
+      std::vector<float> m_z;
+      std::vector<float> m_radius;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+    };
+
+    class ZENI_DLL Capsule_Batch {
+    public:
+      Capsule_Batch() : m_size(0u) {}
+
+      inline size_t size() const;
+      inline bool empty() const;
+      void clear();
+      void reserve(const size_t &capacity);
+
+      void push_back(const Capsule &capsule);
+      void set(const size_t &index, const Capsule &capsule);
+      Capsule operator[](const size_t &index) const;
+
+      /// Fill 'distances' with the distance from each Capsule
+      void shortest_distance(const Point3f &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Sphere &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Plane &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Line &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Ray &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Line_Segment &rhs, std::vector<float> &distances) const;
+      void shortest_distance(const Capsule &rhs, std::vector<float> &distances) const;
+
+      /// Fill 'indices' with the index of each Capsule which intersects
+      void intersects(const Point3f &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Sphere &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Plane &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Line &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Ray &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Line_Segment &rhs, std::vector<size_t> &indices) const;
+      void intersects(const Capsule &rhs, std::vector<size_t> &indices) const;
+
+      void intersects(const Capsule_Batch &rhs, std::vector<std::pair<size_t, size_t> > &pairs) const; ///< Fill 'pairs' with <index in this, index in rhs> for each pair which intersects
+
+    private:
+      size_t m_size;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+      std::vector<float> m_ax;
+      std::vector<float> m_ay;
+      std::vector<float> m_az;
+      std::vector<float> m_dx; ///< end_point_b - end_point_a
+      std::vector<float> m_dy;
+      std::vector<float> m_dz;
+      std::vector<float> m_radius;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+    };
+
+  }
+
+}
+
+#endif
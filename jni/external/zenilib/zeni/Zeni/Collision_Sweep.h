@@ -0,0 +1,150 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Collision::Impact
+ *
+ * \ingroup zenilib
+ *
+ * \brief The Result of a Swept Collision Query
+ *
+ * An Impact records whether a moving object hits another during its motion
+ * and, if so, the interpolation value [0.0f, 1.0f] along the motion at which
+ * they first touch, the point of contact, and the normal of the surface that
+ * was hit (pointing toward the moving object).
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Collision::Swept_Sphere
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Sphere Translating Along a Motion Vector
+ *
+ * This class ZENI_DLL describes a Sphere which moves from its starting
+ * position by 'motion' over a single step.  Querying it against another
+ * object finds the first time of impact rather than testing several
+ * substeps, so fast objects cannot pass through thin ones.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Collision::Swept_Capsule
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Capsule Translating Along a Motion Vector
+ *
+ * This class ZENI_DLL describes a Capsule which moves from its starting
+ * position by 'motion' over a single step.  Queries which lack a closed form
+ * solution use conservative advancement, so the reported time of impact
+ * never lies beyond the true one.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_COLLISION_SWEEP_H
+#define ZENI_COLLISION_SWEEP_H
+
+#include <Zeni/Collision.h>
+
+namespace Zeni {
+  namespace Collision {
+
+    class ZENI_DLL Swept_Sphere;
+    class ZENI_DLL Swept_Capsule;
+
+    class ZENI_DLL Impact {
+    public:
+      Impact() : hit(false), time(1.0f) {}
+      Impact(const float &time_, const Point3f &contact_, const Vector3f &normal_)
+        : hit(true), time(time_), contact(contact_), normal(normal_) {}
+
+      const bool & is_hit() const {return hit;} ///< Returns true if the objects touch during the motion
+      const float & get_time() const {return time;} ///< Returns the interpolation value [0.0f, 1.0f] of first contact, or 1.0f if there is none
+      const Point3f & get_contact() const {return contact;} ///< Returns the point of first contact
+      const Vector3f & get_normal() const {return normal;} ///< Returns the unit normal of the surface hit, pointing toward the moving object
+
+    private:
+      bool hit;
+      float time;
+      Point3f contact;
+      Vector3f normal;
+    };
+
+    class ZENI_DLL Swept_Sphere {
+    public:
+      Swept_Sphere() {}
+      Swept_Sphere(const Sphere &sphere_, const Vector3f &motion_);
+
+      Impact time_of_impact(const Point3f &rhs) const;
+      Impact time_of_impact(const Sphere &rhs) const;
+      Impact time_of_impact(const Plane &rhs) const;
+      Impact time_of_impact(const Line_Segment &rhs) const;
+      Impact time_of_impact(const Capsule &rhs) const;
+      Impact time_of_impact(const Parallelepiped &rhs) const;
+      Impact time_of_impact(const Swept_Sphere &rhs) const;
+      Impact time_of_impact(const Swept_Capsule &rhs) const;
+
+      Sphere at(const float &time) const; ///< Get the Sphere at an interpolation value [0.0f, 1.0f] along the motion
+
+      const Sphere & get_sphere() const {return sphere;}
+      const Vector3f & get_motion() const {return motion;}
+
+    private:
+      Sphere sphere;
+      Vector3f motion;
+    };
+
+    class ZENI_DLL Swept_Capsule {
+    public:
+      Swept_Capsule() {}
+      Swept_Capsule(const Capsule &capsule_, const Vector3f &motion_);
+
+      Impact time_of_impact(const Point3f &rhs) const;
+      Impact time_of_impact(const Sphere &rhs) const;
+      Impact time_of_impact(const Plane &rhs) const;
+      Impact time_of_impact(const Line_Segment &rhs) const;
+      Impact time_of_impact(const Capsule &rhs) const;
+      Impact time_of_impact(const Parallelepiped &rhs) const;
+      Impact time_of_impact(const Swept_Sphere &rhs) const;
+      Impact time_of_impact(const Swept_Capsule &rhs) const;
+
+      Capsule at(const float &time) const; ///< Get the Capsule at an interpolation value [0.0f, 1.0f] along the motion
+
+      const Capsule & get_capsule() const {return capsule;}
+      const Vector3f & get_motion() const {return motion;}
+
+    private:
+      Capsule capsule;
+      Vector3f motion;
+    };
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,259 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Collision::Bounding_Box
+ *
+ * \ingroup zenilib
+ *
+ * \brief Collision Axis-Aligned Bounding Box
+ *
+ * This class ZENI_DLL describes an axis-aligned box in 3-space.  It bounds
+ * the finite objects in Zeni_Collision for use in a broadphase.  Tests
+ * against other objects are conservative:  they never miss an intersection,
+ * but they may report one that the exact test would reject.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Collision::World
+ *
+ * \ingroup zenilib
+ *
+ * \brief Collision Broadphase
+ *
+ * A World holds proxies for Spheres, Line_Segments, Capsules and
+ * Parallelepipeds and finds which of them might be touching without testing
+ * every pair.  Each proxy is bounded by its Bounding_Box, fattened by a
+ * margin so that small movements do not require any work.
+ *
+ * By default, the boxes are kept in a dynamic bounding volume tree which is
+ * rebalanced as proxies are inserted, moved and removed.  Alternatively,
+ * sweep and prune keeps them sorted along the x-axis, which is cheaper when
+ * nearly everything moves every frame.
+ *
+ * Candidate pairs and queries are confirmed with the existing intersects
+ * functions for each pair of objects.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_COLLISION_WORLD_H
+#define ZENI_COLLISION_WORLD_H
+
+#include <Zeni/Collision.h>
+
+#include <utility>
+#include <vector>
+
+namespace Zeni {
+  namespace Collision {
+
+    class ZENI_DLL Bounding_Box {
+    public:
+      Bounding_Box() : lower_bound(0.0f, 0.0f, 0.0f), upper_bound(0.0f, 0.0f, 0.0f) {}
+      Bounding_Box(const Point3f &lower_bound_, const Point3f &upper_bound_) : lower_bound(lower_bound_), upper_bound(upper_bound_) {}
+      explicit Bounding_Box(const Sphere &sphere);
+      explicit Bounding_Box(const Line_Segment &line_segment);
+      explicit Bounding_Box(const Capsule &capsule);
+      explicit Bounding_Box(const Parallelepiped &parallelepiped);
+
+      inline bool intersects(const Bounding_Box &rhs) const;
+      bool intersects(const Sphere &rhs) const;
+      bool intersects(const Plane &rhs) const;
+      bool intersects(const Line &rhs) const;
+      bool intersects(const Ray &rhs) const;
+      bool intersects(const Line_Segment &rhs) const;
+      bool intersects(const Infinite_Cylinder &rhs) const;
+      bool intersects(const Capsule &rhs) const;
+      bool intersects(const Parallelepiped &rhs) const;
+
+      inline bool contains(const Bounding_Box &rhs) const; ///< Check to see if rhs lies entirely within this Bounding_Box
+      inline Bounding_Box merged(const Bounding_Box &rhs) const; ///< Get the smallest Bounding_Box containing both
+      inline Bounding_Box expanded(const float &margin) const; ///< Get a copy grown by 'margin' in every direction
+      inline float surface_area() const;
+
+      const Point3f & get_lower_bound() const {return lower_bound;}
+      const Point3f & get_upper_bound() const {return upper_bound;}
+
+    private:
+      Point3f lower_bound;
+      Point3f upper_bound;
+    };
+
+    class ZENI_DLL World {
+      // Undefined
+      World(const World &);
+      World & operator=(const World &);
+
+    public:
+      typedef size_t Proxy;
+      typedef std::pair<Proxy, Proxy> Proxy_Pair;
+
+      enum Broadphase {DYNAMIC_AABB_TREE, SWEEP_AND_PRUNE};
+
+      World(const Broadphase &broadphase = DYNAMIC_AABB_TREE, const float &margin = 0.1f);
+      ~World();
+
+      template <typename SHAPE>
+      Proxy insert(const SHAPE &shape, void * const &user_data = 0); ///< Add a Sphere, Line_Segment, Capsule or Parallelepiped
+      template <typename SHAPE>
+      void move(const Proxy &proxy, const SHAPE &shape); ///< Replace the object for a proxy; Cheap unless it leaves its fattened box
+      void remove(const Proxy &proxy); ///< Remove a proxy; Its id may be reused
+      void clear(); ///< Remove all proxies
+
+      inline Broadphase get_broadphase() const;
+      inline float get_margin() const;
+      inline size_t size() const; ///< Get the number of proxies
+      inline void * get_user_data(const Proxy &proxy) const;
+      inline const Bounding_Box & get_bounding_box(const Proxy &proxy) const; ///< Get the fattened box of a proxy
+      template <typename SHAPE>
+      const SHAPE * get_shape(const Proxy &proxy) const; ///< Get the object for a proxy, or 0 if it is of another type
+
+      void find_candidate_pairs(std::vector<Proxy_Pair> &pairs) const; ///< Find all pairs whose fattened boxes overlap
+      void find_colliding_pairs(std::vector<Proxy_Pair> &pairs) const; ///< Find all pairs which actually intersect
+
+      void query(const Bounding_Box &bounding_box, std::vector<Proxy> &proxies) const; ///< Find all proxies whose fattened boxes overlap
+      template <typename TYPE>
+      void query(const TYPE &rhs, std::vector<Proxy> &proxies) const; ///< Find all proxies which intersect any object in Zeni_Collision
+
+      int get_tree_height() const; ///< Get the height of the dynamic AABB tree, or 0 for sweep and prune
+
+    private:
+      class Shape {
+      public:
+        virtual ~Shape() {}
+
+        virtual Bounding_Box get_bounding_box() const = 0;
+
+        virtual bool intersects(const Shape &rhs) const = 0;
+        virtual bool intersects(const Sphere &rhs) const = 0;
+        virtual bool intersects(const Plane &rhs) const = 0;
+        virtual bool intersects(const Line &rhs) const = 0;
+        virtual bool intersects(const Ray &rhs) const = 0;
+        virtual bool intersects(const Line_Segment &rhs) const = 0;
+        virtual bool intersects(const Infinite_Cylinder &rhs) const = 0;
+        virtual bool intersects(const Capsule &rhs) const = 0;
+        virtual bool intersects(const Parallelepiped &rhs) const = 0;
+      };
+
+      template <typename SHAPE>
+      class Shape_Impl : public Shape {
+      public:
+        Shape_Impl(const SHAPE &shape_) : shape(shape_) {}
+
+        Bounding_Box get_bounding_box() const {return Bounding_Box(shape);}
+
+        bool intersects(const Shape &rhs) const {return rhs.intersects(shape);}
+        bool intersects(const Sphere &rhs) const {return shape.intersects(rhs);}
+        bool intersects(const Plane &rhs) const {return shape.intersects(rhs);}
+        bool intersects(const Line &rhs) const {return shape.intersects(rhs);}
+        bool intersects(const Ray &rhs) const {return shape.intersects(rhs);}
+        bool intersects(const Line_Segment &rhs) const {return shape.intersects(rhs);}
+        bool intersects(const Infinite_Cylinder &rhs) const {return shape.intersects(rhs);}
+        bool intersects(const Capsule &rhs) const {return shape.intersects(rhs);}
+        bool intersects(const Parallelepiped &rhs) const {return shape.intersects(rhs);}
+
+        SHAPE shape;
+      };
+
+      class Volume {
+      public:
+        virtual ~Volume() {}
+
+        virtual bool may_intersect(const Bounding_Box &bounding_box) const = 0;
+        virtual bool intersects(const Shape &shape) const = 0;
+      };
+
+      template <typename TYPE>
+      class Volume_Impl : public Volume {
+      public:
+        Volume_Impl(const TYPE &volume_) : volume(volume_) {}
+
+        bool may_intersect(const Bounding_Box &bounding_box) const {return bounding_box.intersects(volume);}
+        bool intersects(const Shape &shape) const {return shape.intersects(volume);}
+
+        const TYPE &volume;
+      };
+
+      struct Proxy_Data {
+        Proxy_Data() : shape(0), user_data(0), node(-1) {}
+
+        Shape * shape;
+        Bounding_Box bounding_box;
+        void * user_data;
+        int node;
+      };
+
+      struct Node {
+        Bounding_Box bounding_box;
+        int parent; ///< Next free node when unused
+        int child_a;
+        int child_b;
+        int height; ///< 0 for leaves, -1 when unused
+        Proxy proxy;
+
+        bool is_leaf() const {return child_a == -1;}
+      };
+
+      Proxy insert_Shape(Shape * const &shape, void * const &user_data);
+      void move_Shape(const Proxy &proxy, Shape * const &shape);
+
+      void query_Volume(const Volume &volume, std::vector<Proxy> &proxies) const;
+
+      // Dynamic AABB Tree
+      int allocate_node();
+      void free_node(const int &node);
+      void insert_leaf(const int &leaf);
+      void remove_leaf(const int &leaf);
+      int balance(const int &node);
+
+      // Sweep and Prune
+      void update_sweep() const;
+
+      Broadphase m_broadphase;
+      float m_margin;
+      size_t m_size;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+      std::vector<Proxy_Data> m_proxies;
+      std::vector<Proxy> m_free_proxies;
+
+      std::vector<Node> m_nodes;
+      int m_root;
+      int m_free_node;
+
+      mutable std::vector<Proxy> m_sweep;
+      mutable bool m_sweep_dirty;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+    };
+
+  }
+
+}
+
+#endif
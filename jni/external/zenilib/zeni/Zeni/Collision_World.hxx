@@ -0,0 +1,110 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_COLLISION_WORLD_HXX
+#define ZENI_COLLISION_WORLD_HXX
+
+#include <Zeni/Collision_World.h>
+
+#include <algorithm>
+
+namespace Zeni {
+
+  namespace Collision {
+
+    bool Bounding_Box::intersects(const Bounding_Box &rhs) const {
+      return lower_bound.x <= rhs.upper_bound.x && rhs.lower_bound.x <= upper_bound.x &&
+             lower_bound.y <= rhs.upper_bound.y && rhs.lower_bound.y <= upper_bound.y &&
+             lower_bound.z <= rhs.upper_bound.z && rhs.lower_bound.z <= upper_bound.z;
+    }
+
+    bool Bounding_Box::contains(const Bounding_Box &rhs) const {
+      return lower_bound.x <= rhs.lower_bound.x && rhs.upper_bound.x <= upper_bound.x &&
+             lower_bound.y <= rhs.lower_bound.y && rhs.upper_bound.y <= upper_bound.y &&
+             lower_bound.z <= rhs.lower_bound.z && rhs.upper_bound.z <= upper_bound.z;
+    }
+
+    Bounding_Box Bounding_Box::merged(const Bounding_Box &rhs) const {
+      return Bounding_Box(Point3f(std::min(lower_bound.x, rhs.lower_bound.x),
+                                  std::min(lower_bound.y, rhs.lower_bound.y),
+                                  std::min(lower_bound.z, rhs.lower_bound.z)),
+                          Point3f(std::max(upper_bound.x, rhs.upper_bound.x),
+                                  std::max(upper_bound.y, rhs.upper_bound.y),
+                                  std::max(upper_bound.z, rhs.upper_bound.z)));
+    }
+
+    Bounding_Box Bounding_Box::expanded(const float &margin) const {
+      const Vector3f grow(margin, margin, margin);
+      return Bounding_Box(lower_bound - grow, upper_bound + grow);
+    }
+
+    float Bounding_Box::surface_area() const {
+      const Vector3f size = upper_bound - lower_bound;
+      return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    template <typename SHAPE>
+    World::Proxy World::insert(const SHAPE &shape, void * const &user_data) {
+      return insert_Shape(new Shape_Impl<SHAPE>(shape), user_data);
+    }
+
+    template <typename SHAPE>
+    void World::move(const Proxy &proxy, const SHAPE &shape) {
+      if(Shape_Impl<SHAPE> * const impl = dynamic_cast<Shape_Impl<SHAPE> *>(m_proxies[proxy].shape)) {
+        impl->shape = shape;
+        move_Shape(proxy, impl);
+      }
+      else
+        move_Shape(proxy, new Shape_Impl<SHAPE>(shape));
+    }
+
+    World::Broadphase World::get_broadphase() const {
+      return m_broadphase;
+    }
+
+    float World::get_margin() const {
+      return m_margin;
+    }
+
+    size_t World::size() const {
+      return m_size;
+    }
+
+    void * World::get_user_data(const Proxy &proxy) const {
+      return m_proxies[proxy].user_data;
+    }
+
+    const Bounding_Box & World::get_bounding_box(const Proxy &proxy) const {
+      return m_proxies[proxy].bounding_box;
+    }
+
+    template <typename SHAPE>
+    const SHAPE * World::get_shape(const Proxy &proxy) const {
+      const Shape_Impl<SHAPE> * const impl = dynamic_cast<const Shape_Impl<SHAPE> *>(m_proxies[proxy].shape);
+      return impl ? &impl->shape : 0;
+    }
+
+    template <typename TYPE>
+    void World::query(const TYPE &rhs, std::vector<Proxy> &proxies) const {
+      query_Volume(Volume_Impl<TYPE>(rhs), proxies);
+    }
+
+  }
+
+}
+
+#endif
@@ -92,6 +92,8 @@ namespace Zeni {
     TYPE & operator[](const String &name) const; ///< Get a TYPE by name
     TYPE & operator[](const unsigned long &id) const; ///< Get a TYPE by id
 
+    unsigned long get_generation() const; ///< Get a count which changes whenever any entry is added, replaced, or removed, so that pointers to entries can be kept until it does
+
     // Loaders
     unsigned long give(const String &name, TYPE * const &type, const bool &keep, const String &filename = ""); ///< Add an entry (which it will later delete)
     unsigned long lend(const String &name, TYPE * const &type, const bool &keep); ///< Add an entry (which it will NEVER delete)
@@ -132,6 +134,7 @@ namespace Zeni {
 #pragma warning( pop )
 #endif
 
+    unsigned long m_generation;
     bool m_lost;
   };
 
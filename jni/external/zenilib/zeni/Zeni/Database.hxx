@@ -77,6 +77,7 @@ namespace Zeni {
   template <class TYPE>
   Database<TYPE>::Database(const String &filename, const String &xml_identifier)
     : m_xml_identifier(xml_identifier),
+    m_generation(0u),
     m_lost(true)
   {
     m_filenames.push_front(filename);
@@ -110,6 +111,7 @@ namespace Zeni {
     lr->handles.push_front(typename Lookup::Handle(type, filename, false, keep));
 
     m_entries[lr->id] = type;
+    ++m_generation;
 
     return lr->id;
   }
@@ -137,6 +139,7 @@ namespace Zeni {
     lr->handles.push_front(typename Lookup::Handle(type, "", true, keep));
 
     m_entries[lr->id] = type;
+    ++m_generation;
 
     return lr->id;
   }
@@ -166,6 +169,8 @@ namespace Zeni {
     }
     else
       m_entries[lr.id] = lr.handles.begin()->ptr;
+
+    ++m_generation;
   }
 
   template <class TYPE>
@@ -216,6 +221,11 @@ namespace Zeni {
     return (*this)[get_id(name)];
   }
 
+  template <class TYPE>
+  unsigned long Database<TYPE>::get_generation() const {
+    return m_generation;
+  }
+
   template <class TYPE>
   void Database<TYPE>::clear() {
     uninit();
@@ -299,6 +309,7 @@ namespace Zeni {
     }
 
     m_filenames.erase(it);
+    ++m_generation;
 
     if(m_filenames.empty())
       on_clear();
@@ -348,6 +359,7 @@ namespace Zeni {
     }
 
     m_lookups.clear();
+    ++m_generation;
   }
 
   template <class TYPE>
@@ -373,6 +385,7 @@ namespace Zeni {
     lhr.push_front(handle);
 
     m_entries[it->second->id] = handle.ptr;
+    ++m_generation;
 
     return true;
   }
@@ -408,6 +421,7 @@ namespace Zeni {
         m_entries.erase(it->second->id);
     }
 
+    ++m_generation;
     m_lost = true;
   }
 
@@ -18,7 +18,7 @@
 #ifndef ZENI_EVENT_H
 #define ZENI_EVENT_H
 
-#include <Zeni/Hash_Map.h>
+#include <Zeni/Signal.h>
 
 namespace Zeni {
 
@@ -33,18 +33,12 @@ namespace Zeni {
       virtual Handler * duplicate() const = 0;
     };
 
-    typedef Unordered_Map<Handler *, bool> Handlers;
-
-    ~Event() {
-      clear();
-    }
-
     void lend_Handler(Handler * const &handler) {
-      m_handlers[handler] = false;
+      m_handlers.add(handler, false);
     }
 
     void give_Handler(Handler * const &handler) {
-      m_handlers[handler] = true;
+      m_handlers.add(handler, true);
     }
 
     void fax_Handler(Handler * const &handler) {
@@ -52,36 +46,27 @@ namespace Zeni {
     }
 
     void remove_Handler(Handler * const &handler) {
-      Handlers::iterator ht = m_handlers.find(handler);
-
-      if(ht != m_handlers.end()) {
-        if(ht->second)
-          delete ht->first;
-
-        m_handlers.erase(ht);
-      }
+      m_handlers.remove(handler);
     }
 
     void fire() {
-      const Handlers m_copy = m_handlers;
-      for(Handlers::const_iterator ht = m_copy.begin(), hend = m_copy.end(); ht != hend; ++ht)
-        (*ht->first)();
+      m_handlers.dispatch(Call());
     }
 
     void clear() {
-      for(Handlers::const_iterator ht = m_handlers.begin(), hend = m_handlers.end(); ht != hend; ++ht)
-        if(ht->second)
-          delete ht->first;
-
       m_handlers.clear();
     }
 
   private:
+    struct Call {
+      void operator()(Handler &handler) const {handler();}
+    };
+
 #ifdef _WINDOWS
 #pragma warning( push )
 #pragma warning( disable : 4251 )
 #endif
-    Handlers m_handlers;
+    Handler_List<Handler> m_handlers;
 #ifdef _WINDOWS
 #pragma warning( pop )
 #endif
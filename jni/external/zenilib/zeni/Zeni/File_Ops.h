@@ -29,6 +29,8 @@
 
 namespace Zeni {
 
+  class Archive;
+
   class ZENI_DLL File_Ops;
 
 #ifdef _WINDOWS
@@ -54,6 +56,11 @@ namespace Zeni {
 #endif
     static FILE * get_asset_FILE(const String &filename, off_t * const &start = 0, off_t * const &length = 0); ///< Get a FILE * from an Asset
     static String & load_asset(String &memory, const String &filename); ///< Load a file into memory
+
+    static void mount_Archive(const String &filename); ///< Read assets from an Archive in preference to loose files; Later Archives take precedence; Not safe while assets are loading on other threads; May throw Archive_Load_Failure
+    static void unmount_Archives(); ///< Return to reading loose files only
+    static const Archive * find_Archive(const String &filename); ///< Get the most recently mounted Archive containing a file, or 0 if none do
+
     static const String & get_uniqname(); ///< Get the unique app identifier for the game, set in zenilib.xml
     const String & get_username(); ///< Get the logged-in user's username
     String get_appdata_path(); ///< Get the path that should be used for user-modifiable storage
@@ -64,12 +71,15 @@ namespace Zeni {
     static bool file_exists(const String &file_path); ///< Test for the existence of a file
     static bool delete_file(const String &file_path); ///< Delete a file
     static bool copy_file(const String &from, const String &to); ///< Copy a file from one filepath to another
+    static String get_temporary_path(const String &file_path); ///< Get a path beside file_path, unique to this process and thread, to write before calling replace_file
+    static bool replace_file(const String &from, const String &to); ///< Move a file over another in one step, so readers see either the old file or the new one
 
     // Can be called once only, and only before File_Ops is initialized; May throw File_Ops_Initialized
     static void preinit(const String &unique_app_identifier);
 
   private:
     static String & get_unique_app_identifier();
+    static FILE * get_loose_FILE(const String &filename, off_t &start, off_t &length);
 
 #ifdef ANDROID
     static AAssetManager * m_asset_manager;
@@ -0,0 +1,201 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Float4
+ *
+ * \ingroup zenilib
+ *
+ * \brief Four-Wide Float Arithmetic
+ *
+ * Float4 wraps an SSE register where the compiler enables SSE and falls back
+ * to an equivalent loop over four floats everywhere else, so code written
+ * against it builds on every platform.  Loads and stores are unaligned.
+ *
+ * Comparisons return masks which may only be passed to float4_select or
+ * float4_mask_bits.
+ *
+ * This header is for the implementation of zenilib and is not included by
+ * zeni.h.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_FLOAT4_H
+#define ZENI_FLOAT4_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define ZENI_FLOAT4_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Zeni {
+
+#ifdef ZENI_FLOAT4_SSE
+  struct Float4 {
+    Float4() {}
+    Float4(const __m128 &value_) : value(value_) {}
+    explicit Float4(const float &value_) : value(_mm_set1_ps(value_)) {}
+    Float4(const float &x, const float &y, const float &z, const float &w) : value(_mm_setr_ps(x, y, z, w)) {}
+
+    static Float4 load(const float * const &values) {return _mm_loadu_ps(values);}
+    void store(float * const &values) const {_mm_storeu_ps(values, value);}
+
+    __m128 value;
+  };
+
+  inline Float4 operator+(const Float4 &lhs, const Float4 &rhs) {return _mm_add_ps(lhs.value, rhs.value);}
+  inline Float4 operator-(const Float4 &lhs, const Float4 &rhs) {return _mm_sub_ps(lhs.value, rhs.value);}
+  inline Float4 operator*(const Float4 &lhs, const Float4 &rhs) {return _mm_mul_ps(lhs.value, rhs.value);}
+  inline Float4 operator/(const Float4 &lhs, const Float4 &rhs) {return _mm_div_ps(lhs.value, rhs.value);}
+  inline Float4 float4_min(const Float4 &lhs, const Float4 &rhs) {return _mm_min_ps(lhs.value, rhs.value);}
+  inline Float4 float4_max(const Float4 &lhs, const Float4 &rhs) {return _mm_max_ps(lhs.value, rhs.value);}
+  inline Float4 float4_sqrt(const Float4 &value) {return _mm_sqrt_ps(value.value);}
+  inline Float4 float4_abs(const Float4 &value) {return _mm_andnot_ps(_mm_set1_ps(-0.0f), value.value);}
+  inline Float4 float4_less(const Float4 &lhs, const Float4 &rhs) {return _mm_cmplt_ps(lhs.value, rhs.value);}
+  inline Float4 float4_select(const Float4 &mask, const Float4 &if_true, const Float4 &if_false) {
+    return _mm_or_ps(_mm_and_ps(mask.value, if_true.value), _mm_andnot_ps(mask.value, if_false.value));
+  }
+  inline int float4_mask_bits(const Float4 &mask) {return _mm_movemask_ps(mask.value);}
+#else
+  struct Float4 {
+    Float4() {}
+    explicit Float4(const float &value_) {value[0] = value[1] = value[2] = value[3] = value_;}
+    Float4(const float &x, const float &y, const float &z, const float &w) {value[0] = x; value[1] = y; value[2] = z; value[3] = w;}
+
+    static Float4 load(const float * const &values) {Float4 rv; std::copy(values, values + 4, rv.value); return rv;}
+    void store(float * const &values) const {std::copy(value, value + 4, values);}
+
+    float value[4];
+  };
+
+#define ZENI_FLOAT4_OP(NAME, EXPRESSION) \
+  inline Float4 NAME(const Float4 &lhs, const Float4 &rhs) { \
+    Float4 rv; \
+    for(int i = 0; i != 4; ++i) { \
+      const float &l = lhs.value[i]; \
+      const float &r = rhs.value[i]; \
+      rv.value[i] = (EXPRESSION); \
+    } \
+    return rv; \
+  }
+
+  ZENI_FLOAT4_OP(operator+, l + r)
+  ZENI_FLOAT4_OP(operator-, l - r)
+  ZENI_FLOAT4_OP(operator*, l * r)
+  ZENI_FLOAT4_OP(operator/, l / r)
+  ZENI_FLOAT4_OP(float4_min, r < l ? r : l)
+  ZENI_FLOAT4_OP(float4_max, l < r ? r : l)
+  ZENI_FLOAT4_OP(float4_less, l < r ? 1.0f : 0.0f)
+
+#undef ZENI_FLOAT4_OP
+
+  inline Float4 float4_sqrt(const Float4 &value) {
+    Float4 rv;
+    for(int i = 0; i != 4; ++i)
+      rv.value[i] = float(sqrt(value.value[i]));
+    return rv;
+  }
+  inline Float4 float4_abs(const Float4 &value) {
+    Float4 rv;
+    for(int i = 0; i != 4; ++i)
+      rv.value[i] = float(fabs(value.value[i]));
+    return rv;
+  }
+  inline Float4 float4_select(const Float4 &mask, const Float4 &if_true, const Float4 &if_false) {
+    Float4 rv;
+    for(int i = 0; i != 4; ++i)
+      rv.value[i] = mask.value[i] != 0.0f ? if_true.value[i] : if_false.value[i];
+    return rv;
+  }
+  inline int float4_mask_bits(const Float4 &mask) {
+    return (mask.value[0] != 0.0f ? 1 : 0) | (mask.value[1] != 0.0f ? 2 : 0) |
+           (mask.value[2] != 0.0f ? 4 : 0) | (mask.value[3] != 0.0f ? 8 : 0);
+  }
+#endif
+
+  inline Float4 float4_clamp(const Float4 &value, const Float4 &lower, const Float4 &upper) {
+    return float4_min(float4_max(value, lower), upper);
+  }
+
+  /** Transform 'count' packed (x, y, z) triples by the column-major matrix
+   *  'column' with w = 1, reading from 'in' and writing to 'out', which may
+   *  be the same array
+   */
+  inline void float4_transform3(const float (&column)[4][4], const float * const in, float * const out, const size_t &count) {
+    size_t index = 0;
+
+#ifdef ZENI_FLOAT4_SSE
+    /** Four triples are twelve floats, or three registers.  Transpose them
+     *  into x, y, and z registers, transform, and transpose back.
+     */
+    {
+      const __m128 c0[3] = {_mm_set1_ps(column[0][0]), _mm_set1_ps(column[0][1]), _mm_set1_ps(column[0][2])};
+      const __m128 c1[3] = {_mm_set1_ps(column[1][0]), _mm_set1_ps(column[1][1]), _mm_set1_ps(column[1][2])};
+      const __m128 c2[3] = {_mm_set1_ps(column[2][0]), _mm_set1_ps(column[2][1]), _mm_set1_ps(column[2][2])};
+      const __m128 c3[3] = {_mm_set1_ps(column[3][0]), _mm_set1_ps(column[3][1]), _mm_set1_ps(column[3][2])};
+
+      for(; index + 4 <= count; index += 4) {
+        const float * const src = in + 3 * index;
+        const __m128 a = _mm_loadu_ps(src);     // x0 y0 z0 x1
+        const __m128 b = _mm_loadu_ps(src + 4); // y1 z1 x2 y2
+        const __m128 c = _mm_loadu_ps(src + 8); // z2 x3 y3 z3
+
+        const __m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+        __m128 r[3];
+        for(int i = 0; i < 3; ++i)
+          r[i] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0[i], x), _mm_mul_ps(c1[i], y)),
+                            _mm_add_ps(_mm_mul_ps(c2[i], z), c3[i]));
+
+        // r[0] = X0 X1 X2 X3, r[1] = Y0 Y1 Y2 Y3, r[2] = Z0 Z1 Z2 Z3
+        const __m128 xy01 = _mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(1, 0, 1, 0)); // X0 X1 Y0 Y1
+        const __m128 xy23 = _mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(3, 2, 3, 2)); // X2 X3 Y2 Y3
+        const __m128 zx = _mm_shuffle_ps(r[2], r[0], _MM_SHUFFLE(1, 1, 0, 0));   // Z0 Z0 X1 X1
+        const __m128 yz = _mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(1, 1, 1, 1));   // Y1 Y1 Z1 Z1
+        const __m128 zx23 = _mm_shuffle_ps(r[2], r[0], _MM_SHUFFLE(3, 3, 2, 2)); // Z2 Z2 X3 X3
+        const __m128 yz23 = _mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(3, 3, 3, 3)); // Y3 Y3 Z3 Z3
+
+        float * const dest = out + 3 * index;
+        _mm_storeu_ps(dest, _mm_shuffle_ps(xy01, zx, _MM_SHUFFLE(2, 0, 2, 0)));         // X0 Y0 Z0 X1
+        _mm_storeu_ps(dest + 4, _mm_shuffle_ps(yz, xy23, _MM_SHUFFLE(2, 0, 2, 0)));     // Y1 Z1 X2 Y2
+        _mm_storeu_ps(dest + 8, _mm_shuffle_ps(zx23, yz23, _MM_SHUFFLE(2, 0, 2, 0)));   // Z2 X3 Y3 Z3
+      }
+    }
+#endif
+
+    for(; index < count; ++index) {
+      const float * const src = in + 3 * index;
+      const float x = src[0], y = src[1], z = src[2];
+      float * const dest = out + 3 * index;
+      dest[0] = column[0][0] * x + column[1][0] * y + column[2][0] * z + column[3][0];
+      dest[1] = column[0][1] * x + column[1][1] * y + column[2][1] * z + column[3][1];
+      dest[2] = column[0][2] * x + column[1][2] * y + column[2][2] * z + column[3][2];
+    }
+  }
+
+}
+
+#endif
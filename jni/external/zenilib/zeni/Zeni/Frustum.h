@@ -0,0 +1,81 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Frustum
+ *
+ * \ingroup zenilib
+ *
+ * \brief The Viewing Volume of a Camera
+ *
+ * A Frustum is bounded by six inward facing planes: near, far, left, right,
+ * top, and bottom.  Bounding spheres and axis-aligned boxes can be tested
+ * against it one at a time, which distinguishes objects entirely inside
+ * from those straddling a plane so that hierarchies can skip testing
+ * children, or many at a time, four per iteration.
+ *
+ * To test bounds given in the space of an object, test against the Frustum
+ * transformed by that object's object-to-world Matrix4f.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_FRUSTUM_H
+#define ZENI_FRUSTUM_H
+
+#include <Zeni/Collision.h>
+#include <Zeni/Coordinate.h>
+#include <Zeni/Matrix4f.h>
+
+namespace Zeni {
+
+  class ZENI_DLL Camera;
+
+  class ZENI_DLL Frustum {
+  public:
+    enum Containment {OUTSIDE, INTERSECTING, INSIDE};
+
+    Frustum(); ///< A Frustum containing everything
+    Frustum(const Camera &camera, const float &aspect_ratio); ///< The Frustum seen by 'camera' for a viewport of width/height 'aspect_ratio'
+
+    Frustum transformed(const Matrix4f &object_to_world) const; ///< Get the Frustum in the space of an object; 'object_to_world' must be affine
+
+    Containment contains(const Point3f &point) const;
+    Containment contains(const Collision::Sphere &sphere) const;
+    Containment contains(const Point3f &lower_bound, const Point3f &upper_bound) const; ///< Test an axis-aligned box
+
+    /// Set visible[i] to false for each sphere entirely outside the Frustum and true for all others
+    void cull_spheres(const Point3f * const centers, const float * const radii, const size_t &count, bool * const visible) const;
+    /// Set visible[i] to false for each axis-aligned box entirely outside the Frustum and true for all others
+    void cull_boxes(const Point3f * const lower_bounds, const Point3f * const upper_bounds, const size_t &count, bool * const visible) const;
+
+  private:
+    float signed_distance(const int &plane, const Point3f &point) const;
+    float box_radius(const int &plane, const Vector3f &half_extent) const;
+
+    // Structure of arrays for four-wide tests; Inside is normal * point + distance >= 0
+    float m_normal_x[6];
+    float m_normal_y[6];
+    float m_normal_z[6];
+    float m_distance[6];
+  };
+
+}
+
+#endif
@@ -92,7 +92,7 @@ namespace Zeni {
     inline Matrix4f & operator-=(const Matrix4f &rhs); ///< Set equal to the difference
 
     // Matrix Products
-    inline Matrix4f operator*(const Matrix4f &rhs) const; ///< Get the product
+    Matrix4f operator*(const Matrix4f &rhs) const; ///< Get the product
     inline Matrix4f operator*=(const Matrix4f &rhs); ///< Get the product
     inline Matrix4f operator/(const Matrix4f &rhs) const; ///< Get the product with the inverse
     inline Matrix4f operator/=(const Matrix4f &rhs); ///< Set equal to the product with the inverse
@@ -120,6 +120,9 @@ namespace Zeni {
 	  float m_matrix[4][4];
   };
 
+  /// Transform 'count' Point3fs from 'in' into 'out', which may be the same array
+  ZENI_DLL void transform_points(const Matrix4f &matrix, const Point3f * const in, Point3f * const out, const size_t &count);
+
   ZENI_DLL std::ostream & serialize(std::ostream &os, const Matrix4f &value);
   ZENI_DLL std::istream & unserialize(std::istream &is, Matrix4f &value);
 
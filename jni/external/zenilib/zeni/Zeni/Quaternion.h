@@ -115,6 +115,9 @@ namespace Zeni {
     return rhs * lhs;
   }
 
+  /// Rotate 'count' Vector3f_Packeds from 'in' into 'out', which may be the same array
+  ZENI_DLL void rotate_vectors(const Quaternion &rotation, const Vector3f_Packed * const in, Vector3f_Packed * const out, const size_t &count);
+
   ZENI_DLL std::ostream & serialize(std::ostream &os, const Quaternion &value);
   ZENI_DLL std::istream & unserialize(std::istream &is, Quaternion &value);
 
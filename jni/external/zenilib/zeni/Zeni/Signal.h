@@ -0,0 +1,230 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Handler_List
+ *
+ * \ingroup zenilib
+ *
+ * \brief An Ordered Array of Handlers Safe to Modify During Dispatch
+ *
+ * Handlers are called in the order in which they were added.  A Handler
+ * added during dispatch is first called by the next dispatch.  A Handler
+ * removed during dispatch is not called again, and if owned, it is deleted
+ * once the outermost dispatch completes, so a Handler may remove itself.
+ *
+ * Dispatch walks a contiguous array without copying it or allocating.
+ *
+ * \note Handler_List underlies Event and Signal and is not meant to be used directly.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Signal
+ *
+ * \ingroup zenilib
+ *
+ * \brief An Event Carrying a Typed Payload
+ *
+ * A Signal passes a PAYLOAD by reference to each of its Handlers.  Use one
+ * for gameplay events which fire frequently or which have many listeners.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_SIGNAL_H
+#define ZENI_SIGNAL_H
+
+#include <Zeni/Hash_Map.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  template <typename HANDLER>
+  class Handler_List {
+    // Undefined
+    Handler_List(const Handler_List &);
+    Handler_List & operator=(const Handler_List &);
+
+  public:
+    Handler_List() : m_firing(0u) {}
+
+    ~Handler_List() {
+      clear();
+    }
+
+    inline size_t size() const {return m_index.size();} ///< Get the number of Handlers
+
+    void add(HANDLER * const &handler, const bool &owned) {
+      const typename Index::iterator it = m_index.find(handler);
+
+      if(it != m_index.end())
+        m_entries[it->second].owned = owned;
+      else {
+        m_index[handler] = m_entries.size();
+        m_entries.push_back(Entry(handler, owned));
+      }
+    }
+
+    void remove(HANDLER * const &handler) {
+      const typename Index::iterator it = m_index.find(handler);
+
+      if(it != m_index.end()) {
+        erase(m_entries[it->second]);
+        m_index.erase(it);
+        tidy();
+      }
+    }
+
+    void clear() {
+      for(typename std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        erase(*it);
+      m_index.clear();
+      tidy();
+    }
+
+    /// Call 'call(handler)' for each Handler present when dispatch began
+    template <typename CALL>
+    void dispatch(const CALL &call) {
+      Dispatch_Guard guard(*this);
+
+      for(size_t i = 0, iend = m_entries.size(); i != iend; ++i) {
+        if(m_entries[i].handler)
+          call(*m_entries[i].handler);
+      }
+    }
+
+  private:
+    struct Entry {
+      Entry(HANDLER * const &handler_, const bool &owned_) : handler(handler_), owned(owned_) {}
+
+      HANDLER * handler; ///< 0 once removed
+      bool owned;
+    };
+
+    typedef Unordered_Map<HANDLER *, size_t> Index;
+
+    class Dispatch_Guard;
+    friend class Dispatch_Guard;
+
+    class Dispatch_Guard {
+      // Undefined
+      Dispatch_Guard(const Dispatch_Guard &);
+      Dispatch_Guard & operator=(const Dispatch_Guard &);
+
+    public:
+      Dispatch_Guard(Handler_List &list_) : list(list_) {++list.m_firing;}
+      ~Dispatch_Guard() {
+        --list.m_firing;
+        list.tidy();
+      }
+
+    private:
+      Handler_List &list;
+    };
+
+    void erase(Entry &entry) {
+      if(entry.handler && entry.owned)
+        m_dead.push_back(entry.handler);
+      entry.handler = 0;
+    }
+
+    /// Outside of dispatch, delete removed Handlers and close the gaps they left once they outnumber the rest
+    void tidy() {
+      if(m_firing)
+        return;
+
+      for(typename std::vector<HANDLER *>::iterator it = m_dead.begin(); it != m_dead.end(); ++it)
+        delete *it;
+      m_dead.clear();
+
+      if(m_entries.size() <= 2u * m_index.size() + 8u)
+        return;
+
+      size_t kept = 0;
+      for(size_t i = 0; i != m_entries.size(); ++i) {
+        if(m_entries[i].handler) {
+          if(kept != i) {
+            m_entries[kept] = m_entries[i];
+            m_index[m_entries[kept].handler] = kept;
+          }
+          ++kept;
+        }
+      }
+      m_entries.resize(kept, Entry(0, false));
+    }
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Entry> m_entries;
+    Index m_index;
+    std::vector<HANDLER *> m_dead; ///< Owned Handlers removed during dispatch, awaiting deletion
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+
+    size_t m_firing;
+  };
+
+  template <typename PAYLOAD>
+  class Signal {
+  public:
+    class Handler {
+    public:
+      virtual ~Handler() {}
+
+      virtual void operator()(const PAYLOAD &payload) = 0;
+
+      virtual Handler * duplicate() const = 0;
+    };
+
+    inline size_t size() const {return m_handlers.size();} ///< Get the number of Handlers
+
+    void lend_Handler(Handler * const &handler) {m_handlers.add(handler, false);} ///< Add a Handler which the Signal will NEVER delete
+    void give_Handler(Handler * const &handler) {m_handlers.add(handler, true);} ///< Add a Handler which the Signal will later delete
+    void fax_Handler(Handler * const &handler) {give_Handler(handler->duplicate());} ///< Add a duplicate of a Handler
+    void remove_Handler(Handler * const &handler) {m_handlers.remove(handler);} ///< Remove a Handler, deleting it if it was given
+
+    void fire(const PAYLOAD &payload) {m_handlers.dispatch(Call(payload));} ///< Call every Handler with 'payload' in the order added
+
+    void clear() {m_handlers.clear();} ///< Remove every Handler
+
+  private:
+    class Call {
+    public:
+      Call(const PAYLOAD &payload_) : payload(payload_) {}
+
+      void operator()(Handler &handler) const {handler(payload);}
+
+    private:
+      const PAYLOAD &payload;
+    };
+
+    Handler_List<Handler> m_handlers;
+  };
+
+}
+
+#endif
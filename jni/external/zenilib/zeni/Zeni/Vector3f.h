@@ -31,6 +31,23 @@
  * Contact: bazald@zenipex.com
  */
 
+/**
+ * \class Zeni::Vector3f_Packed
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Padding-Free 3-Space Vector for Bulk Storage
+ *
+ * Vector3f carries a degenerate flag which pads it to 16 bytes.  
+ * Vector3f_Packed stores only the three components, so large arrays of 
+ * normals or offsets stay dense and can be handed directly to vertex buffers 
+ * and bulk transforms.  Convert to a Vector3f for arithmetic.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
 #ifndef ZENI_VECTOR3F_H
 #define ZENI_VECTOR3F_H
 
@@ -41,6 +58,7 @@ namespace Zeni {
   struct Point3f;
   struct Vector2f;
   struct Vector3f;
+  struct Vector3f_Packed;
 
   namespace Global {
     ZENI_DLL extern const float pi; ///< pi == 3.1415926...
@@ -123,6 +141,27 @@ namespace Zeni {
     bool degenerate;
   };
 
+  struct ZENI_DLL Vector3f_Packed {
+    inline Vector3f_Packed();
+    inline Vector3f_Packed(const float &i_, const float &j_, const float &k_);
+    inline Vector3f_Packed(const Vector3f &rhs);
+
+    inline operator Vector3f() const; ///< Get the equivalent Vector3f
+
+    union {
+      float i;
+      float x;
+    };
+    union {
+      float j;
+      float y;
+    };
+    union {
+      float k;
+      float z;
+    };
+  };
+
   // Vector Scalar Multiplication Part II of II
   inline Vector3f operator*(const float &lhs, const Vector3f &rhs); ///< Get the scalar multiple
 
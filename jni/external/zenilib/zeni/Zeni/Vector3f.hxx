@@ -195,6 +195,25 @@ namespace Zeni {
     return ptr[index];
   }
 
+  Vector3f_Packed::Vector3f_Packed()
+    : i(0.0f), j(0.0f), k(0.0f)
+  {
+  }
+
+  Vector3f_Packed::Vector3f_Packed(const float &i_, const float &j_, const float &k_)
+    : i(i_), j(j_), k(k_)
+  {
+  }
+
+  Vector3f_Packed::Vector3f_Packed(const Vector3f &rhs)
+    : i(rhs.i), j(rhs.j), k(rhs.k)
+  {
+  }
+
+  Vector3f_Packed::operator Vector3f() const {
+    return Vector3f(i, j, k);
+  }
+
 }
 
 #include <Zeni/Coordinate.hxx>
@@ -18,10 +18,10 @@ project "zeni"
 
   configuration "*"
     flags { "ExtraWarnings" }
-    includedirs { ".", "../../sdl_net", "../../sdl", "../../tinyxml" }
+    includedirs { ".", "../../sdl_net", "../../sdl", "../../tinyxml", "../../zlib" }
 
 --     pchheader "jni/external/zenilib/zeni/zeni.h"
 --     pchsource "jni/external/zenilib/zeni/String.cpp"
 
     files { "**.h", "**.hxx", "**.cpp" }
-    links { "local_tinyxml" }
+    links { "local_tinyxml", "local_z" }
@@ -17,12 +17,17 @@
 
 #include <zeni.h>
 
+#include "Zeni/Archive.cpp"
 #include "Zeni/Camera.cpp"
 #include "Zeni/Collision.cpp"
+#include "Zeni/Collision_World.cpp"
+#include "Zeni/Collision_Batch.cpp"
+#include "Zeni/Collision_Sweep.cpp"
 #include "Zeni/Color.cpp"
 #include "Zeni/Colors.cpp"
 #include "Zeni/Coordinate.cpp"
 #include "Zeni/File_Ops.cpp"
+#include "Zeni/Frustum.cpp"
 #include "Zeni/Matrix4f.cpp"
 #include "Zeni/Quaternion.cpp"
 #include "Zeni/Quit_Event.cpp"
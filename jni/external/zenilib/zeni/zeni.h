@@ -43,14 +43,19 @@
 #endif
 
 #include <Zeni/Android.h>
+#include <Zeni/Archive.h>
 #include <Zeni/Camera.h>
 #include <Zeni/Chronometer.h>
 #include <Zeni/Collision.h>
+#include <Zeni/Collision_World.h>
+#include <Zeni/Collision_Batch.h>
+#include <Zeni/Collision_Sweep.h>
 #include <Zeni/Color.h>
 #include <Zeni/Colors.h>
 #include <Zeni/Coordinate.h>
 #include <Zeni/Database.h>
 #include <Zeni/File_Ops.h>
+#include <Zeni/Frustum.h>
 #include <Zeni/Hash_Map.h>
 #include <Zeni/Matrix4f.h>
 #include <Zeni/Quaternion.h>
@@ -58,13 +63,17 @@
 #include <Zeni/Random.h>
 #include <Zeni/Resource.h>
 #include <Zeni/Serialization.h>
+#include <Zeni/Signal.h>
 #include <Zeni/String.h>
 #include <Zeni/Timer_HQ.h>
 #include <Zeni/Vector3f.h>
 #include <Zeni/XML.h>
 
+#include <Zeni/Archive.hxx>
 #include <Zeni/Camera.hxx>
 #include <Zeni/Collision.hxx>
+#include <Zeni/Collision_World.hxx>
+#include <Zeni/Collision_Batch.hxx>
 #include <Zeni/Color.hxx>
 #include <Zeni/Coordinate.hxx>
 #include <Zeni/Matrix4f.hxx>
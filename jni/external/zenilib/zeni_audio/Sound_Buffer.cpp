@@ -120,7 +120,7 @@ namespace Zeni {
     /*** Open VorbisFile ***/
 
     OggVorbis_File oggFile;
-    if(ov_fopen(const_cast<char *>((filename + ".ogg").c_str()), &oggFile))
+    if(Sound_Renderer_AL::ov_open_asset(filename + ".ogg", oggFile))
       return std::make_pair(AL_NONE, 0.0f);
 
     /*** Get Information About the Audio File ***/
@@ -154,6 +154,8 @@ namespace Zeni {
       }
     }
 
+    ov_clear(&oggFile);
+
     /*** Generate Audio Buffer ***/
 
     ALuint bufferID = AL_NONE;
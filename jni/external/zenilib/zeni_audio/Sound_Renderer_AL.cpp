@@ -47,6 +47,23 @@ namespace Zeni {
   }
 #endif
 
+  static size_t archive_read(void *ptr, size_t size, size_t nmemb, void *datasource) {
+    return size ? static_cast<Archive_Reader *>(datasource)->read(ptr, size * nmemb) / size : 0u;
+  }
+
+  static int archive_seek(void *datasource, ogg_int64_t offset, int whence) {
+    return static_cast<Archive_Reader *>(datasource)->seek(long(offset), whence) ? 0 : -1;
+  }
+
+  static int archive_close(void *datasource) {
+    delete static_cast<Archive_Reader *>(datasource);
+    return 0;
+  }
+
+  static long archive_tell(void *datasource) {
+    return static_cast<Archive_Reader *>(datasource)->tell();
+  }
+
   Sound_Renderer_AL::Sound_Renderer_AL()
     : m_device(0),
     m_context(0),
@@ -218,6 +235,22 @@ namespace Zeni {
       return "OpenAL not initialized";
   }
 
+  int Sound_Renderer_AL::ov_open_asset(const String &filename, OggVorbis_File &vf) {
+    const Archive * const archive = File_Ops::find_Archive(filename);
+    if(!archive)
+      return ov_fopen(const_cast<char *>(filename.c_str()), &vf);
+
+    const ov_callbacks callbacks = {archive_read, archive_seek, archive_close, archive_tell};
+
+    /// The Archive_Reader is deleted by ov_clear, or here on failure
+    Archive_Reader * const reader = new Archive_Reader(*archive, filename);
+    const int result = ov_open_callbacks(reader, &vf, 0, 0, callbacks);
+    if(result)
+      delete reader;
+
+    return result;
+  }
+
   void Sound_Renderer_AL::set_listener_position(const Point3f &position) {
     ALfloat listener_position[3] = {position.x, position.y, position.z};
     alListenerfv()(AL_POSITION, listener_position);
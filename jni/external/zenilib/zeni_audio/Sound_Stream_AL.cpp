@@ -15,7 +15,7 @@ namespace Zeni {
     if(!dynamic_cast<Sound_Renderer_AL *>(&get_Sound().get_Renderer()))
       throw Sound_Stream_Init_Failure();
 
-    const int result = ov_fopen((path + ".ogg").c_str(), &oggStream);
+    const int result = Sound_Renderer_AL::ov_open_asset(path + ".ogg", oggStream);
     if(result < 0)
       throw Sound_Stream_Ogg_Read_Failure();
 
@@ -109,6 +109,8 @@ namespace Zeni {
     static String errorString(const ALenum &err);
     static String errorString();
 
+    static int ov_open_asset(const String &filename, OggVorbis_File &vf); ///< Open an Ogg Vorbis file from a mounted Archive if possible, or else from disk; Returns as ov_fopen
+
     // Listener Functions
     void set_listener_position(const Point3f &position); ///< Set the position of the listener and BGM.
     void set_listener_velocity(const Vector3f &velocity); ///< Set the velocity of the listener and BGM for the doppler effect.
@@ -0,0 +1,385 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+#include <Zeni/Singleton.hxx>
+
+namespace Zeni {
+
+  struct Job_Record {
+    Job_Record() : job(0), parent(0), generation(0u), unfinished(0u), prerequisites(0u), submitted(false) {}
+
+    Job * job; ///< 0 for a Job that only gathers children
+    Job_Record * parent;
+    unsigned long generation; ///< Incremented on completion, invalidating outstanding Job_Handles
+    size_t unfinished; ///< 1 for the Job itself plus 1 for each incomplete child
+    size_t prerequisites; ///< Incomplete prerequisites
+    bool submitted;
+    std::vector<Job_Record *> dependents;
+  };
+
+  class Job_System::Queue {
+  public:
+    Mutex mutex;
+    std::deque<Job_Record *> records;
+  };
+
+  class Job_System::Worker : public Task {
+  public:
+    Worker(Job_System &job_system_, const size_t &queue_) : job_system(job_system_), queue(queue_) {}
+
+    int function() {
+      job_system.work(queue);
+      return 0;
+    }
+
+  private:
+    Job_System &job_system;
+    size_t queue;
+  };
+
+  class Span_Job : public Job {
+  public:
+    Span_Job() : function_(0), begin(0), end(0) {}
+
+    void function() {
+      (*function_)(begin, end);
+    }
+
+    const Span_Function * function_;
+    size_t begin;
+    size_t end;
+  };
+
+  template class Singleton<Job_System>;
+
+  Job_System * Job_System::create() {
+    return new Job_System;
+  }
+
+  Job_System::Job_System()
+    : m_num_workers(0u),
+    m_num_started(0u),
+    m_num_sleeping(0u),
+    m_single_threaded(false),
+    m_ready(false),
+    m_quit(false)
+  {
+    const size_t cores = Thread::get_num_cores();
+    const size_t workers = cores - 1u;
+
+    /// Every Queue exists before any worker starts
+    for(size_t i = 0; i != workers + 1u; ++i)
+      m_queues.push_back(new Queue);
+    m_worker_ids.resize(workers, 0u);
+
+    size_t started = 0u;
+    try {
+      for(; started != workers; ++started) {
+        m_workers.push_back(new Worker(*this, started));
+        m_threads.push_back(new Thread(*m_workers.back()));
+      }
+    }
+    catch(Thread_Init_Failure &) {
+      /// Run with however many workers could be started, possibly none
+    }
+
+    /// Workers wait for the final count before reading it, then record their ids so get_current_queue can find them
+    Mutex::Lock lock(m_mutex);
+    m_num_workers = started;
+    m_ready = true;
+    m_cv.broadcast();
+    while(m_num_started != m_num_workers)
+      m_cv.wait(lock);
+  }
+
+  Job_System::~Job_System() {
+    {
+      Mutex::Lock lock(m_mutex);
+      m_quit = true;
+      m_cv.broadcast();
+    }
+
+    for(std::vector<Thread *>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+      delete *it;
+    for(std::vector<Worker *>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+      delete *it;
+    for(std::vector<Queue *>::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
+      delete *it;
+    for(std::vector<Job_Record *>::iterator it = m_records.begin(); it != m_records.end(); ++it)
+      delete *it;
+  }
+
+  Job_Handle Job_System::prepare(Job &job, const Job_Handle &parent) {
+    return prepare_record(&job, parent);
+  }
+
+  void Job_System::depend(const Job_Handle &job, const Job_Handle &prerequisite) {
+    Mutex::Lock lock(m_mutex);
+
+    assert(job.m_record && job.m_record->generation == job.m_generation && !job.m_record->submitted);
+
+    Job_Record * const record = prerequisite.m_record;
+    if(record && record->generation == prerequisite.m_generation) {
+      record->dependents.push_back(job.m_record);
+      ++job.m_record->prerequisites;
+    }
+  }
+
+  void Job_System::submit(const Job_Handle &job) {
+    {
+      Mutex::Lock lock(m_mutex);
+
+      assert(job.m_record && job.m_record->generation == job.m_generation && !job.m_record->submitted);
+
+      job.m_record->submitted = true;
+      if(job.m_record->prerequisites)
+        return;
+    }
+
+    push(job.m_record);
+  }
+
+  Job_Handle Job_System::run(Job &job, const Job_Handle &parent) {
+    const Job_Handle handle = prepare_record(&job, parent);
+    submit(handle);
+    return handle;
+  }
+
+  bool Job_System::is_complete(const Job_Handle &job) const {
+    Mutex::Lock lock(m_mutex);
+    return !job.m_record || job.m_record->generation != job.m_generation;
+  }
+
+  void Job_System::wait(const Job_Handle &job) {
+    const size_t queue = get_current_queue();
+
+    while(!is_complete(job)) {
+      if(Job_Record * const record = pop(queue)) {
+        execute(record);
+        continue;
+      }
+
+      Mutex::Lock lock(m_mutex);
+      ++m_num_sleeping;
+      while(job.m_record->generation == job.m_generation && !is_queued(queue))
+        m_cv.wait(lock);
+      --m_num_sleeping;
+    }
+  }
+
+  void Job_System::parallel_for(const Span_Function &function, const size_t &count, const size_t &grain) {
+    const size_t spans = std::min(count / std::max(grain, size_t(1u)), 4u * (m_num_workers + 1u));
+    if(spans < 2u || m_single_threaded) {
+      function(0u, count);
+      return;
+    }
+
+    std::vector<Span_Job> jobs(spans);
+    const Job_Handle root = prepare_record(0, Job_Handle());
+
+    for(size_t i = 0; i != spans; ++i) {
+      jobs[i].function_ = &function;
+      jobs[i].begin = count * i / spans;
+      jobs[i].end = count * (i + 1) / spans;
+      run(jobs[i], root);
+    }
+
+    finish(root.m_record);
+    wait(root);
+  }
+
+  void Job_System::set_single_threaded(const bool &single_threaded) {
+    Mutex::Lock lock(m_mutex);
+    m_single_threaded = single_threaded;
+    m_cv.broadcast();
+  }
+
+  Job_Handle Job_System::prepare_record(Job * const &job, const Job_Handle &parent) {
+    Mutex::Lock lock(m_mutex);
+
+    Job_Record * record;
+    if(m_free_records.empty()) {
+      record = new Job_Record;
+      m_records.push_back(record);
+    }
+    else {
+      record = m_free_records.back();
+      m_free_records.pop_back();
+    }
+
+    record->job = job;
+    record->unfinished = 1u;
+    record->prerequisites = 0u;
+    record->submitted = false;
+
+    if(parent.m_record && parent.m_record->generation == parent.m_generation) {
+      record->parent = parent.m_record;
+      ++parent.m_record->unfinished;
+    }
+    else
+      record->parent = 0;
+
+    return Job_Handle(record, record->generation);
+  }
+
+  void Job_System::push(Job_Record * const &record) {
+    Queue &queue = *m_queues[m_single_threaded ? m_num_workers : get_current_queue()];
+
+    {
+      Mutex::Lock lock(queue.mutex);
+      queue.records.push_back(record);
+    }
+
+    Mutex::Lock lock(m_mutex);
+    if(m_num_sleeping)
+      m_cv.broadcast();
+  }
+
+  Job_Record * Job_System::pop(const size_t &queue) {
+    /// Newest first from this Thread's own queue, for locality
+    if(queue != m_num_workers && !m_single_threaded) {
+      Queue &own = *m_queues[queue];
+      Mutex::Lock lock(own.mutex);
+      if(!own.records.empty()) {
+        Job_Record * const record = own.records.back();
+        own.records.pop_back();
+        return record;
+      }
+    }
+
+    /// Oldest first from every other queue, starting with the one shared by non-worker Threads
+    const size_t num_queues = m_single_threaded ? 1u : m_num_workers + 1u;
+    for(size_t i = 0; i != num_queues; ++i) {
+      Queue &other = *m_queues[m_num_workers - i];
+      Mutex::Lock lock(other.mutex);
+      if(!other.records.empty()) {
+        Job_Record * const record = other.records.front();
+        other.records.pop_front();
+        return record;
+      }
+    }
+
+    return 0;
+  }
+
+  bool Job_System::is_queued(const size_t &queue) {
+    if(m_single_threaded && queue != m_num_workers)
+      return false;
+
+    const size_t num_queues = m_single_threaded ? 1u : m_num_workers + 1u;
+    for(size_t i = 0; i != num_queues; ++i) {
+      Queue &other = *m_queues[m_num_workers - i];
+      Mutex::Lock lock(other.mutex);
+      if(!other.records.empty())
+        return true;
+    }
+
+    return false;
+  }
+
+  void Job_System::execute(Job_Record * const &record) {
+    if(record->job)
+      record->job->function();
+
+    finish(record);
+  }
+
+  void Job_System::finish(Job_Record * const &record) {
+    std::vector<Job_Record *> ready;
+
+    {
+      Mutex::Lock lock(m_mutex);
+
+      for(Job_Record * complete = record; complete && !--complete->unfinished; ) {
+        for(std::vector<Job_Record *>::iterator it = complete->dependents.begin(); it != complete->dependents.end(); ++it) {
+          if(!--(*it)->prerequisites && (*it)->submitted)
+            ready.push_back(*it);
+        }
+        complete->dependents.clear();
+
+        Job_Record * const parent = complete->parent;
+
+        ++complete->generation;
+        m_free_records.push_back(complete);
+
+        complete = parent;
+      }
+
+      if(m_num_sleeping)
+        m_cv.broadcast();
+    }
+
+    for(std::vector<Job_Record *>::iterator it = ready.begin(); it != ready.end(); ++it)
+      push(*it);
+  }
+
+  size_t Job_System::get_current_queue() const {
+    const unsigned long id = Thread::get_current_id();
+
+    for(size_t i = 0; i != m_num_workers; ++i) {
+      if(m_worker_ids[i] == id)
+        return i;
+    }
+
+    return m_num_workers;
+  }
+
+  void Job_System::work(const size_t &queue) {
+    {
+      Mutex::Lock lock(m_mutex);
+      while(!m_ready)
+        m_cv.wait(lock);
+      m_worker_ids[queue] = Thread::get_current_id();
+      ++m_num_started;
+      m_cv.broadcast();
+    }
+
+    for(;;) {
+      if(!m_single_threaded) {
+        if(Job_Record * const record = pop(queue)) {
+          execute(record);
+          continue;
+        }
+      }
+
+      Mutex::Lock lock(m_mutex);
+      if(m_quit)
+        break;
+
+      ++m_num_sleeping;
+      while(!m_quit && (m_single_threaded || !is_queued(queue)))
+        m_cv.wait(lock);
+      --m_num_sleeping;
+    }
+  }
+
+  Job_System & get_Job_System() {
+    return Job_System::get();
+  }
+
+}
@@ -0,0 +1,189 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_core.h>
+
+#ifdef ANDROID
+#include <unistd.h>
+#else
+#include <SDL/SDL.h>
+#endif
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  Mutex::Mutex() {
+#ifdef ANDROID
+    if(pthread_mutex_init(&m_mutex, 0))
+      throw Thread_Init_Failure();
+#else
+    m_mutex = SDL_CreateMutex();
+    if(!m_mutex)
+      throw Thread_Init_Failure();
+#endif
+  }
+
+  Mutex::~Mutex() {
+#ifdef ANDROID
+    pthread_mutex_destroy(&m_mutex);
+#else
+    SDL_DestroyMutex(m_mutex);
+#endif
+  }
+
+  void Mutex::lock() {
+#ifdef ANDROID
+    pthread_mutex_lock(&m_mutex);
+#else
+    SDL_LockMutex(m_mutex);
+#endif
+  }
+
+  void Mutex::unlock() {
+#ifdef ANDROID
+    pthread_mutex_unlock(&m_mutex);
+#else
+    SDL_UnlockMutex(m_mutex);
+#endif
+  }
+
+  Mutex::Lock::Lock(Mutex &mutex)
+    : m_mutex(mutex)
+  {
+    m_mutex.lock();
+  }
+
+  Mutex::Lock::~Lock() {
+    m_mutex.unlock();
+  }
+
+  Condition_Variable::Condition_Variable() {
+#ifdef ANDROID
+    if(pthread_cond_init(&m_cond, 0))
+      throw Thread_Init_Failure();
+#else
+    m_cond = SDL_CreateCond();
+    if(!m_cond)
+      throw Thread_Init_Failure();
+#endif
+  }
+
+  Condition_Variable::~Condition_Variable() {
+#ifdef ANDROID
+    pthread_cond_destroy(&m_cond);
+#else
+    SDL_DestroyCond(m_cond);
+#endif
+  }
+
+  void Condition_Variable::wait(Mutex::Lock &lock) {
+#ifdef ANDROID
+    pthread_cond_wait(&m_cond, &lock.m_mutex.m_mutex);
+#else
+    SDL_CondWait(m_cond, lock.m_mutex.m_mutex);
+#endif
+  }
+
+  void Condition_Variable::signal() {
+#ifdef ANDROID
+    pthread_cond_signal(&m_cond);
+#else
+    SDL_CondSignal(m_cond);
+#endif
+  }
+
+  void Condition_Variable::broadcast() {
+#ifdef ANDROID
+    pthread_cond_broadcast(&m_cond);
+#else
+    SDL_CondBroadcast(m_cond);
+#endif
+  }
+
+  Thread::Thread(Task &task)
+    : m_running(true),
+    m_status(0)
+  {
+#ifdef ANDROID
+    if(pthread_create(&m_thread, 0, &Thread::run, &task))
+      throw Thread_Init_Failure();
+#else
+    m_thread = SDL_CreateThread(&Thread::run, "Zeni::Thread", &task);
+    if(!m_thread)
+      throw Thread_Init_Failure();
+#endif
+  }
+
+  Thread::~Thread() {
+    wait();
+  }
+
+  int Thread::wait() {
+    if(m_running) {
+#ifdef ANDROID
+      void * status = 0;
+      pthread_join(m_thread, &status);
+      m_status = int(reinterpret_cast<size_t>(status));
+#else
+      SDL_WaitThread(m_thread, &m_status);
+#endif
+      m_running = false;
+    }
+
+    return m_status;
+  }
+
+  size_t Thread::get_num_cores() {
+#ifdef ANDROID
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    const int cores = SDL_GetCPUCount();
+#endif
+
+    return cores > 0 ? size_t(cores) : 1u;
+  }
+
+  unsigned long Thread::get_current_id() {
+#ifdef ANDROID
+    return (unsigned long)(pthread_self());
+#else
+    return (unsigned long)(SDL_ThreadID());
+#endif
+  }
+
+  void for_each_span(const Span_Function &function, const size_t &count, const size_t &min_parallel) {
+    if(count < 2u || count < min_parallel)
+      function(0u, count);
+    else
+      get_Job_System().parallel_for(function, count);
+  }
+
+#ifdef ANDROID
+  void * Thread::run(void * task) {
+    return reinterpret_cast<void *>(size_t(reinterpret_cast<Task *>(task)->function()));
+  }
+#else
+  int Thread::run(void * task) {
+    return reinterpret_cast<Task *>(task)->function();
+  }
+#endif
+
+}
@@ -0,0 +1,183 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Job
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Function to be Run by the Job_System
+ *
+ * \note A Job must not throw, and it must outlive its completion.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Job_Handle
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Reference to a Job Submitted to the Job_System
+ *
+ * A Job_Handle is cheap to copy and remains safe to use after its Job has
+ * completed.  A default constructed Job_Handle refers to no Job and is
+ * always complete.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Job_System
+ *
+ * \ingroup zenilib
+ *
+ * \brief The Job_System Singleton
+ *
+ * The Job_System runs Jobs on a pool of worker Threads, one fewer than the
+ * number of cores, since a Thread waiting on a Job runs queued Jobs itself
+ * rather than sleeping.  Each worker keeps its own queue, running the Jobs
+ * it submitted most recently first and stealing the oldest Jobs from other
+ * queues when its own is empty.
+ *
+ * A Job may be given a parent, which does not complete until all of its
+ * children have, and prerequisites, which must complete before it may
+ * begin.  Prerequisites must be added between prepare and submit.
+ *
+ * In single threaded mode, workers sit idle and Jobs run on the waiting
+ * Thread in the order in which they became ready, which makes runs
+ * reproducible for debugging.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_JOB_SYSTEM_H
+#define ZENI_JOB_SYSTEM_H
+
+#include <Zeni/Singleton.h>
+#include <Zeni/Thread.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  class ZENI_CORE_DLL Job {
+  public:
+    virtual ~Job() {}
+
+    virtual void function() = 0; ///< The work to be done
+  };
+
+  struct Job_Record;
+
+  class ZENI_CORE_DLL Job_Handle {
+    friend class Job_System;
+
+  public:
+    Job_Handle() : m_record(0), m_generation(0u) {} ///< Refer to no Job
+
+  private:
+    Job_Handle(Job_Record * const &record, const unsigned long &generation) : m_record(record), m_generation(generation) {}
+
+    Job_Record * m_record;
+    unsigned long m_generation;
+  };
+
+  class ZENI_CORE_DLL Job_System;
+
+#ifdef _WINDOWS
+  ZENI_CORE_EXT template class ZENI_CORE_DLL Singleton<Job_System>;
+#endif
+
+  class ZENI_CORE_DLL Job_System : public Singleton<Job_System> {
+    friend class Singleton<Job_System>;
+
+    static Job_System * create();
+
+    Job_System();
+    ~Job_System();
+
+    // Undefined
+    Job_System(const Job_System &);
+    Job_System & operator=(const Job_System &);
+
+  public:
+    Job_Handle prepare(Job &job, const Job_Handle &parent = Job_Handle()); ///< Create a Job without running it; 'parent' will not complete until it does
+    void depend(const Job_Handle &job, const Job_Handle &prerequisite); ///< Prevent a prepared Job from beginning until 'prerequisite' completes
+    void submit(const Job_Handle &job); ///< Queue a prepared Job to run as soon as its prerequisites complete
+    Job_Handle run(Job &job, const Job_Handle &parent = Job_Handle()); ///< Prepare and submit a Job
+
+    bool is_complete(const Job_Handle &job) const; ///< Check to see if a Job and all of its children have completed
+    void wait(const Job_Handle &job); ///< Run queued Jobs until 'job' and all of its children have completed
+
+    /// Split [0, count) into spans of at least 'grain' elements and run them as Jobs, returning once all are complete
+    void parallel_for(const Span_Function &function, const size_t &count, const size_t &grain = 1u);
+
+    inline size_t get_num_workers() const; ///< Get the number of worker Threads, not counting Threads waiting on Jobs
+
+    void set_single_threaded(const bool &single_threaded); ///< Run Jobs only on waiting Threads; Call only when no Jobs are pending
+    inline bool is_single_threaded() const; ///< Check to see if Jobs run only on waiting Threads
+
+  private:
+    class Queue;
+    class Worker;
+
+    Job_Handle prepare_record(Job * const &job, const Job_Handle &parent);
+    void push(Job_Record * const &record);
+    Job_Record * pop(const size_t &queue);
+    bool is_queued(const size_t &queue);
+    void execute(Job_Record * const &record);
+    void finish(Job_Record * const &record);
+    size_t get_current_queue() const;
+    void work(const size_t &queue);
+
+    mutable Mutex m_mutex;
+    Condition_Variable m_cv;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Queue *> m_queues; ///< One per worker, then one for all other Threads
+    std::vector<unsigned long> m_worker_ids;
+    std::vector<Worker *> m_workers;
+    std::vector<Thread *> m_threads;
+    std::vector<Job_Record *> m_records; ///< Never freed before destruction, so Job_Handles remain safe to check
+    std::vector<Job_Record *> m_free_records;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+
+    size_t m_num_workers;
+    size_t m_num_started;
+    size_t m_num_sleeping;
+    bool m_single_threaded;
+    bool m_ready; ///< Set once m_num_workers is final; Workers wait for it
+    bool m_quit;
+  };
+
+  ZENI_CORE_DLL Job_System & get_Job_System(); ///< Get access to the singleton.
+
+}
+
+#endif
@@ -0,0 +1,35 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_JOB_SYSTEM_HXX
+#define ZENI_JOB_SYSTEM_HXX
+
+#include <Zeni/Job_System.h>
+
+namespace Zeni {
+
+  size_t Job_System::get_num_workers() const {
+    return m_num_workers;
+  }
+
+  bool Job_System::is_single_threaded() const {
+    return m_single_threaded;
+  }
+
+}
+
+#endif
@@ -0,0 +1,213 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Mutex
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Mutual Exclusion Lock
+ *
+ * Prefer Mutex::Lock to calling lock() and unlock() directly.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Condition_Variable
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Condition Variable for Use with a Mutex::Lock
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Task
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Function to be Run by a Thread
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Thread
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Thread of Execution
+ *
+ * A Thread begins running its Task immediately.  Destroying a Thread waits
+ * for the Task to finish.
+ *
+ * \note The Task must outlive the Thread.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+/**
+ * \class Zeni::Span_Function
+ *
+ * \ingroup zenilib
+ *
+ * \brief Work on a Span of Independent Elements
+ *
+ * Pass one to for_each_span or Job_System::parallel_for to split a large, evenly divisible workload 
+ * across the available cores.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_THREAD_H
+#define ZENI_THREAD_H
+
+#include <Zeni/Error.h>
+
+#ifdef ANDROID
+#include <pthread.h>
+#else
+struct SDL_mutex;
+struct SDL_cond;
+struct SDL_Thread;
+#endif
+
+namespace Zeni {
+
+  class ZENI_CORE_DLL Mutex {
+    friend class Condition_Variable;
+
+    // Undefined
+    Mutex(const Mutex &);
+    Mutex & operator=(const Mutex &);
+
+  public:
+    Mutex();
+    ~Mutex();
+
+    void lock(); ///< Block until the Mutex can be acquired
+    void unlock(); ///< Release the Mutex
+
+    class ZENI_CORE_DLL Lock {
+      friend class Condition_Variable;
+
+      // Undefined
+      Lock(const Lock &);
+      Lock & operator=(const Lock &);
+
+    public:
+      Lock(Mutex &mutex); ///< Acquire the Mutex
+      ~Lock(); ///< Release the Mutex
+
+    private:
+      Mutex &m_mutex;
+    };
+
+  private:
+#ifdef ANDROID
+    pthread_mutex_t m_mutex;
+#else
+    SDL_mutex *m_mutex;
+#endif
+  };
+
+  class ZENI_CORE_DLL Condition_Variable {
+    // Undefined
+    Condition_Variable(const Condition_Variable &);
+    Condition_Variable & operator=(const Condition_Variable &);
+
+  public:
+    Condition_Variable();
+    ~Condition_Variable();
+
+    void wait(Mutex::Lock &lock); ///< Atomically release the Mutex and sleep until signaled, then reacquire it
+    void signal(); ///< Wake one waiting Thread
+    void broadcast(); ///< Wake all waiting Threads
+
+  private:
+#ifdef ANDROID
+    pthread_cond_t m_cond;
+#else
+    SDL_cond *m_cond;
+#endif
+  };
+
+  class ZENI_CORE_DLL Task {
+  public:
+    virtual ~Task() {}
+
+    virtual int function() = 0; ///< The work to be done; The return value is passed to Thread::wait
+  };
+
+  class ZENI_CORE_DLL Thread {
+    // Undefined
+    Thread(const Thread &);
+    Thread & operator=(const Thread &);
+
+  public:
+    Thread(Task &task); ///< Begin running task->function() in a new Thread
+    ~Thread(); ///< Wait for the Task to finish
+
+    int wait(); ///< Wait for the Task to finish and get its return value
+
+    static size_t get_num_cores(); ///< Get the number of processor cores available
+    static unsigned long get_current_id(); ///< Get an identifier unique to the calling Thread
+
+  private:
+#ifdef ANDROID
+    static void * run(void * task);
+
+    pthread_t m_thread;
+#else
+    static int run(void * task);
+
+    SDL_Thread *m_thread;
+#endif
+
+    bool m_running;
+    int m_status;
+  };
+
+  class ZENI_CORE_DLL Span_Function {
+  public:
+    virtual ~Span_Function() {}
+
+    virtual void operator()(const size_t &begin, const size_t &end) const = 0; ///< Work on elements [begin, end)
+  };
+
+  /// Split [0, count) into spans and run them in parallel on the Job_System, unless count < min_parallel
+  ZENI_CORE_DLL void for_each_span(const Span_Function &function, const size_t &count, const size_t &min_parallel);
+
+  struct ZENI_CORE_DLL Thread_Init_Failure : public Error {
+    Thread_Init_Failure() : Error("Zeni Thread Failed to Initialize Correctly") {}
+  };
+
+}
+
+#endif
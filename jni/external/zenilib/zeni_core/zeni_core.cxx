@@ -18,5 +18,7 @@
 #include <zeni_core.h>
 
 #include "Zeni/Core.cpp"
+#include "Zeni/Job_System.cpp"
 #include "Zeni/Joysticks.cpp"
+#include "Zeni/Thread.cpp"
 #include "Zeni/Timer.cpp"
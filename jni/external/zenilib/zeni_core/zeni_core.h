@@ -29,8 +29,11 @@
 
 #include <Zeni/Core.h>
 #include <Zeni/Controllers.h>
+#include <Zeni/Job_System.h>
+#include <Zeni/Thread.h>
 #include <Zeni/Timer.h>
 
+#include <Zeni/Job_System.hxx>
 #include <Zeni/Timer.hxx>
 
 #endif
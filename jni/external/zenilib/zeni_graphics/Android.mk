@@ -8,18 +8,27 @@ LOCAL_C_INCLUDES += . $(LOCAL_PATH)/../zeni_core $(LOCAL_PATH)/../zeni $(LOCAL_P
 #LOCAL_CPP_EXTENSION := .cxx
 #LOCAL_SRC_FILES := src/zeni_graphics.cxx
 LOCAL_SRC_FILES := \
+  Command_List.cpp \
   EZ2D.cpp \
   Fog.cpp \
   Font.cpp \
   Fonts.cpp \
   Image.cpp \
+  Image_Cache.cpp \
   Light.cpp \
+  Light_Clusters.cpp \
   Material.cpp \
   Model.cpp \
+  Particle_System.cpp \
+  Primitive_Batch.cpp \
+  Program_Cache.cpp \
   Projector.cpp \
   Renderable.cpp \
   Shader.cpp \
+  Sprite_Animation.cpp \
   Texture.cpp \
+  Texture_Atlas.cpp \
+  Texture_Loader.cpp \
   Textures.cpp \
   Vertex2f.cpp \
   Vertex3f.cpp \
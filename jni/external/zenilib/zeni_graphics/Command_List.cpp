@@ -0,0 +1,300 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <zeni_graphics.h>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  namespace {
+
+    /// A Command making a call with no arguments
+    class Call : public Command_List::Command {
+    public:
+      Call(void (Video::*function_)()) : function(function_) {}
+
+      void execute(Video &video) const {(video.*function)();}
+
+    private:
+      void (Video::*function)();
+    };
+
+    /// A Command making a call with one argument, stored by value
+    template <typename ARGUMENT>
+    class Call_1 : public Command_List::Command {
+    public:
+      Call_1(void (Video::*function_)(const ARGUMENT &), const ARGUMENT &argument_) : function(function_), argument(argument_) {}
+
+      void execute(Video &video) const {(video.*function)(argument);}
+
+    private:
+      void (Video::*function)(const ARGUMENT &);
+      ARGUMENT argument;
+    };
+
+    class Set_2d : public Command_List::Command {
+    public:
+      Set_2d(const std::pair<Point2f, Point2f> &camera2d_, const bool &fix_aspect_ratio_) : camera2d(camera2d_), fix_aspect_ratio(fix_aspect_ratio_) {}
+
+      void execute(Video &video) const {video.set_2d(camera2d, fix_aspect_ratio);}
+
+    private:
+      std::pair<Point2f, Point2f> camera2d;
+      bool fix_aspect_ratio;
+    };
+
+    class Set_3d : public Command_List::Command {
+    public:
+      Set_3d(const Camera &camera_) : camera(camera_) {}
+
+      void execute(Video &video) const {video.set_3d(camera);}
+
+    private:
+      Camera camera;
+    };
+
+    class Set_Alpha_Test : public Command_List::Command {
+    public:
+      Set_Alpha_Test(const bool &enabled_, const Video::TEST &test_, const float &value_) : enabled(enabled_), test(test_), value(value_) {}
+
+      void execute(Video &video) const {video.set_alpha_test(enabled, test, value);}
+
+    private:
+      bool enabled;
+      Video::TEST test;
+      float value;
+    };
+
+    class Apply_Texture_Name : public Command_List::Command {
+    public:
+      Apply_Texture_Name(const String &name_) : name(name_) {}
+
+      void execute(Video &video) const {video.apply_Texture(name);}
+
+    private:
+      String name;
+    };
+
+    class Apply_Texture : public Command_List::Command {
+    public:
+      Apply_Texture(const Texture &texture_) : texture(&texture_) {}
+
+      void execute(Video &video) const {video.apply_Texture(*texture);}
+
+    private:
+      const Texture * texture;
+    };
+
+    class Set_Light : public Command_List::Command {
+    public:
+      Set_Light(const int &number_, const Light &light_) : number(number_), light(light_) {}
+
+      void execute(Video &video) const {video.set_Light(number, light);}
+
+    private:
+      int number;
+      Light light;
+    };
+
+    class Set_Program : public Command_List::Command {
+    public:
+      Set_Program(Program &program_) : program(&program_) {}
+
+      void execute(Video &video) const {video.set_program(*program);}
+
+    private:
+      Program * program;
+    };
+
+    class Rotate_Scene : public Command_List::Command {
+    public:
+      Rotate_Scene(const Vector3f &about_, const float &radians_) : about(about_), radians(radians_) {}
+
+      void execute(Video &video) const {video.rotate_scene(about, radians);}
+
+    private:
+      Vector3f about;
+      float radians;
+    };
+
+    class Render_Reference : public Command_List::Command {
+    public:
+      Render_Reference(const Renderable &renderable_) : renderable(&renderable_) {}
+
+      void execute(Video &video) const {video.render(*renderable);}
+
+    private:
+      const Renderable * renderable;
+    };
+
+  }
+
+  Command_List::Command_List() {
+  }
+
+  Command_List::~Command_List() {
+    clear();
+  }
+
+  void Command_List::execute(Video &video) const {
+    for(std::vector<Command *>::const_iterator it = m_commands.begin(); it != m_commands.end(); ++it)
+      (*it)->execute(video);
+  }
+
+  void Command_List::clear() {
+    for(std::vector<Command *>::iterator it = m_commands.begin(); it != m_commands.end(); ++it)
+      delete *it;
+    m_commands.clear();
+  }
+
+  void Command_List::record(Command * const &command) {
+    try {
+      m_commands.push_back(command);
+    }
+    catch(...) {
+      delete command;
+      throw;
+    }
+  }
+
+  void Command_List::set_2d(const std::pair<Point2f, Point2f> &camera2d, const bool &fix_aspect_ratio) {
+    record(new Set_2d(camera2d, fix_aspect_ratio));
+  }
+
+  void Command_List::set_3d(const Camera &camera) {
+    record(new Set_3d(camera));
+  }
+
+  void Command_List::set_backface_culling(const bool &on) {
+    record(new Call_1<bool>(&Video::set_backface_culling, on));
+  }
+
+  void Command_List::set_zwrite(const bool &enabled) {
+    record(new Call_1<bool>(&Video::set_zwrite, enabled));
+  }
+
+  void Command_List::set_ztest(const bool &enabled) {
+    record(new Call_1<bool>(&Video::set_ztest, enabled));
+  }
+
+  void Command_List::set_alpha_test(const bool &enabled, const Video::TEST &test, const float &value) {
+    record(new Set_Alpha_Test(enabled, test, value));
+  }
+
+  void Command_List::clear_depth_buffer() {
+    record(new Call(&Video::clear_depth_buffer));
+  }
+
+  void Command_List::set_Color(const Color &color) {
+    record(new Call_1<Color>(&Video::set_Color, color));
+  }
+
+  void Command_List::apply_Texture(const String &name) {
+    record(new Apply_Texture_Name(name));
+  }
+
+  void Command_List::apply_Texture(const Texture &texture) {
+    record(new Apply_Texture(texture));
+  }
+
+  void Command_List::unapply_Texture() {
+    record(new Call(&Video::unapply_Texture));
+  }
+
+  void Command_List::set_lighting(const bool &on) {
+    record(new Call_1<bool>(&Video::set_lighting, on));
+  }
+
+  void Command_List::set_ambient_lighting(const Color &color) {
+    record(new Call_1<Color>(&Video::set_ambient_lighting, color));
+  }
+
+  void Command_List::set_Light(const int &number, const Light &light) {
+    record(new Set_Light(number, light));
+  }
+
+  void Command_List::unset_Light(const int &number) {
+    record(new Call_1<int>(&Video::unset_Light, number));
+  }
+
+  void Command_List::set_Material(const Material &material) {
+    record(new Call_1<Material>(&Video::set_Material, material));
+  }
+
+  void Command_List::unset_Material(const Material &material) {
+    record(new Call_1<Material>(&Video::unset_Material, material));
+  }
+
+  void Command_List::set_Fog(const Fog &fog) {
+    record(new Call_1<Fog>(&Video::set_Fog, fog));
+  }
+
+  void Command_List::unset_Fog() {
+    record(new Call(&Video::unset_Fog));
+  }
+
+  void Command_List::set_program(Program &program) {
+    record(new Set_Program(program));
+  }
+
+  void Command_List::unset_program() {
+    record(new Call(&Video::unset_program));
+  }
+
+  void Command_List::select_world_matrix() {
+    record(new Call(&Video::select_world_matrix));
+  }
+
+  void Command_List::push_world_stack() {
+    record(new Call(&Video::push_world_stack));
+  }
+
+  void Command_List::pop_world_stack() {
+    record(new Call(&Video::pop_world_stack));
+  }
+
+  void Command_List::translate_scene(const Vector3f &direction) {
+    record(new Call_1<Vector3f>(&Video::translate_scene, direction));
+  }
+
+  void Command_List::rotate_scene(const Vector3f &about, const float &radians) {
+    record(new Rotate_Scene(about, radians));
+  }
+
+  void Command_List::rotate_scene(const Quaternion &rotation) {
+    const std::pair<Vector3f, float> aa = rotation.get_rotation();
+    record(new Rotate_Scene(aa.first, aa.second));
+  }
+
+  void Command_List::scale_scene(const Vector3f &factor) {
+    record(new Call_1<Vector3f>(&Video::scale_scene, factor));
+  }
+
+  void Command_List::transform_scene(const Matrix4f &transformation) {
+    record(new Call_1<Matrix4f>(&Video::transform_scene, transformation));
+  }
+
+  void Command_List::render_reference(const Renderable &renderable) {
+    record(new Render_Reference(renderable));
+  }
+
+}
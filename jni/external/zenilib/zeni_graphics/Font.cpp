@@ -18,6 +18,9 @@
 #include <zeni_graphics.h>
 
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
@@ -32,6 +35,552 @@
 
 namespace Zeni {
 
+  static const size_t g_no_page = size_t(-1);
+
+  class Font_FT::Glyph_Cache {
+    Glyph_Cache(const Glyph_Cache &);
+    Glyph_Cache & operator=(const Glyph_Cache &);
+
+    struct Page {
+      Page(const Point2i &size);
+      ~Page();
+
+      bool insert(const Point2i &size, Point2i &upper_left); ///< Shelf placement
+      void clear();
+
+      Image image;
+      std::vector<Point3i> shelves; ///< (y, height, next free x) of each shelf
+      int next_shelf; ///< y of the first row not yet claimed by a shelf
+      int used_area;
+      size_t num_glyphs;
+      unsigned long last_used;
+      Texture * texture;
+      bool dirty;
+    };
+
+  public:
+    enum {DISTANCE_FIELD_HEIGHT = 48, DISTANCE_FIELD_SPREAD = 6};
+
+    Glyph_Cache(const String &filepath, const int &pixel_height, const int &spread);
+    ~Glyph_Cache();
+
+    static Glyph_Cache * acquire_distance_field(const String &filepath); ///< Get the cache shared by every distance field Font_FT of a typeface
+    void release(); ///< Give up a reference, deleting a coverage bitmap cache or releasing the Textures of a distance field cache once unused
+
+    int get_pixel_height() const {return m_pixel_height;}
+    int get_spread() const {return m_spread;}
+    size_t get_max_pages() const {return m_max_pages;}
+    void set_max_pages(const size_t &max_pages);
+    const Point2i & get_page_size() const {return m_page_size;}
+    Cache_Stats get_stats() const;
+    void reset_stats();
+
+    unsigned long get_generation() const {return m_generation;} ///< Changes whenever Glyphs are evicted
+    void begin_use() {++m_frame;} ///< Mark the beginning of a call which uses Glyphs
+    const Glyph & get_glyph(const Uint32 &codepoint); ///< Find or rasterize a Glyph, marking its page as used
+    void touch(const String &text); ///< Bring every Glyph in 'text' into the cache before rendering begins
+    void apply_page(Video &vr, const size_t &page, size_t &applied);
+
+  private:
+    struct Nearest {
+      int dx, dy;
+
+      int distance2() const {return dx * dx + dy * dy;}
+    };
+
+    void rasterize(const Uint32 &codepoint, Glyph &glyph);
+    size_t allocate(const Point2i &size, Point2i &upper_left); ///< Find room on a page, evicting if necessary
+    void evict(const size_t &page);
+
+    static void copy_coverage(const FT_Bitmap &bitmap, Image &image, const Point2i &upper_left);
+    static void copy_distance_field(const FT_Bitmap &bitmap, const int &spread, Image &image, const Point2i &upper_left);
+    static void propagate(std::vector<Nearest> &grid, const int &width, const int &height, const int &x, const int &y, const int &ox, const int &oy);
+    static void sweep(std::vector<Nearest> &grid, const int &width, const int &height);
+    static int next_power_of_two(const int &value);
+
+    class Registry : public Unordered_Map<String, Glyph_Cache *> {
+    public:
+      ~Registry() {
+        for(iterator it = begin(); it != end(); ++it)
+          delete it->second;
+      }
+    };
+
+    static Registry g_distance_field_caches; ///< Distance fields suit any resolution, so they outlive the Fonts using them
+    static unsigned long g_generations; ///< Generations are unique across caches, so a Glyph_Batch cannot mistake one cache for another
+
+    String m_filepath;
+    size_t m_references;
+
+    String m_file; ///< FreeType reads the face from this buffer for the life of the cache
+    FT_Library m_library;
+    FT_Face m_face;
+    int m_pixel_height;
+    int m_spread; ///< 0 for coverage bitmaps, otherwise the distance in pixels represented by the full range of a distance field
+    int m_ascent;
+
+    Unordered_Map<Uint32, Glyph> m_glyphs;
+    std::vector<Page *> m_pages;
+    const Glyph * m_ascii[128]; ///< Shortcuts into m_glyphs
+    Point2i m_page_size;
+    size_t m_max_pages;
+
+    unsigned long m_frame; ///< Incremented by each call which uses Glyphs
+    unsigned long m_generation;
+    size_t m_rasterizations;
+    size_t m_evictions;
+  };
+
+  Font_FT::Glyph_Cache::Registry Font_FT::Glyph_Cache::g_distance_field_caches;
+  unsigned long Font_FT::Glyph_Cache::g_generations = 0u;
+
+  Font_FT::Glyph_Cache::Page::Page(const Point2i &size)
+    : image(size, Image::Luminance_Alpha, false),
+    next_shelf(0),
+    used_area(0),
+    num_glyphs(0u),
+    last_used(0u),
+    texture(0),
+    dirty(true)
+  {
+  }
+
+  Font_FT::Glyph_Cache::Page::~Page() {
+    delete texture;
+  }
+
+  bool Font_FT::Glyph_Cache::Page::insert(const Point2i &size, Point2i &upper_left) {
+    /// Choose the shortest shelf which is tall enough and has room left
+    size_t best = shelves.size();
+    for(size_t i = 0; i != shelves.size(); ++i) {
+      if(shelves[i].y >= size.y && shelves[i].z + size.x <= image.width() &&
+         (best == shelves.size() || shelves[i].y < shelves[best].y))
+      {
+        best = i;
+      }
+    }
+
+    if(best == shelves.size()) {
+      if(next_shelf + size.y > image.height() || size.x > image.width())
+        return false;
+
+      shelves.push_back(Point3i(next_shelf, size.y, 0));
+      next_shelf += size.y;
+    }
+
+    upper_left = Point2i(shelves[best].z, shelves[best].x);
+    shelves[best].z += size.x;
+
+    used_area += size.x * size.y;
+    ++num_glyphs;
+    dirty = true;
+
+    return true;
+  }
+
+  void Font_FT::Glyph_Cache::Page::clear() {
+    memset(image.get_data(), 0, image.width() * image.height() * 2);
+    shelves.clear();
+    next_shelf = 0;
+    used_area = 0;
+    num_glyphs = 0u;
+    dirty = true;
+  }
+
+  int Font_FT::Glyph_Cache::next_power_of_two(const int &value) {
+    int power = 1;
+    while(power < value)
+      power <<= 1;
+    return power;
+  }
+
+  Font_FT::Glyph_Cache::Glyph_Cache(const String &filepath, const int &pixel_height, const int &spread)
+    : m_filepath(filepath),
+    m_references(1u),
+    m_library(0),
+    m_face(0),
+    m_pixel_height(pixel_height),
+    m_spread(spread),
+    m_ascent(0),
+    m_max_pages(4u),
+    m_frame(0u),
+    m_generation(++g_generations),
+    m_rasterizations(0u),
+    m_evictions(0u)
+  {
+    memset(m_ascii, 0, sizeof(m_ascii));
+
+    String filename(filepath.c_str());
+    File_Ops::load_asset(m_file, filename);
+
+    FT_Open_Args foargs;
+    memset(&foargs, 0, sizeof(FT_Open_Args));
+    foargs.flags = FT_OPEN_MEMORY;
+    foargs.memory_base = reinterpret_cast<const FT_Byte *>(m_file.c_str());
+    foargs.memory_size = FT_Long(m_file.size());
+
+    //Create and initilize a freetype font library.
+    if(FT_Init_FreeType(&m_library)) {
+      m_library = 0;
+      ZENI_LOGE("FT_Init_FreeType(...) failed.");
+      throw Error("FT_Init_FreeType(...) failed.");
+    }
+    ZENI_LOGD("FT_Init_FreeType(...) success.");
+
+    //The object in which Freetype holds information on a given
+    //font is called a "face".  It is kept open so that glyphs can be
+    //rasterized as they are first needed.
+    if(FT_Open_Face(m_library, &foargs, 0, &m_face)) {
+      m_face = 0;
+      FT_Done_FreeType(m_library);
+      ZENI_LOGE("FT_Open_Face(...) failed.");
+      throw Error("FT_Open_Face(...) failed.");
+    }
+    ZENI_LOGD("FT_Open_Face(...) success.");
+
+    if(FT_Set_Pixel_Sizes(m_face, 0, m_pixel_height)) {
+      FT_Done_Face(m_face);
+      FT_Done_FreeType(m_library);
+      ZENI_LOGE("FT_Set_Pixel_Sizes(...) failed.");
+      throw Error("FT_Set_Pixel_Sizes(...) failed.");
+    }
+    ZENI_LOGD("FT_Set_Pixel_Sizes(...) success.");
+
+    m_ascent = int((m_face->size->metrics.ascender + 63) >> 6);
+
+    /// Room for roughly the printable ASCII characters per page, and for at least one of the largest glyphs
+    const int cell = m_pixel_height + 2 * m_spread + 1;
+    const int side = std::max(std::min(std::max(next_power_of_two(8 * cell), 128), 1024), next_power_of_two(2 * cell));
+    m_page_size = Point2i(side, side);
+  }
+
+  Font_FT::Glyph_Cache::~Glyph_Cache() {
+    for(std::vector<Page *>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+      delete *it;
+
+    FT_Done_Face(m_face);
+    FT_Done_FreeType(m_library);
+  }
+
+  Font_FT::Glyph_Cache * Font_FT::Glyph_Cache::acquire_distance_field(const String &filepath) {
+    Registry::iterator it = g_distance_field_caches.find(filepath);
+    if(it != g_distance_field_caches.end()) {
+      ++it->second->m_references;
+      return it->second;
+    }
+
+    Glyph_Cache * const cache = new Glyph_Cache(filepath, DISTANCE_FIELD_HEIGHT, DISTANCE_FIELD_SPREAD);
+    g_distance_field_caches[filepath] = cache;
+    return cache;
+  }
+
+  void Font_FT::Glyph_Cache::release() {
+    if(--m_references)
+      return;
+
+    if(!m_spread) {
+      delete this;
+      return;
+    }
+
+    /// Fonts are released before the rendering device is, so keep only what survives a change of resolution
+    for(std::vector<Page *>::iterator it = m_pages.begin(); it != m_pages.end(); ++it) {
+      delete (*it)->texture;
+      (*it)->texture = 0;
+      (*it)->dirty = true;
+    }
+  }
+
+  void Font_FT::Glyph_Cache::set_max_pages(const size_t &max_pages) {
+    m_max_pages = std::max(max_pages, size_t(1u));
+
+    while(m_pages.size() > m_max_pages) {
+      evict(m_pages.size() - 1u);
+      delete m_pages.back();
+      m_pages.pop_back();
+    }
+  }
+
+  Font_FT::Cache_Stats Font_FT::Glyph_Cache::get_stats() const {
+    Cache_Stats stats;
+
+    stats.pages = m_pages.size();
+    stats.max_pages = m_max_pages;
+    stats.rasterizations = m_rasterizations;
+    stats.evictions = m_evictions;
+
+    float used = 0.0f;
+    for(std::vector<Page *>::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it) {
+      stats.glyphs += (*it)->num_glyphs;
+      used += float((*it)->used_area);
+    }
+    if(!m_pages.empty())
+      stats.occupancy = used / (float(m_page_size.x) * m_page_size.y * m_pages.size());
+
+    return stats;
+  }
+
+  void Font_FT::Glyph_Cache::reset_stats() {
+    m_rasterizations = 0u;
+    m_evictions = 0u;
+  }
+
+  const Font_FT::Glyph & Font_FT::Glyph_Cache::get_glyph(const Uint32 &codepoint) {
+    const Glyph * glyph = codepoint < 128 ? m_ascii[codepoint] : 0;
+
+    if(!glyph) {
+      Unordered_Map<Uint32, Glyph>::iterator it = m_glyphs.find(codepoint);
+      if(it == m_glyphs.end()) {
+        it = m_glyphs.insert(std::make_pair(codepoint, Glyph())).first;
+        rasterize(codepoint, it->second);
+      }
+
+      glyph = &it->second;
+      if(codepoint < 128)
+        m_ascii[codepoint] = glyph;
+    }
+
+    if(glyph->m_page != g_no_page)
+      m_pages[glyph->m_page]->last_used = m_frame;
+
+    return *glyph;
+  }
+
+  void Font_FT::Glyph_Cache::touch(const String &text) {
+    for(size_t i = 0; i < text.size(); )
+      get_glyph(decode_utf8(text, i));
+  }
+
+  void Font_FT::Glyph_Cache::apply_page(Video &vr, const size_t &page, size_t &applied) {
+    Page &p = *m_pages[page];
+    p.last_used = m_frame;
+
+    if(p.dirty) {
+      delete p.texture;
+      p.texture = 0;
+      p.texture = vr.create_Texture(p.image);
+      p.dirty = false;
+      applied = g_no_page;
+    }
+
+    if(applied != page) {
+      vr.apply_Texture(*p.texture);
+      applied = page;
+    }
+  }
+
+  void Font_FT::Glyph_Cache::rasterize(const Uint32 &codepoint, Glyph &glyph) {
+    /// Control characters have neither width nor appearance
+    if(codepoint < 32)
+      return;
+
+    if(FT_Load_Char(m_face, codepoint, FT_LOAD_RENDER)) {
+      ZENI_LOGW(("FT_Load_Char(...) failed for U+" + uitoa(codepoint) + ".").c_str());
+      return;
+    }
+
+    ++m_rasterizations;
+
+    const FT_GlyphSlot slot = m_face->glyph;
+    const FT_Bitmap &bitmap = slot->bitmap;
+    const int width = int(bitmap.width) + 2 * m_spread;
+    const int rows = int(bitmap.rows) + 2 * m_spread;
+    const int left = slot->bitmap_left - m_spread;
+    const int top = m_ascent - slot->bitmap_top - m_spread;
+
+    glyph.m_glyph_width = slot->advance.x / 64.0f;
+    glyph.m_upper_left_point = Point2f(float(left), float(top));
+    glyph.m_lower_right_point = Point2f(float(left + width), float(top + rows));
+
+    if(!bitmap.width || !bitmap.rows)
+      return;
+
+    /// Leave a texel of space to the right and below so that filtering does not bleed between glyphs
+    Point2i upper_left;
+    const size_t page = allocate(Point2i(width + 1, rows + 1), upper_left);
+    if(page == g_no_page) {
+      ZENI_LOGW(("Glyph U+" + uitoa(codepoint) + " is too large for the glyph cache.").c_str());
+      return;
+    }
+
+    if(m_spread)
+      copy_distance_field(bitmap, m_spread, m_pages[page]->image, upper_left);
+    else
+      copy_coverage(bitmap, m_pages[page]->image, upper_left);
+
+    glyph.m_upper_left_texel.x = float(upper_left.x) / m_page_size.x;
+    glyph.m_upper_left_texel.y = float(upper_left.y) / m_page_size.y;
+    glyph.m_lower_right_texel.x = float(upper_left.x + width) / m_page_size.x;
+    glyph.m_lower_right_texel.y = float(upper_left.y + rows) / m_page_size.y;
+    glyph.m_page = page;
+  }
+
+  size_t Font_FT::Glyph_Cache::allocate(const Point2i &size, Point2i &upper_left) {
+    if(size.x > m_page_size.x || size.y > m_page_size.y)
+      return g_no_page;
+
+    for(size_t page = 0; page != m_pages.size(); ++page)
+      if(m_pages[page]->insert(size, upper_left))
+        return page;
+
+    if(m_pages.size() < m_max_pages) {
+      m_pages.push_back(new Page(m_page_size));
+      m_pages.back()->last_used = m_frame;
+      m_pages.back()->insert(size, upper_left);
+      return m_pages.size() - 1u;
+    }
+
+    size_t lru = 0u;
+    for(size_t page = 1u; page != m_pages.size(); ++page)
+      if(m_pages[page]->last_used < m_pages[lru]->last_used)
+        lru = page;
+
+    evict(lru);
+    m_pages[lru]->last_used = m_frame;
+    m_pages[lru]->insert(size, upper_left);
+    return lru;
+  }
+
+  void Font_FT::Glyph_Cache::evict(const size_t &page) {
+    for(Unordered_Map<Uint32, Glyph>::iterator it = m_glyphs.begin(); it != m_glyphs.end(); ) {
+      if(it->second.m_page == page)
+        m_glyphs.erase(it++);
+      else
+        ++it;
+    }
+
+    memset(m_ascii, 0, sizeof(m_ascii));
+
+    m_pages[page]->clear();
+    m_generation = ++g_generations;
+    ++m_evictions;
+  }
+
+  void Font_FT::Glyph_Cache::copy_coverage(const FT_Bitmap &bitmap, Image &image, const Point2i &upper_left) {
+    const int row_size = image.width() * 2;
+
+    for(int j = 0; j != int(bitmap.rows); ++j) {
+      const unsigned char * src = bitmap.buffer + j * bitmap.pitch;
+      Uint8 * dst = image.get_data() + (upper_left.y + j) * row_size + upper_left.x * 2;
+      for(int i = 0; i != int(bitmap.width); ++i, ++src, dst += 2) {
+        dst[0] = 0xFF;
+        dst[1] = *src;
+      }
+    }
+  }
+
+  void Font_FT::Glyph_Cache::propagate(std::vector<Nearest> &grid, const int &width, const int &height, const int &x, const int &y, const int &ox, const int &oy) {
+    const int nx = x + ox;
+    const int ny = y + oy;
+    if(nx < 0 || nx >= width || ny < 0 || ny >= height)
+      return;
+
+    Nearest candidate = grid[ny * width + nx];
+    candidate.dx += ox;
+    candidate.dy += oy;
+
+    Nearest &current = grid[y * width + x];
+    if(candidate.distance2() < current.distance2())
+      current = candidate;
+  }
+
+  /// Two passes of the 8-neighbour sequential Euclidean distance transform
+  void Font_FT::Glyph_Cache::sweep(std::vector<Nearest> &grid, const int &width, const int &height) {
+    for(int y = 0; y != height; ++y) {
+      for(int x = 0; x != width; ++x) {
+        propagate(grid, width, height, x, y, -1, 0);
+        propagate(grid, width, height, x, y, 0, -1);
+        propagate(grid, width, height, x, y, -1, -1);
+        propagate(grid, width, height, x, y, 1, -1);
+      }
+      for(int x = width - 1; x >= 0; --x)
+        propagate(grid, width, height, x, y, 1, 0);
+    }
+
+    for(int y = height - 1; y >= 0; --y) {
+      for(int x = width - 1; x >= 0; --x) {
+        propagate(grid, width, height, x, y, 1, 0);
+        propagate(grid, width, height, x, y, 0, 1);
+        propagate(grid, width, height, x, y, -1, 1);
+        propagate(grid, width, height, x, y, 1, 1);
+      }
+      for(int x = 0; x != width; ++x)
+        propagate(grid, width, height, x, y, -1, 0);
+    }
+  }
+
+  void Font_FT::Glyph_Cache::copy_distance_field(const FT_Bitmap &bitmap, const int &spread, Image &image, const Point2i &upper_left) {
+    const int width = int(bitmap.width) + 2 * spread;
+    const int height = int(bitmap.rows) + 2 * spread;
+    const int far_away = width + height;
+
+    std::vector<Uint8> coverage(width * height, 0);
+    for(int j = 0; j != int(bitmap.rows); ++j)
+      memcpy(&coverage[(j + spread) * width + spread], bitmap.buffer + j * bitmap.pitch, bitmap.width);
+
+    /// Distance from outside texels to the glyph, and from inside texels to the background
+    const Nearest here = {0, 0};
+    const Nearest unknown = {far_away, far_away};
+    std::vector<Nearest> to_inside(width * height);
+    std::vector<Nearest> to_outside(width * height);
+    for(int i = 0; i != width * height; ++i) {
+      const bool inside = coverage[i] >= 0x80;
+      to_inside[i] = inside ? here : unknown;
+      to_outside[i] = inside ? unknown : here;
+    }
+
+    sweep(to_inside, width, height);
+    sweep(to_outside, width, height);
+
+    const int row_size = image.width() * 2;
+    const float scale = 0.5f / spread;
+
+    for(int j = 0; j != height; ++j) {
+      Uint8 * dst = image.get_data() + (upper_left.y + j) * row_size + upper_left.x * 2;
+      for(int i = 0; i != width; ++i, dst += 2) {
+        const int index = j * width + i;
+
+        /// Positive inside; Antialiased edge texels know their distance more precisely than the transform
+        float distance;
+        if(coverage[index] != 0x00 && coverage[index] != 0xFF)
+          distance = (coverage[index] - 127.5f) / 255.0f;
+        else if(coverage[index])
+          distance = float(sqrt(float(to_outside[index].distance2()))) - 0.5f;
+        else
+          distance = 0.5f - float(sqrt(float(to_inside[index].distance2())));
+
+        dst[0] = 0xFF;
+        dst[1] = Uint8(std::min(std::max(0.5f + distance * scale, 0.0f), 1.0f) * 255.0f + 0.5f);
+      }
+    }
+  }
+
+  Glyph_Batch::Glyph_Batch()
+    : m_generation(0u)
+  {
+  }
+
+  bool Glyph_Batch::empty() const {
+    for(std::vector<Primitive_Batch<Vertex2f_Texture> >::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+      if(!it->empty())
+        return false;
+    return true;
+  }
+
+  size_t Glyph_Batch::get_num_draws() const {
+    size_t draws = 0u;
+    for(std::vector<Primitive_Batch<Vertex2f_Texture> >::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+      if(!it->empty())
+        ++draws;
+    return draws;
+  }
+
+  void Glyph_Batch::clear() {
+    for(std::vector<Primitive_Batch<Vertex2f_Texture> >::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+      it->clear();
+    m_generation = 0u;
+  }
+
   Font::Font ()
     : m_glyph_height(0),
     m_virtual_screen_height(0.0f)
@@ -47,60 +596,36 @@ namespace Zeni {
   {
   }
 
-  Font_FT::Glyph::Glyph()
-    : m_glyph_width(0.0f)
-  {
+  bool Font::batch_text(Glyph_Batch &, const String &, const Point2f &, const JUSTIFY &) const {
+    return false;
   }
 
-  Font_FT::Glyph::Glyph(FT_Face &face,
-                        const char &c,
-                        const int &ascent,
-                        const float &vratio,
-                        const Point2i &position,
-                        const Point2i &total_size)
-    : m_glyph_width(0.0f)
-  {
-    // Reload the Glyph for our character.
-    if(FT_Load_Char(face, c, FT_LOAD_RENDER))
-      throw Error("FT_Load_Char(...) failed.");
-
-    // Move the face's glyph into a Glyph object.
-    FT_Glyph glyph;
-    if(FT_Get_Glyph(face->glyph, &glyph))
-      throw Error("FT_Get_Glyph(...) failed.");
-
-    FT_BitmapGlyph bglyph = reinterpret_cast<FT_BitmapGlyph>(glyph);
-
-    m_glyph_width = int(glyph->advance.x) / (65536.0f * vratio);
-    m_upper_left_point.x = bglyph->left / vratio;
-    m_upper_left_point.y = (ascent - bglyph->top) / vratio;
-    m_lower_right_point.x = (bglyph->left + bglyph->bitmap.width) / vratio;
-    m_lower_right_point.y = (ascent - bglyph->top + bglyph->bitmap.rows) / vratio;
-
-    m_upper_left_texel.x = float(position.x) / total_size.x;
-    m_upper_left_texel.y = float(position.y) / total_size.y;
-    m_lower_right_texel.x = float(position.x + bglyph->bitmap.width) / total_size.x;
-    m_lower_right_texel.y = float(position.y + bglyph->bitmap.rows) / total_size.y;
-
-//     ZENI_LOGD(("Generating Glyph " + itoa(glyph->advance.x) + "|" + ftoa(m_glyph_width) + " (" + itoa(bglyph->left) + "," + itoa(bglyph->top) + ") [" + itoa(bglyph->bitmap.width) + "," + itoa(bglyph->bitmap.rows) + "]").c_str());
+  bool Font::is_current(const Glyph_Batch &) const {
+    return false;
+  }
 
-    // Destroy the glyph object
-    FT_Done_Glyph(glyph);
+  void Font::render_batch(const Glyph_Batch &, const Color &) const {
   }
 
-  void Font_FT::Glyph::render(Video &vr, const Point2f &position, const float &vratio) const {
-    const float x = int(position.x * vratio + 0.5f) / vratio;
-    const float y = int(position.y * vratio + 0.5f) / vratio;
+  Font_FT::Glyph::Glyph()
+    : m_glyph_width(0.0f),
+    m_page(g_no_page)
+  {
+  }
 
-    Quadrilateral<Vertex2f_Texture> rect(
-      (Vertex2f_Texture(Point2f(m_upper_left_point.x + x, m_upper_left_point.y + y), m_upper_left_texel)) ,
-      (Vertex2f_Texture(Point2f(m_upper_left_point.x + x, m_lower_right_point.y + y), Point2f(m_upper_left_texel.x, m_lower_right_texel.y))) ,
-      (Vertex2f_Texture(Point2f(m_lower_right_point.x + x, m_lower_right_point.y + y), m_lower_right_texel)) ,
-      (Vertex2f_Texture(Point2f(m_lower_right_point.x + x, m_upper_left_point.y + y), Point2f(m_lower_right_texel.x, m_upper_left_texel.y))) );
+  Quadrilateral<Vertex2f_Texture> Font_FT::Glyph::get_quad(const Point2f &position, const float &scale) const {
+    const Point2f upper_left(m_upper_left_point.x * scale + position.x, m_upper_left_point.y * scale + position.y);
+    const Point2f lower_right(m_lower_right_point.x * scale + position.x, m_lower_right_point.y * scale + position.y);
 
-//     ZENI_LOGD(("Rendering Glyph " + ftoa(m_glyph_width) + " (" + ftoa(m_upper_left_point.x + x) + "," + ftoa(m_upper_left_point.y + y) + "), " + ftoa(m_lower_right_point.x + x) + "x" + ftoa(m_lower_right_point.y + y) + ", texture (" + ftoa(m_upper_left_texel.x) + "," + ftoa(m_upper_left_texel.y) + "), " + ftoa(m_lower_right_texel.x) + "x" + ftoa(m_lower_right_texel.y)).c_str());
+    return Quadrilateral<Vertex2f_Texture>(
+      (Vertex2f_Texture(upper_left, m_upper_left_texel)) ,
+      (Vertex2f_Texture(Point2f(upper_left.x, lower_right.y), Point2f(m_upper_left_texel.x, m_lower_right_texel.y))) ,
+      (Vertex2f_Texture(lower_right, m_lower_right_texel)) ,
+      (Vertex2f_Texture(Point2f(lower_right.x, upper_left.y), Point2f(m_lower_right_texel.x, m_upper_left_texel.y))) );
+  }
 
-    vr.render(rect);
+  void Font_FT::Glyph::render(Video &vr, const Point2f &position, const float &scale) const {
+    vr.render(get_quad(position, scale));
   }
 
   void Font_FT::Glyph::render(Video &vr, const Point3f &position, const Vector3f &right, const Vector3f &down) const {
@@ -122,7 +647,10 @@ namespace Zeni {
   }
 
   Font_FT::Font_FT()
-    : m_ascent(0),
+    : m_cache(0),
+    m_scale(0.0f),
+    m_smoothing(0.0f),
+    m_distance_field(false),
     m_font_height(0.0f),
     m_vratio(0.0f)
   {
@@ -130,13 +658,17 @@ namespace Zeni {
 
   Font_FT::Font_FT(const String &filepath,
                    const float &glyph_height,
-                   const float &virtual_screen_height)
+                   const float &virtual_screen_height,
+                   const bool &distance_field)
     : Font(glyph_height,
            (virtual_screen_height < MINIMUM_VIRTUAL_SCREEN_HEIGHT ||
            virtual_screen_height > MAXIMUM_VIRTUAL_SCREEN_HEIGHT) ?
            float(get_Window().get_height()) : virtual_screen_height,
            filepath),
-    m_ascent(0),
+    m_cache(0),
+    m_scale(0.0f),
+    m_smoothing(0.0f),
+    m_distance_field(distance_field),
     m_font_height(glyph_height),
 #ifdef TEMP_DISABLE
     m_vratio(1.0f)
@@ -145,74 +677,91 @@ namespace Zeni {
 #endif
   {
     ZENI_LOGD(("Generating font '" + filepath + "', size " + ftoa(m_font_height) + ", ratio " + ftoa(m_vratio)).c_str());
-    init(filepath);
+
+    if(m_distance_field) {
+      m_cache = Glyph_Cache::acquire_distance_field(filepath);
+      m_scale = glyph_height / m_cache->get_pixel_height();
+
+      /// Half a screen pixel, measured in the alpha units of the distance field
+      const float pixels_per_texel = m_scale * m_vratio;
+      m_smoothing = std::min(0.25f / (pixels_per_texel * m_cache->get_spread()), 0.5f);
+    }
+    else {
+      m_cache = new Glyph_Cache(filepath, int(get_text_height() * m_vratio + 0.5f), 0);
+      m_scale = 1.0f / m_vratio;
+    }
+  }
+
+  Font_FT::~Font_FT() {
+    if(m_cache)
+      m_cache->release();
   }
-  
+
   float Font_FT::get_text_width(const String &text) const {
-    float max_width = 0.0f, width = 0.0f;
-    unsigned int pos = 0;
-    const unsigned int size = static_cast<unsigned int>(text.size());
-
-    for(; pos < size; ++pos)
-      if(text[pos] != '\r' && text[pos] != '\n')
-        width += m_glyph[int(text[pos])].get_glyph_width();
-      else {
-        max_width = std::max(max_width, width);
-        width = 0.0f;
-      }
+    m_cache->begin_use();
+
+    float max_width = 0.0f;
+
+    for(size_t pos = 0; pos < text.size(); ) {
+      max_width = std::max(max_width, get_line_width(text, pos));
+
+      while(pos < text.size() && text[pos] != '\r' && text[pos] != '\n')
+        ++pos;
+      if(pos < text.size())
+        ++pos;
+    }
 
-    return std::max(max_width, width);
+    return max_width;
   }
 
   void Font_FT::render_text(const String &text, const Point2f &position, const Color &color, const JUSTIFY &justify) const {
     Video &vr = get_Video();
-    const float &x = position.x;
-    const float &y = position.y;
 
     const Color previous_color = vr.get_Color();
 
     vr.set_Color(color);
-    vr.apply_Texture(*m_texture);
-
-    float cx, x_diff, cy = y;
-    unsigned int i = 0u;
+    if(m_distance_field)
+      vr.set_distance_field(m_smoothing);
 
-NEXT_LINE:
+    m_cache->begin_use();
+    m_cache->touch(text);
 
-    cx = x;
-    x_diff = 0.0f;
+    size_t applied = g_no_page;
+    float cy = position.y;
 
-    if(justify != ZENI_LEFT) {
-      for(unsigned int j = i; j < text.size(); ++j) {
-        if(text[j] == '\r' || text[j] == '\n')
-          break;
-
-        x_diff -= m_glyph[int(text[j])].get_glyph_width();
-      }
+    for(size_t i = 0; ; ) {
+      float cx = position.x;
 
       if(justify == ZENI_CENTER)
-        cx += x_diff / 2u;
+        cx -= get_line_width(text, i) / 2.0f;
       else if(justify == ZENI_RIGHT)
-        cx += x_diff;
-    }
+        cx -= get_line_width(text, i);
 
-    for(; i < text.size(); ++i) {
-      if(text[i] == '\r' && i+1 < text.size() && text[i+1] == '\n')
-        ++i;
+      while(i < text.size() && text[i] != '\r' && text[i] != '\n') {
+        const Glyph &glyph = m_cache->get_glyph(decode_utf8(text, i));
 
-      if(text[i] == '\r' || text[i] == '\n') {
-        ++i;
-        cy += m_font_height;
-        goto NEXT_LINE;
-      }
-      else {
-        m_glyph[int(text[i])].render(vr, Point2f(cx, cy), m_vratio);
-        cx += m_glyph[int(text[i])].get_glyph_width();
+        if(glyph.m_page != g_no_page) {
+          m_cache->apply_page(vr, glyph.m_page, applied);
+          glyph.render(vr, get_glyph_position(cx, cy), m_scale);
+        }
+
+        cx += glyph.get_glyph_width() * m_scale;
       }
+
+      if(i == text.size())
+        break;
+
+      if(text[i] == '\r' && i + 1 < text.size() && text[i + 1] == '\n')
+        ++i;
+      ++i;
+      cy += m_font_height;
     }
 
-    vr.unapply_Texture();
+    if(applied != g_no_page)
+      vr.unapply_Texture();
 
+    if(m_distance_field)
+      vr.unset_distance_field();
     vr.set_Color(previous_color);
   }
 
@@ -222,176 +771,208 @@ NEXT_LINE:
     const Color previous_color = vr.get_Color();
 
     vr.set_Color(color);
-    vr.apply_Texture(*m_texture);
+    if(m_distance_field)
+      vr.set_distance_field(m_smoothing);
 
-    Point3f pos, vertical_pos = position;
-    float x_diff;
-    unsigned int i = 0u;
+    m_cache->begin_use();
+    m_cache->touch(text);
 
-NEXT_LINE_2:
+    const Vector3f scaled_right = m_scale * right;
+    const Vector3f scaled_down = m_scale * down;
 
-    pos = vertical_pos;
-    x_diff = 0.0f;
+    size_t applied = g_no_page;
+    Point3f vertical_pos = position;
 
-    if(justify != ZENI_LEFT) {
-      for(unsigned int j = i; j < text.size(); ++j) {
-        if(text[j] == '\r' || text[j] == '\n')
-          break;
+    for(size_t i = 0; ; ) {
+      Point3f pos = vertical_pos;
 
-        x_diff -= m_glyph[int(text[j])].get_glyph_width();
+      if(justify == ZENI_CENTER)
+        pos -= get_line_width(text, i) / 2.0f * right;
+      else if(justify == ZENI_RIGHT)
+        pos -= get_line_width(text, i) * right;
+
+      while(i < text.size() && text[i] != '\r' && text[i] != '\n') {
+        const Glyph &glyph = m_cache->get_glyph(decode_utf8(text, i));
+
+        if(glyph.m_page != g_no_page) {
+          m_cache->apply_page(vr, glyph.m_page, applied);
+          glyph.render(vr, pos, scaled_right, scaled_down);
+        }
+
+        pos += glyph.get_glyph_width() * scaled_right;
       }
 
+      if(i == text.size())
+        break;
+
+      if(text[i] == '\r' && i + 1 < text.size() && text[i + 1] == '\n')
+        ++i;
+      ++i;
+      vertical_pos += m_font_height * down;
+    }
+
+    if(applied != g_no_page)
+      vr.unapply_Texture();
+
+    if(m_distance_field)
+      vr.unset_distance_field();
+    vr.set_Color(previous_color);
+  }
+
+  bool Font_FT::batch_text(Glyph_Batch &batch, const String &text, const Point2f &position, const JUSTIFY &justify) const {
+    const unsigned long generation = m_cache->get_generation();
+    if(batch.empty())
+      batch.m_generation = generation;
+
+    m_cache->begin_use();
+    m_cache->touch(text);
+
+    float cy = position.y;
+
+    for(size_t i = 0; ; ) {
+      float cx = position.x;
+
       if(justify == ZENI_CENTER)
-        pos += x_diff / 2.0f * right;
+        cx -= get_line_width(text, i) / 2.0f;
       else if(justify == ZENI_RIGHT)
-        pos += x_diff * right;
-    }
+        cx -= get_line_width(text, i);
 
-    for(; i < text.size(); ++i) {
-      if(text[i] == '\r' && i+1 < text.size() && text[i+1] == '\n')
-        ++i;
+      while(i < text.size() && text[i] != '\r' && text[i] != '\n') {
+        const Glyph &glyph = m_cache->get_glyph(decode_utf8(text, i));
 
-      if(text[i] == '\r' || text[i] == '\n') {
-        ++i;
-        vertical_pos += m_font_height * down;
-        goto NEXT_LINE_2;
+        if(glyph.m_page != g_no_page) {
+          if(batch.m_pages.size() <= glyph.m_page)
+            batch.m_pages.resize(glyph.m_page + 1u);
+          batch.m_pages[glyph.m_page].add(glyph.get_quad(get_glyph_position(cx, cy), m_scale));
+        }
+
+        cx += glyph.get_glyph_width() * m_scale;
       }
-      else {
-        m_glyph[int(text[i])].render(vr, pos, right, down);
-        pos += m_glyph[int(text[i])].get_glyph_width() * right;
+
+      if(i == text.size())
+        break;
+
+      if(text[i] == '\r' && i + 1 < text.size() && text[i + 1] == '\n')
+        ++i;
+      ++i;
+      cy += m_font_height;
+    }
+
+    /// Rasterizing this text may have evicted glyphs added earlier
+    if(m_cache->get_generation() != generation)
+      batch.m_generation = 0u;
+
+    return true;
+  }
+
+  bool Font_FT::is_current(const Glyph_Batch &batch) const {
+    return batch.m_generation == m_cache->get_generation() || batch.empty();
+  }
+
+  void Font_FT::render_batch(const Glyph_Batch &batch, const Color &color) const {
+    assert(is_current(batch));
+
+    Video &vr = get_Video();
+
+    const Color previous_color = vr.get_Color();
+
+    vr.set_Color(color);
+    if(m_distance_field)
+      vr.set_distance_field(m_smoothing);
+
+    m_cache->begin_use();
+
+    size_t applied = g_no_page;
+
+    for(size_t page = 0; page != batch.m_pages.size(); ++page) {
+      if(!batch.m_pages[page].empty()) {
+        m_cache->apply_page(vr, page, applied);
+        vr.render(batch.m_pages[page]);
       }
     }
 
-    vr.unapply_Texture();
+    if(applied != g_no_page)
+      vr.unapply_Texture();
 
+    if(m_distance_field)
+      vr.unset_distance_field();
     vr.set_Color(previous_color);
   }
 
-  void Font_FT::init(const String &filepath) {
-    String filename(filepath.c_str());
-    String file;
-    File_Ops::load_asset(file, filename);
+  size_t Font_FT::get_max_cache_pages() const {
+    return m_cache->get_max_pages();
+  }
 
-    FT_Open_Args foargs;
-    memset(&foargs, 0, sizeof(FT_Open_Args));
-    foargs.flags = FT_OPEN_MEMORY;
-    foargs.memory_base = reinterpret_cast<const FT_Byte *>(file.c_str());
-    foargs.memory_size = FT_Long(file.size());
+  void Font_FT::set_max_cache_pages(const size_t &max_cache_pages) {
+    m_cache->set_max_pages(max_cache_pages);
+  }
 
-    const int height = int(get_text_height() * m_vratio + 0.5f);
+  const Point2i & Font_FT::get_cache_page_size() const {
+    return m_cache->get_page_size();
+  }
 
-    //Create and initilize a freetype font library.
-    FT_Library library;
-    if(FT_Init_FreeType(&library)) {
-      ZENI_LOGE("FT_Init_FreeType(...) failed.");
-      throw Error("FT_Init_FreeType(...) failed.");
-    }
-    ZENI_LOGD("FT_Init_FreeType(...) success.");
+  Font_FT::Cache_Stats Font_FT::get_cache_stats() const {
+    return m_cache->get_stats();
+  }
 
-    //The object in which Freetype holds information on a given
-    //font is called a "face".
-    FT_Face face;
+  void Font_FT::reset_cache_stats() {
+    m_cache->reset_stats();
+  }
 
-    //This is where we load in the font information from the file.
-    //Of all the places where the code might die, this is the most likely,
-    //as FT_New_Face will die if the font file does not exist or is somehow broken.
-    if(FT_Open_Face(library, &foargs, 0, &face)) {
-      ZENI_LOGE("FT_Open_Face(...) failed.");
-      throw Error("FT_Open_Face(...) failed.");
+  Uint32 Font_FT::decode_utf8(const String &text, size_t &pos) {
+    const Uint8 lead = Uint8(text[pos++]);
+    if(lead < 0x80)
+      return lead;
+
+    Uint32 codepoint;
+    Uint32 minimum;
+    int continuations;
+
+    if((lead & 0xE0) == 0xC0) {
+      codepoint = lead & 0x1F;
+      minimum = 0x80;
+      continuations = 1;
     }
-    ZENI_LOGD("FT_Open_Face(...) success.");
+    else if((lead & 0xF0) == 0xE0) {
+      codepoint = lead & 0x0F;
+      minimum = 0x800;
+      continuations = 2;
+    }
+    else if((lead & 0xF8) == 0xF0) {
+      codepoint = lead & 0x07;
+      minimum = 0x10000;
+      continuations = 3;
+    }
+    else
+      return 0xFFFD;
 
-    if(FT_Set_Pixel_Sizes(face, 0, height)) {
-      ZENI_LOGE("FT_Set_Pixel_Sizes(...) failed.");
-      throw Error("FT_Set_Pixel_Sizes(...) failed.");
+    for(; continuations; --continuations) {
+      if(pos == text.size() || (Uint8(text[pos]) & 0xC0) != 0x80)
+        return 0xFFFD;
+      codepoint = (codepoint << 6) | (Uint8(text[pos++]) & 0x3F);
     }
-    ZENI_LOGD("FT_Set_Pixel_Sizes(...) success.");
 
-    //This is where we actually create each of the fonts display lists.
-    std::vector<Image> glyph(96);
-    Point2i maxsz;
-    for(int i = 32; i != 128; ++i) {
-      Image &img = glyph[i - 32];
-      img = gen_glyph(face, char(i));
-      if(img.width() >= maxsz.x)
-        maxsz.x = img.width() + 1;
-      if(img.height() >= maxsz.y)
-        maxsz.y = img.height() + 1;
-    }
-
-    Image glyphs(Point2i(next_power_of_two(10 * maxsz.x), next_power_of_two(10 * maxsz.y)), Image::Luminance_Alpha, false);
-    m_glyph.reserve(256);
-		m_glyph.resize(32);
-    for(int i = 0; i != 96; ++i) {
-      const Point2i pos((i % 10) * maxsz.x, (i / 10) * maxsz.y);
-      glyphs.blit(pos, glyph[i]);
-      m_glyph.push_back(Glyph(face, char(i + 32), m_ascent, m_vratio, pos, glyphs.size()));
-    }
-    glyph.clear();
-		m_glyph.resize(256);
-
-    ZENI_LOGD("Generating Texture from glyphs.");
-    m_texture = std::auto_ptr<Texture>(get_Video().create_Texture(glyphs));
-
-    //We don't need the face information now that the display
-    //lists have been created, so we free the assosiated resources.
-    ZENI_LOGD("Calling FT_Done_Face(...).");
-    FT_Done_Face(face);
-
-    //Ditto for the library.
-    ZENI_LOGD("Calling FT_Done_FreeType(...).");
-    FT_Done_FreeType(library);
-  }
-
-  int Font_FT::next_power_of_two(const int &a) {
-    int rval=1;
-    while(rval<a) rval<<=1;
-    return rval;
-  }
-
-  Image Font_FT::gen_glyph(FT_Face &face, const char &ch) {
-    //Load the Glyph for our character.
-    if(FT_Load_Char(face, ch, FT_LOAD_RENDER)) {
-      ZENI_LOGE("FT_Load_Char(...) failed.");
-      throw Error("FT_Load_Char(...) failed.");
-    }
-//     ZENI_LOGD("FT_Load_Char(...) success.");
-
-    //Move the face's glyph into a Glyph object.
-    FT_Glyph glyph;
-    if(FT_Get_Glyph(face->glyph, &glyph)) {
-      ZENI_LOGE("FT_Get_Glyph(...) failed.");
-      throw Error("FT_Get_Glyph(...) failed.");
-    }
-//     ZENI_LOGD("FT_Get_Glyph(...) success.");
-
-    FT_BitmapGlyph bglyph = reinterpret_cast<FT_BitmapGlyph>(glyph);
-
-    //Update the maximum Glyph ascent
-    if(bglyph->top > m_ascent)
-      m_ascent = bglyph->top;
-
-    //Here we fill in the data for the expanded bitmap.
-    //Notice that we are using two channel bitmap (one for
-    //luminocity and one for alpha), but we assign
-    //both luminocity and alpha to the value that we
-    //find in the FreeType bitmap. 
-    //We use the ?: operator so that value which we use
-    //will be 0 if we are in the padding zone, and whatever
-    //is the the Freetype bitmap otherwise.
-    Image image(Point2i(bglyph->bitmap.width, bglyph->bitmap.rows), Image::Luminance_Alpha, false);
-    Uint8 * image_data = image.get_data();
-//     ZENI_LOGD("Copying glyph into Image.");
-    for(int pixel = 0, pend = bglyph->bitmap.width * bglyph->bitmap.rows; pixel != pend; ++pixel) {
-      image_data[2 * pixel] = 0xFF;
-      image_data[2 * pixel + 1] = bglyph->bitmap.buffer[pixel];
-    }
-//     ZENI_LOGD("Glyph copied into Image.");
-
-    //Destroy the glyph object
-    FT_Done_Glyph(glyph);
-
-    return image;
+    /// Reject overlong encodings, surrogates, and values beyond Unicode
+    if(codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+      return 0xFFFD;
+
+    return codepoint;
+  }
+
+  float Font_FT::get_line_width(const String &text, size_t pos) const {
+    float width = 0.0f;
+
+    while(pos < text.size() && text[pos] != '\r' && text[pos] != '\n')
+      width += m_cache->get_glyph(decode_utf8(text, pos)).get_glyph_width();
+
+    return width * m_scale;
+  }
+
+  Point2f Font_FT::get_glyph_position(const float &x, const float &y) const {
+    if(m_distance_field)
+      return Point2f(x, y);
+    else
+      return Point2f(int(x * m_vratio + 0.5f) / m_vratio, int(y * m_vratio + 0.5f) / m_vratio);
   }
 
 }
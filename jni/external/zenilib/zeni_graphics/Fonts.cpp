@@ -88,7 +88,9 @@ namespace Zeni {
         virtual_screen_height = vsh.to_float();
     }
 
-    return get_Video().create_Font(filepath, height, virtual_screen_height);
+    XML_Element_c distance_field = xml_element["distance_field"];
+
+    return get_Video().create_Font(filepath, height, virtual_screen_height, distance_field.good() && distance_field.to_bool());
   }
 
 }
@@ -20,16 +20,270 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <memory>
 #include <png.h>
 
 namespace Zeni {
 
+  /// For each destination coordinate, the source coordinates and weights which contribute to it
+  struct Image_Filter {
+    int taps;
+    std::vector<int> index;
+    std::vector<float> weight;
+  };
+
+  static const float g_pi = 3.14159265f;
+
+  static int wrap_or_clamp(const int &i, const int &size, const bool &tileable) {
+    if(tileable) {
+      const int wrapped = i % size;
+      return wrapped < 0 ? wrapped + size : wrapped;
+    }
+
+    return i < 0 ? 0 : i >= size ? size - 1 : i;
+  }
+
+  static float catmull_rom(const float &x) {
+    const float ax = fabs(x);
+
+    if(ax < 1.0f)
+      return (1.5f * ax - 2.5f) * ax * ax + 1.0f;
+    if(ax < 2.0f)
+      return ((-0.5f * ax + 2.5f) * ax - 4.0f) * ax + 2.0f;
+    return 0.0f;
+  }
+
+  static float bessel_i0(const float &x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+    for(int k = 1; k != 16; ++k) {
+      const float factor = x / (2.0f * k);
+      term *= factor * factor;
+      sum += term;
+    }
+    return sum;
+  }
+
+  static void build_interpolating_filter(Image_Filter &filter, const int &source_size, const int &size, const bool &tileable, const Image::Resampling &resampling) {
+    filter.taps = resampling == Image::Bicubic ? 4 : 2;
+    filter.index.resize(size * filter.taps);
+    filter.weight.resize(size * filter.taps);
+
+    /// Sample positions match those of extract_Color(const Point2f &)
+    for(int i = 0; i != size; ++i) {
+      const float scaled = float(i) / size * source_size;
+      const int ul = int(scaled);
+      const float t = scaled - ul;
+
+      int * const index = &filter.index[i * filter.taps];
+      float * const weight = &filter.weight[i * filter.taps];
+
+      if(resampling == Image::Bicubic) {
+        for(int k = 0; k != 4; ++k) {
+          index[k] = wrap_or_clamp(ul + k - 1, source_size, tileable);
+          weight[k] = catmull_rom(t - (k - 1));
+        }
+      }
+      else {
+        index[0] = wrap_or_clamp(ul, source_size, tileable);
+        index[1] = wrap_or_clamp(ul + 1, source_size, tileable);
+        weight[0] = 1.0f - t;
+        weight[1] = t;
+      }
+    }
+  }
+
+  static void build_decimating_filter(Image_Filter &filter, const int &source_size, const int &size, const bool &tileable, const Image::Downsampling &downsampling) {
+    if(source_size == size) {
+      filter.taps = 1;
+      filter.index.resize(size);
+      filter.weight.assign(size, 1.0f);
+      for(int i = 0; i != size; ++i)
+        filter.index[i] = i;
+      return;
+    }
+
+    if(downsampling == Image::Kaiser) {
+      /// Kaiser windowed sinc over the 6 nearest source texels, centered between the middle two
+      const float beta = 4.0f;
+      float kernel[6];
+      float total = 0.0f;
+      for(int k = 0; k != 6; ++k) {
+        const float d = k - 2.5f;
+        const float sinc = sin(g_pi * d / 2.0f) / (g_pi * d / 2.0f);
+        const float r = d / 3.0f;
+        kernel[k] = sinc * bessel_i0(beta * sqrt(1.0f - r * r)) / bessel_i0(beta);
+        total += kernel[k];
+      }
+
+      filter.taps = 6;
+      filter.index.resize(size * 6);
+      filter.weight.resize(size * 6);
+      for(int i = 0; i != size; ++i)
+        for(int k = 0; k != 6; ++k) {
+          filter.index[i * 6 + k] = wrap_or_clamp(2 * i - 2 + k, source_size, tileable);
+          filter.weight[i * 6 + k] = kernel[k] / total;
+        }
+    }
+    else {
+      filter.taps = 2;
+      filter.index.resize(size * 2);
+      filter.weight.assign(size * 2, 0.5f);
+      for(int i = 0; i != size; ++i) {
+        filter.index[i * 2] = 2 * i;
+        filter.index[i * 2 + 1] = 2 * i + 1;
+      }
+    }
+  }
+
+  static class Image_Gamma_Tables {
+  public:
+    Image_Gamma_Tables() {
+      for(int i = 0; i != 256; ++i) {
+        const float c = i / 255.0f;
+        identity[i] = float(i);
+        to_linear[i] = c <= 0.04045f ? c / 12.92f : pow((c + 0.055f) / 1.055f, 2.4f);
+      }
+
+      for(int i = 0; i != 4096; ++i) {
+        const float l = i / 4095.0f;
+        const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * pow(l, 1.0f / 2.4f) - 0.055f;
+        from_linear[i] = Uint8(c * 255.0f + 0.5f);
+      }
+    }
+
+    float identity[256];
+    float to_linear[256];
+    Uint8 from_linear[4096];
+  } g_gamma_tables;
+
+  /// Split rows into spans across Threads if there is enough work to make it worthwhile
+  static void for_each_row_span(const Span_Function &function, const int &rows, const int &samples_per_row) {
+    for_each_span(function, size_t(rows), size_t((65535 + samples_per_row) / samples_per_row));
+  }
+
+  /// Filter each source row horizontally into floating point
+  class Image_Horizontal_Pass : public Span_Function {
+  public:
+    Image_Horizontal_Pass(const Uint8 * const &source_, const int &source_row_size_, const int &channels_, const Image_Filter &filter_, const int &width_, const float * const * const &tables_, float * const &dest_)
+      : source(source_), source_row_size(source_row_size_), channels(channels_), filter(filter_), width(width_), tables(tables_), dest(dest_)
+    {
+    }
+
+    void operator()(const size_t &begin, const size_t &end) const {
+      const int taps = filter.taps;
+      const int row_size = width * channels;
+
+      for(int j = int(begin); j != int(end); ++j) {
+        const Uint8 * const src = source + j * source_row_size;
+        float * dst = dest + j * row_size;
+
+        for(int i = 0; i != width; ++i) {
+          const int * const index = &filter.index[i * taps];
+          const float * const weight = &filter.weight[i * taps];
+
+          for(int c = 0; c != channels; ++c, ++dst) {
+            const float * const table = tables[c];
+            float sum = 0.0f;
+            for(int t = 0; t != taps; ++t)
+              sum += weight[t] * table[src[index[t] * channels + c]];
+            *dst = sum;
+          }
+        }
+      }
+    }
+
+  private:
+    const Uint8 * source;
+    int source_row_size;
+    int channels;
+    const Image_Filter &filter;
+    int width;
+    const float * const * tables;
+    float * dest;
+  };
+
+  /// Filter the horizontally filtered rows vertically, a whole row at a time, and convert back to bytes
+  class Image_Vertical_Pass : public Span_Function {
+  public:
+    Image_Vertical_Pass(const float * const &source_, const int &row_size_, const int &channels_, const Image_Filter &filter_, const bool * const &linear_, Uint8 * const &dest_, const int &dest_row_size_)
+      : source(source_), row_size(row_size_), channels(channels_), filter(filter_), linear(linear_), dest(dest_), dest_row_size(dest_row_size_)
+    {
+    }
+
+    void operator()(const size_t &begin, const size_t &end) const {
+      const int taps = filter.taps;
+      std::vector<float> row(row_size);
+
+      for(int j = int(begin); j != int(end); ++j) {
+        const int * const index = &filter.index[j * taps];
+        const float * const weight = &filter.weight[j * taps];
+
+        std::fill(row.begin(), row.end(), 0.0f);
+        for(int t = 0; t != taps; ++t) {
+          const float w = weight[t];
+          const float * const src = source + index[t] * row_size;
+          for(int i = 0; i != row_size; ++i)
+            row[i] += w * src[i];
+        }
+
+        Uint8 * const dst = dest + j * dest_row_size;
+        for(int i = 0; i != row_size; ++i) {
+          const float value = row[i];
+          if(linear[i % channels]) {
+            const int scaled = int(value * 4095.0f + 0.5f);
+            dst[i] = g_gamma_tables.from_linear[scaled < 0 ? 0 : scaled > 4095 ? 4095 : scaled];
+          }
+          else {
+            const int rounded = int(value + 0.5f);
+            dst[i] = Uint8(rounded < 0 ? 0 : rounded > 255 ? 255 : rounded);
+          }
+        }
+      }
+    }
+
+  private:
+    const float * source;
+    int row_size;
+    int channels;
+    const Image_Filter &filter;
+    const bool * linear;
+    Uint8 * dest;
+    int dest_row_size;
+  };
+
+  static void resample(const Uint8 * const &source, const Point2i &source_size, const int &source_row_size,
+                       Uint8 * const &dest, const Point2i &dest_size, const int &dest_row_size,
+                       const int &channels, const bool &has_alpha,
+                       const Image_Filter &x_filter, const Image_Filter &y_filter, const bool &gamma_correct)
+  {
+    bool linear[4];
+    const float * tables[4];
+    for(int c = 0; c != channels; ++c) {
+      linear[c] = gamma_correct && !(has_alpha && c == channels - 1);
+      tables[c] = linear[c] ? g_gamma_tables.to_linear : g_gamma_tables.identity;
+    }
+
+    const int row_size = dest_size.x * channels;
+    std::vector<float> horizontal(source_size.y * row_size);
+
+    for_each_row_span(Image_Horizontal_Pass(source, source_row_size, channels, x_filter, dest_size.x, tables, &horizontal[0]),
+                      source_size.y, row_size * x_filter.taps);
+    for_each_row_span(Image_Vertical_Pass(&horizontal[0], row_size, channels, y_filter, linear, dest, dest_row_size),
+                      dest_size.y, row_size * y_filter.taps);
+  }
+
 //   static void png_read_from_memory(png_structp png_ptr, png_bytep data, png_size_t length) {
 //     png_bytep * const p = reinterpret_cast<png_bytep *>(png_get_io_ptr(png_ptr));
 //     memcpy(data, *p, length);
 //     *p += length;
 //   }
 
+  static void png_read_from_Archive(png_structp png_ptr, png_bytep data, png_size_t length) {
+    if(static_cast<Archive_Reader *>(png_get_io_ptr(png_ptr))->read(data, length) != length)
+      png_error(png_ptr, "Read past the end of an Archive entry.");
+  }
+
   Image::Image()
    : m_color_space(Image::RGBA),
    m_bytes_per_pixel(4),
@@ -45,11 +299,16 @@ namespace Zeni {
 //     String memory;
 //     ZENI_LOGD("Begin Image::Image(...)::File_Ops::get_asset_FILE(...).");
 //     File_Ops::load_asset(memory, filename);
-    FILE * const file = File_Ops::get_asset_FILE(filename);
+
+    /// Entries in an Archive are read straight from its mapping, rather than reopening it
+    const Archive * const archive = File_Ops::find_Archive(filename);
+    const std::auto_ptr<Archive_Reader> reader(archive ? new Archive_Reader(*archive, filename) : 0);
+
+    FILE * const file = reader.get() ? 0 : File_Ops::get_asset_FILE(filename);
     class file_Destroyer {
     public:
       file_Destroyer(FILE * const &file_) : m_file(file_) {}
-      ~file_Destroyer() {fclose(m_file);}
+      ~file_Destroyer() {if(m_file) fclose(m_file);}
 
     private:
       FILE * m_file;
@@ -58,7 +317,7 @@ namespace Zeni {
 
 //   if(memory.length() < 8u || png_sig_cmp(reinterpret_cast<png_byte *>(const_cast<char *>(memory.c_str())), 0, 8)) {
     png_byte header[8];
-    if(!fread(header, 8u, 1u, file) || png_sig_cmp(header, 0, 8)) {
+    if((reader.get() ? reader->read(header, 8u) != 8u : !fread(header, 8u, 1u, file)) || png_sig_cmp(header, 0, 8)) {
       ZENI_LOGE("PNG detection failure.");
       throw Texture_Init_Failure();
     }
@@ -109,7 +368,10 @@ namespace Zeni {
     //init png reading
 //     png_bytep mem_ptr = reinterpret_cast<png_bytep>(const_cast<char *>(memory.c_str() + 8u));
 //     png_set_read_fn(png_ptr, &mem_ptr, png_read_from_memory);
-    png_init_io(png_ptr, file);
+    if(reader.get())
+      png_set_read_fn(png_ptr, reader.get(), png_read_from_Archive);
+    else
+      png_init_io(png_ptr, file);
 
     //let libpng know you already read the first 8 bytes
     png_set_sig_bytes(png_ptr, 8);
@@ -331,15 +593,17 @@ namespace Zeni {
     return uc.interpolate_to(y_rhs_part, lc);
   }
 
-  void Image::resize(const int &width, const int &height) {
+  void Image::resize(const int &width, const int &height, const Resampling &resampling) {
     Image resized(Point2i(width, height), m_color_space, m_tileable);
 
-    const float w = float(width);
-    const float h = float(height);
+    if(width > 0 && height > 0 && m_size.x > 0 && m_size.y > 0) {
+      Image_Filter x_filter, y_filter;
+      build_interpolating_filter(x_filter, m_size.x, width, m_tileable, resampling);
+      build_interpolating_filter(y_filter, m_size.y, height, m_tileable, resampling);
 
-    for(int i = 0; i != width; ++i)
-      for(int j = 0; j != height; ++j)
-        resized.set_Color(Point2i(i, j), extract_Color(Point2f(i / w, j / h)));
+      resample(&m_data[0], m_size, m_row_size, &resized.m_data[0], resized.m_size, resized.m_row_size,
+               m_bytes_per_pixel, false, x_filter, y_filter, false);
+    }
 
     std::swap(m_size, resized.m_size);
     std::swap(m_color_space, resized.m_color_space);
@@ -349,6 +613,33 @@ namespace Zeni {
     std::swap(m_tileable, resized.m_tileable);
   }
 
+  Image Image::downsample(const Downsampling &downsampling, const bool &gamma_correct) const {
+    Image downsampled(Point2i(std::max(1, m_size.x / 2), std::max(1, m_size.y / 2)), m_color_space, m_tileable);
+
+    if(m_size.x > 0 && m_size.y > 0) {
+      Image_Filter x_filter, y_filter;
+      build_decimating_filter(x_filter, m_size.x, downsampled.m_size.x, m_tileable, downsampling);
+      build_decimating_filter(y_filter, m_size.y, downsampled.m_size.y, m_tileable, downsampling);
+
+      resample(&m_data[0], m_size, m_row_size, &downsampled.m_data[0], downsampled.m_size, downsampled.m_row_size,
+               m_bytes_per_pixel, m_color_space == Luminance_Alpha || m_color_space == RGBA, x_filter, y_filter, gamma_correct);
+    }
+
+    return downsampled;
+  }
+
+  void Image::build_mipmaps(std::vector<Image> &mipmaps, const Downsampling &downsampling, const bool &gamma_correct) const {
+    mipmaps.clear();
+
+    int levels = 0;
+    for(int size = std::max(m_size.x, m_size.y); size > 1; size /= 2)
+      ++levels;
+    mipmaps.reserve(levels);
+
+    for(int i = 0; i != levels; ++i)
+      mipmaps.push_back((i ? mipmaps.back() : *this).downsample(downsampling, gamma_correct));
+  }
+
   bool Image::blit(const Point2i &upper_left, const Image &source) {
     if(this == &source || m_color_space != source.m_color_space)
       return false;
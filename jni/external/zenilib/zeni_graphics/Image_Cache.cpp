@@ -0,0 +1,298 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_graphics.h>
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sys/stat.h>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  static const char g_magic[4] = {'Z', 'I', 'M', 'G'};
+  static const Uint32 g_version = 2u;
+  static const Uint32 g_max_levels = 32u; ///< Enough for any dimension which fits in an int
+  static const long g_alignment = 16;
+
+  struct Image_Cache_Header {
+    char magic[4];
+    Uint32 version;
+    Uint32 source_size;
+    Uint32 source_mtime_low;
+    Uint32 source_mtime_high;
+    Uint32 color_space;
+    Uint32 tileable;
+    Uint32 num_levels;
+    Uint32 path_length; ///< The source path follows the header, since filenames may share a hash
+  };
+
+  struct Image_Cache_Level {
+    Uint32 width;
+    Uint32 height;
+    Uint32 offset;
+    Uint32 size;
+  };
+
+  /// FNV-1a
+  static Uint32 hash_filename(const String &filename) {
+    Uint32 hash = 2166136261u;
+    for(const char * c = filename.c_str(); *c; ++c) {
+      hash ^= Uint8(*c);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  static long align(const long &offset) {
+    return (offset + g_alignment - 1) / g_alignment * g_alignment;
+  }
+
+  /// Describe the PNG as it currently exists, for comparison against a cache entry
+  static bool describe_source(const String &filename, Image_Cache_Header &header) {
+#ifdef ANDROID
+    return false;
+#else
+    struct stat status;
+    if(stat(filename.c_str(), &status))
+      return false;
+
+    const Uint32 low = Uint32(status.st_mtime & 0xFFFFFFFF);
+    const Uint32 high = Uint32((status.st_mtime >> 16) >> 16);
+
+    memcpy(header.magic, g_magic, sizeof(g_magic));
+    header.version = g_version;
+    header.source_size = Uint32(status.st_size);
+    header.source_mtime_low = low;
+    header.source_mtime_high = high;
+
+    return true;
+#endif
+  }
+
+  static int get_bytes_per_pixel(const Uint32 &color_space) {
+    return color_space == Image::Luminance ? 1 :
+           color_space == Image::Luminance_Alpha ? 2 :
+           color_space == Image::RGB ? 3 :
+           4;
+  }
+
+  Image * Image_Cache::load_Image(const String &filename, const bool &tileable, std::vector<Image> * const &mipmaps) {
+    std::auto_ptr<Image> image(new Image);
+
+    if(load(filename, tileable, *image, mipmaps))
+      return image.release();
+
+    image.reset(new Image(filename, tileable));
+
+    /// Entries always hold the whole mip chain, so callers with and without mipmaps share them rather than replacing one another's
+    std::vector<Image> built;
+    std::vector<Image> &chain = mipmaps ? *mipmaps : built;
+    image->build_mipmaps(chain);
+
+    store(filename, *image, &chain);
+
+    return image.release();
+  }
+
+  bool Image_Cache::load(const String &filename, const bool &tileable, Image &image, std::vector<Image> * const &mipmaps) {
+    Image_Cache_Header expected;
+    if(!describe_source(filename, expected))
+      return false;
+
+    FILE * const file = fopen(get_cache_path(filename).c_str(), "rb");
+    if(!file)
+      return false;
+
+    class file_Destroyer {
+    public:
+      file_Destroyer(FILE * const &file_) : m_file(file_) {}
+      ~file_Destroyer() {fclose(m_file);}
+
+    private:
+      FILE * m_file;
+    } file_destroyer(file);
+
+    Image_Cache_Header header;
+    if(!fread(&header, sizeof(header), 1u, file) ||
+       memcmp(header.magic, expected.magic, sizeof(header.magic)) ||
+       header.version != expected.version ||
+       header.source_size != expected.source_size ||
+       header.source_mtime_low != expected.source_mtime_low ||
+       header.source_mtime_high != expected.source_mtime_high ||
+       header.color_space > Image::RGBA ||
+       header.tileable != Uint32(tileable) ||
+       !header.num_levels ||
+       header.num_levels > g_max_levels ||
+       header.path_length != filename.size())
+    {
+      return false;
+    }
+
+    String path(filename.size(), '\0');
+    if((!path.empty() && fread(&path[0], path.size(), 1u, file) != 1u) || path != filename)
+      return false;
+
+    std::vector<Image_Cache_Level> levels(header.num_levels);
+    if(fread(&levels[0], sizeof(Image_Cache_Level), levels.size(), file) != levels.size())
+      return false;
+
+    /// Never trust the table to describe more than the file contains
+    if(fseek(file, 0, SEEK_END))
+      return false;
+    const long file_size = ftell(file);
+    if(file_size < 0)
+      return false;
+
+    /// Levels beyond the first are only useful if they form a complete chain
+    if(mipmaps) {
+      Uint32 expected_levels = 1u;
+      for(Uint32 size = std::max(levels[0].width, levels[0].height); size > 1u; size /= 2u)
+        ++expected_levels;
+
+      if(header.num_levels != expected_levels)
+        return false;
+    }
+
+    const size_t num_levels = mipmaps ? levels.size() : 1u;
+    std::vector<Image> loaded(num_levels);
+    const int bytes_per_pixel = get_bytes_per_pixel(header.color_space);
+
+    for(size_t i = 0; i != num_levels; ++i) {
+      const Image_Cache_Level &level = levels[i];
+      Image &dest = loaded[i];
+
+      if(level.width > Uint32(INT_MAX) || level.height > Uint32(INT_MAX) ||
+         Uint64(level.size) != Uint64(level.width) * level.height * bytes_per_pixel ||
+         Uint64(level.offset) + level.size > Uint64(file_size))
+      {
+        return false;
+      }
+
+      dest.m_size = Point2i(int(level.width), int(level.height));
+      dest.m_color_space = Image::Color_Space(header.color_space);
+      dest.m_bytes_per_pixel = bytes_per_pixel;
+      dest.m_row_size = int(level.width) * bytes_per_pixel;
+      dest.m_tileable = tileable;
+      dest.m_data.resize(level.size);
+
+      if(fseek(file, long(level.offset), SEEK_SET) ||
+         (level.size && !fread(&dest.m_data[0], level.size, 1u, file)))
+      {
+        return false;
+      }
+    }
+
+    swap(image, loaded[0]);
+
+    if(mipmaps) {
+      mipmaps->resize(loaded.size() - 1u);
+      for(size_t i = 1; i != loaded.size(); ++i)
+        swap((*mipmaps)[i - 1], loaded[i]);
+    }
+
+    return true;
+  }
+
+  bool Image_Cache::store(const String &filename, const Image &image, const std::vector<Image> * const &mipmaps) {
+    Image_Cache_Header header;
+    if(!describe_source(filename, header))
+      return false;
+
+    header.color_space = Uint32(image.color_space());
+    header.tileable = Uint32(image.tileable());
+    header.num_levels = Uint32(1u + (mipmaps ? mipmaps->size() : 0u));
+    header.path_length = Uint32(filename.size());
+
+    std::vector<const Image *> images(header.num_levels);
+    images[0] = &image;
+    for(size_t i = 1; i != images.size(); ++i)
+      images[i] = &(*mipmaps)[i - 1];
+
+    std::vector<Image_Cache_Level> levels(header.num_levels);
+    long offset = align(long(sizeof(header) + filename.size() + levels.size() * sizeof(Image_Cache_Level)));
+    for(size_t i = 0; i != levels.size(); ++i) {
+      levels[i].width = Uint32(images[i]->width());
+      levels[i].height = Uint32(images[i]->height());
+      levels[i].offset = Uint32(offset);
+      levels[i].size = Uint32(images[i]->m_row_size * images[i]->height());
+      offset = align(offset + long(levels[i].size));
+    }
+
+    File_Ops &fo = get_File_Ops();
+    const String appdata_path = fo.get_appdata_path();
+    if(!File_Ops::create_directory(appdata_path) ||
+       !File_Ops::create_directory(appdata_path + "cache") ||
+       !File_Ops::create_directory(appdata_path + "cache/textures"))
+    {
+      return false;
+    }
+
+    /// Write beside the entry and move it into place, so that readers and other writers never see it partially written
+    const String path = get_cache_path(filename);
+    const String temporary_path = File_Ops::get_temporary_path(path);
+    FILE * const file = fopen(temporary_path.c_str(), "wb");
+    if(!file)
+      return false;
+
+    bool good = fwrite(&header, sizeof(header), 1u, file) == 1u &&
+                (filename.empty() || fwrite(filename.c_str(), filename.size(), 1u, file) == 1u) &&
+                fwrite(&levels[0], sizeof(Image_Cache_Level), levels.size(), file) == levels.size();
+
+    for(size_t i = 0; good && i != levels.size(); ++i) {
+      static const char padding[g_alignment] = {0};
+      const long pad = long(levels[i].offset) - ftell(file);
+      good = pad >= 0 && (!pad || fwrite(padding, size_t(pad), 1u, file)) &&
+             (!levels[i].size || fwrite(images[i]->get_data(), levels[i].size, 1u, file));
+    }
+
+    if(fclose(file))
+      good = false;
+
+    if(good)
+      good = File_Ops::replace_file(temporary_path, path);
+
+    /// Never leave a partial entry behind
+    if(!good)
+      remove(temporary_path.c_str());
+
+    return good;
+  }
+
+  void Image_Cache::swap(Image &lhs, Image &rhs) {
+    std::swap(lhs.m_size, rhs.m_size);
+    std::swap(lhs.m_color_space, rhs.m_color_space);
+    std::swap(lhs.m_bytes_per_pixel, rhs.m_bytes_per_pixel);
+    std::swap(lhs.m_row_size, rhs.m_row_size);
+    std::swap(lhs.m_data, rhs.m_data);
+    std::swap(lhs.m_tileable, rhs.m_tileable);
+  }
+
+  String Image_Cache::get_cache_path(const String &filename) {
+    char name[16];
+    sprintf(name, "%08x.zimg", unsigned(hash_filename(filename)));
+
+    return get_File_Ops().get_appdata_path() + "cache/textures/" + name;
+  }
+
+}
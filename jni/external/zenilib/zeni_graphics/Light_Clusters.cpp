@@ -0,0 +1,319 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_graphics.h>
+
+#include <Zeni/Float4.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  /// Light::range defaults to 2^100, so anything this far is as good as unbounded
+  static const float g_unbounded_range = 1.0e30f;
+
+  /// The distance at which a Light dims below 1/256 of its brightest component, capped by Light::range
+  static float get_light_range(const Light &light) {
+    if(light.light_type == LIGHT_DIRECTIONAL)
+      return g_unbounded_range;
+
+    const float brightest = std::max(std::max(std::max(light.diffuse.r, light.diffuse.g), std::max(light.diffuse.b, light.specular.r)),
+                                     std::max(std::max(light.specular.g, light.specular.b), std::max(light.ambient.r, std::max(light.ambient.g, light.ambient.b))));
+
+    /// Solve quadratic * d^2 + linear * d + constant == 256 * brightest
+    const float c = light.constant_attenuation - 256.0f * brightest;
+    const float l = light.linear_attenuation;
+    const float q = light.quadratic_attenuation;
+
+    float reach = g_unbounded_range;
+    if(c >= 0.0f)
+      reach = 0.0f;
+    else if(q > 0.0f)
+      reach = (-l + std::sqrt(l * l - 4.0f * q * c)) / (2.0f * q);
+    else if(l > 0.0f)
+      reach = -c / l;
+
+    return std::min(light.range, reach);
+  }
+
+  static Vector3f rotate_to_view(const Matrix4f &view, const Vector3f &direction) {
+    return Vector3f(view.get_row(0) * direction, view.get_row(1) * direction, view.get_row(2) * direction).normalized();
+  }
+
+  static void pack_light(const Light &light, const Point3f &view_position, const Vector3f &view_direction, const float &range, float * const texels) {
+    const bool spot = light.light_type == LIGHT_SPOT && light.spot_phi < Global::pi;
+
+    if(light.light_type == LIGHT_DIRECTIONAL) {
+      texels[0] = -view_direction.i;
+      texels[1] = -view_direction.j;
+      texels[2] = -view_direction.k;
+      texels[3] = 3.0f;
+    }
+    else {
+      texels[0] = view_position.x;
+      texels[1] = view_position.y;
+      texels[2] = view_position.z;
+      texels[3] = spot ? 2.0f : 1.0f;
+    }
+
+    texels[4] = view_direction.i;
+    texels[5] = view_direction.j;
+    texels[6] = view_direction.k;
+    texels[7] = spot ? std::cos(0.5f * light.spot_phi) : -1.0f;
+
+    texels[8] = light.diffuse.r;
+    texels[9] = light.diffuse.g;
+    texels[10] = light.diffuse.b;
+    texels[11] = light.spot_exponent;
+
+    texels[12] = light.specular.r;
+    texels[13] = light.specular.g;
+    texels[14] = light.specular.b;
+    texels[15] = range;
+
+    texels[16] = light.ambient.r;
+    texels[17] = light.ambient.g;
+    texels[18] = light.ambient.b;
+    texels[19] = light.constant_attenuation;
+
+    texels[20] = light.linear_attenuation;
+    texels[21] = light.quadratic_attenuation;
+    texels[22] = 0.0f;
+    texels[23] = 0.0f;
+  }
+
+  /** Find the tiles covered by a sphere between depths 'd0' and 'd1'.
+   *  The lanes hold the left, right, bottom, and top of its bounding box,
+   *  each of which projects furthest out at one depth or the other.
+   */
+  static bool find_tiles(const Point3f &center, const float &radius, const float &d0, const float &d1,
+                         const Point2f &projection_scale, const int &columns, const int &rows, int (&tiles)[4])
+  {
+    const Float4 extent(center.x - radius, center.x + radius, center.y - radius, center.y + radius);
+    const Float4 scale0(projection_scale.x / d0, projection_scale.x / d0, projection_scale.y / d0, projection_scale.y / d0);
+    const Float4 scale1(projection_scale.x / d1, projection_scale.x / d1, projection_scale.y / d1, projection_scale.y / d1);
+
+    const Float4 ndc0 = extent * scale0;
+    const Float4 ndc1 = extent * scale1;
+    const Float4 upper = float4_less(Float4(0.0f), Float4(0.0f, 1.0f, 0.0f, 1.0f));
+    const Float4 ndc = float4_select(upper, float4_max(ndc0, ndc1), float4_min(ndc0, ndc1));
+
+    const Float4 size(static_cast<float>(columns), static_cast<float>(columns), static_cast<float>(rows), static_cast<float>(rows));
+    const Float4 half(0.5f);
+    float t[4];
+    ((ndc * half + half) * size).store(t);
+
+    if(t[1] < 0.0f || t[0] >= columns || t[3] < 0.0f || t[2] >= rows)
+      return false;
+
+    tiles[0] = std::max(0, int(std::floor(t[0])));
+    tiles[1] = std::min(columns - 1, int(std::floor(t[1])));
+    tiles[2] = std::max(0, int(std::floor(t[2])));
+    tiles[3] = std::min(rows - 1, int(std::floor(t[3])));
+    return true;
+  }
+
+  /// Assign the Lights reaching a span of slices to their clusters
+  class Light_Clusters::Slice_Span : public Span_Function {
+  public:
+    Slice_Span(Light_Clusters &clusters_) : clusters(clusters_) {}
+
+    void operator()(const size_t &begin, const size_t &end) const {
+      Light_Clusters &lc = clusters;
+      const size_t per_slice = size_t(lc.m_columns * lc.m_rows);
+      const float depth_ratio = lc.m_far_clip / lc.m_near_clip;
+
+      for(size_t s = begin; s != end; ++s) {
+        const float slice_near = lc.m_near_clip * std::pow(depth_ratio, float(s) / lc.m_slices);
+        const float slice_far = lc.m_near_clip * std::pow(depth_ratio, float(s + 1u) / lc.m_slices);
+        size_t * const counts = &lc.m_cluster_counts[s * per_slice];
+        size_t * const offsets = &lc.m_cluster_offsets[s * per_slice];
+        std::vector<float> &indices = lc.m_slice_indices[s];
+
+        std::fill(counts, counts + per_slice, size_t(0u));
+
+        for(int pass = 0; pass != 2; ++pass) {
+          if(pass) {
+            size_t total = 0u;
+            for(size_t c = 0; c != per_slice; ++c) {
+              offsets[c] = total;
+              total += counts[c];
+            }
+            indices.resize(total);
+          }
+
+          for(size_t e = lc.m_slice_begin[s]; e != lc.m_slice_begin[s + 1u]; ++e) {
+            const size_t light = lc.m_slice_lights[e];
+            const Point3f &center = lc.m_positions[light];
+            const float range = lc.m_ranges[light];
+            const float d0 = std::max(slice_near, -center.z - range);
+            const float d1 = std::min(slice_far, -center.z + range);
+
+            int tiles[4];
+            if(!find_tiles(center, range, d0, d1, lc.m_projection_scale, lc.m_columns, lc.m_rows, tiles))
+              continue;
+
+            for(int r = tiles[2]; r <= tiles[3]; ++r)
+              for(int c = tiles[0]; c <= tiles[1]; ++c) {
+                const size_t cluster = size_t(r * lc.m_columns + c);
+                if(pass) /// Counting back down to zero
+                  indices[offsets[cluster] + --counts[cluster]] = float(lc.m_texels[light]);
+                else
+                  ++counts[cluster];
+              }
+          }
+        }
+      }
+    }
+
+  private:
+    Light_Clusters &clusters;
+  };
+
+  Light_Clusters::Light_Clusters(const int &columns, const int &rows, const int &slices)
+    : m_columns(std::max(1, columns)),
+    m_rows(std::max(1, rows)),
+    m_slices(std::max(1, slices)),
+    m_near_clip(1.0f),
+    m_far_clip(2.0f),
+    m_num_unbounded(0u),
+    m_num_indices(0u)
+  {
+  }
+
+  size_t Light_Clusters::add(const Light &light) {
+    m_lights.push_back(light);
+    return m_lights.size() - 1u;
+  }
+
+  void Light_Clusters::clear() {
+    m_lights.clear();
+  }
+
+  void Light_Clusters::build(const Camera &camera, const std::pair<Point2i, Point2i> &viewport) {
+    const Matrix4f view = camera.get_view_matrix();
+    const float aspect = float(viewport.second.x - viewport.first.x) / std::max(1, viewport.second.y - viewport.first.y);
+    const float tan_y = std::tan(0.5f * camera.get_tunneled_fov_rad());
+
+    m_near_clip = camera.get_tunneled_near_clip();
+    m_far_clip = std::max(camera.get_tunneled_far_clip(), m_near_clip * 1.001f);
+    m_projection_scale = Point2f(1.0f / (tan_y * aspect), 1.0f / tan_y);
+
+    const size_t num_lights = m_lights.size();
+    const size_t per_slice = size_t(m_columns * m_rows);
+
+    /// Bring every Light into view space at once
+    m_positions.resize(num_lights);
+    m_ranges.resize(num_lights);
+    m_texels.resize(num_lights);
+    m_num_unbounded = 0u;
+    for(size_t i = 0; i != num_lights; ++i) {
+      m_positions[i] = m_lights[i].position;
+      m_ranges[i] = get_light_range(m_lights[i]);
+      if(m_ranges[i] >= g_unbounded_range)
+        ++m_num_unbounded;
+    }
+    if(num_lights)
+      transform_points(view, &m_positions[0], &m_positions[0], num_lights);
+
+    /// Unbounded Lights take the first texels, so they can be shaded without consulting any cluster
+    const size_t light_rows = std::max(size_t(1u), (num_lights + lights_per_row - 1u) / lights_per_row);
+    m_light_texels.assign(light_rows * lights_per_row * texels_per_light * 4u, 0.0f);
+
+    for(size_t i = 0, unbounded = 0u, bounded = m_num_unbounded; i != num_lights; ++i) {
+      m_texels[i] = m_ranges[i] >= g_unbounded_range ? unbounded++ : bounded++;
+      pack_light(m_lights[i], m_positions[i], rotate_to_view(view, m_lights[i].spot_direction), m_ranges[i],
+                 &m_light_texels[m_texels[i] * texels_per_light * 4u]);
+    }
+
+    /// Bin the bounded Lights by the slices they reach
+    const float slice_scale = m_slices / std::log(m_far_clip / m_near_clip);
+    m_slice_ranges.resize(2u * num_lights);
+    m_slice_begin.assign(size_t(m_slices) + 1u, 0u);
+
+    for(size_t i = 0; i != num_lights; ++i) {
+      int &first = m_slice_ranges[2u * i];
+      int &last = m_slice_ranges[2u * i + 1u];
+      first = last = -1;
+
+      const float depth = -m_positions[i].z;
+      const float range = m_ranges[i];
+      if(range >= g_unbounded_range || range <= 0.0f || depth + range < m_near_clip || depth - range > m_far_clip)
+        continue;
+
+      first = std::max(0, std::min(m_slices - 1, int(std::log(std::max(depth - range, m_near_clip) / m_near_clip) * slice_scale)));
+      last = std::max(0, std::min(m_slices - 1, int(std::log(std::min(depth + range, m_far_clip) / m_near_clip) * slice_scale)));
+
+      for(int s = first; s <= last; ++s)
+        ++m_slice_begin[size_t(s) + 1u];
+    }
+
+    for(size_t s = 1; s != m_slice_begin.size(); ++s)
+      m_slice_begin[s] += m_slice_begin[s - 1];
+
+    m_slice_lights.resize(m_slice_begin.back());
+    {
+      std::vector<size_t> cursor(m_slice_begin.begin(), m_slice_begin.end() - 1);
+      for(size_t i = 0; i != num_lights; ++i)
+        for(int s = m_slice_ranges[2u * i]; s != -1 && s <= m_slice_ranges[2u * i + 1u]; ++s)
+          m_slice_lights[cursor[size_t(s)]++] = i;
+    }
+
+    /// Slices own disjoint clusters, so they can be filled in parallel
+    m_cluster_counts.resize(per_slice * m_slices);
+    m_cluster_offsets.resize(per_slice * m_slices);
+    m_slice_indices.resize(size_t(m_slices));
+
+    const Slice_Span span(*this);
+    if(m_slice_lights.size() >= 1024u)
+      get_Job_System().parallel_for(span, size_t(m_slices));
+    else
+      span(0u, size_t(m_slices));
+
+    /// Concatenate the slices
+    m_num_indices = 0u;
+    for(size_t s = 0; s != size_t(m_slices); ++s)
+      m_num_indices += m_slice_indices[s].size();
+
+    const size_t index_rows = std::max(size_t(1u), (m_num_indices + indices_per_row - 1u) / indices_per_row);
+    m_index_texels.resize(index_rows * indices_per_row);
+    m_cluster_texels.resize(per_slice * m_slices * 4u);
+
+    for(size_t s = 0, base = 0u; s != size_t(m_slices); ++s) {
+      const std::vector<float> &indices = m_slice_indices[s];
+      std::copy(indices.begin(), indices.end(), m_index_texels.begin() + base);
+
+      for(size_t c = s * per_slice; c != (s + 1u) * per_slice; ++c) {
+        const size_t end = c + 1u != (s + 1u) * per_slice ? m_cluster_offsets[c + 1u] : indices.size();
+        float * const texel = &m_cluster_texels[4u * c];
+        texel[0] = float(base + m_cluster_offsets[c]);
+        texel[1] = float(end - m_cluster_offsets[c]);
+        texel[2] = 0.0f;
+        texel[3] = 0.0f;
+      }
+
+      base += indices.size();
+    }
+  }
+
+}
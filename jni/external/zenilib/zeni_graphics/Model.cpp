@@ -35,9 +35,20 @@ namespace Zeni {
 
   class Model_Renderer : public Model_Visitor {
   public:
+    /// If 'frustum_' is given, 'model_to_parent_' must be the transformation applied to the Model as a whole
+    Model_Renderer(const Frustum * const &frustum_ = 0, const Matrix4f &model_to_parent_ = Matrix4f::Identity())
+      : frustum(frustum_),
+      model_to_parent(model_to_parent_)
+    {
+    }
+
     virtual void operator()(const Model &model, Lib3dsMeshInstanceNode * const &node, Lib3dsMesh * const &mesh);
 
     void create_vertex_buffer(Vertex_Buffer * const &user_p, const Model &model, Lib3dsMeshInstanceNode * const &node, Lib3dsMesh * const &mesh);
+
+  private:
+    const Frustum * frustum;
+    Matrix4f model_to_parent;
   };
 
   void Model_Renderer::create_vertex_buffer(Vertex_Buffer * const &user_p, const Model &model, Lib3dsMeshInstanceNode * const &node, Lib3dsMesh * const &mesh) {
@@ -317,6 +328,14 @@ namespace Zeni {
   }
 
   void Model::render() const {
+    render_meshes(0);
+  }
+
+  void Model::render(const Frustum &frustum) const {
+    render_meshes(&frustum);
+  }
+
+  void Model::render_meshes(const Frustum * const &frustum) const {
 //     GUARANTEED_FINISHED_BEGIN(m_loader);
     
     if(!m_unrenderer)
@@ -330,7 +349,10 @@ namespace Zeni {
     vr.rotate_scene(m_rotate, m_rotate_angle);
     vr.scale_scene(m_scale);
 
-    Model_Renderer mr;
+    Model_Renderer mr(frustum,
+                      Matrix4f::Translate(Vector3f(m_translate)) *
+                      Matrix4f::Rotate(Quaternion::Axis_Angle(m_rotate, m_rotate_angle)) *
+                      Matrix4f::Scale(m_scale));
     visit_meshes(mr);
 
     vr.pop_world_stack();
@@ -351,16 +373,26 @@ namespace Zeni {
 
     vr.push_world_stack();
 
+    Matrix4f mesh_to_model = Matrix4f::Identity();
+
     if(node) {
+      const Vector3f pivot(-node->pivot[0],
+                           -node->pivot[1],
+                           -node->pivot[2]);
+
       vr.transform_scene(reinterpret_cast<const Matrix4f &>(node->base.matrix));
-      vr.translate_scene(Vector3f(-node->pivot[0],
-                                  -node->pivot[1],
-                                  -node->pivot[2]));
+      vr.translate_scene(pivot);
+
+      mesh_to_model = reinterpret_cast<const Matrix4f &>(node->base.matrix) * Matrix4f::Translate(pivot);
     }
-    vr.transform_scene(reinterpret_cast<const Matrix4f &>(mesh->matrix).inverted());
+    const Matrix4f mesh_inverse = reinterpret_cast<const Matrix4f &>(mesh->matrix).inverted();
+    vr.transform_scene(mesh_inverse);
 
     //user_p->debug_render(); ///HACK
-    user_p->render();
+    if(frustum)
+      user_p->render(frustum->transformed(model_to_parent * mesh_to_model * mesh_inverse));
+    else
+      user_p->render();
 
     vr.pop_world_stack();
   }
@@ -394,8 +426,43 @@ namespace Zeni {
 //   }
   
 #ifndef TEMP_DISABLE
+  static long archive_seek(void *self, long offset, Lib3dsIoSeek origin) {
+    return static_cast<Archive_Reader *>(self)->seek(offset, origin == LIB3DS_SEEK_SET ? SEEK_SET : origin == LIB3DS_SEEK_CUR ? SEEK_CUR : SEEK_END) ? 0 : -1;
+  }
+
+  static long archive_tell(void *self) {
+    return static_cast<Archive_Reader *>(self)->tell();
+  }
+
+  static size_t archive_read(void *self, void *buffer, size_t size) {
+    return static_cast<Archive_Reader *>(self)->read(buffer, size);
+  }
+
+  static size_t archive_write(void *, const void *, size_t) {
+    return 0;
+  }
+
   void Model::load() {
-    m_file = lib3ds_file_open(m_filename.c_str());
+    if(const Archive * const archive = File_Ops::find_Archive(m_filename)) {
+      Archive_Reader reader(*archive, m_filename);
+
+      Lib3dsIo io;
+      memset(&io, 0, sizeof(io));
+      io.self = &reader;
+      io.seek_func = archive_seek;
+      io.tell_func = archive_tell;
+      io.read_func = archive_read;
+      io.write_func = archive_write;
+
+      m_file = lib3ds_file_new();
+      if(m_file && !lib3ds_file_read(m_file, &io)) {
+        lib3ds_file_free(m_file);
+        m_file = 0;
+      }
+    }
+    else
+      m_file = lib3ds_file_open(m_filename.c_str());
+
     if(!m_file)
       throw Model_Init_Failure();
 
@@ -0,0 +1,363 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_graphics.h>
+
+#include <Zeni/Float4.h>
+
+#include <algorithm>
+
+#ifndef DISABLE_DX9
+#include <d3dx9.h>
+#endif
+
+#ifndef DISABLE_GL
+#if defined(REQUIRE_GL_ES)
+#include <GLES/gl.h>
+#else
+#include <GL/glew.h>
+#endif
+#endif
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  /// Uint16 indices reach 65536 vertices, so larger systems are drawn in chunks
+  static const size_t g_particles_per_chunk = 16384u;
+
+  /// Fewer particles than this are not worth splitting across the Job_System
+  static const size_t g_particles_min_parallel = 16384u;
+
+  /// Move, grow, and fade a span of groups of four particles, marking those that expire
+  class Particle_System::Update_Span : public Span_Function {
+  public:
+    Update_Span(Particle_System &system_, const float &time_step_, const float &damping_)
+      : system(system_),
+      time_step(time_step_),
+      damping(damping_)
+    {
+    }
+
+    void operator()(const size_t &begin, const size_t &end) const {
+      Particle_System &ps = system;
+      const Float4 dt(time_step);
+      const Float4 damp(damping);
+      const Float4 one(1.0f);
+      const Float4 ax(ps.m_acceleration.i * time_step);
+      const Float4 ay(ps.m_acceleration.j * time_step);
+      const Float4 az(ps.m_acceleration.k * time_step);
+
+      for(size_t group = begin; group != end; ++group) {
+        const size_t i = 4u * group;
+
+        const Float4 vx = Float4::load(&ps.m_vx[i]) * damp + ax;
+        const Float4 vy = Float4::load(&ps.m_vy[i]) * damp + ay;
+        const Float4 vz = Float4::load(&ps.m_vz[i]) * damp + az;
+        vx.store(&ps.m_vx[i]);
+        vy.store(&ps.m_vy[i]);
+        vz.store(&ps.m_vz[i]);
+        (Float4::load(&ps.m_x[i]) + vx * dt).store(&ps.m_x[i]);
+        (Float4::load(&ps.m_y[i]) + vy * dt).store(&ps.m_y[i]);
+        (Float4::load(&ps.m_z[i]) + vz * dt).store(&ps.m_z[i]);
+
+        const Float4 age = Float4::load(&ps.m_age[i]) + dt;
+        age.store(&ps.m_age[i]);
+
+        /// The fraction of its lifetime each particle has lived
+        const Float4 t = float4_min(age * Float4::load(&ps.m_inv_lifetime[i]), one);
+        (Float4::load(&ps.m_start_size[i]) + t * Float4::load(&ps.m_size_change[i])).store(&ps.m_size[i]);
+        (Float4::load(&ps.m_start_alpha[i]) * (one - t)).store(&ps.m_alpha[i]);
+
+        ps.m_expired[group] = Uint8(~float4_mask_bits(float4_less(t, one)) & 0xF);
+      }
+    }
+
+  private:
+    Particle_System &system;
+    float time_step;
+    float damping;
+  };
+
+  /// Build the camera-facing quads of a span of particles
+  class Particle_System::Vertex_Span : public Span_Function {
+  public:
+    Vertex_Span(const Particle_System &system_, const bool &rgba_)
+      : system(system_),
+      rgba(rgba_)
+    {
+    }
+
+    void operator()(const size_t &begin, const size_t &end) const {
+      const Particle_System &ps = system;
+      const Vector3f right = 0.5f * ps.m_right;
+      const Vector3f up = 0.5f * ps.m_up;
+
+      /// Copies, not references, so that writing the vertices cannot force the particles to be read again
+      for(size_t i = begin; i != end; ++i) {
+        const float size = ps.m_size[i];
+        const float rx = right.i * size, ry = right.j * size, rz = right.k * size;
+        const float ux = up.i * size, uy = up.j * size, uz = up.k * size;
+        const float x = ps.m_x[i], y = ps.m_y[i], z = ps.m_z[i];
+
+        const Uint32 argb = (Uint32(std::min(std::max(ps.m_alpha[i], 0.0f), 1.0f) * 255.0f + 0.5f) << 24) | ps.m_rgb[i];
+        const Uint32 color = rgba ? ((argb & 0x000000FF) << 16) | ((argb & 0x00FF0000) >> 16) | (argb & 0xFF00FF00) : argb;
+
+        Vertex * const quad = &ps.m_vertices[4u * i];
+        const Vertex a = {x - rx + ux, y - ry + uy, z - rz + uz, color, 0.0f, 0.0f};
+        const Vertex b = {x - rx - ux, y - ry - uy, z - rz - uz, color, 0.0f, 1.0f};
+        const Vertex c = {x + rx - ux, y + ry - uy, z + rz - uz, color, 1.0f, 1.0f};
+        const Vertex d = {x + rx + ux, y + ry + uy, z + rz + uz, color, 1.0f, 0.0f};
+        quad[0] = a;
+        quad[1] = b;
+        quad[2] = c;
+        quad[3] = d;
+      }
+    }
+
+  private:
+    const Particle_System &system;
+    bool rgba;
+  };
+
+  Particle_System::Emitter::Emitter()
+    : rate(100.0f),
+    lifetime(1.0f),
+    start_size(1.0f),
+    end_size(1.0f),
+    enabled(true)
+  {
+  }
+
+  Particle_System::Particle_System(const size_t &capacity)
+    : m_num_particles(0u),
+    m_capacity((capacity + 3u) & ~size_t(3u)),
+    m_drag(0.0f),
+    m_multithreaded(true),
+    m_right(0.0f, -1.0f, 0.0f),
+    m_up(0.0f, 0.0f, 1.0f)
+  {
+    /// Whole groups of four are always allocated, so that update() never needs a scalar remainder
+    std::vector<float> * const arrays[] = {&m_x, &m_y, &m_z, &m_vx, &m_vy, &m_vz, &m_age, &m_inv_lifetime,
+                                           &m_start_size, &m_size_change, &m_start_alpha, &m_size, &m_alpha};
+    for(size_t i = 0; i != sizeof(arrays) / sizeof(arrays[0]); ++i)
+      arrays[i]->resize(m_capacity);
+    m_rgb.resize(m_capacity);
+    m_expired.resize(m_capacity / 4u);
+
+    const size_t quads = std::min(m_capacity, g_particles_per_chunk);
+    m_indices.resize(6u * quads);
+    for(size_t q = 0; q != quads; ++q) {
+      const Uint16 v = Uint16(4u * q);
+      Uint16 * const index = &m_indices[6u * q];
+      index[0] = v;
+      index[1] = Uint16(v + 1u);
+      index[2] = Uint16(v + 2u);
+      index[3] = v;
+      index[4] = Uint16(v + 2u);
+      index[5] = Uint16(v + 3u);
+    }
+  }
+
+  size_t Particle_System::create_emitter(const Emitter &emitter) {
+    Emitter_Slot slot;
+    slot.emitter = emitter;
+    slot.carry = 0.0f;
+    slot.live = true;
+
+    if(m_free_emitters.empty()) {
+      m_emitters.push_back(slot);
+      return m_emitters.size() - 1u;
+    }
+
+    const size_t handle = m_free_emitters.back();
+    m_free_emitters.pop_back();
+    m_emitters[handle] = slot;
+    return handle;
+  }
+
+  void Particle_System::destroy_emitter(const size_t &emitter) {
+    assert(emitter < m_emitters.size() && m_emitters[emitter].live);
+
+    m_emitters[emitter].live = false;
+    m_free_emitters.push_back(emitter);
+  }
+
+  void Particle_System::emit(const Emitter &emitter, const size_t &count) {
+    spawn(emitter, count);
+  }
+
+  void Particle_System::clear() {
+    m_num_particles = 0u;
+  }
+
+  void Particle_System::face(const Camera &camera) {
+    m_right = -camera.get_left();
+    m_up = camera.get_up();
+  }
+
+  void Particle_System::update(const float &time_step) {
+    const size_t groups = (m_num_particles + 3u) / 4u;
+    const Update_Span span(*this, time_step, std::max(0.0f, 1.0f - m_drag * time_step));
+    if(m_multithreaded)
+      for_each_span(span, groups, g_particles_min_parallel / 4u);
+    else
+      span(0u, groups);
+
+    /** Replace each expired particle with the last.  Working from the back,
+     *  every particle past the one being replaced has already been checked.
+     */
+    for(size_t group = groups; group-- != 0u; ) {
+      const Uint8 expired = m_expired[group];
+      if(!expired)
+        continue;
+
+      for(size_t lane = 4u; lane-- != 0u; ) {
+        const size_t i = 4u * group + lane;
+        if((expired & (1u << lane)) && i < m_num_particles)
+          move_particle(--m_num_particles, i);
+      }
+    }
+
+    for(std::vector<Emitter_Slot>::iterator it = m_emitters.begin(); it != m_emitters.end(); ++it) {
+      if(!it->live || !it->emitter.enabled)
+        continue;
+
+      it->carry += it->emitter.rate * time_step;
+      const size_t count = size_t(std::max(it->carry, 0.0f));
+      it->carry -= float(count);
+      spawn(it->emitter, count);
+    }
+  }
+
+  bool Particle_System::is_3d() const {
+    return true;
+  }
+
+#ifndef DISABLE_GL_FIXED
+  void Particle_System::render_to(Video_GL_Fixed &) const {
+    render_gl();
+  }
+#endif
+
+#ifndef DISABLE_GL_SHADER
+  void Particle_System::render_to(Video_GL_Shader &) const {
+    render_gl();
+  }
+#endif
+
+#ifndef DISABLE_DX9
+  void Particle_System::render_to(Video_DX9 &screen) const {
+    if(!m_num_particles)
+      return;
+
+    fill_vertices(false);
+
+    screen.get_d3d_device()->SetFVF(D3DFVF_XYZ | D3DFVF_DIFFUSE | D3DFVF_TEX1);
+
+    for(size_t first = 0; first < m_num_particles; first += g_particles_per_chunk) {
+      const size_t quads = std::min(g_particles_per_chunk, m_num_particles - first);
+      screen.get_d3d_device()->DrawIndexedPrimitiveUP(D3DPT_TRIANGLELIST, 0, UINT(4u * quads), UINT(2u * quads),
+                                                      &m_indices[0], D3DFMT_INDEX16, &m_vertices[4u * first], sizeof(Vertex));
+    }
+
+    screen.set_fvf_3d(screen.is_fvf_3d());
+  }
+#endif
+
+  void Particle_System::spawn(const Emitter &emitter, const size_t &count) {
+    const size_t end = std::min(m_capacity, m_num_particles + count);
+    const float inv_lifetime = 1.0f / std::max(emitter.lifetime, 0.0001f);
+    const Uint32 rgb = emitter.color.get_argb() & 0x00FFFFFF;
+
+    for(size_t i = m_num_particles; i != end; ++i) {
+      m_x[i] = emitter.position.x + emitter.position_spread.i * (2.0f * m_random.frand_lte() - 1.0f);
+      m_y[i] = emitter.position.y + emitter.position_spread.j * (2.0f * m_random.frand_lte() - 1.0f);
+      m_z[i] = emitter.position.z + emitter.position_spread.k * (2.0f * m_random.frand_lte() - 1.0f);
+      m_vx[i] = emitter.velocity.i + emitter.velocity_spread.i * (2.0f * m_random.frand_lte() - 1.0f);
+      m_vy[i] = emitter.velocity.j + emitter.velocity_spread.j * (2.0f * m_random.frand_lte() - 1.0f);
+      m_vz[i] = emitter.velocity.k + emitter.velocity_spread.k * (2.0f * m_random.frand_lte() - 1.0f);
+      m_age[i] = 0.0f;
+      m_inv_lifetime[i] = inv_lifetime;
+      m_start_size[i] = emitter.start_size;
+      m_size_change[i] = emitter.end_size - emitter.start_size;
+      m_start_alpha[i] = emitter.color.a;
+      m_size[i] = emitter.start_size;
+      m_alpha[i] = emitter.color.a;
+      m_rgb[i] = rgb;
+    }
+
+    m_num_particles = end;
+  }
+
+  void Particle_System::move_particle(const size_t &from, const size_t &to) {
+    m_x[to] = m_x[from];
+    m_y[to] = m_y[from];
+    m_z[to] = m_z[from];
+    m_vx[to] = m_vx[from];
+    m_vy[to] = m_vy[from];
+    m_vz[to] = m_vz[from];
+    m_age[to] = m_age[from];
+    m_inv_lifetime[to] = m_inv_lifetime[from];
+    m_start_size[to] = m_start_size[from];
+    m_size_change[to] = m_size_change[from];
+    m_start_alpha[to] = m_start_alpha[from];
+    m_size[to] = m_size[from];
+    m_alpha[to] = m_alpha[from];
+    m_rgb[to] = m_rgb[from];
+  }
+
+  void Particle_System::fill_vertices(const bool &rgba) const {
+    m_vertices.resize(4u * m_num_particles);
+
+    const Vertex_Span span(*this, rgba);
+    if(m_multithreaded)
+      for_each_span(span, m_num_particles, g_particles_min_parallel);
+    else
+      span(0u, m_num_particles);
+  }
+
+#ifndef DISABLE_GL
+  void Particle_System::render_gl() const {
+    if(!m_num_particles)
+      return;
+
+    fill_vertices(true);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    for(size_t first = 0; first < m_num_particles; first += g_particles_per_chunk) {
+      const size_t quads = std::min(g_particles_per_chunk, m_num_particles - first);
+      const Vertex &vertex = m_vertices[4u * first];
+      glVertexPointer(3, GL_FLOAT, sizeof(Vertex), &vertex.x);
+      glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), &vertex.color);
+      glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &vertex.u);
+      glDrawElements(GL_TRIANGLES, GLsizei(6u * quads), GL_UNSIGNED_SHORT, &m_indices[0]);
+    }
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+  }
+#endif
+
+}
@@ -0,0 +1,84 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_graphics.h>
+
+#ifndef DISABLE_DX9
+#include <d3dx9.h>
+#endif
+
+#ifndef DISABLE_GL
+#if defined(REQUIRE_GL_ES)
+#include <GLES/gl.h>
+#else
+#include <GL/glew.h>
+#endif
+#endif
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+#include <Zeni/Primitive_Batch.hxx>
+
+namespace Zeni {
+
+#ifndef DISABLE_GL_SHADER
+  template <>
+  void Primitive_Batch<Vertex2f_Color>::render_to(Video_GL_Shader &) const {
+    if(m_vertices.empty())
+      return;
+
+    m_colors.resize(m_vertices.size());
+    for(size_t i = 0; i != m_vertices.size(); ++i) {
+      const Uint32 &argb = m_vertices[i].get_Color();
+      m_colors[i] = ((argb & 0x000000FF) << 16) | ((argb & 0x00FF0000) >> 16) | (argb & 0xFF00FF00);
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex2f_Color), m_vertices[0].get_address());
+    glEnableClientState(GL_COLOR_ARRAY);
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, &m_colors[0]);
+
+    glDrawArrays(m_primitive == LINES ? GL_LINES : GL_TRIANGLES, 0, GLsizei(m_vertices.size()));
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+  }
+
+  template <>
+  void Primitive_Batch<Vertex2f_Texture>::render_to(Video_GL_Shader &) const {
+    if(m_vertices.empty())
+      return;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex2f_Texture), m_vertices[0].get_address());
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex2f_Texture), &m_vertices[0].texture_coordinate);
+
+    glDrawArrays(m_primitive == LINES ? GL_LINES : GL_TRIANGLES, 0, GLsizei(m_vertices.size()));
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+  }
+#endif
+
+  template class Primitive_Batch<Vertex2f_Color>;
+  template class Primitive_Batch<Vertex2f_Texture>;
+
+}
@@ -0,0 +1,230 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_graphics.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+#if !defined(DISABLE_GL) && !defined(DISABLE_GL_SHADER)
+
+namespace Zeni {
+
+  static const char g_program_magic[4] = {'Z', 'P', 'R', 'G'};
+  static const Uint32 g_program_version = 1u;
+
+  struct Program_Cache_Header {
+    char magic[4];
+    Uint32 version;
+    Uint32 source_hash;
+    Uint32 source_size;
+    Uint32 driver_hash;
+    Uint32 format;
+    Uint32 size;
+    Uint32 build_microseconds;
+  };
+
+  /// FNV-1a, continuing from 'hash'
+  static Uint32 hash_bytes(const char * const data, const size_t &size, Uint32 hash = 2166136261u) {
+    for(size_t i = 0; i != size; ++i) {
+      hash ^= Uint8(data[i]);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  /// Programs linked by a different driver, or even a different version of it, must not be reused
+  static Uint32 hash_driver() {
+    Uint32 hash = 2166136261u;
+
+    const GLenum names[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    for(int i = 0; i != 3; ++i) {
+      const char * const str = reinterpret_cast<const char *>(glGetString(names[i]));
+      if(str)
+        hash = hash_bytes(str, strlen(str), hash);
+      hash = hash_bytes("\n", 1u, hash);
+    }
+
+    return hash;
+  }
+
+  static void describe_program(const String &source, Program_Cache_Header &header) {
+    memcpy(header.magic, g_program_magic, sizeof(g_program_magic));
+    header.version = g_program_version;
+    header.source_hash = hash_bytes(source.c_str(), source.size());
+    header.source_size = Uint32(source.size());
+    header.driver_hash = hash_driver();
+  }
+
+  bool Program_Cache::is_supported() {
+#ifdef REQUIRE_GL_ES
+    return false;
+#else
+    if(!GLEW_ARB_get_program_binary && !GLEW_VERSION_4_1)
+      return false;
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+#endif
+  }
+
+  bool Program_Cache::load(const GLuint &program, const String &source) {
+    const Time_HQ start;
+
+    float build_seconds;
+    if(!read(program, source, build_seconds)) {
+      ++m_misses;
+      return false;
+    }
+
+    ++m_hits;
+    m_seconds_saved += build_seconds - float(start.get_seconds_passed());
+    return true;
+  }
+
+  bool Program_Cache::store(const GLuint &program, const String &source, const float &build_seconds) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if(length <= 0)
+      return false;
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &written, &format, &binary[0]);
+    if(written <= 0)
+      return false;
+
+    Program_Cache_Header header;
+    describe_program(source, header);
+    header.format = Uint32(format);
+    header.size = Uint32(written);
+    header.build_microseconds = Uint32(std::max(build_seconds, 0.0f) * 1000000.0f);
+
+    File_Ops &fo = get_File_Ops();
+    const String appdata_path = fo.get_appdata_path();
+    if(!File_Ops::create_directory(appdata_path) ||
+       !File_Ops::create_directory(appdata_path + "cache") ||
+       !File_Ops::create_directory(appdata_path + "cache/programs"))
+    {
+      return false;
+    }
+
+    /// Write beside the entry and move it into place, so that readers and other writers never see it partially written
+    const String path = get_cache_path(source);
+    const String temporary_path = File_Ops::get_temporary_path(path);
+    FILE * const file = fopen(temporary_path.c_str(), "wb");
+    if(!file)
+      return false;
+
+    bool good = fwrite(&header, sizeof(header), 1u, file) &&
+                fwrite(&binary[0], header.size, 1u, file);
+
+    if(fclose(file))
+      good = false;
+
+    if(good)
+      good = File_Ops::replace_file(temporary_path, path);
+
+    /// Never leave a partial entry behind
+    if(!good)
+      remove(temporary_path.c_str());
+
+    return good;
+  }
+
+  String Program_Cache::get_cache_path(const String &source) {
+    char name[24];
+    sprintf(name, "%08x%08x.zprg", unsigned(hash_bytes(source.c_str(), source.size())), unsigned(hash_driver()));
+
+    return get_File_Ops().get_appdata_path() + "cache/programs/" + name;
+  }
+
+  void Program_Cache::reset_stats() {
+    m_hits = 0u;
+    m_misses = 0u;
+    m_seconds_saved = 0.0f;
+  }
+
+  bool Program_Cache::read(const GLuint &program, const String &source, float &build_seconds) {
+    FILE * const file = fopen(get_cache_path(source).c_str(), "rb");
+    if(!file)
+      return false;
+
+    class file_Destroyer {
+    public:
+      file_Destroyer(FILE * const &file_) : m_file(file_) {}
+      ~file_Destroyer() {fclose(m_file);}
+
+    private:
+      FILE * m_file;
+    } file_destroyer(file);
+
+    Program_Cache_Header expected;
+    describe_program(source, expected);
+
+    Program_Cache_Header header;
+    if(!fread(&header, sizeof(header), 1u, file) ||
+       memcmp(header.magic, expected.magic, sizeof(header.magic)) ||
+       header.version != expected.version ||
+       header.source_hash != expected.source_hash ||
+       header.source_size != expected.source_size ||
+       header.driver_hash != expected.driver_hash ||
+       !header.size)
+    {
+      return false;
+    }
+
+    /// Never trust the header to describe more than the file contains
+    const long start = ftell(file);
+    if(start < 0 || fseek(file, 0, SEEK_END))
+      return false;
+    const long end = ftell(file);
+    if(end < start || Uint64(header.size) > Uint64(end - start) || fseek(file, start, SEEK_SET))
+      return false;
+
+    std::vector<char> binary(header.size);
+    if(fread(&binary[0], header.size, 1u, file) != 1u)
+      return false;
+
+    /// The driver may still reject a binary, after an update for example
+    glProgramBinary(program, GLenum(header.format), &binary[0], GLsizei(header.size));
+
+    GLint rv = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &rv);
+    if(rv != GL_TRUE)
+      return false;
+
+    build_seconds = header.build_microseconds / 1000000.0f;
+    return true;
+  }
+
+  bool Program_Cache::m_enabled = false;
+  size_t Program_Cache::m_hits = 0u;
+  size_t Program_Cache::m_misses = 0u;
+  float Program_Cache::m_seconds_saved = 0.0f;
+
+}
+
+#endif
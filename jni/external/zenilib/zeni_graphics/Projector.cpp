@@ -17,3 +17,55 @@
 
 #include <zeni_graphics.h>
 
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  /// Transform a span of Point3fs into camera space and then onto the screen
+  class Projector3D_Span : public Span_Function {
+  public:
+    Projector3D_Span(const Matrix4f &world_to_camera_, const Vector3f &uln_, const Vector3f &uln2lrf_, const float &near2far_, const Vector3f &size_, const Vector3f &offset_, const Point3f * const &in_, Point3f * const &out_)
+      : world_to_camera(world_to_camera_),
+      uln(uln_),
+      inv_uln2lrf(1.0f / uln2lrf_.i, 1.0f / uln2lrf_.j, 1.0f / uln2lrf_.k),
+      near2far_minus_one(near2far_ - 1.0f),
+      size(size_),
+      offset(offset_),
+      in(in_),
+      out(out_)
+    {
+    }
+
+    void operator()(const size_t &begin, const size_t &end) const {
+      transform_points(world_to_camera, in + begin, out + begin, end - begin);
+
+      for(Point3f * point = out + begin, * const point_end = out + end; point != point_end; ++point) {
+        const float z_value = (point->z - uln.k) * inv_uln2lrf.k;
+        const float inv_scale = 1.0f / (z_value * near2far_minus_one + 1.0f);
+
+        point->x = (point->x * inv_scale - uln.i) * inv_uln2lrf.i * size.i + offset.i;
+        point->y = (point->y * inv_scale - uln.j) * inv_uln2lrf.j * size.j + offset.j;
+        point->z = z_value * size.k + offset.k;
+      }
+    }
+
+  private:
+    const Matrix4f &world_to_camera;
+    Vector3f uln;
+    Vector3f inv_uln2lrf;
+    float near2far_minus_one;
+    Vector3f size;
+    Vector3f offset;
+    const Point3f * const in;
+    Point3f * const out;
+  };
+
+  void Projector3D::project_points(const Point3f * const in, Point3f * const out, const size_t &count) const {
+    for_each_span(Projector3D_Span(m_world_to_camera, m_uln, m_uln2lrf, m_near2far, size(), offset(), in, out), count, 65536u);
+  }
+
+}
+
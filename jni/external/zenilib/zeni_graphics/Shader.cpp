@@ -21,9 +21,95 @@
 #include <d3dx9shader.h>
 #endif
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <iostream>
 
 namespace Zeni {
+
+  int Program::get_uniform(const String &) const {
+    return -1;
+  }
+
+  int Program::get_attribute(const String &) const {
+    return -1;
+  }
+
+  void Program::set_uniform(const int &uniform, const int &value) {
+    set_uniform_data(uniform, UNIFORM_INT, &value, 1u);
+  }
+
+  void Program::set_uniform(const int &uniform, const float &value) {
+    set_uniform_data(uniform, UNIFORM_FLOAT, &value, 1u);
+  }
+
+  void Program::set_uniform(const int &uniform, const Point2f &value) {
+    const float data[2] = {value.x, value.y};
+    set_uniform_data(uniform, UNIFORM_VEC2, data, 1u);
+  }
+
+  void Program::set_uniform(const int &uniform, const Vector3f &value) {
+    const float data[3] = {value.i, value.j, value.k};
+    set_uniform_data(uniform, UNIFORM_VEC3, data, 1u);
+  }
+
+  void Program::set_uniform(const int &uniform, const Color &value) {
+    const float data[4] = {value.r, value.g, value.b, value.a};
+    set_uniform_data(uniform, UNIFORM_VEC4, data, 1u);
+  }
+
+  void Program::set_uniform(const int &uniform, const Matrix4f &value) {
+    set_uniform_data(uniform, UNIFORM_MAT4, reinterpret_cast<const float *>(&value), 1u);
+  }
+
+  void Program::set_uniform(const int &uniform, const int * const &values, const size_t &count) {
+    set_uniform_data(uniform, UNIFORM_INT, values, count);
+  }
+
+  void Program::set_uniform(const int &uniform, const float * const &values, const size_t &count) {
+    set_uniform_data(uniform, UNIFORM_FLOAT, values, count);
+  }
+
+  void Program::set_uniform(const int &uniform, const Point2f * const &values, const size_t &count) {
+    std::vector<float> data(2u * count);
+    for(size_t i = 0; i != count; ++i) {
+      data[2u * i] = values[i].x;
+      data[2u * i + 1u] = values[i].y;
+    }
+    set_uniform_data(uniform, UNIFORM_VEC2, count ? &data[0] : 0, count);
+  }
+
+  void Program::set_uniform(const int &uniform, const Vector3f * const &values, const size_t &count) {
+    std::vector<float> data(3u * count);
+    for(size_t i = 0; i != count; ++i) {
+      data[3u * i] = values[i].i;
+      data[3u * i + 1u] = values[i].j;
+      data[3u * i + 2u] = values[i].k;
+    }
+    set_uniform_data(uniform, UNIFORM_VEC3, count ? &data[0] : 0, count);
+  }
+
+  void Program::set_uniform(const int &uniform, const Color * const &values, const size_t &count) {
+    std::vector<float> data(4u * count);
+    for(size_t i = 0; i != count; ++i) {
+      data[4u * i] = values[i].r;
+      data[4u * i + 1u] = values[i].g;
+      data[4u * i + 2u] = values[i].b;
+      data[4u * i + 3u] = values[i].a;
+    }
+    set_uniform_data(uniform, UNIFORM_VEC4, count ? &data[0] : 0, count);
+  }
+
+  void Program::set_uniform(const int &uniform, const Matrix4f * const &values, const size_t &count) {
+    std::vector<float> data(16u * count);
+    for(size_t i = 0; i != count; ++i)
+      memcpy(&data[16u * i], &values[i], 16u * sizeof(float));
+    set_uniform_data(uniform, UNIFORM_MAT4, count ? &data[0] : 0, count);
+  }
+
+  void Program::set_uniform_data(const int &, const Uniform_Type &, const void * const &, const size_t &) {
+  }
   
 #ifndef DISABLE_GL_FIXED
   Shader_GL_Fixed::Shader_GL_Fixed(const String &shader_src, const Type &type)
@@ -71,12 +157,29 @@ namespace Zeni {
 
 #ifndef DISABLE_GL_SHADER
   Shader_GL_Shader::Shader_GL_Shader(const String &shader_src, const Type &type)
-    : m_shader(glCreateShader(type == VERTEX ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER))
+    : m_shader(glCreateShader(type == VERTEX ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER)),
+    m_source(shader_src),
+    m_type(type),
+    m_compiled(false)
   {
-    const char * src_ptr = shader_src.c_str();
-    glShaderSource(m_shader, 1, reinterpret_cast<const GLchar **>(&src_ptr), 0);
     if(!m_shader)
       throw Shader_Init_Failure();
+
+    /// A cached Program may never need it compiled
+    if(!Program_Cache::is_enabled())
+      compile();
+  }
+
+  Shader_GL_Shader::~Shader_GL_Shader() {
+    glDeleteShader(m_shader);
+  }
+
+  void Shader_GL_Shader::compile() {
+    if(m_compiled)
+      return;
+
+    const char * src_ptr = m_source.c_str();
+    glShaderSource(m_shader, 1, reinterpret_cast<const GLchar **>(&src_ptr), 0);
     glCompileShader(m_shader);
 
     // Check vertex shader
@@ -89,18 +192,23 @@ namespace Zeni {
       std::cerr << "Shader initialization failure: " << log << std::endl;
       throw Shader_Init_Failure();
     }
-  }
 
-  Shader_GL_Shader::~Shader_GL_Shader() {
-    glDeleteShader(m_shader);
+    m_compiled = true;
   }
   
+  Program_GL_Shader * Program_GL_Shader::g_current = 0;
+
   Program_GL_Shader::Program_GL_Shader()
-    : m_program(glCreateProgram())
+    : m_program(glCreateProgram()),
+    m_linked(false),
+    m_dirty(false)
   {
   }
   
   Program_GL_Shader::~Program_GL_Shader() {
+    if(g_current == this)
+      g_current = 0;
+
     for(std::list<Shader_GL_Shader *>::iterator it = m_shaders.begin(), iend = m_shaders.end(); it != iend; ++it)
       glDetachShader(m_program, (*it)->get());
     m_shaders.clear();
@@ -112,9 +220,36 @@ namespace Zeni {
     Shader_GL_Shader &shader_gl_shader = dynamic_cast<Shader_GL_Shader &>(shader);
     m_shaders.push_back(&shader_gl_shader);
     glAttachShader(m_program, shader_gl_shader.get());
+    m_linked = false;
   }
   
   void Program_GL_Shader::link() {
+    if(m_linked)
+      return;
+
+    const bool caching = Program_Cache::is_enabled() && Program_Cache::is_supported();
+    String key;
+
+    if(caching) {
+      for(std::list<Shader_GL_Shader *>::iterator it = m_shaders.begin(), iend = m_shaders.end(); it != iend; ++it) {
+        key += (*it)->get_type() == Shader::VERTEX ? 'v' : 'f';
+        key += (*it)->get_source();
+        key += '\0';
+      }
+
+      if(Program_Cache::load(m_program, key)) {
+        find_uniforms();
+        return;
+      }
+
+      glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    const Time_HQ start;
+
+    for(std::list<Shader_GL_Shader *>::iterator it = m_shaders.begin(), iend = m_shaders.end(); it != iend; ++it)
+      (*it)->compile();
+
     glLinkProgram(m_program);
     
     GLint rv = GL_TRUE, len;
@@ -126,6 +261,271 @@ namespace Zeni {
       std::cerr << "Shader link failure: " << log << std::endl;
       throw Shader_Link_Failure();
     }
+
+    if(caching)
+      Program_Cache::store(m_program, key, float(start.get_seconds_passed()));
+
+    find_uniforms();
+  }
+
+  void Program_GL_Shader::find_uniforms() {
+    m_linked = true;
+    m_dirty = false;
+    m_uniforms.clear();
+    m_uniform_handles.clear();
+    m_attributes.clear();
+    m_ints.clear();
+    m_floats.clear();
+
+    GLint count = 0, max_length = 0;
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+    std::vector<GLchar> name_buf(size_t(std::max(max_length, 1)));
+
+    for(GLint i = 0; i != count; ++i) {
+      GLsizei length = 0;
+      Uniform uniform;
+      glGetActiveUniform(m_program, GLuint(i), GLsizei(name_buf.size()), &length, &uniform.size, &uniform.type, &name_buf[0]);
+
+      String name(&name_buf[0], size_t(length));
+      if(name.size() > 3u && name.compare(name.size() - 3u, 3u, "[0]") == 0)
+        name.resize(name.size() - 3u);
+
+      /// Built-in uniforms and members of uniform blocks have no location
+      uniform.location = glGetUniformLocation(m_program, name.c_str());
+      if(uniform.location == -1)
+        continue;
+
+      switch(uniform.type) {
+        case GL_FLOAT:      uniform.components = 1u;  uniform.integer = false; break;
+        case GL_FLOAT_VEC2: uniform.components = 2u;  uniform.integer = false; break;
+        case GL_FLOAT_VEC3: uniform.components = 3u;  uniform.integer = false; break;
+        case GL_FLOAT_VEC4: uniform.components = 4u;  uniform.integer = false; break;
+        case GL_FLOAT_MAT4: uniform.components = 16u; uniform.integer = false; break;
+        case GL_INT_VEC2:
+        case GL_BOOL_VEC2:  uniform.components = 2u;  uniform.integer = true;  break;
+        case GL_INT_VEC3:
+        case GL_BOOL_VEC3:  uniform.components = 3u;  uniform.integer = true;  break;
+        case GL_INT_VEC4:
+        case GL_BOOL_VEC4:  uniform.components = 4u;  uniform.integer = true;  break;
+        case GL_FLOAT_MAT2:
+        case GL_FLOAT_MAT3:
+          continue; ///< No typed setter, so leave them to raw GL
+        default:            uniform.components = 1u;  uniform.integer = true;  break; ///< int, bool, and samplers
+      }
+
+      const size_t words = uniform.components * size_t(uniform.size);
+      if(uniform.integer) {
+        uniform.offset = m_ints.size();
+        m_ints.resize(m_ints.size() + words, 0);
+      }
+      else {
+        uniform.offset = m_floats.size();
+        m_floats.resize(m_floats.size() + words, 0.0f);
+      }
+      uniform.dirty = false;
+
+      /// Initializers in the source mean uniforms need not start at 0, so start from what GL holds
+      for(GLint element = 0; element != uniform.size; ++element) {
+        const GLint location = element ? glGetUniformLocation(m_program, (name + '[' + itoa(element) + ']').c_str()) : uniform.location;
+        if(location == -1)
+          continue;
+
+        const size_t offset = uniform.offset + size_t(element) * uniform.components;
+        if(uniform.integer)
+          glGetUniformiv(m_program, location, &m_ints[offset]);
+        else
+          glGetUniformfv(m_program, location, &m_floats[offset]);
+      }
+
+      m_uniform_handles[name] = int(m_uniforms.size());
+      m_uniforms.push_back(uniform);
+    }
+
+    glGetProgramiv(m_program, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(m_program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_length);
+    name_buf.resize(size_t(std::max(max_length, 1)));
+
+    for(GLint i = 0; i != count; ++i) {
+      GLsizei length = 0;
+      GLint size;
+      GLenum type;
+      glGetActiveAttrib(m_program, GLuint(i), GLsizei(name_buf.size()), &length, &size, &type, &name_buf[0]);
+
+      const String name(&name_buf[0], size_t(length));
+      const GLint location = glGetAttribLocation(m_program, name.c_str());
+      if(location != -1)
+        m_attributes[name] = location;
+    }
+  }
+
+  int Program_GL_Shader::get_uniform(const String &name) const {
+    const Unordered_Map<String, int>::const_iterator it = m_uniform_handles.find(name);
+    return it == m_uniform_handles.end() ? -1 : it->second;
+  }
+
+  int Program_GL_Shader::get_attribute(const String &name) const {
+    const Unordered_Map<String, GLint>::const_iterator it = m_attributes.find(name);
+    return it == m_attributes.end() ? -1 : it->second;
+  }
+
+  bool Program_GL_Shader::bind_uniform_block(const String &name, const GLuint &binding) {
+    link();
+
+    const GLuint index = glGetUniformBlockIndex(m_program, name.c_str());
+    if(index == GL_INVALID_INDEX)
+      return false;
+
+    glUniformBlockBinding(m_program, index, binding);
+    return true;
+  }
+
+  void Program_GL_Shader::use() {
+    link();
+
+    glUseProgram(m_program);
+    g_current = this;
+
+    if(m_dirty) {
+      for(std::vector<Uniform>::iterator it = m_uniforms.begin(), iend = m_uniforms.end(); it != iend; ++it)
+        if(it->dirty) {
+          upload(*it);
+          it->dirty = false;
+        }
+      m_dirty = false;
+    }
+  }
+
+  void Program_GL_Shader::unuse() {
+    glUseProgram(0); ///< DEPRECATED: Requires SDL_GL_CONTEXT_PROFILE_COMPATIBILITY
+    g_current = 0;
+  }
+
+  void Program_GL_Shader::set_uniform_data(const int &uniform, const Uniform_Type &type, const void * const &data, const size_t &count) {
+    if(uniform < 0 || size_t(uniform) >= m_uniforms.size() || !count)
+      return;
+
+    Uniform &u = m_uniforms[size_t(uniform)];
+
+    static const size_t components[] = {1u, 1u, 2u, 3u, 4u, 16u};
+    if(u.components != components[type] || u.integer != (type == UNIFORM_INT))
+      throw Shader_Uniform_Type_Mismatch();
+
+    const size_t bytes = std::min(count, size_t(u.size)) * u.components * 4u;
+    void * const values = u.integer ? static_cast<void *>(&m_ints[u.offset]) : static_cast<void *>(&m_floats[u.offset]);
+    if(!memcmp(values, data, bytes))
+      return;
+    memcpy(values, data, bytes);
+
+    if(g_current == this)
+      upload(u);
+    else {
+      u.dirty = true;
+      m_dirty = true;
+    }
+  }
+
+  void Program_GL_Shader::upload(const Uniform &uniform) const {
+    const GLint * const ints = uniform.integer ? &m_ints[uniform.offset] : 0;
+    const GLfloat * const floats = uniform.integer ? 0 : &m_floats[uniform.offset];
+
+    switch(uniform.type) {
+      case GL_FLOAT:      glUniform1fv(uniform.location, uniform.size, floats); break;
+      case GL_FLOAT_VEC2: glUniform2fv(uniform.location, uniform.size, floats); break;
+      case GL_FLOAT_VEC3: glUniform3fv(uniform.location, uniform.size, floats); break;
+      case GL_FLOAT_VEC4: glUniform4fv(uniform.location, uniform.size, floats); break;
+      case GL_FLOAT_MAT4: glUniformMatrix4fv(uniform.location, uniform.size, GL_FALSE, floats); break;
+      case GL_INT_VEC2:
+      case GL_BOOL_VEC2:  glUniform2iv(uniform.location, uniform.size, ints); break;
+      case GL_INT_VEC3:
+      case GL_BOOL_VEC3:  glUniform3iv(uniform.location, uniform.size, ints); break;
+      case GL_INT_VEC4:
+      case GL_BOOL_VEC4:  glUniform4iv(uniform.location, uniform.size, ints); break;
+      default:            glUniform1iv(uniform.location, uniform.size, ints); break;
+    }
+  }
+
+  Uniform_Buffer::Uniform_Buffer(const size_t &size, const GLuint &binding)
+    : m_data(size, 0u),
+    m_dirty_begin(size),
+    m_dirty_end(0u),
+    m_buffer(0),
+    m_binding(binding)
+  {
+    if(!is_supported())
+      throw Uniform_Buffer_Init_Failure();
+
+    glGenBuffers(1, &m_buffer);
+    if(!m_buffer)
+      throw Uniform_Buffer_Init_Failure();
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+    glBufferData(GL_UNIFORM_BUFFER, GLsizeiptr(size), size ? &m_data[0] : 0, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_buffer);
+  }
+
+  Uniform_Buffer::~Uniform_Buffer() {
+    glDeleteBuffers(1, &m_buffer);
+  }
+
+  bool Uniform_Buffer::is_supported() {
+#ifdef REQUIRE_GL_ES
+    return false;
+#else
+    return GLEW_VERSION_3_1 || GLEW_ARB_uniform_buffer_object;
+#endif
+  }
+
+  void Uniform_Buffer::set(const size_t &offset, const int &value) {
+    set(offset, &value, sizeof(int));
+  }
+
+  void Uniform_Buffer::set(const size_t &offset, const float &value) {
+    set(offset, &value, sizeof(float));
+  }
+
+  void Uniform_Buffer::set(const size_t &offset, const Point2f &value) {
+    const float data[2] = {value.x, value.y};
+    set(offset, data, sizeof(data));
+  }
+
+  void Uniform_Buffer::set(const size_t &offset, const Vector3f &value) {
+    const float data[3] = {value.i, value.j, value.k};
+    set(offset, data, sizeof(data));
+  }
+
+  void Uniform_Buffer::set(const size_t &offset, const Color &value) {
+    const float data[4] = {value.r, value.g, value.b, value.a};
+    set(offset, data, sizeof(data));
+  }
+
+  void Uniform_Buffer::set(const size_t &offset, const Matrix4f &value) {
+    set(offset, &value, 16u * sizeof(float));
+  }
+
+  void Uniform_Buffer::set(const size_t &offset, const void * const &data, const size_t &size) {
+    assert(offset + size <= m_data.size());
+
+    if(!size || !memcmp(&m_data[offset], data, size))
+      return;
+    memcpy(&m_data[offset], data, size);
+
+    m_dirty_begin = std::min(m_dirty_begin, offset);
+    m_dirty_end = std::max(m_dirty_end, offset + size);
+  }
+
+  void Uniform_Buffer::apply() {
+    if(m_dirty_begin < m_dirty_end) {
+      glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+      glBufferSubData(GL_UNIFORM_BUFFER, GLintptr(m_dirty_begin), GLsizeiptr(m_dirty_end - m_dirty_begin), &m_data[m_dirty_begin]);
+      glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+      m_dirty_begin = m_data.size();
+      m_dirty_end = 0u;
+    }
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_buffer);
   }
 #endif
 
@@ -0,0 +1,226 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_graphics.h>
+
+#include <Zeni/Float4.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  /// Every frame must take some time, or a looping clip could never be stepped through
+  static const float g_min_frame_duration = 0.001f;
+
+  Sprite_Animation::Sprite_Animation()
+    : m_num_instances(0u),
+    m_generation(0u)
+  {
+  }
+
+  size_t Sprite_Animation::add_clip(const String &sprite, const float &frame_duration, const bool &loop) {
+    const Sprite * const frames = dynamic_cast<const Sprite *>(&get_Textures()[sprite]);
+    if(!frames)
+      throw Sprite_Function_Misapplied();
+
+    std::vector<String> textures;
+    for(int i = 0, end = frames->get_num_frames(); i != end; ++i)
+      textures.push_back(frames->get_frame_name(i));
+
+    return add_clip(textures, std::vector<float>(textures.size(), frame_duration), loop);
+  }
+
+  size_t Sprite_Animation::add_clip(const std::vector<String> &textures, const std::vector<float> &durations, const bool &loop) {
+    if(textures.empty() || textures.size() != durations.size())
+      throw Sprite_Animation_Invalid_Clip();
+
+    Clip clip;
+    clip.first = m_frame_names.size();
+    clip.count = textures.size();
+    clip.duration = 0.0f;
+    clip.loop = loop;
+
+    for(size_t i = 0; i != textures.size(); ++i) {
+      const float duration = std::max(durations[i], g_min_frame_duration);
+      m_frame_names.push_back(textures[i]);
+      m_frame_durations.push_back(duration);
+      clip.duration += duration;
+    }
+    m_frames.resize(m_frame_names.size());
+
+    try {
+      resolve(get_Textures().get_generation() == m_generation ? clip.first : 0u);
+    }
+    catch(...) {
+      m_frame_names.resize(clip.first);
+      m_frame_durations.resize(clip.first);
+      m_frames.resize(clip.first);
+      throw;
+    }
+
+    m_clips.push_back(clip);
+    return m_clips.size() - 1u;
+  }
+
+  size_t Sprite_Animation::create(const size_t &clip, const float &speed) {
+    if(clip >= m_clips.size())
+      throw Sprite_Animation_Invalid_Clip();
+
+    size_t instance;
+    if(m_free_instances.empty()) {
+      instance = m_instance_flags.size();
+      m_instance_frames.push_back(0u);
+      m_instance_clips.push_back(0u);
+      m_instance_flags.push_back(0u);
+
+      /// Whole groups of four, paused, so that update() never needs a scalar remainder
+      const size_t padded = (m_instance_flags.size() + 3u) & ~size_t(3u);
+      m_remaining.resize(padded, 1.0f);
+      m_speeds.resize(padded, 0.0f);
+    }
+    else {
+      instance = m_free_instances.back();
+      m_free_instances.pop_back();
+    }
+
+    m_instance_flags[instance] = LIVE;
+    m_speeds[instance] = std::max(speed, 0.0f);
+    ++m_num_instances;
+
+    play(instance, clip);
+
+    return instance;
+  }
+
+  void Sprite_Animation::destroy(const size_t &instance) {
+    assert(instance < m_instance_flags.size() && (m_instance_flags[instance] & LIVE));
+
+    m_instance_flags[instance] = 0u;
+    m_remaining[instance] = 1.0f;
+    m_speeds[instance] = 0.0f;
+    m_free_instances.push_back(instance);
+    --m_num_instances;
+  }
+
+  void Sprite_Animation::play(const size_t &instance, const size_t &clip) {
+    assert(instance < m_instance_flags.size() && (m_instance_flags[instance] & LIVE));
+
+    if(clip >= m_clips.size())
+      throw Sprite_Animation_Invalid_Clip();
+
+    m_instance_clips[instance] = clip;
+    m_instance_frames[instance] = m_clips[clip].first;
+    m_remaining[instance] = m_frame_durations[m_clips[clip].first];
+    m_instance_flags[instance] &= Uint8(~FINISHED);
+  }
+
+  void Sprite_Animation::set_speed(const size_t &instance, const float &speed) {
+    assert(instance < m_instance_flags.size() && (m_instance_flags[instance] & LIVE));
+
+    m_speeds[instance] = std::max(speed, 0.0f);
+  }
+
+  const Sprite_Animation::Frame & Sprite_Animation::get_frame(const size_t &instance) const {
+    assert(instance < m_instance_flags.size() && (m_instance_flags[instance] & LIVE));
+
+    /// Textures may have been reloaded or lost since the last update()
+    if(get_Textures().get_generation() != m_generation)
+      resolve(0u);
+
+    return m_frames[m_instance_frames[instance]];
+  }
+
+  void Sprite_Animation::apply_Texture(const size_t &instance) const {
+    get_Video().apply_Texture(*get_frame(instance).texture);
+  }
+
+  void Sprite_Animation::update(const float &time_step) {
+    if(get_Textures().get_generation() != m_generation)
+      resolve(0u);
+
+    const Float4 dt(time_step);
+    const Float4 zero(0.0f);
+
+    for(size_t i = 0; i != m_remaining.size(); i += 4u) {
+      const Float4 remaining = Float4::load(&m_remaining[i]) - Float4::load(&m_speeds[i]) * dt;
+      remaining.store(&m_remaining[i]);
+
+      /// Only instances whose frames have ended need to step through their clips
+      const int ended = ~float4_mask_bits(float4_less(zero, remaining)) & 0xF;
+      if(ended)
+        for(size_t lane = 0; lane != 4u; ++lane)
+          if(ended & (1 << lane))
+            advance(i + lane);
+    }
+  }
+
+  void Sprite_Animation::advance(const size_t &instance) {
+    const Clip &clip = m_clips[m_instance_clips[instance]];
+    const size_t end = clip.first + clip.count;
+    float remaining = m_remaining[instance];
+    size_t frame = m_instance_frames[instance];
+
+    /// Each whole loop returns to the same point in the clip, so skip them all at once
+    if(clip.loop && -remaining > clip.duration)
+      remaining = -std::fmod(-remaining, clip.duration);
+
+    while(remaining <= 0.0f) {
+      if(++frame == end) {
+        if(!clip.loop) {
+          /// Hold the last frame for good
+          frame = end - 1u;
+          remaining = std::numeric_limits<float>::max();
+          m_instance_flags[instance] |= FINISHED;
+          break;
+        }
+
+        frame = clip.first;
+      }
+
+      remaining += m_frame_durations[frame];
+    }
+
+    m_remaining[instance] = remaining;
+    m_instance_frames[instance] = frame;
+  }
+
+  void Sprite_Animation::resolve(const size_t &first_frame) const {
+    Textures &textures = get_Textures();
+
+    for(size_t i = first_frame; i != m_frames.size(); ++i) {
+      const Texture &texture = textures[m_frame_names[i]];
+      if(dynamic_cast<const Sprite *>(&texture))
+        throw Sprite_Containing_Sprite();
+
+      Frame &frame = m_frames[i];
+      frame.texture = &texture;
+      frame.region = dynamic_cast<const Texture_Atlas_Region *>(&texture);
+      frame.upper_left = frame.region ? frame.region->get_upper_left_texel() : Point2f(0.0f, 0.0f);
+      frame.lower_right = frame.region ? frame.region->get_lower_right_texel() : Point2f(1.0f, 1.0f);
+    }
+
+    m_generation = textures.get_generation();
+  }
+
+}
@@ -18,6 +18,7 @@
 #include <zeni_graphics.h>
 
 #include <iostream>
+#include <memory>
 
 #include <Zeni/GLU.h>
 
@@ -29,6 +30,12 @@
 
 namespace Zeni {
 
+  void Texture::apply_Texture_transformed(const Matrix4f &texture_matrix) const {
+    apply_Texture();
+
+    get_Video().set_texture_matrix(texture_matrix);
+  }
+
   Sprite::Sprite()
     : Texture(false),
     m_frame(0)
@@ -103,6 +110,13 @@ namespace Zeni {
     return int(m_frames.size());
   }
 
+  const String & Sprite::get_frame_name(const int &frame_number) const {
+    if(frame_number < 0 || frame_number >= int(m_frames.size()))
+      throw Frame_Out_of_Range();
+
+    return m_frames[size_t(frame_number)].first;
+  }
+
   int Sprite::get_current_frame() const {
     if(m_frames.empty())
       return -1;
@@ -159,7 +173,7 @@ namespace Zeni {
       load(m_filename, m_repeat);
   }
 
-  Texture_GL::Texture_GL(const Image &image)
+  Texture_GL::Texture_GL(const Image &image, const int &mip_levels)
     : Texture(image.tileable()),
     m_size(Point2i(image.width(), image.height())),
     m_texture_id(build_from_Image(image)),
@@ -169,6 +183,11 @@ namespace Zeni {
     , m_filename(1, '\0')
 #endif
   {
+    /// OpenGL ES lacks GL_TEXTURE_MAX_LEVEL, leaving every reduced level in use there
+#ifndef REQUIRE_GL_ES
+    if(mip_levels >= 0 && Textures::get_mipmapping())
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mip_levels);
+#endif
   }
 
   Texture_GL::Texture_GL(const Point2i &size, const bool &repeat)
@@ -197,22 +216,45 @@ namespace Zeni {
       glDeleteFramebuffersEXT(1, &m_frame_buffer_object);
 #endif
 
-    if(m_texture_id)
+    if(m_texture_id) {
+      if(g_bound_texture_id == m_texture_id)
+        g_bound_texture_id = 0;
+
       glDeleteTextures(1, &m_texture_id);
+    }
   }
 
   void Texture_GL::apply_Texture() const {
+    bind();
+
+    get_Video().unset_texture_matrix();
+  }
+
+  void Texture_GL::apply_Texture_transformed(const Matrix4f &texture_matrix) const {
+    bind();
+
+    get_Video().set_texture_matrix(texture_matrix);
+  }
+
+  void Texture_GL::bind() const {
     if(!m_texture_id)
       load(m_filename, m_repeat);
     
     glEnable(GL_TEXTURE_2D);
 
-    glBindTexture(GL_TEXTURE_2D, m_texture_id);
+    if(g_bound_texture_id != m_texture_id) {
+      glBindTexture(GL_TEXTURE_2D, m_texture_id);
+      g_bound_texture_id = m_texture_id;
+    }
 
     glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
   }
 
   GLuint Texture_GL::build_from_Image(const Image &image) {
+    return build_from_Image(image, std::vector<Image>());
+  }
+
+  GLuint Texture_GL::build_from_Image(const Image &image, const std::vector<Image> &mipmaps) {
     GLuint texture_id = 0;
     
     const GLenum format =
@@ -236,6 +278,7 @@ namespace Zeni {
     }
 
     glBindTexture(GL_TEXTURE_2D, texture_id);
+    g_bound_texture_id = texture_id;
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, image.tileable() ? GL_REPEAT : GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, image.tileable() ? GL_REPEAT : GL_CLAMP_TO_EDGE);
@@ -272,30 +315,45 @@ namespace Zeni {
     */
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
 
-    if(
-#ifndef REQUIRE_GL_ES
-      GLEW_VERSION_1_4 &&
-#endif
-      Textures::get_mipmapping())
-    {
-      glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
-    }
+    bool upload_mipmaps = Textures::get_mipmapping() && !mipmaps.empty();
 #ifndef REQUIRE_GL_ES
-    if(GLEW_VERSION_1_4 || !Textures::get_mipmapping())
+    upload_mipmaps |= Textures::get_mipmapping() && !GLEW_VERSION_1_4;
 #endif
-    {
+
+    if(upload_mipmaps) {
+      std::vector<Image> built;
+      if(mipmaps.empty())
+        image.build_mipmaps(built);
+      const std::vector<Image> &levels = mipmaps.empty() ? built : mipmaps;
+
+      glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
       glTexImage2D(GL_TEXTURE_2D, 0, format, image.width(), image.height(), 0, format, GL_UNSIGNED_BYTE, static_cast<const GLvoid *>(image.get_data()));
+      for(size_t level = 0; level != levels.size(); ++level)
+        glTexImage2D(GL_TEXTURE_2D, GLint(level + 1), format, levels[level].width(), levels[level].height(), 0, format, GL_UNSIGNED_BYTE, static_cast<const GLvoid *>(levels[level].get_data()));
+      glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     }
-#ifndef REQUIRE_GL_ES
     else {
-      Zeni::gluBuild2DMipmaps(GL_TEXTURE_2D, format, image.width(), image.height(), format, GL_UNSIGNED_BYTE, static_cast<const GLvoid *>(image.get_data()));
+      if(Textures::get_mipmapping())
+        glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+
+      glTexImage2D(GL_TEXTURE_2D, 0, format, image.width(), image.height(), 0, format, GL_UNSIGNED_BYTE, static_cast<const GLvoid *>(image.get_data()));
     }
-#endif
 
     return texture_id;
   }
 
   void Texture_GL::load(const String &filename, const bool &repeat) const {
+    if(Textures::get_caching()) {
+      std::vector<Image> mipmaps;
+      const std::auto_ptr<Image> image(Image_Cache::load_Image(filename, repeat, Textures::get_mipmapping() ? &mipmaps : 0));
+
+      m_size = image->size();
+
+      m_texture_id = build_from_Image(*image, mipmaps);
+
+      return;
+    }
+
     Image image(filename, repeat);
 
     m_size.x = image.width();
@@ -303,6 +361,8 @@ namespace Zeni {
 
     m_texture_id = build_from_Image(image);
   }
+
+  GLuint Texture_GL::g_bound_texture_id = 0;
   
 #endif
 
@@ -316,10 +376,10 @@ namespace Zeni {
     load(filename);
   }
 
-  Texture_DX9::Texture_DX9(const Image &image)
+  Texture_DX9::Texture_DX9(const Image &image, const int &mip_levels)
     : Texture(image.tileable()),
     m_size(image.size()),
-    m_texture(build_from_Image(image)),
+    m_texture(build_from_Image(image, mip_levels)),
     m_render_to_surface(0)
   {
   }
@@ -368,6 +428,18 @@ namespace Zeni {
   }
 
   void Texture_DX9::apply_Texture() const {
+    bind();
+
+    static_cast<Video_DX9 &>(get_Video()).unset_texture_matrix();
+  }
+
+  void Texture_DX9::apply_Texture_transformed(const Matrix4f &texture_matrix) const {
+    bind();
+
+    static_cast<Video_DX9 &>(get_Video()).set_texture_matrix(texture_matrix);
+  }
+
+  void Texture_DX9::bind() const {
     Video_DX9 &vdx = static_cast<Video_DX9 &>(get_Video());
     
     vdx.get_d3d_device()->SetSamplerState(0, D3DSAMP_ADDRESSU, m_repeat ? D3DTADDRESS_WRAP : D3DTADDRESS_CLAMP);
@@ -411,7 +483,7 @@ namespace Zeni {
     vr.get_d3d_device()->SetSamplerState(0, D3DSAMP_MIPFILTER, (!disable_mipmapping && Textures::get_mipmapping() ? D3DTEXF_LINEAR : D3DTEXF_NONE));
   }
 
-  IDirect3DTexture9 * Texture_DX9::build_from_Image(const Image &image) {
+  IDirect3DTexture9 * Texture_DX9::build_from_Image(const Image &image, const int &mip_levels) {
     Video_DX9 &vdx = dynamic_cast<Video_DX9 &>(get_Video());
 
     IDirect3DTexture9 * ppTexture;
@@ -443,7 +515,7 @@ namespace Zeni {
 
     if(FAILED(Video_DX9::D3DXCreateTexture()(vdx.get_d3d_device(),
                                              UINT(image.width()), UINT(image.height()),
-                                             D3DX_DEFAULT,
+                                             mip_levels < 0 ? D3DX_DEFAULT : UINT(mip_levels + 1),
                                              0,
                                              format,
                                              D3DPOOL_MANAGED,
@@ -511,10 +583,10 @@ namespace Zeni {
     //if(FAILED(D3DXCreateTextureFromFile(vr.get_d3d_device(), filename.c_str(), &m_texture)))
     //  throw Texture_Init_Failure();
 
-    Image image(filename);
+    const std::auto_ptr<Image> image(Textures::get_caching() ? Image_Cache::load_Image(filename, false) : new Image(filename));
 
-    m_texture = build_from_Image(image);
-    m_size = image.size();
+    m_texture = build_from_Image(*image);
+    m_size = image->size();
   }
 #endif
 #endif
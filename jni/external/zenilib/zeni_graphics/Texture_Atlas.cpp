@@ -0,0 +1,328 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_graphics.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  static int next_power_of_two(const int &value) {
+    int power = 1;
+    while(power < value)
+      power <<= 1;
+    return power;
+  }
+
+  static int round_up(const int &value, const int &multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+  }
+
+  Texture_Atlas_Region::Texture_Atlas_Region(const Texture_Atlas &atlas, const size_t &page, const Point2i &upper_left, const Point2i &size)
+    : Texture(false),
+    m_atlas(&atlas),
+    m_page(page),
+    m_size(size)
+  {
+    const Point2i &page_size = atlas.get_page_Image(page).size();
+
+    m_upper_left_texel = Point2f(float(upper_left.x) / page_size.x,
+                                 float(upper_left.y) / page_size.y);
+    m_lower_right_texel = Point2f(float(upper_left.x + size.x) / page_size.x,
+                                  float(upper_left.y + size.y) / page_size.y);
+
+    m_texture_matrix = Matrix4f::Translate(Vector3f(m_upper_left_texel.x, m_upper_left_texel.y, 0.0f)) *
+                       Matrix4f::Scale(Vector3f(m_lower_right_texel.x - m_upper_left_texel.x,
+                                                m_lower_right_texel.y - m_upper_left_texel.y,
+                                                1.0f));
+  }
+
+  void Texture_Atlas_Region::apply_Texture() const {
+    m_atlas->apply_page(m_page, m_texture_matrix);
+  }
+
+  Texture_Atlas::Page::Page(const Point2i &size)
+    : image(size, Image::RGBA),
+    used_area(0),
+    texture(0),
+    dirty(true)
+  {
+    skyline.push_back(Point3i(0, 0, size.x));
+  }
+
+  bool Texture_Atlas::Page::insert(const Point2i &size, Point2i &upper_left) {
+    const Point2i &page_size = image.size();
+
+    size_t best = skyline.size();
+    int best_bottom = INT_MAX;
+    int best_width = INT_MAX;
+    int best_y = 0;
+
+    for(size_t i = 0; i != skyline.size(); ++i) {
+      if(skyline[i].x + size.x > page_size.x)
+        break;
+
+      int y = skyline[i].y;
+      int remaining = size.x;
+      size_t j = i;
+      for(; remaining > 0 && j != skyline.size(); ++j) {
+        y = std::max(y, skyline[j].y);
+        if(y + size.y > page_size.y)
+          break;
+        remaining -= skyline[j].z;
+      }
+
+      if(remaining > 0)
+        continue;
+
+      const int bottom = y + size.y;
+      if(bottom < best_bottom || (bottom == best_bottom && skyline[i].z < best_width)) {
+        best = i;
+        best_bottom = bottom;
+        best_width = skyline[i].z;
+        best_y = y;
+      }
+    }
+
+    if(best == skyline.size())
+      return false;
+
+    upper_left = Point2i(skyline[best].x, best_y);
+
+    skyline.insert(skyline.begin() + best, Point3i(upper_left.x, best_bottom, size.x));
+
+    /// Shrink or remove the segments now lying beneath the new one
+    for(size_t i = best + 1; i != skyline.size();) {
+      const int covered = skyline[i - 1].x + skyline[i - 1].z - skyline[i].x;
+      if(covered <= 0)
+        break;
+
+      skyline[i].x += covered;
+      skyline[i].z -= covered;
+
+      if(skyline[i].z > 0)
+        break;
+
+      skyline.erase(skyline.begin() + i);
+    }
+
+    for(size_t i = 0; i + 1 < skyline.size();) {
+      if(skyline[i].y == skyline[i + 1].y) {
+        skyline[i].z += skyline[i + 1].z;
+        skyline.erase(skyline.begin() + i + 1);
+      }
+      else
+        ++i;
+    }
+
+    used_area += size.x * size.y;
+    dirty = true;
+
+    return true;
+  }
+
+  Texture_Atlas::Texture_Atlas(const Point2i &page_size, const int &padding)
+    : m_page_size(next_power_of_two(page_size.x), next_power_of_two(page_size.y)),
+    m_padding(padding > 0 ? next_power_of_two(padding) : 0),
+    m_mip_levels(0)
+  {
+    for(int size = m_padding; size > 1; size >>= 1)
+      ++m_mip_levels;
+  }
+
+  Texture_Atlas::~Texture_Atlas() {
+    for(std::vector<Page *>::iterator it = m_pages.begin(); it != m_pages.end(); ++it) {
+      delete (*it)->texture;
+      delete *it;
+    }
+  }
+
+  float Texture_Atlas::get_occupancy() const {
+    float used = 0.0f;
+    float total = 0.0f;
+
+    for(std::vector<Page *>::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it) {
+      used += float((*it)->used_area);
+      total += float((*it)->image.width()) * (*it)->image.height();
+    }
+
+    return total ? used / total : 0.0f;
+  }
+
+  bool Texture_Atlas::fits(const Point2i &size) const {
+    const Point2i padded = get_padded_size(size);
+
+    return padded.x <= m_page_size.x &&
+           padded.y <= m_page_size.y;
+  }
+
+  Texture_Atlas_Region * Texture_Atlas::pack(const Image &image) {
+    /// Padded sizes are all multiples of the padding, so the skyline keeps every region aligned to it
+    const Point2i padded = get_padded_size(image.size());
+
+    Point2i upper_left;
+    size_t page = 0u;
+
+    if(fits(image.size())) {
+      for(; page != m_pages.size(); ++page)
+        if(m_pages[page]->insert(padded, upper_left))
+          break;
+
+      if(page == m_pages.size()) {
+        m_pages.push_back(new Page(m_page_size));
+        if(!m_pages.back()->insert(padded, upper_left))
+          throw Texture_Init_Failure();
+      }
+    }
+    else {
+      /// Oversized Images get a page of their own
+      page = m_pages.size();
+      m_pages.push_back(new Page(Point2i(next_power_of_two(padded.x), next_power_of_two(padded.y))));
+      if(!m_pages.back()->insert(padded, upper_left))
+        throw Texture_Init_Failure();
+    }
+
+    copy_with_padding(m_pages[page]->image, upper_left, padded, image, m_padding);
+
+    return new Texture_Atlas_Region(*this, page,
+                                    Point2i(upper_left.x + m_padding, upper_left.y + m_padding),
+                                    image.size());
+  }
+
+  void Texture_Atlas::apply_page(const size_t &page) const {
+    get_current_page(page).texture->apply_Texture();
+  }
+
+  void Texture_Atlas::apply_page(const size_t &page, const Matrix4f &texture_matrix) const {
+    get_current_page(page).texture->apply_Texture_transformed(texture_matrix);
+  }
+
+  void Texture_Atlas::upload() const {
+    for(std::vector<Page *>::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+      if((*it)->dirty)
+        upload(**it);
+  }
+
+  void Texture_Atlas::lose_resources() {
+    for(std::vector<Page *>::iterator it = m_pages.begin(); it != m_pages.end(); ++it) {
+      delete (*it)->texture;
+      (*it)->texture = 0;
+      (*it)->dirty = true;
+    }
+  }
+
+  const Texture_Atlas::Page & Texture_Atlas::get_current_page(const size_t &page) const {
+    if(page >= m_pages.size())
+      throw Texture_Atlas_Page_Out_of_Range();
+
+    const Page &p = *m_pages[page];
+
+    if(p.dirty)
+      upload(p);
+
+    return p;
+  }
+
+  Point2i Texture_Atlas::get_padded_size(const Point2i &size) const {
+    const int alignment = std::max(1, m_padding);
+
+    return Point2i(round_up(size.x + 2 * m_padding, alignment),
+                   round_up(size.y + 2 * m_padding, alignment));
+  }
+
+  void Texture_Atlas::upload(const Page &page) const {
+    delete page.texture;
+    page.texture = 0;
+    page.texture = get_Video().create_Texture(page.image, m_mip_levels);
+    page.dirty = false;
+  }
+
+  void Texture_Atlas::copy_with_padding(Image &dest, const Point2i &upper_left, const Point2i &padded_size, const Image &source, const int &padding) {
+    const int width = source.width();
+    const int height = source.height();
+    const int bytes_per_pixel =
+      source.color_space() == Image::Luminance ? 1 :
+      source.color_space() == Image::Luminance_Alpha ? 2 :
+      source.color_space() == Image::RGB ? 3 :
+      4;
+
+    const int dest_row_size = dest.width() * 4;
+    const int right = padded_size.x - padding - width;
+    const int bottom = padded_size.y - padding - height;
+
+    /// Each source row is expanded to RGBA once, with its edge texels replicated into the padding and alignment
+    std::vector<Uint8> row(padded_size.x * 4);
+
+    for(int j = 0; j != height; ++j) {
+      const Uint8 * src = source.get_data() + j * width * bytes_per_pixel;
+      Uint8 * dst = &row[0] + padding * 4;
+
+      switch(source.color_space()) {
+        case Image::Luminance:
+          for(int i = 0; i != width; ++i, src += 1, dst += 4) {
+            dst[0] = dst[1] = dst[2] = src[0];
+            dst[3] = 0xFF;
+          }
+          break;
+
+        case Image::Luminance_Alpha:
+          for(int i = 0; i != width; ++i, src += 2, dst += 4) {
+            dst[0] = dst[1] = dst[2] = src[0];
+            dst[3] = src[1];
+          }
+          break;
+
+        case Image::RGB:
+          for(int i = 0; i != width; ++i, src += 3, dst += 4) {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = 0xFF;
+          }
+          break;
+
+        case Image::RGBA:
+        default:
+          memcpy(dst, src, width * 4);
+          break;
+      }
+
+      for(int i = 0; i != padding; ++i)
+        memcpy(&row[0] + i * 4, &row[0] + padding * 4, 4);
+      for(int i = 0; i != right; ++i)
+        memcpy(&row[0] + (padding + width + i) * 4, &row[0] + (padding + width - 1) * 4, 4);
+
+      Uint8 * const dest_row = dest.get_data() + (upper_left.y + padding + j) * dest_row_size + upper_left.x * 4;
+      memcpy(dest_row, &row[0], padded_size.x * 4);
+
+      if(j == 0)
+        for(int k = 0; k != padding; ++k)
+          memcpy(dest_row - (k + 1) * dest_row_size, &row[0], padded_size.x * 4);
+      if(j == height - 1)
+        for(int k = 0; k != bottom; ++k)
+          memcpy(dest_row + (k + 1) * dest_row_size, &row[0], padded_size.x * 4);
+    }
+  }
+
+}
@@ -0,0 +1,262 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_graphics.h>
+
+#include <cfloat>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  static const Point2i g_placeholder_size(1, 1);
+
+  Texture_Loader::Job::Job(Texture_Async * const &owner_, const String &filename_, const bool &repeat_)
+    : owner(owner_),
+    filename(filename_),
+    repeat(repeat_),
+    image(0)
+  {
+  }
+
+  Texture_Loader::Job::~Job() {
+    delete image;
+  }
+
+  Texture_Loader::Texture_Loader(const size_t &num_threads)
+    : m_num_jobs(0u),
+    m_quit(false),
+    m_placeholder(0),
+    m_worst_upload_time(0.0f)
+  {
+    const size_t cores = Thread::get_num_cores();
+    const size_t threads = num_threads ? num_threads : cores > 1u ? cores - 1u : 1u;
+
+    try {
+      for(size_t i = 0; i != threads; ++i)
+        m_threads.push_back(new Thread(*this));
+    }
+    catch(...) {
+      if(m_threads.empty())
+        throw;
+    }
+  }
+
+  Texture_Loader::~Texture_Loader() {
+    {
+      Mutex::Lock lock(m_mutex);
+      m_quit = true;
+      m_queued_cv.broadcast();
+    }
+
+    for(std::vector<Thread *>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+      delete *it;
+
+    for(std::list<Job *>::iterator it = m_queued.begin(); it != m_queued.end(); ++it) {
+      if((*it)->owner) {
+        (*it)->owner->m_job = 0;
+        (*it)->owner->m_failed = true;
+      }
+      delete *it;
+    }
+
+    for(std::list<Job *>::iterator it = m_decoded.begin(); it != m_decoded.end(); ++it) {
+      if((*it)->owner) {
+        (*it)->owner->m_job = 0;
+        (*it)->owner->m_failed = true;
+      }
+      delete *it;
+    }
+
+    delete m_placeholder;
+  }
+
+  size_t Texture_Loader::get_num_pending() const {
+    Mutex::Lock lock(m_mutex);
+    return m_num_jobs;
+  }
+
+  Texture_Async * Texture_Loader::load(const String &filename, const bool &repeat) {
+    Texture_Async * const texture = new Texture_Async(*this, repeat);
+
+    Mutex::Lock lock(m_mutex);
+
+    texture->m_job = new Job(texture, filename, repeat);
+    m_queued.push_back(texture->m_job);
+    ++m_num_jobs;
+
+    m_queued_cv.signal();
+
+    return texture;
+  }
+
+  void Texture_Loader::upload(const float &budget) {
+    const Time_HQ start;
+
+    for(;;) {
+      Job * job;
+      {
+        Mutex::Lock lock(m_mutex);
+
+        if(m_decoded.empty())
+          break;
+
+        job = m_decoded.front();
+        m_decoded.pop_front();
+        --m_num_jobs;
+      }
+
+      if(job->owner) {
+        Texture_Async &owner = *job->owner;
+        owner.m_job = 0;
+
+        if(job->image) {
+          try {
+            owner.m_texture = get_Video().create_Texture(*job->image);
+          }
+          catch(...) {
+            owner.m_failed = true;
+          }
+        }
+        else
+          owner.m_failed = true;
+      }
+
+      delete job;
+
+      if(start.get_seconds_passed() >= budget)
+        break;
+    }
+
+    const float elapsed = float(start.get_seconds_passed());
+    if(elapsed > m_worst_upload_time)
+      m_worst_upload_time = elapsed;
+  }
+
+  void Texture_Loader::finish() {
+    for(;;) {
+      {
+        Mutex::Lock lock(m_mutex);
+
+        while(m_decoded.empty() && m_num_jobs)
+          m_decoded_cv.wait(lock);
+
+        if(!m_num_jobs)
+          break;
+      }
+
+      upload(FLT_MAX);
+    }
+  }
+
+  void Texture_Loader::lose_resources() {
+    delete m_placeholder;
+    m_placeholder = 0;
+  }
+
+  int Texture_Loader::function() {
+    for(;;) {
+      Job * job;
+      {
+        Mutex::Lock lock(m_mutex);
+
+        while(m_queued.empty() && !m_quit)
+          m_queued_cv.wait(lock);
+
+        if(m_quit)
+          break;
+
+        job = m_queued.front();
+        m_queued.pop_front();
+
+        /// Skip Jobs whose Textures were destroyed before decoding began
+        if(!job->owner) {
+          delete job;
+          --m_num_jobs;
+          m_decoded_cv.broadcast();
+          continue;
+        }
+      }
+
+      Image * image = 0;
+      try {
+        image = Textures::get_caching() ? Image_Cache::load_Image(job->filename, job->repeat) : new Image(job->filename, job->repeat);
+      }
+      catch(...) {
+      }
+
+      {
+        Mutex::Lock lock(m_mutex);
+
+        job->image = image;
+        m_decoded.push_back(job);
+        m_decoded_cv.broadcast();
+      }
+    }
+
+    return 0;
+  }
+
+  void Texture_Loader::cancel(Job * const &job) {
+    Mutex::Lock lock(m_mutex);
+    job->owner = 0;
+  }
+
+  void Texture_Loader::apply_placeholder() const {
+    if(!m_placeholder)
+      m_placeholder = get_Video().create_Texture(Image(g_placeholder_size, Image::RGBA, false));
+
+    m_placeholder->apply_Texture();
+  }
+
+  const Point2i & Texture_Loader::get_placeholder_size() {
+    return g_placeholder_size;
+  }
+
+  Texture_Async::Texture_Async(Texture_Loader &loader, const bool &repeat)
+    : Texture(repeat),
+    m_loader(&loader),
+    m_job(0),
+    m_texture(0),
+    m_failed(false)
+  {
+  }
+
+  Texture_Async::~Texture_Async() {
+    if(m_job)
+      m_loader->cancel(m_job);
+
+    delete m_texture;
+  }
+
+  void Texture_Async::apply_Texture() const {
+    if(m_texture)
+      m_texture->apply_Texture();
+    else if(m_failed)
+      throw Texture_Init_Failure();
+    else
+      m_loader->apply_placeholder();
+  }
+
+  const Point2i & Texture_Async::get_size() const {
+    return m_texture ? m_texture->get_size() : m_loader->get_placeholder_size();
+  }
+
+}
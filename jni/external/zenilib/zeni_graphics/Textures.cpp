@@ -19,6 +19,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 #if defined(_LINUX)
 #include <dlfcn.h>
@@ -45,7 +46,11 @@ namespace Zeni {
   Textures::Unlose Textures::g_unlose;
 
   Textures::Textures()
-    : Database<Texture>("config/textures.xml", "Textures")
+    : Database<Texture>("config/textures.xml", "Textures"),
+    m_atlas(0),
+    m_packed_atlas(0),
+    m_kept_atlas(0),
+    m_loader(0)
   {
     Video &vr = get_Video();
 
@@ -59,6 +64,10 @@ namespace Zeni {
     Video::remove_pre_uninit(&g_lose);
 
     Database<Texture>::uninit();
+
+    delete m_packed_atlas;
+    delete m_kept_atlas;
+    delete m_loader;
   }
 
   Textures & get_Textures() {
@@ -101,6 +110,28 @@ namespace Zeni {
     return sprite->set_current_frame(frame_number);
   }
 
+  unsigned long Textures::pack_Image(const String &name, const Image &image, const bool &keep) {
+    Texture_Atlas *&atlas = keep ? m_kept_atlas : m_packed_atlas;
+    if(!atlas)
+      atlas = new Texture_Atlas;
+
+    return give(name, atlas->pack(image), keep);
+  }
+
+  size_t Textures::get_num_pending() const {
+    return m_loader ? m_loader->get_num_pending() : 0u;
+  }
+
+  void Textures::upload_decoded() {
+    if(m_loader)
+      m_loader->upload(m_upload_budget);
+  }
+
+  void Textures::finish_loading() {
+    if(m_loader)
+      m_loader->finish();
+  }
+
   void Textures::set_texturing_mode(const int &anisotropic_filtering_, const bool &bilinear_filtering_, const bool &mipmapping_) {
     const int af = anisotropic_filtering_ == -1 ? get_Video().get_maximum_anisotropy() : anisotropic_filtering_;
     
@@ -123,25 +154,52 @@ namespace Zeni {
 
   void Textures::on_load() {
     m_loaded = true;
+
+    if(!m_lazy_loading) {
+      if(m_atlas)
+        m_atlas->upload();
+      if(m_packed_atlas)
+        m_packed_atlas->upload();
+      if(m_kept_atlas)
+        m_kept_atlas->upload();
+    }
   }
 
   void Textures::on_clear() {
     m_loaded = false;
+
+    /// Every entry loaded from a file is about to go; packed Images may outlive them
+    delete m_atlas;
+    m_atlas = 0;
   }
 
   void Textures::on_lose() {
     m_loaded = false;
+
+    delete m_atlas;
+    m_atlas = 0;
+
+    delete m_packed_atlas;
+    m_packed_atlas = 0;
+
+    if(m_kept_atlas)
+      m_kept_atlas->lose_resources();
+
+    if(m_loader)
+      m_loader->lose_resources();
   }
 
   Texture * Textures::load(XML_Element_c &xml_element, const String &name, const String &filename) {
     const XML_Element_c is_sprite_e = xml_element["is_sprite"];
     const bool is_sprite = is_sprite_e.good() && is_sprite_e.to_bool();
+    const XML_Element_c atlas_e = xml_element["atlas"];
+    const bool atlas = atlas_e.good() ? atlas_e.to_bool() : m_atlasing;
 
     if(!is_sprite) {
       const String filepath = xml_element["filepath"].to_string();
       const bool tile = xml_element["tile"].to_bool();
 
-      return get_Video().load_Texture(filepath, tile, m_lazy_loading);
+      return load_Texture(filepath, tile, atlas);
     }
     else {
       Sprite * s = new Sprite();
@@ -156,15 +214,16 @@ namespace Zeni {
           else if(texture.value() == "file") {
             const String filepath = texture["filepath"].to_string();
             const bool tile = texture["tile"].to_bool();
+            const XML_Element_c frame_atlas_e = texture["atlas"];
             const String frame_name = name + '/' + ulltoa(frame_number);
 
-            Texture * const texture = get_Video().load_Texture(filepath, tile, m_lazy_loading);
+            Texture * const texture = load_Texture(filepath, tile, frame_atlas_e.good() ? frame_atlas_e.to_bool() : atlas);
 
             const unsigned long id = give(frame_name, texture, false, filename);
 
             s->append_frame(frame_name, id);
           }
-          else if(texture.value() == "is_sprite")
+          else if(texture.value() == "is_sprite" || texture.value() == "atlas")
             --frame_number;
           else
             throw Database_Load_Entry_Failed(name);
@@ -178,10 +237,38 @@ namespace Zeni {
     }
   }
 
+  Texture * Textures::load_Texture(const String &filepath, const bool &tile, const bool &atlas) {
+    if(!atlas || tile) {
+      if(m_asynchronous_loading) {
+        if(!m_loader) {
+          /// Loader Threads build mip chains with for_each_span, so the Job_System must exist before they start
+          get_Job_System();
+          m_loader = new Texture_Loader;
+        }
+
+        return m_loader->load(filepath, tile);
+      }
+
+      return get_Video().load_Texture(filepath, tile, m_lazy_loading);
+    }
+
+    const std::auto_ptr<Image> image(m_caching ? Image_Cache::load_Image(filepath, tile) : new Image(filepath, tile));
+
+    if(!m_atlas)
+      m_atlas = new Texture_Atlas;
+
+    /// Images too large to share a page get one of their own, padded to a power of two
+    return m_atlas->pack(*image);
+  }
+
   bool Textures::m_loaded = false;
   bool Textures::m_bilinear_filtering = true;
   bool Textures::m_mipmapping = true;
   int Textures::m_anisotropic_filtering = 0;
   bool Textures::m_lazy_loading = false;
+  bool Textures::m_atlasing = false;
+  bool Textures::m_asynchronous_loading = false;
+  bool Textures::m_caching = false;
+  float Textures::m_upload_budget = 0.002f;
 
 }
@@ -46,12 +46,24 @@ namespace Zeni {
   Vertex_Buffer::Vertex_Buffer_Range::Vertex_Buffer_Range(Material * const &m, const size_t &s, const size_t &ne)
     : material(m), 
     start(s), 
-    num_elements(ne)
+    num_elements(ne),
+    visible(true)
   {
   }
 
+  Vertex_Buffer::Cull_Stats::Cull_Stats()
+    : visible(0u),
+    culled(0u),
+    seconds(0.0f)
+  {
+  }
+
+  static Vertex_Buffer::Cull_Stats g_cull_stats;
+  static Vertex_Buffer::Cull_Stats g_cull_stats_previous;
+
   Vertex_Buffer::Vertex_Buffer()
     : m_align_normals(false),
+    m_culled(false),
     m_renderer(0),
     m_prerendered(false),
     m_macrorenderer(new Vertex_Buffer_Macrorenderer)
@@ -240,7 +252,72 @@ namespace Zeni {
     }
   };
 
+  static void set_visible(std::vector<Vertex_Buffer::Vertex_Buffer_Range *> &descriptors, const bool &visible) {
+    for(std::vector<Vertex_Buffer::Vertex_Buffer_Range *>::iterator it = descriptors.begin(); it != descriptors.end(); ++it)
+      (*it)->visible = visible;
+  }
+
+  static size_t set_visible(std::vector<Vertex_Buffer::Vertex_Buffer_Range *> &descriptors, const Frustum &frustum) {
+    size_t visible = 0u;
+    for(std::vector<Vertex_Buffer::Vertex_Buffer_Range *>::iterator it = descriptors.begin(); it != descriptors.end(); ++it) {
+      (*it)->visible = frustum.contains((*it)->lower_bound, (*it)->upper_bound) != Frustum::OUTSIDE;
+      if((*it)->visible)
+        ++visible;
+    }
+    return visible;
+  }
+
   void Vertex_Buffer::render() {
+    if(m_culled) {
+      set_visible(m_descriptors_cm, true);
+      set_visible(m_descriptors_t, true);
+      m_culled = false;
+    }
+
+    render_ranges();
+  }
+
+  void Vertex_Buffer::render(const Frustum &frustum) {
+    prerender();
+
+    const Time_HQ start;
+
+    const size_t ranges = m_descriptors_cm.size() + m_descriptors_t.size();
+    size_t visible;
+
+    /** Only test individual ranges if the Vertex_Buffer as a whole
+     *  straddles the Frustum.
+     */
+    switch(frustum.contains(m_lower_bound, m_upper_bound)) {
+      case Frustum::INTERSECTING:
+        visible = set_visible(m_descriptors_cm, frustum) + set_visible(m_descriptors_t, frustum);
+        break;
+
+      case Frustum::INSIDE:
+        set_visible(m_descriptors_cm, true);
+        set_visible(m_descriptors_t, true);
+        visible = ranges;
+        break;
+
+      case Frustum::OUTSIDE:
+      default:
+        set_visible(m_descriptors_cm, false);
+        set_visible(m_descriptors_t, false);
+        visible = 0u;
+        break;
+    }
+
+    m_culled = visible != ranges;
+
+    g_cull_stats.visible += visible;
+    g_cull_stats.culled += ranges - visible;
+    g_cull_stats.seconds += float(start.get_seconds_passed());
+
+    if(visible)
+      render_ranges();
+  }
+
+  void Vertex_Buffer::render_ranges() {
     if(!m_renderer) {
       Video &vr = get_Video();
 
@@ -253,6 +330,15 @@ namespace Zeni {
     m_renderer->render();
   }
 
+  const Vertex_Buffer::Cull_Stats & Vertex_Buffer::get_cull_stats() {
+    return g_cull_stats_previous;
+  }
+
+  void Vertex_Buffer::next_cull_frame() {
+    g_cull_stats_previous = g_cull_stats;
+    g_cull_stats = Cull_Stats();
+  }
+
   void Vertex_Buffer::lose() {
     delete m_renderer;
     m_renderer = 0;
@@ -262,6 +348,7 @@ namespace Zeni {
     if(!m_prerendered) {
       sort_triangles();
       set_descriptors();
+      set_bounds();
       if(m_align_normals)
         align_similar_normals();
 
@@ -422,6 +509,56 @@ namespace Zeni {
     DESCRIBER<Vertex3f_Texture>()(m_triangles_t, m_descriptors_t, 0u);
   }
 
+  template<typename VERTEX>
+  static void set_bounds(const std::vector<Triangle<VERTEX> *> &triangles,
+                         std::vector<Vertex_Buffer::Vertex_Buffer_Range *> &descriptors,
+                         Point3f &lower_bound,
+                         Point3f &upper_bound,
+                         bool &started)
+  {
+    for(std::vector<Vertex_Buffer::Vertex_Buffer_Range *>::iterator it = descriptors.begin();
+        it != descriptors.end();
+        ++it)
+    {
+      Point3f lower = (*triangles[(*it)->start])[0].position;
+      Point3f upper = lower;
+
+      for(size_t i = (*it)->start, iend = (*it)->start + (*it)->num_elements; i != iend; ++i)
+        for(int j = 0; j != 3; ++j) {
+          const Point3f &position = (*triangles[i])[j].position;
+
+          lower.x = std::min(lower.x, position.x);
+          lower.y = std::min(lower.y, position.y);
+          lower.z = std::min(lower.z, position.z);
+          upper.x = std::max(upper.x, position.x);
+          upper.y = std::max(upper.y, position.y);
+          upper.z = std::max(upper.z, position.z);
+        }
+
+      (*it)->lower_bound = lower;
+      (*it)->upper_bound = upper;
+
+      if(started) {
+        lower_bound = Point3f(std::min(lower_bound.x, lower.x), std::min(lower_bound.y, lower.y), std::min(lower_bound.z, lower.z));
+        upper_bound = Point3f(std::max(upper_bound.x, upper.x), std::max(upper_bound.y, upper.y), std::max(upper_bound.z, upper.z));
+      }
+      else {
+        lower_bound = lower;
+        upper_bound = upper;
+        started = true;
+      }
+    }
+  }
+
+  void Vertex_Buffer::set_bounds() {
+    bool started = false;
+    m_lower_bound = Point3f();
+    m_upper_bound = Point3f();
+
+    Zeni::set_bounds(m_triangles_cm, m_descriptors_cm, m_lower_bound, m_upper_bound, started);
+    Zeni::set_bounds(m_triangles_t, m_descriptors_t, m_lower_bound, m_upper_bound, started);
+  }
+
   void Vertex_Buffer::lose_all() {
     std::set<Vertex_Buffer *> &vbos = get_vbos();
 
@@ -585,8 +722,10 @@ namespace Zeni {
       if(descriptors[i]->material.get())
         vr.set_Material(*descriptors[i]->material);
 
-      VB_Renderer_GL microrenderer(int(3u*descriptors[i]->start), int(3u*descriptors[i]->num_elements));
-      macrorenderer(microrenderer);
+      if(descriptors[i]->visible) {
+        VB_Renderer_GL microrenderer(int(3u*descriptors[i]->start), int(3u*descriptors[i]->num_elements));
+        macrorenderer(microrenderer);
+      }
 
       if(descriptors[i]->material.get())
         vr.unset_Material(*descriptors[i]->material);
@@ -960,13 +1099,15 @@ namespace Zeni {
         if(descriptors[i]->material.get())
           vdx.set_Material(*descriptors[i]->material);
 
-        if(vbo_dx9.is_vbo) {
-          VB_Renderer_DX9VBO microrenderer(vdx, 3u * descriptors[i]->start, descriptors[i]->num_elements);
-          macrorenderer(microrenderer);
-        }
-        else {
-          VB_Renderer_DX9 microrenderer(vdx, descriptors[i]->num_elements, vbo_dx9.data.alt + 3u * descriptors[i]->start, stride);
-          macrorenderer(microrenderer);
+        if(descriptors[i]->visible) {
+          if(vbo_dx9.is_vbo) {
+            VB_Renderer_DX9VBO microrenderer(vdx, 3u * descriptors[i]->start, descriptors[i]->num_elements);
+            macrorenderer(microrenderer);
+          }
+          else {
+            VB_Renderer_DX9 microrenderer(vdx, descriptors[i]->num_elements, vbo_dx9.data.alt + 3u * descriptors[i]->start, stride);
+            macrorenderer(microrenderer);
+          }
         }
 
         if(descriptors[i]->material.get())
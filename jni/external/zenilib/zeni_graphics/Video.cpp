@@ -119,12 +119,17 @@ namespace Zeni {
   Video::Video()
     :
     m_color(1.0f, 1.0f, 1.0f, 1.0f),
+    m_texture_matrix(Matrix4f::Identity()),
+    m_texture_matrix_set(false),
     m_preview(Matrix4f::Translate(Vector3f(-0.5f, -0.5f, 0.0f)) *
       Matrix4f::Scale(Vector3f(0.5f, -0.5f, -1.0f)) *
       Matrix4f::Translate(Vector3f(1.0f, -1.0f, 0.0f))),
     m_alpha_test(false),
     m_alpha_function(Video::ZENI_ALWAYS),
     m_alpha_value(0.0f),
+    m_distance_field_alpha_test(false),
+    m_distance_field_alpha_function(Video::ZENI_ALWAYS),
+    m_distance_field_alpha_value(0.0f),
     m_3d(false)
   {
     static bool once = false;
@@ -152,6 +157,7 @@ namespace Zeni {
 
   void Video::set_2d_view(const std::pair<Point2f, Point2f> &camera2d, const std::pair<Point2i, Point2i> &viewport, const bool &fix_aspect_ratio) {
     m_3d = false;
+    m_frustum = Frustum();
 
     set_viewport(calculate_viewport(camera2d, viewport, fix_aspect_ratio));
 
@@ -180,6 +186,8 @@ namespace Zeni {
     const Matrix4f projection = camera.get_projection_matrix(viewport);
     set_projection_matrix(projection);
 
+    m_frustum = camera.get_frustum(viewport);
+
     set_viewport(viewport);
   }
 
@@ -215,6 +223,29 @@ namespace Zeni {
     g_clear_color = color;
   }
 
+  void Video::set_texture_matrix(const Matrix4f &texture_matrix) {
+    m_texture_matrix = texture_matrix;
+    m_texture_matrix_set = true;
+  }
+
+  void Video::unset_texture_matrix() {
+    m_texture_matrix = Matrix4f::Identity();
+    m_texture_matrix_set = false;
+  }
+
+  void Video::set_distance_field(const float &) {
+    /// Without a fragment program, the alpha test gives hard but scalable edges
+    m_distance_field_alpha_test = m_alpha_test;
+    m_distance_field_alpha_function = m_alpha_function;
+    m_distance_field_alpha_value = m_alpha_value;
+
+    set_alpha_test(true, ZENI_GREATER_OR_EQUAL, 0.5f);
+  }
+
+  void Video::unset_distance_field() {
+    set_alpha_test(m_distance_field_alpha_test, m_distance_field_alpha_function, m_distance_field_alpha_value);
+  }
+
   void Video::set_lighting(const bool &on) {
     g_lighting = on;
   }
@@ -23,6 +23,7 @@
 #include <SDL/SDL_syswm.h>
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
 #include <d3d9.h>
@@ -191,6 +192,8 @@ namespace Zeni {
     get_Textures().unlose_resources();
     get_Fonts().unlose_resources();
 
+    get_Textures().upload_decoded();
+
     return true;
   }
 
@@ -381,6 +384,32 @@ namespace Zeni {
     set_fvf();
   }
 
+  void Video_DX9::set_texture_matrix(const Matrix4f &texture_matrix) {
+    if(is_texture_matrix_set() && !memcmp(&get_texture_matrix(), &texture_matrix, sizeof(Matrix4f)))
+      return;
+
+    Video::set_texture_matrix(texture_matrix);
+
+    // Direct3D transforms 2D texture coordinates as (u, v, 1), so the translation belongs in the third row
+    D3DMATRIX matrix = *reinterpret_cast<const D3DMATRIX *>(&texture_matrix);
+    matrix._31 = matrix._41;
+    matrix._32 = matrix._42;
+    matrix._41 = 0.0f;
+    matrix._42 = 0.0f;
+
+    m_d3d_device->SetTransform(D3DTS_TEXTURE0, &matrix);
+    m_d3d_device->SetTextureStageState(0, D3DTSS_TEXTURETRANSFORMFLAGS, D3DTTFF_COUNT2);
+  }
+
+  void Video_DX9::unset_texture_matrix() {
+    if(!is_texture_matrix_set())
+      return;
+
+    Video::unset_texture_matrix();
+
+    m_d3d_device->SetTextureStageState(0, D3DTSS_TEXTURETRANSFORMFLAGS, D3DTTFF_DISABLE);
+  }
+
   void Video_DX9::set_lighting(const bool &on) {
     Video::set_lighting(on);
 
@@ -554,8 +583,8 @@ namespace Zeni {
     return new Texture_DX9(filename, repeat);
   }
 
-  Texture * Video_DX9::create_Texture(const Image &image) {
-    return new Texture_DX9(image);
+  Texture * Video_DX9::create_Texture(const Image &image, const int &mip_levels) {
+    return new Texture_DX9(image, mip_levels);
   }
 
   Texture * Video_DX9::create_Texture(const Point2i &size, const bool &repeat) {
@@ -570,8 +599,8 @@ namespace Zeni {
     return new Texture_DX9(corrected, repeat);
   }
 
-  Font * Video_DX9::create_Font(const String &filename, const float &glyph_height, const float &virtual_screen_height) {
-    return new Font_FT(filename, glyph_height, virtual_screen_height);
+  Font * Video_DX9::create_Font(const String &filename, const float &glyph_height, const float &virtual_screen_height, const bool &distance_field) {
+    return new Font_FT(filename, glyph_height, virtual_screen_height, distance_field);
   }
 
   Vertex_Buffer_Renderer * Video_DX9::create_Vertex_Buffer_Renderer(Vertex_Buffer &vertex_buffer) {
@@ -44,6 +44,7 @@ namespace GLXEW {
 
 #include <GLSLANG/ShaderLang.h>
 
+#include <cstring>
 #include <iostream>
 
 #if defined(_DEBUG) && defined(_WINDOWS)
@@ -106,6 +107,8 @@ namespace Zeni {
     get_Textures().unlose_resources();
     get_Fonts().unlose_resources();
 
+    get_Textures().upload_decoded();
+
     return true;
   }
 
@@ -352,6 +355,28 @@ namespace Zeni {
     glDisable(GL_TEXTURE_2D);
   }
 
+  void Video_GL_Fixed::set_texture_matrix(const Matrix4f &texture_matrix) {
+    if(is_texture_matrix_set() && !memcmp(&get_texture_matrix(), &texture_matrix, sizeof(Matrix4f)))
+      return;
+
+    Video::set_texture_matrix(texture_matrix);
+
+    glMatrixMode(GL_TEXTURE);
+    glLoadMatrixf(reinterpret_cast<GLfloat *>(const_cast<Matrix4f *>(&texture_matrix)));
+    glMatrixMode(GL_MODELVIEW);
+  }
+
+  void Video_GL_Fixed::unset_texture_matrix() {
+    if(!is_texture_matrix_set())
+      return;
+
+    Video::unset_texture_matrix();
+
+    glMatrixMode(GL_TEXTURE);
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+  }
+
   void Video_GL_Fixed::set_lighting(const bool &on) {
     Video::set_lighting(on);
 
@@ -500,6 +525,7 @@ namespace Zeni {
       (Textures::get_bilinear_filtering() ? GL_LINEAR : GL_NEAREST));
     glDisable(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, 0);
+    Texture_GL::g_bound_texture_id = 0;
 
     m_render_target = 0;
 #endif
@@ -583,16 +609,16 @@ namespace Zeni {
     return new Texture_GL(filename, repeat, lazy_loading);
   }
 
-  Texture * Video_GL_Fixed::create_Texture(const Image &image) {
-    return new Texture_GL(image);
+  Texture * Video_GL_Fixed::create_Texture(const Image &image, const int &mip_levels) {
+    return new Texture_GL(image, mip_levels);
   }
 
   Texture * Video_GL_Fixed::create_Texture(const Point2i &size, const bool &repeat) {
     return new Texture_GL(size, repeat);
   }
 
-  Font * Video_GL_Fixed::create_Font(const String &filename, const float &glyph_height, const float &virtual_screen_height) {
-    return new Font_FT(filename, glyph_height, virtual_screen_height);
+  Font * Video_GL_Fixed::create_Font(const String &filename, const float &glyph_height, const float &virtual_screen_height, const bool &distance_field) {
+    return new Font_FT(filename, glyph_height, virtual_screen_height, distance_field);
   }
 
   Vertex_Buffer_Renderer * Video_GL_Fixed::create_Vertex_Buffer_Renderer(Vertex_Buffer &vertex_buffer) {
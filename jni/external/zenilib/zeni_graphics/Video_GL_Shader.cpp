@@ -44,6 +44,7 @@ namespace GLXEW {
 
 #include <GLSLANG/ShaderLang.h>
 
+#include <cstring>
 #include <iostream>
 
 #if defined(_DEBUG) && defined(_WINDOWS)
@@ -73,7 +74,19 @@ namespace Zeni {
 #endif
       m_maximum_anisotropy(-1),
       m_zwrite(false),
-      m_render_target(0)
+      m_render_target(0),
+      m_distance_field_vertex_shader(0),
+      m_distance_field_fragment_shader(0),
+      m_distance_field_program(0),
+      m_distance_field_smoothing(-1),
+      m_distance_field_previous(0),
+      m_distance_field_tried(false),
+      m_clustered_vertex_shader(0),
+      m_clustered_fragment_shader(0),
+      m_clustered_program(0),
+      m_clustered_textured(-1),
+      m_clustered_tried(false),
+      m_clustered_active(false)
 #ifdef MANUAL_GL_VSYNC_DELAY
       ,
       m_buffer_swap_end_time(0u),
@@ -100,6 +113,8 @@ namespace Zeni {
     get_Textures().unlose_resources();
     get_Fonts().unlose_resources();
 
+    get_Textures().upload_decoded();
+
     return true;
   }
 
@@ -336,14 +351,75 @@ namespace Zeni {
 
   void Video_GL_Shader::apply_Texture(const unsigned long &id) {
     get_Textures().apply_Texture(id);
+
+    if(m_clustered_active)
+      m_clustered_program->set_uniform(m_clustered_textured, 1);
   }
 
   void Video_GL_Shader::apply_Texture(const Texture &texture) {
     texture.apply_Texture();
+
+    if(m_clustered_active)
+      m_clustered_program->set_uniform(m_clustered_textured, 1);
   }
 
   void Video_GL_Shader::unapply_Texture() {
     glDisable(GL_TEXTURE_2D);
+
+    if(m_clustered_active)
+      m_clustered_program->set_uniform(m_clustered_textured, 0);
+  }
+
+  void Video_GL_Shader::set_texture_matrix(const Matrix4f &texture_matrix) {
+    if(is_texture_matrix_set() && !memcmp(&get_texture_matrix(), &texture_matrix, sizeof(Matrix4f)))
+      return;
+
+    Video::set_texture_matrix(texture_matrix);
+
+    glMatrixMode(GL_TEXTURE);
+    glLoadMatrixf(reinterpret_cast<GLfloat *>(const_cast<Matrix4f *>(&texture_matrix)));
+    glMatrixMode(GL_MODELVIEW);
+  }
+
+  void Video_GL_Shader::unset_texture_matrix() {
+    if(!is_texture_matrix_set())
+      return;
+
+    Video::unset_texture_matrix();
+
+    glMatrixMode(GL_TEXTURE);
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+  }
+
+  void Video_GL_Shader::set_distance_field(const float &smoothing) {
+    if(!m_distance_field_tried)
+      init_distance_field();
+
+    if(!m_distance_field_program) {
+      Video::set_distance_field(smoothing);
+      return;
+    }
+
+    if(Program_GL_Shader::get_current() != m_distance_field_program)
+      m_distance_field_previous = Program_GL_Shader::get_current();
+
+    m_distance_field_program->use();
+    m_distance_field_program->set_uniform(m_distance_field_smoothing, smoothing);
+  }
+
+  void Video_GL_Shader::unset_distance_field() {
+    if(!m_distance_field_program) {
+      Video::unset_distance_field();
+      return;
+    }
+
+    /// A user Program or clustered lighting may have been current before the text
+    if(m_distance_field_previous)
+      m_distance_field_previous->use();
+    else
+      Program_GL_Shader::unuse();
+    m_distance_field_previous = 0;
   }
 
   void Video_GL_Shader::set_lighting(const bool &on) {
@@ -401,6 +477,56 @@ namespace Zeni {
     glDisable(ln);
   }
 
+  /// Replace the contents of a float texture, leaving 'unit' active
+  static void upload_cluster_texels(const GLenum &unit, const GLuint &texture, const size_t &width, const size_t &height, const std::vector<float> &texels) {
+    glActiveTexture(unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+#ifndef REQUIRE_GL_ES
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F_ARB, GLsizei(width), GLsizei(height), 0, GL_RGBA, GL_FLOAT, &texels[0]);
+#endif
+  }
+
+  bool Video_GL_Shader::set_clustered_lighting(const Light_Clusters &clusters) {
+    if(!m_clustered_tried)
+      init_clustered_lighting();
+
+    if(!m_clustered_program || clusters.get_light_texels().empty())
+      return false;
+
+    const size_t light_width = Light_Clusters::lights_per_row * Light_Clusters::texels_per_light;
+    const size_t light_height = clusters.get_light_texels().size() / (4u * light_width);
+    const size_t cluster_width = size_t(clusters.get_columns() * clusters.get_rows());
+    const size_t index_width = Light_Clusters::indices_per_row / 4u;
+    const size_t index_height = clusters.get_index_texels().size() / Light_Clusters::indices_per_row;
+
+    upload_cluster_texels(GL_TEXTURE1, m_clustered_textures[0], light_width, light_height, clusters.get_light_texels());
+    upload_cluster_texels(GL_TEXTURE2, m_clustered_textures[1], cluster_width, size_t(clusters.get_slices()), clusters.get_cluster_texels());
+    upload_cluster_texels(GL_TEXTURE3, m_clustered_textures[2], index_width, index_height, clusters.get_index_texels());
+    glActiveTexture(GL_TEXTURE0);
+
+    Program_GL_Shader &program = *m_clustered_program;
+    program.use();
+    program.set_uniform(program.get_uniform("light_scale"), Point2f(1.0f / light_width, 1.0f / light_height));
+    program.set_uniform(program.get_uniform("index_scale"), Point2f(1.0f / index_width, 1.0f / index_height));
+    program.set_uniform(program.get_uniform("cluster_dims"), Vector3f(float(clusters.get_columns()), float(clusters.get_rows()), float(clusters.get_slices())));
+    program.set_uniform(program.get_uniform("projection_scale"), clusters.get_projection_scale());
+    program.set_uniform(program.get_uniform("slice_params"), Point2f(clusters.get_near_clip(),
+                                                                     clusters.get_slices() / std::log(clusters.get_far_clip() / clusters.get_near_clip())));
+    program.set_uniform(program.get_uniform("num_unbounded"), float(clusters.get_num_unbounded()));
+    program.set_uniform(m_clustered_textured, glIsEnabled(GL_TEXTURE_2D) ? 1 : 0);
+
+    m_clustered_active = true;
+    return true;
+  }
+
+  void Video_GL_Shader::unset_clustered_lighting() {
+    if(!m_clustered_active)
+      return;
+
+    Program_GL_Shader::unuse();
+    m_clustered_active = false;
+  }
+
   void Video_GL_Shader::set_Material(const Material &material) {
     material.set(*this);
   }
@@ -423,12 +549,11 @@ namespace Zeni {
   }
   
   void Video_GL_Shader::set_program(Program &program) {
-    program.link();
-    glUseProgram(dynamic_cast<Program_GL_Shader &>(program).get());
+    dynamic_cast<Program_GL_Shader &>(program).use();
   }
 
   void Video_GL_Shader::unset_program() {
-    glUseProgram(0); ///< DEPRECATED: Requires SDL_GL_CONTEXT_PROFILE_COMPATIBILITY
+    Program_GL_Shader::unuse();
   }
 
   void Video_GL_Shader::set_render_target(Texture &
@@ -494,6 +619,7 @@ namespace Zeni {
       (Textures::get_bilinear_filtering() ? GL_LINEAR : GL_NEAREST));
     glDisable(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, 0);
+    Texture_GL::g_bound_texture_id = 0;
 
     m_render_target = 0;
 #endif
@@ -577,16 +703,16 @@ namespace Zeni {
     return new Texture_GL(filename, repeat, lazy_loading);
   }
 
-  Texture * Video_GL_Shader::create_Texture(const Image &image) {
-    return new Texture_GL(image);
+  Texture * Video_GL_Shader::create_Texture(const Image &image, const int &mip_levels) {
+    return new Texture_GL(image, mip_levels);
   }
 
   Texture * Video_GL_Shader::create_Texture(const Point2i &size, const bool &repeat) {
     return new Texture_GL(size, repeat);
   }
 
-  Font * Video_GL_Shader::create_Font(const String &filename, const float &glyph_height, const float &virtual_screen_height) {
-    return new Font_FT(filename, glyph_height, virtual_screen_height);
+  Font * Video_GL_Shader::create_Font(const String &filename, const float &glyph_height, const float &virtual_screen_height, const bool &distance_field) {
+    return new Font_FT(filename, glyph_height, virtual_screen_height, distance_field);
   }
 
   Vertex_Buffer_Renderer * Video_GL_Shader::create_Vertex_Buffer_Renderer(Vertex_Buffer &vertex_buffer) {
@@ -791,7 +917,209 @@ namespace Zeni {
     Core::assert_no_error();
   }
 
+  void Video_GL_Shader::init_distance_field() {
+    m_distance_field_tried = true;
+
+#ifndef REQUIRE_GL_ES
+    if(!GLEW_VERSION_2_0)
+      return;
+
+    /// Fixed function transformation and color, with alpha taken from the distance field
+    static const char * const vertex_src =
+      "varying vec2 texcoord;\n"
+      "void main() {\n"
+      "  gl_Position = ftransform();\n"
+      "  gl_FrontColor = gl_Color;\n"
+      "  texcoord = (gl_TextureMatrix[0] * gl_MultiTexCoord0).xy;\n"
+      "}\n";
+
+    static const char * const fragment_src =
+      "uniform sampler2D glyphs;\n"
+      "uniform float smoothing;\n"
+      "varying vec2 texcoord;\n"
+      "void main() {\n"
+      "  float field = texture2D(glyphs, texcoord).a;\n"
+      "  gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * smoothstep(0.5 - smoothing, 0.5 + smoothing, field));\n"
+      "}\n";
+
+    try {
+      m_distance_field_vertex_shader = new Shader_GL_Shader(vertex_src, Shader::VERTEX);
+      m_distance_field_fragment_shader = new Shader_GL_Shader(fragment_src, Shader::FRAGMENT);
+      m_distance_field_program = new Program_GL_Shader;
+      m_distance_field_program->attach(*m_distance_field_vertex_shader);
+      m_distance_field_program->attach(*m_distance_field_fragment_shader);
+      m_distance_field_program->link();
+    }
+    catch(Error &) {
+      std::cerr << "Quality Warning:  Distance field text will be rendered with the alpha test instead of a fragment program.\n";
+
+      delete m_distance_field_program;
+      delete m_distance_field_fragment_shader;
+      delete m_distance_field_vertex_shader;
+      m_distance_field_program = 0;
+      m_distance_field_fragment_shader = 0;
+      m_distance_field_vertex_shader = 0;
+      return;
+    }
+
+    m_distance_field_smoothing = m_distance_field_program->get_uniform("smoothing");
+#endif
+  }
+
+  void Video_GL_Shader::init_clustered_lighting() {
+    m_clustered_tried = true;
+
+#ifndef REQUIRE_GL_ES
+    if(!GLEW_VERSION_2_0 || (!GLEW_VERSION_3_0 && !GLEW_ARB_texture_float))
+      return;
+
+    /// Fixed function transformation, with lighting done in view space per fragment
+    static const char * const vertex_src =
+      "varying vec3 position;\n"
+      "varying vec3 normal;\n"
+      "varying vec2 texcoord;\n"
+      "void main() {\n"
+      "  position = (gl_ModelViewMatrix * gl_Vertex).xyz;\n"
+      "  normal = gl_NormalMatrix * gl_Normal;\n"
+      "  texcoord = (gl_TextureMatrix[0] * gl_MultiTexCoord0).xy;\n"
+      "  gl_Position = ftransform();\n"
+      "}\n";
+
+    /// Unbounded lights first, then those of the fragment's cluster; The light model follows fixed function, with separate specular
+    static const char * const fragment_src =
+      "uniform sampler2D texture0;\n"
+      "uniform sampler2D lights;\n"
+      "uniform sampler2D clusters;\n"
+      "uniform sampler2D indices;\n"
+      "uniform int textured;\n"
+      "uniform vec2 light_scale;\n"
+      "uniform vec2 index_scale;\n"
+      "uniform vec3 cluster_dims;\n"
+      "uniform vec2 projection_scale;\n"
+      "uniform vec2 slice_params;\n"
+      "uniform float num_unbounded;\n"
+      "varying vec3 position;\n"
+      "varying vec3 normal;\n"
+      "varying vec2 texcoord;\n"
+      "vec4 light_texel(float light, float texel) {\n"
+      "  float row = floor(light / 256.0);\n"
+      "  return texture2D(lights, (vec2((light - row * 256.0) * 6.0 + texel, row) + 0.5) * light_scale);\n"
+      "}\n"
+      "void shade(float light, vec3 N, vec3 V, inout vec3 color, inout vec3 specular) {\n"
+      "  vec4 t0 = light_texel(light, 0.0);\n"
+      "  vec4 t3 = light_texel(light, 3.0);\n"
+      "  vec4 t4 = light_texel(light, 4.0);\n"
+      "  vec3 L = t0.xyz;\n"
+      "  float attenuation = 1.0;\n"
+      "  if(t0.w < 2.5) {\n"
+      "    L -= position;\n"
+      "    float d = length(L);\n"
+      "    if(d > t3.w)\n"
+      "      return;\n"
+      "    L /= d;\n"
+      "    vec4 t5 = light_texel(light, 5.0);\n"
+      "    attenuation = 1.0 / (t4.w + t5.x * d + t5.y * d * d);\n"
+      "    if(t0.w > 1.5) {\n"
+      "      vec4 t1 = light_texel(light, 1.0);\n"
+      "      float spot = dot(-L, t1.xyz);\n"
+      "      if(spot < t1.w)\n"
+      "        return;\n"
+      "      attenuation *= pow(spot, light_texel(light, 2.0).w);\n"
+      "    }\n"
+      "  }\n"
+      "  vec4 t2 = light_texel(light, 2.0);\n"
+      "  float diffuse = max(dot(N, L), 0.0);\n"
+      "  color += attenuation * (t4.rgb * gl_FrontMaterial.ambient.rgb + diffuse * t2.rgb * gl_FrontMaterial.diffuse.rgb);\n"
+      "  if(diffuse > 0.0)\n"
+      "    specular += attenuation * pow(max(dot(N, normalize(L + V)), 0.0), gl_FrontMaterial.shininess) * t3.rgb * gl_FrontMaterial.specular.rgb;\n"
+      "}\n"
+      "void main() {\n"
+      "  vec3 N = normalize(gl_FrontFacing ? normal : -normal);\n"
+      "  vec3 V = normalize(-position);\n"
+      "  vec3 color = gl_FrontMaterial.emission.rgb + gl_LightModel.ambient.rgb * gl_FrontMaterial.ambient.rgb;\n"
+      "  vec3 specular = vec3(0.0);\n"
+      "  for(float i = 0.0; i < num_unbounded; i += 1.0)\n"
+      "    shade(i, N, V, color, specular);\n"
+      "  vec2 tile = clamp(floor((position.xy / -position.z * projection_scale * 0.5 + 0.5) * cluster_dims.xy), vec2(0.0), cluster_dims.xy - 1.0);\n"
+      "  float slice = clamp(floor(log(-position.z / slice_params.x) * slice_params.y), 0.0, cluster_dims.z - 1.0);\n"
+      "  vec4 cluster = texture2D(clusters, (vec2(tile.y * cluster_dims.x + tile.x, slice) + 0.5) / vec2(cluster_dims.x * cluster_dims.y, cluster_dims.z));\n"
+      "  for(float i = 0.0; i < cluster.y; i += 1.0) {\n"
+      "    float index = cluster.x + i;\n"
+      "    float texel = floor(index / 4.0);\n"
+      "    float row = floor(texel / 1024.0);\n"
+      "    vec4 four = texture2D(indices, (vec2(texel - row * 1024.0, row) + 0.5) * index_scale);\n"
+      "    shade(dot(four, vec4(equal(vec4(index - texel * 4.0), vec4(0.0, 1.0, 2.0, 3.0)))), N, V, color, specular);\n"
+      "  }\n"
+      "  vec4 base = vec4(color, gl_FrontMaterial.diffuse.a);\n"
+      "  if(textured != 0)\n"
+      "    base *= texture2D(texture0, texcoord);\n"
+      "  gl_FragColor = vec4(base.rgb + specular, base.a);\n"
+      "}\n";
+
+    try {
+      m_clustered_vertex_shader = new Shader_GL_Shader(vertex_src, Shader::VERTEX);
+      m_clustered_fragment_shader = new Shader_GL_Shader(fragment_src, Shader::FRAGMENT);
+      m_clustered_program = new Program_GL_Shader;
+      m_clustered_program->attach(*m_clustered_vertex_shader);
+      m_clustered_program->attach(*m_clustered_fragment_shader);
+      m_clustered_program->link();
+    }
+    catch(Error &) {
+      std::cerr << "Quality Warning:  Clustered lighting is unavailable.\n";
+
+      delete m_clustered_program;
+      delete m_clustered_fragment_shader;
+      delete m_clustered_vertex_shader;
+      m_clustered_program = 0;
+      m_clustered_fragment_shader = 0;
+      m_clustered_vertex_shader = 0;
+      return;
+    }
+
+    /// Off unit 0, so that Texture_GL's record of its binding stays true
+    glActiveTexture(GL_TEXTURE1);
+    glGenTextures(3, m_clustered_textures);
+    for(int i = 0; i != 3; ++i) {
+      glBindTexture(GL_TEXTURE_2D, m_clustered_textures[i]);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    /// Samplers never change, so set them while the Program is not current
+    Program_GL_Shader &program = *m_clustered_program;
+    program.set_uniform(program.get_uniform("texture0"), 0);
+    program.set_uniform(program.get_uniform("lights"), 1);
+    program.set_uniform(program.get_uniform("clusters"), 2);
+    program.set_uniform(program.get_uniform("indices"), 3);
+    m_clustered_textured = program.get_uniform("textured");
+#endif
+  }
+
   void Video_GL_Shader::uninit() {
+    delete m_distance_field_program;
+    delete m_distance_field_fragment_shader;
+    delete m_distance_field_vertex_shader;
+    m_distance_field_program = 0;
+    m_distance_field_fragment_shader = 0;
+    m_distance_field_vertex_shader = 0;
+    m_distance_field_tried = false;
+
+    if(m_clustered_program)
+      glDeleteTextures(3, m_clustered_textures);
+    delete m_clustered_program;
+    delete m_clustered_fragment_shader;
+    delete m_clustered_vertex_shader;
+    m_clustered_program = 0;
+    m_clustered_fragment_shader = 0;
+    m_clustered_vertex_shader = 0;
+    m_clustered_textured = -1;
+    m_clustered_tried = false;
+    m_clustered_active = false;
+
     ShDestruct(m_vertex_compiler);
     ShDestruct(m_fragment_compiler);
 
@@ -0,0 +1,148 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Command_List
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Recording of Video Calls to be Replayed Later
+ *
+ * A Command_List records the same calls one would make on Video without
+ * touching Video, so a frame can be recorded on one Thread and replayed on
+ * the Thread that owns the rendering context.
+ *
+ * Arguments are copied when recorded, except for those taken by
+ * reference to Textures, Programs, and Renderables passed to
+ * render_reference, which must survive until the Command_List is replayed.
+ * Anything else can be recorded by deriving from Command_List::Command.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_COMMAND_LIST_H
+#define ZENI_COMMAND_LIST_H
+
+#include <Zeni/Camera.h>
+#include <Zeni/Color.h>
+#include <Zeni/Coordinate.h>
+#include <Zeni/Matrix4f.h>
+#include <Zeni/Quaternion.h>
+#include <Zeni/String.h>
+#include <Zeni/Video.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  class ZENI_GRAPHICS_DLL Command_List {
+    // Undefined
+    Command_List(const Command_List &);
+    Command_List & operator=(const Command_List &);
+
+  public:
+    class ZENI_GRAPHICS_DLL Command {
+    public:
+      virtual ~Command() {}
+
+      virtual void execute(Video &video) const = 0; ///< Make the recorded call
+    };
+
+    Command_List();
+    ~Command_List();
+
+    inline size_t size() const; ///< Get the number of Commands recorded
+    inline bool empty() const; ///< Check to see if no Commands have been recorded
+
+    void execute(Video &video) const; ///< Replay every Command in the order recorded
+    void clear(); ///< Forget every Command
+
+    void record(Command * const &command); ///< Record a custom Command; The Command_List takes ownership
+
+    // Views
+    void set_2d(const std::pair<Point2f, Point2f> &camera2d, const bool &fix_aspect_ratio = false);
+    void set_3d(const Camera &camera);
+
+    // Render State
+    void set_backface_culling(const bool &on);
+    void set_zwrite(const bool &enabled);
+    void set_ztest(const bool &enabled);
+    void set_alpha_test(const bool &enabled, const Video::TEST &test = Video::ZENI_ALWAYS, const float &value = 0.0f);
+    void clear_depth_buffer();
+
+    // Color and Texturing
+    void set_Color(const Color &color);
+    void apply_Texture(const String &name);
+    void apply_Texture(const Texture &texture);
+    void unapply_Texture();
+
+    // Lighting, Materials, and Fog
+    void set_lighting(const bool &on = true);
+    void set_ambient_lighting(const Color &color);
+    void set_Light(const int &number, const Light &light);
+    void unset_Light(const int &number);
+    void set_Material(const Material &material);
+    void unset_Material(const Material &material);
+    void set_Fog(const Fog &fog);
+    void unset_Fog();
+
+    // Shaders
+    void set_program(Program &program);
+    void unset_program();
+
+    // Model/World Transformation Stack Functions
+    void select_world_matrix();
+    void push_world_stack();
+    void pop_world_stack();
+    void translate_scene(const Vector3f &direction);
+    void rotate_scene(const Vector3f &about, const float &radians);
+    void rotate_scene(const Quaternion &rotation);
+    void scale_scene(const Vector3f &factor);
+    void transform_scene(const Matrix4f &transformation);
+
+    // Rendering
+    template <typename RENDERABLE>
+    void render(const RENDERABLE &renderable); ///< Record a copy of a Renderable, such as a Quadrilateral<Vertex2f_Texture>
+    void render_reference(const Renderable &renderable); ///< Record a Renderable which will survive until replay
+
+  private:
+    template <typename RENDERABLE>
+    class Render_Copy : public Command {
+    public:
+      Render_Copy(const RENDERABLE &renderable_) : renderable(renderable_) {}
+
+      void execute(Video &video) const {video.render(renderable);}
+
+    private:
+      RENDERABLE renderable;
+    };
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Command *> m_commands;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+  };
+
+}
+
+#endif
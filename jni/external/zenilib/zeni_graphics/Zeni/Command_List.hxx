@@ -0,0 +1,41 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ZENI_COMMAND_LIST_HXX
+#define ZENI_COMMAND_LIST_HXX
+
+#include <Zeni/Command_List.h>
+
+namespace Zeni {
+
+  size_t Command_List::size() const {
+    return m_commands.size();
+  }
+
+  bool Command_List::empty() const {
+    return m_commands.empty();
+  }
+
+  template <typename RENDERABLE>
+  void Command_List::render(const RENDERABLE &renderable) {
+    record(new Render_Copy<RENDERABLE>(renderable));
+  }
+
+}
+
+#endif
@@ -41,19 +41,48 @@
  * Contact: bazald@zenipex.com
  */
 
+/**
+ * \class Zeni::Font_FT
+ *
+ * \ingroup zenilib
+ *
+ * \brief A FreeType Font with a Glyph Cache
+ *
+ * Text is decoded as UTF-8.  Each glyph is rasterized the first time it is
+ * needed and shelf-packed into one of a bounded number of atlas pages.  When
+ * every page is full, the least recently used page is emptied and refilled,
+ * so memory stays bounded no matter how many distinct glyphs are drawn.
+ *
+ * A distance field Font_FT instead stores, for each texel, the signed
+ * distance to the edge of the glyph.  Thresholding that distance when
+ * rendering produces crisp edges at any scale, so every size of a typeface
+ * shares one cache rasterized at a single size, and changing resolution
+ * requires no rasterization at all.
+ *
+ * \note Call reset_cache_stats() once per frame to measure rasterizations per frame.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
 #ifndef ZENI_FONT_H
 #define ZENI_FONT_H
 
 #include <Zeni/Color.h>
 #include <Zeni/Coordinate.h>
 #include <Zeni/Core.h>
+#include <Zeni/Hash_Map.h>
 #include <Zeni/Image.h>
+#include <Zeni/Primitive_Batch.h>
 #include <Zeni/String.h>
 
 #include <memory>
+#include <vector>
 
 #include <Zeni/Define.h>
 
+typedef struct FT_LibraryRec_* FT_Library;
 typedef struct FT_FaceRec_* FT_Face;
 
 namespace Zeni {
@@ -67,6 +96,43 @@ namespace Zeni {
 
   enum JUSTIFY {ZENI_LEFT = 0, ZENI_CENTER = 1, ZENI_RIGHT = 2};
 
+  /**
+   * \ingroup zenilib
+   *
+   * \brief Glyphs Laid Out by a Font to be Rendered Together
+   *
+   * A Glyph_Batch holds the glyphs of any number of strings, grouped by the
+   * Texture they are drawn from, so that the Font which built it can render
+   * them all in one draw per Texture.  Keep one around and clear it rather
+   * than laying out text every frame.
+   *
+   * \author bazald
+   *
+   * Contact: bazald@zenipex.com
+   */
+
+  class ZENI_GRAPHICS_DLL Glyph_Batch {
+    friend class Font_FT;
+
+  public:
+    Glyph_Batch();
+
+    bool empty() const; ///< Check to see if the batch holds no glyphs
+    size_t get_num_draws() const; ///< Get the number of draws needed to render the batch
+    void clear(); ///< Remove every glyph, keeping the memory for reuse
+
+  private:
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Primitive_Batch<Vertex2f_Texture> > m_pages; ///< Indexed by the page of the glyph cache
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+    unsigned long m_generation; ///< Of the glyph cache when the first glyph was added
+  };
+
   class ZENI_GRAPHICS_DLL Font {
     Font(const Font &);
     Font & operator=(const Font &);
@@ -90,6 +156,12 @@ namespace Zeni {
     virtual void render_text(const String &text, const Point3f &position, const Vector3f &right, const Vector3f &down,
       const Color &color, const JUSTIFY &justify = ZENI_DEFAULT_JUSTIFY) const = 0;
 
+    /// Add text at screen position (x, y) to a Glyph_Batch, returning false if this Font cannot batch text
+    virtual bool batch_text(Glyph_Batch &batch, const String &text, const Point2f &position,
+      const JUSTIFY &justify = ZENI_DEFAULT_JUSTIFY) const;
+    virtual bool is_current(const Glyph_Batch &batch) const; ///< Check to see if a Glyph_Batch built by this Font can still be rendered
+    virtual void render_batch(const Glyph_Batch &batch, const Color &color) const; ///< Render a current Glyph_Batch built by this Font
+
   private:
     float m_glyph_height;
     float m_virtual_screen_height;
@@ -102,30 +174,42 @@ namespace Zeni {
 
     struct ZENI_GRAPHICS_DLL Glyph {
       Glyph();
-      Glyph(FT_Face &face,
-            const char &c,
-            const int &ascent,
-            const float &vratio,
-            const Point2i &position,
-            const Point2i &total_size
-      );
 
       inline float get_glyph_width() const;
 
-      inline void render(Video &vr, const Point2f &position, const float &vratio) const;
+      Quadrilateral<Vertex2f_Texture> get_quad(const Point2f &position, const float &scale) const;
+      inline void render(Video &vr, const Point2f &position, const float &scale) const;
       inline void render(Video &vr, const Point3f &position, const Vector3f &right, const Vector3f &down) const;
 
-    private:
+      // Measured in pixels of the Glyph_Cache
       float m_glyph_width;
       Point2f m_upper_left_point, m_lower_right_point;
+
       Point2f m_upper_left_texel, m_lower_right_texel;
+      size_t m_page; ///< size_t(-1) for Glyphs with nothing to draw
     };
 
+    class Glyph_Cache;
+    friend class Glyph_Cache;
+
   public:
+    struct Cache_Stats {
+      Cache_Stats() : pages(0u), max_pages(0u), glyphs(0u), occupancy(0.0f), rasterizations(0u), evictions(0u) {}
+
+      size_t pages; ///< Atlas pages allocated
+      size_t max_pages; ///< Atlas pages allowed
+      size_t glyphs; ///< Glyphs currently cached
+      float occupancy; ///< Fraction of allocated page area covered by glyphs
+      size_t rasterizations; ///< Glyphs rasterized since the last call to reset_cache_stats()
+      size_t evictions; ///< Pages emptied since the last call to reset_cache_stats()
+    };
+
     Font_FT(); ///< Instantiate a new Font with a call to get_Video().create_Font()
     Font_FT(const String &filepath,
             const float &glyph_height,
-            const float &virtual_screen_height); ///< Instantiate a new Font with a call to get_Video().create_Font()
+            const float &virtual_screen_height,
+            const bool &distance_field = false); ///< Instantiate a new Font with a call to get_Video().create_Font()
+    ~Font_FT();
 
     virtual float get_text_width(const String &text) const; ///< Get the width of text rendering using this font.  Approximately text_height * text.length() / 2.0f
 
@@ -134,22 +218,31 @@ namespace Zeni {
     virtual void render_text(const String &text, const Point3f &position, const Vector3f &right, const Vector3f &down,
       const Color &color, const JUSTIFY &justify = ZENI_DEFAULT_JUSTIFY) const;
 
-  private:
-    void init(const String &filepath);
+    /// Add text at screen position (x, y) to a Glyph_Batch; The batch goes stale if its glyphs are evicted from the cache
+    virtual bool batch_text(Glyph_Batch &batch, const String &text, const Point2f &position,
+      const JUSTIFY &justify = ZENI_DEFAULT_JUSTIFY) const;
+    virtual bool is_current(const Glyph_Batch &batch) const; ///< Check to see if a Glyph_Batch built by this Font can still be rendered
+    virtual void render_batch(const Glyph_Batch &batch, const Color &color) const; ///< Render a current Glyph_Batch built by this Font
 
-    int next_power_of_two(const int &value);
-    Image gen_glyph(FT_Face &face, const char &ch);
+    inline bool is_distance_field() const; ///< Determine whether glyphs are rendered from a signed distance field shared by every size of this typeface
 
-#ifdef _WINDOWS
-#pragma warning( push )
-#pragma warning( disable : 4251 )
-#endif
-    std::vector<Glyph> m_glyph;
-    std::auto_ptr<Texture> m_texture;
-#ifdef _WINDOWS
-#pragma warning( pop )
-#endif
-    int m_ascent;
+    size_t get_max_cache_pages() const; ///< Get the maximum number of atlas pages
+    void set_max_cache_pages(const size_t &max_cache_pages); ///< Set the maximum number of atlas pages, evicting any in excess; Must be at least 1; Affects every Font sharing the cache
+    const Point2i & get_cache_page_size() const; ///< Get the resolution of each atlas page
+
+    Cache_Stats get_cache_stats() const; ///< Get the state of the glyph cache
+    void reset_cache_stats(); ///< Zero the counts of rasterizations and evictions
+
+    static Uint32 decode_utf8(const String &text, size_t &pos); ///< Decode the codepoint at 'pos' and advance past it; Malformed sequences decode as U+FFFD
+
+  private:
+    float get_line_width(const String &text, size_t pos) const;
+    Point2f get_glyph_position(const float &x, const float &y) const; ///< Coverage bitmaps are sharpest when aligned with screen pixels
+
+    Glyph_Cache * m_cache; ///< Shared by every distance field Font_FT of the same typeface
+    float m_scale; ///< Virtual screen units per pixel of the Glyph_Cache
+    float m_smoothing; ///< Half-width of antialiased distance field edges, in alpha units
+    bool m_distance_field;
 
     float m_font_height;
     float m_vratio;
@@ -38,6 +38,10 @@ namespace Zeni {
     return m_glyph_width;
   }
 
+  bool Font_FT::is_distance_field() const {
+    return m_distance_field;
+  }
+
 }
 
 #endif
@@ -24,6 +24,12 @@
  *
  * This class describes a image, loaded from a file.
  *
+ * Resizing and downsampling are separable and work over whole rows at a
+ * time.  Large Images are split into spans of rows which are processed on
+ * separate Threads.
+ *
+ * \note Gamma correct downsampling treats color channels as sRGB, averaging them in linear space.  Alpha is always linear.
+ *
  * \author bazald
  *
  * Contact: bazald@zenipex.com
@@ -50,8 +56,12 @@
 namespace Zeni {
 
   class ZENI_GRAPHICS_DLL Image {
+    friend class Image_Cache;
+
   public:
     enum Color_Space {Luminance, Luminance_Alpha, RGB, RGBA};
+    enum Resampling {Bilinear, Bicubic};
+    enum Downsampling {Box, Kaiser};
 
     Image();
     Image(const String &filename, const bool &tileable_ = false);
@@ -72,7 +82,9 @@ namespace Zeni {
 
     Color extract_Color(const Point2f &coordinate) const; ///< Get the Color value of a given coordinate, [0.0f, 0.0f] to (1.0f, 1.0f), with wrapping if (tileable == true).
 
-    void resize(const int &width, const int &height);
+    void resize(const int &width, const int &height, const Resampling &resampling = Bilinear); ///< Resample the Image to the given dimensions.
+    Image downsample(const Downsampling &downsampling = Box, const bool &gamma_correct = false) const; ///< Get the next level of a mip chain, half as large in each dimension but no smaller than 1x1.
+    void build_mipmaps(std::vector<Image> &mipmaps, const Downsampling &downsampling = Box, const bool &gamma_correct = false) const; ///< Get every successive level of a mip chain down to 1x1, not including this Image.
     bool blit(const Point2i &upper_left, const Image &source); ///< Copy a different Image in the same color-space into this Image. Returns true if blits successfully, false otherwise.
 
   private:
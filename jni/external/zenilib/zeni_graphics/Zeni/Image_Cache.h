@@ -0,0 +1,71 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Image_Cache
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Cache of Decoded Images
+ *
+ * Decoding PNGs is slow.  The Image_Cache stores each decoded Image, along
+ * with its whole mip chain, under 'cache/textures/' in the appdata path.
+ * Callers which do not need mipmaps read only the first level.  Each entry records the path, size, and modification time
+ * of its PNG and is discarded as soon as the size or time changes.  Entries
+ * are written beside their final paths and then moved into place, so that
+ * readers never see one partially written.
+ *
+ * An entry consists of a fixed header, the path, a table of levels, and the
+ * raw pixels of each level aligned to 16 bytes.
+ *
+ * \note Caching is enabled with Textures::set_caching.
+ *
+ * \note Assets packed into an Android APK have no modification times and are never cached.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_IMAGE_CACHE_H
+#define ZENI_IMAGE_CACHE_H
+
+#include <Zeni/Image.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  class ZENI_GRAPHICS_DLL Image_Cache {
+    // Undefined
+    Image_Cache();
+
+  public:
+    static Image * load_Image(const String &filename, const bool &tileable, std::vector<Image> * const &mipmaps = 0); ///< Load an Image, and its mip chain if requested, from the cache if possible, or else decode and cache it with its whole mip chain; The caller owns the returned Image
+
+    static bool load(const String &filename, const bool &tileable, Image &image, std::vector<Image> * const &mipmaps = 0); ///< Load an Image, and its mip chain if requested, from the cache; Returns false if there is no valid entry
+    static bool store(const String &filename, const Image &image, const std::vector<Image> * const &mipmaps = 0); ///< Cache an Image and, optionally, its mip chain; Returns false on failure
+
+    static String get_cache_path(const String &filename); ///< Get the path of the cache entry for a PNG
+
+  private:
+    static void swap(Image &lhs, Image &rhs);
+  };
+
+}
+
+#endif
@@ -0,0 +1,123 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Light_Clusters
+ *
+ * \ingroup zenilib
+ *
+ * \brief Any Number of Lights, Assigned to Clusters of the View Frustum
+ *
+ * The view frustum is divided into a grid of tiles across the screen and
+ * exponentially deeper slices along the view direction.  build() assigns
+ * each Light to every cluster its range reaches, so that a fragment need
+ * only consider the Lights of its own cluster.  Lights without a finite
+ * range, including all directional Lights, reach every cluster and are
+ * kept apart from the rest.
+ *
+ * A Light's range is the lesser of Light::range and the distance at which
+ * its attenuation dims it below 1/256.
+ *
+ * The results are laid out as RGBA float texels, ready to be uploaded as
+ * textures for Video_GL_Shader::set_clustered_lighting.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_LIGHT_CLUSTERS_H
+#define ZENI_LIGHT_CLUSTERS_H
+
+#include <Zeni/Camera.h>
+#include <Zeni/Light.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  class ZENI_GRAPHICS_DLL Light_Clusters {
+  public:
+    static const int texels_per_light = 6; ///< View position and type, spot direction and cutoff, diffuse and exponent, specular and range, ambient and constant attenuation, and then linear and quadratic attenuation
+    static const int lights_per_row = 256;
+    static const int indices_per_row = 4096; ///< Four to a texel
+
+    Light_Clusters(const int &columns = 16, const int &rows = 9, const int &slices = 24);
+
+    inline size_t size() const; ///< Get the number of Lights
+    inline const Light & operator[](const size_t &index) const; ///< Get a Light
+    inline Light & operator[](const size_t &index); ///< Get a Light; Changes take effect on the next build()
+
+    size_t add(const Light &light); ///< Add a Light, returning its index
+    void clear(); ///< Remove every Light
+
+    /// Assign every Light to the clusters it reaches in the view of 'camera'
+    void build(const Camera &camera, const std::pair<Point2i, Point2i> &viewport);
+
+    // Results of the most recent build()
+    inline int get_columns() const; ///< Get the number of tiles across
+    inline int get_rows() const; ///< Get the number of tiles down
+    inline int get_slices() const; ///< Get the number of slices in depth
+    inline float get_near_clip() const;
+    inline float get_far_clip() const;
+    inline const Point2f & get_projection_scale() const; ///< Get 1/tan of half the field of view, in x and y
+    inline size_t get_num_unbounded() const; ///< Get the number of Lights reaching every cluster; They occupy the first light texels
+    inline size_t get_num_indices() const; ///< Get the total number of Light references from clusters
+
+    inline const std::vector<float> & get_light_texels() const; ///< lights_per_row Lights per row
+    inline const std::vector<float> & get_cluster_texels() const; ///< Offset and count of each cluster's indices; columns*rows texels wide and slices high
+    inline const std::vector<float> & get_index_texels() const; ///< Light texel numbers of the bounded Lights in each cluster; indices_per_row per row
+
+  private:
+    class Slice_Span;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Light> m_lights;
+
+    std::vector<Point3f> m_positions; ///< In view space
+    std::vector<float> m_ranges;
+    std::vector<size_t> m_texels; ///< The light texel number of each Light
+    std::vector<int> m_slice_ranges; ///< The first and last slice reached by each Light, or -1 if it reaches none
+    std::vector<size_t> m_slice_begin; ///< Offsets into m_slice_lights for each slice, followed by the total
+    std::vector<size_t> m_slice_lights; ///< Bounded Lights, grouped by the slices they reach
+    std::vector<std::vector<float> > m_slice_indices; ///< Light texel numbers, grouped by cluster, for each slice
+    std::vector<size_t> m_cluster_counts;
+    std::vector<size_t> m_cluster_offsets; ///< Into the indices of its slice
+
+    std::vector<float> m_light_texels;
+    std::vector<float> m_cluster_texels;
+    std::vector<float> m_index_texels;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+
+    int m_columns;
+    int m_rows;
+    int m_slices;
+    float m_near_clip;
+    float m_far_clip;
+    Point2f m_projection_scale;
+    size_t m_num_unbounded;
+    size_t m_num_indices;
+  };
+
+}
+
+#endif
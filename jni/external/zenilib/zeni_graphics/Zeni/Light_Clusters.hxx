@@ -0,0 +1,83 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_LIGHT_CLUSTERS_HXX
+#define ZENI_LIGHT_CLUSTERS_HXX
+
+#include <Zeni/Light_Clusters.h>
+
+namespace Zeni {
+
+  size_t Light_Clusters::size() const {
+    return m_lights.size();
+  }
+
+  const Light & Light_Clusters::operator[](const size_t &index) const {
+    return m_lights[index];
+  }
+
+  Light & Light_Clusters::operator[](const size_t &index) {
+    return m_lights[index];
+  }
+
+  int Light_Clusters::get_columns() const {
+    return m_columns;
+  }
+
+  int Light_Clusters::get_rows() const {
+    return m_rows;
+  }
+
+  int Light_Clusters::get_slices() const {
+    return m_slices;
+  }
+
+  float Light_Clusters::get_near_clip() const {
+    return m_near_clip;
+  }
+
+  float Light_Clusters::get_far_clip() const {
+    return m_far_clip;
+  }
+
+  const Point2f & Light_Clusters::get_projection_scale() const {
+    return m_projection_scale;
+  }
+
+  size_t Light_Clusters::get_num_unbounded() const {
+    return m_num_unbounded;
+  }
+
+  size_t Light_Clusters::get_num_indices() const {
+    return m_num_indices;
+  }
+
+  const std::vector<float> & Light_Clusters::get_light_texels() const {
+    return m_light_texels;
+  }
+
+  const std::vector<float> & Light_Clusters::get_cluster_texels() const {
+    return m_cluster_texels;
+  }
+
+  const std::vector<float> & Light_Clusters::get_index_texels() const {
+    return m_index_texels;
+  }
+
+}
+
+#endif
@@ -77,6 +77,7 @@ struct Lib3dsNode;
 namespace Zeni {
 
   class ZENI_GRAPHICS_DLL Model;
+  class Frustum;
   struct Quaternion;
 
   class ZENI_GRAPHICS_DLL Model_Visitor {
@@ -135,11 +136,14 @@ namespace Zeni {
     void visit_meshes(Model_Visitor &mv, Lib3dsNode * node = 0, Lib3dsMesh * const &mesh = 0) const; ///< Visit all meshes
 
     void render() const;
+    void render(const Frustum &frustum) const; ///< Render only the meshes and ranges which may lie within 'frustum', given in the coordinates the Model is translated in
 
     // Thread-Unsafe versions
     inline Lib3dsFile * const & thun_get_file() const; ///< Get the full 3ds file info - Thread Unsafe Version
 
   private:
+    void render_meshes(const Frustum * const &frustum) const;
+
     String m_filename;
     Lib3dsFile *m_file;
     float m_keyframe;
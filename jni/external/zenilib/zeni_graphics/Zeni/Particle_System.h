@@ -0,0 +1,178 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Particle_System
+ *
+ * \ingroup zenilib
+ *
+ * \brief Many Camera-Facing Particles Updated and Rendered Together
+ *
+ * Particles are stored as parallel arrays, one per attribute, in a pool
+ * whose capacity is fixed on construction.  Emitters are taken from and
+ * returned to a pool of their own, and spawn particles at a steady rate.
+ * Particles that would exceed the capacity are simply not spawned.
+ *
+ * update() moves every particle four at a time, growing or shrinking it
+ * from its start size to its end size and fading it out over its
+ * lifetime.  Large systems can be updated in parallel on the Job_System.
+ *
+ * Particles render as one batch of textured quads, turned to face the
+ * Camera last passed to face().  Give the Particle_System a Material to
+ * choose the texture; Use one Particle_System for each texture.  Particles
+ * are usually best rendered after opaque geometry, with lighting and depth
+ * writes disabled.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_PARTICLE_SYSTEM_H
+#define ZENI_PARTICLE_SYSTEM_H
+
+#include <Zeni/Camera.h>
+#include <Zeni/Color.h>
+#include <Zeni/Random.h>
+#include <Zeni/Renderable.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  class ZENI_GRAPHICS_DLL Particle_System : public Renderable {
+  public:
+    struct ZENI_GRAPHICS_DLL Emitter {
+      Emitter();
+
+      Point3f position;
+      Vector3f position_spread; ///< Particles start up to this far from 'position' along each axis
+      Vector3f velocity;
+      Vector3f velocity_spread; ///< Particles start up to this much faster or slower along each axis
+      float rate; ///< Particles per second
+      float lifetime; ///< In seconds
+      float start_size; ///< The width of a new particle
+      float end_size; ///< The width of a particle at the end of its lifetime
+      Color color; ///< Alpha fades to zero over the lifetime of each particle
+      bool enabled; ///< Spawn particles on update()
+    };
+
+    Particle_System(const size_t &capacity = 65536u);
+
+    inline size_t size() const; ///< Get the number of live particles
+    inline size_t capacity() const; ///< Get the maximum number of live particles
+    inline bool empty() const; ///< Check to see if there are no live particles
+
+    size_t create_emitter(const Emitter &emitter = Emitter()); ///< Take an Emitter from the pool, returning its handle
+    void destroy_emitter(const size_t &emitter); ///< Return an Emitter to the pool; Its particles live out their lifetimes
+    inline const Emitter & get_emitter(const size_t &emitter) const; ///< Get an Emitter by handle
+    inline Emitter & get_emitter(const size_t &emitter); ///< Get an Emitter by handle, to move it or change its parameters
+
+    void emit(const Emitter &emitter, const size_t &count); ///< Spawn a burst of particles, ignoring 'rate' and 'enabled'
+    void clear(); ///< Remove every particle, leaving the Emitters
+
+    inline const Vector3f & get_acceleration() const;
+    inline void set_acceleration(const Vector3f &acceleration); ///< Set the acceleration applied to every particle, such as gravity
+    inline float get_drag() const;
+    inline void set_drag(const float &drag); ///< Set the fraction of its velocity each particle loses per second
+    inline bool is_multithreaded() const;
+    inline void set_multithreaded(const bool &multithreaded = true); ///< Set whether large systems update in parallel on the Job_System
+
+    void face(const Camera &camera); ///< Turn the particles to face 'camera' in subsequent renders
+
+    void update(const float &time_step); ///< Move every particle, remove those that have expired, and then spawn new ones
+
+    /// Tell the rendering system if we're using 3D coordinates
+    virtual bool is_3d() const;
+
+#ifndef DISABLE_GL_FIXED
+    virtual void render_to(Video_GL_Fixed &screen) const;
+#endif
+
+#ifndef DISABLE_GL_SHADER
+    virtual void render_to(Video_GL_Shader &screen) const;
+#endif
+
+#ifndef DISABLE_DX9
+    virtual void render_to(Video_DX9 &screen) const;
+#endif
+
+  private:
+    class Update_Span;
+    class Vertex_Span;
+
+    struct Vertex {
+      float x, y, z;
+      Uint32 color;
+      float u, v;
+    };
+
+    struct Emitter_Slot {
+      Emitter emitter;
+      float carry; ///< The fraction of a particle left over from the last update()
+      bool live;
+    };
+
+    void spawn(const Emitter &emitter, const size_t &count);
+    void move_particle(const size_t &from, const size_t &to);
+    void fill_vertices(const bool &rgba) const; ///< Otherwise ARGB
+#ifndef DISABLE_GL
+    void render_gl() const;
+#endif
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_z;
+    std::vector<float> m_vx;
+    std::vector<float> m_vy;
+    std::vector<float> m_vz;
+    std::vector<float> m_age;
+    std::vector<float> m_inv_lifetime;
+    std::vector<float> m_start_size;
+    std::vector<float> m_size_change;
+    std::vector<float> m_start_alpha;
+    std::vector<float> m_size; ///< As of the last update()
+    std::vector<float> m_alpha; ///< As of the last update()
+    std::vector<Uint32> m_rgb;
+    std::vector<Uint8> m_expired; ///< One bit for each particle in each group of four
+
+    std::vector<Emitter_Slot> m_emitters;
+    std::vector<size_t> m_free_emitters;
+
+    mutable std::vector<Vertex> m_vertices; ///< Scratch space, four for each particle
+    std::vector<Uint16> m_indices; ///< Two triangles for each quad in a chunk
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+
+    size_t m_num_particles;
+    size_t m_capacity;
+    Vector3f m_acceleration;
+    float m_drag;
+    bool m_multithreaded;
+    Vector3f m_right;
+    Vector3f m_up;
+    Random m_random;
+  };
+
+}
+
+#endif
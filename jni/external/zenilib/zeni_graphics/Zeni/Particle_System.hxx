@@ -0,0 +1,75 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_PARTICLE_SYSTEM_HXX
+#define ZENI_PARTICLE_SYSTEM_HXX
+
+#include <Zeni/Particle_System.h>
+
+#include <cassert>
+
+namespace Zeni {
+
+  size_t Particle_System::size() const {
+    return m_num_particles;
+  }
+
+  size_t Particle_System::capacity() const {
+    return m_capacity;
+  }
+
+  bool Particle_System::empty() const {
+    return !m_num_particles;
+  }
+
+  const Particle_System::Emitter & Particle_System::get_emitter(const size_t &emitter) const {
+    assert(emitter < m_emitters.size() && m_emitters[emitter].live);
+    return m_emitters[emitter].emitter;
+  }
+
+  Particle_System::Emitter & Particle_System::get_emitter(const size_t &emitter) {
+    assert(emitter < m_emitters.size() && m_emitters[emitter].live);
+    return m_emitters[emitter].emitter;
+  }
+
+  const Vector3f & Particle_System::get_acceleration() const {
+    return m_acceleration;
+  }
+
+  void Particle_System::set_acceleration(const Vector3f &acceleration) {
+    m_acceleration = acceleration;
+  }
+
+  float Particle_System::get_drag() const {
+    return m_drag;
+  }
+
+  void Particle_System::set_drag(const float &drag) {
+    m_drag = drag;
+  }
+
+  bool Particle_System::is_multithreaded() const {
+    return m_multithreaded;
+  }
+
+  void Particle_System::set_multithreaded(const bool &multithreaded) {
+    m_multithreaded = multithreaded;
+  }
+
+}
+
+#endif
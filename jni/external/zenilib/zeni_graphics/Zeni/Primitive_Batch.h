@@ -0,0 +1,98 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_PRIMITIVE_BATCH_H
+#define ZENI_PRIMITIVE_BATCH_H
+
+#include <Zeni/Line_Segment.h>
+#include <Zeni/Quadrilateral.h>
+#include <Zeni/Renderable.h>
+#include <Zeni/Triangle.h>
+#include <Zeni/Vertex2f.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  /**
+   * \ingroup zenilib
+   *
+   * \brief Many Lines or Triangles Rendered in a Single Draw
+   *
+   * Unlike a Vertex_Buffer, a Primitive_Batch keeps its vertices in the
+   * order in which they were added and stays in system memory, so it is
+   * cheap to clear and refill whenever its contents change.  Quadrilaterals
+   * are added as two Triangles.
+   *
+   * \author bazald
+   *
+   * Contact: bazald@zenipex.com
+   */
+
+  template <typename VERTEX>
+  class Primitive_Batch : public Renderable {
+  public:
+    enum Primitive {LINES = 2, TRIANGLES = 3}; ///< Valued by the number of vertices in each
+
+    Primitive_Batch(const Primitive &primitive = TRIANGLES);
+
+    const Primitive & get_primitive() const; ///< Get the kind of primitive in the batch
+    size_t size() const; ///< Get the number of primitives in the batch
+    bool empty() const; ///< Check to see if the batch is empty
+
+    void add(const Line_Segment<VERTEX> &line_segment); ///< Add a Line_Segment to a batch of LINES
+    void add(const Triangle<VERTEX> &triangle); ///< Add a Triangle to a batch of TRIANGLES
+    void add(const Quadrilateral<VERTEX> &quadrilateral); ///< Add a Quadrilateral to a batch of TRIANGLES
+    void clear(); ///< Remove every primitive, keeping the memory for reuse
+
+    /// Tell the rendering system if we're using 3D coordinates
+    virtual bool is_3d() const;
+
+#ifndef DISABLE_GL_FIXED
+    virtual void render_to(Video_GL_Fixed &screen) const;
+#endif
+
+#ifndef DISABLE_GL_SHADER
+    virtual void render_to(Video_GL_Shader &screen) const;
+#endif
+
+#ifndef DISABLE_DX9
+    virtual void render_to(Video_DX9 &screen) const;
+#endif
+
+  private:
+    Primitive m_primitive;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<VERTEX> m_vertices;
+    mutable std::vector<Uint32> m_colors; ///< Scratch space for reordering color channels for OpenGL
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+  };
+
+#ifdef _WINDOWS
+  ZENI_GRAPHICS_EXT template class ZENI_GRAPHICS_DLL Primitive_Batch<Vertex2f_Color>;
+  ZENI_GRAPHICS_EXT template class ZENI_GRAPHICS_DLL Primitive_Batch<Vertex2f_Texture>;
+#endif
+
+}
+
+#endif
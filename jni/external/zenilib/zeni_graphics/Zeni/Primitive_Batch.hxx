@@ -0,0 +1,126 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_PRIMITIVE_BATCH_HXX
+#define ZENI_PRIMITIVE_BATCH_HXX
+
+// HXXed below
+#include <Zeni/Video_DX9.h>
+
+#include <Zeni/Primitive_Batch.h>
+
+// Not HXXed
+#if defined(REQUIRE_GL_ES)
+#include <GLES/gl.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#include <cassert>
+
+namespace Zeni {
+
+  template <typename VERTEX>
+  Primitive_Batch<VERTEX>::Primitive_Batch(const Primitive &primitive)
+    : m_primitive(primitive)
+  {
+  }
+
+  template <typename VERTEX>
+  const typename Primitive_Batch<VERTEX>::Primitive & Primitive_Batch<VERTEX>::get_primitive() const {
+    return m_primitive;
+  }
+
+  template <typename VERTEX>
+  size_t Primitive_Batch<VERTEX>::size() const {
+    return m_vertices.size() / m_primitive;
+  }
+
+  template <typename VERTEX>
+  bool Primitive_Batch<VERTEX>::empty() const {
+    return m_vertices.empty();
+  }
+
+  template <typename VERTEX>
+  void Primitive_Batch<VERTEX>::add(const Line_Segment<VERTEX> &line_segment) {
+    assert(m_primitive == LINES);
+
+    m_vertices.push_back(line_segment.a);
+    m_vertices.push_back(line_segment.b);
+  }
+
+  template <typename VERTEX>
+  void Primitive_Batch<VERTEX>::add(const Triangle<VERTEX> &triangle) {
+    assert(m_primitive == TRIANGLES);
+
+    m_vertices.push_back(triangle.a);
+    m_vertices.push_back(triangle.b);
+    m_vertices.push_back(triangle.c);
+  }
+
+  template <typename VERTEX>
+  void Primitive_Batch<VERTEX>::add(const Quadrilateral<VERTEX> &quadrilateral) {
+    assert(m_primitive == TRIANGLES);
+
+    /// As split by Quadrilateral::get_duplicate_t0 and get_duplicate_t1
+    m_vertices.push_back(quadrilateral.a);
+    m_vertices.push_back(quadrilateral.b);
+    m_vertices.push_back(quadrilateral.c);
+    m_vertices.push_back(quadrilateral.a);
+    m_vertices.push_back(quadrilateral.c);
+    m_vertices.push_back(quadrilateral.d);
+  }
+
+  template <typename VERTEX>
+  void Primitive_Batch<VERTEX>::clear() {
+    m_vertices.clear();
+  }
+
+  template <typename VERTEX>
+  bool Primitive_Batch<VERTEX>::is_3d() const {
+    return VERTEX().is_3d();
+  }
+
+#if !defined(DISABLE_GL) && !defined(REQUIRE_GL_ES)
+  template <typename VERTEX>
+  void Primitive_Batch<VERTEX>::render_to(Video_GL_Fixed &screen) const {
+    if(m_vertices.empty())
+      return;
+
+    glBegin(m_primitive == LINES ? GL_LINES : GL_TRIANGLES);
+    for(typename std::vector<VERTEX>::const_iterator it = m_vertices.begin(); it != m_vertices.end(); ++it)
+      it->subrender_to(screen);
+    glEnd();
+  }
+#endif
+
+#ifndef DISABLE_DX9
+  template <typename VERTEX>
+  void Primitive_Batch<VERTEX>::render_to(Video_DX9 &screen) const {
+    if(m_vertices.empty())
+      return;
+
+    screen.get_d3d_device()->DrawPrimitiveUP(m_primitive == LINES ? D3DPT_LINELIST : D3DPT_TRIANGLELIST,
+                                             UINT(size()), m_vertices[0].get_address(), sizeof(VERTEX));
+  }
+#endif
+
+}
+
+#include <Zeni/Video_DX9.hxx>
+
+#endif
@@ -0,0 +1,84 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Program_Cache
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Cache of Linked Program Binaries
+ *
+ * Compiling and linking GLSL can take a long time on some drivers.  The
+ * Program_Cache stores the binary of each linked Program_GL_Shader under
+ * 'cache/programs/' in the appdata path, keyed by its shader sources and
+ * by the vendor, renderer, and version strings of the driver.  A Program
+ * whose binary loads and links is never compiled at all.  Any entry the
+ * driver rejects is simply replaced once the Program has been compiled
+ * and linked again.
+ *
+ * An entry consists of a fixed header followed by the binary.
+ *
+ * \note Requires GL_ARB_get_program_binary and at least one binary format.  Otherwise, as with some software renderers, every Program falls back to compiling and the cache counts nothing.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_PROGRAM_CACHE_H
+#define ZENI_PROGRAM_CACHE_H
+
+#include <Zeni/Shader.h>
+
+#if !defined(DISABLE_GL) && !defined(DISABLE_GL_SHADER)
+
+namespace Zeni {
+
+  class ZENI_GRAPHICS_DLL Program_Cache {
+    // Undefined
+    Program_Cache();
+
+  public:
+    inline static bool is_enabled(); ///< Check to see if Program_GL_Shaders are cached
+    inline static void set_enabled(const bool &enabled = true); ///< Set whether Program_GL_Shaders should be cached; Shaders created while enabled are compiled only when needed
+
+    static bool is_supported(); ///< Check to see if the driver can provide program binaries
+
+    static bool load(const GLuint &program, const String &source); ///< Load and link the cached binary for 'source' into 'program'; Returns false if there is no valid entry
+    static bool store(const GLuint &program, const String &source, const float &build_seconds); ///< Cache the binary of 'program', linked from 'source' in 'build_seconds'; Returns false on failure
+
+    static String get_cache_path(const String &source); ///< Get the path of the cache entry for a set of shader sources
+
+    inline static size_t get_hits(); ///< Get the number of Programs loaded from the cache
+    inline static size_t get_misses(); ///< Get the number of Programs that had to be compiled
+    inline static float get_seconds_saved(); ///< Get the compile and link time saved by hits, less the time spent loading
+    static void reset_stats(); ///< Zero the hits, misses, and time saved
+
+  private:
+    static bool read(const GLuint &program, const String &source, float &build_seconds);
+
+    static bool m_enabled;
+    static size_t m_hits;
+    static size_t m_misses;
+    static float m_seconds_saved;
+  };
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_PROGRAM_CACHE_HXX
+#define ZENI_PROGRAM_CACHE_HXX
+
+#include <Zeni/Program_Cache.h>
+
+#if !defined(DISABLE_GL) && !defined(DISABLE_GL_SHADER)
+
+namespace Zeni {
+
+  bool Program_Cache::is_enabled() {
+    return m_enabled;
+  }
+
+  void Program_Cache::set_enabled(const bool &enabled) {
+    m_enabled = enabled;
+  }
+
+  size_t Program_Cache::get_hits() {
+    return m_hits;
+  }
+
+  size_t Program_Cache::get_misses() {
+    return m_misses;
+  }
+
+  float Program_Cache::get_seconds_saved() {
+    return m_seconds_saved;
+  }
+
+}
+
+#endif
+
+#endif
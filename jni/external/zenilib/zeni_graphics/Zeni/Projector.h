@@ -118,6 +118,10 @@ namespace Zeni {
     inline Vector3f unproject(const Vector3f &screen_coord) const; ///< Map screen coordinates ([viewport.first.x, viewport.second.x], [viewport.first.y, viewport.second.y], [0, 1]) to coordinates in the viewing frustum
     inline Point3f unproject(const Point3f &screen_coord) const; ///< Map screen coordinates ([viewport.first.x, viewport.second.x], [viewport.first.y, viewport.second.y], [0, 1]) to coordinates in the viewing frustum
 
+    void project_points(const Point3f * const in, Point3f * const out, const size_t &count) const; ///< project() 'count' Point3fs from 'in' into 'out', which may be the same array; Large batches are split across Threads
+
+    inline const Frustum & get_frustum() const; ///< Get the viewing Frustum in world coordinates
+
   private:
     inline void init(
       const Camera &camera3d,
@@ -130,6 +134,8 @@ namespace Zeni {
     Vector3f m_uln2lrf;
 
     float m_near2far;
+
+    Frustum m_frustum;
   };
 
 }
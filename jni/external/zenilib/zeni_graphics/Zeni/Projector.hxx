@@ -144,6 +144,12 @@ namespace Zeni {
     m_uln2lrf = Vector3f(right, bottom, -tunneled_far_clip) - m_uln;
 
     m_near2far = tunneled_far_clip / tunneled_near_clip;
+
+    m_frustum = camera3d.get_frustum(viewport);
+  }
+
+  const Frustum & Projector3D::get_frustum() const {
+    return m_frustum;
   }
 
 }
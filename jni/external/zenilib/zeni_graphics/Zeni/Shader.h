@@ -71,11 +71,34 @@
  * Contact: bazald@zenipex.com
  */
 
+/**
+ * \class Zeni::Uniform_Buffer
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Block of Uniforms Shared by Every Program_GL_Shader Bound to It
+ *
+ * Per-frame data such as the camera, lights, and fog can be set once in a
+ * Uniform_Buffer rather than once per Program.  Offsets are in bytes and
+ * must follow the std140 layout of the uniform block.  Only the range
+ * changed since the last apply() is uploaded.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
 #ifndef ZENI_SHADER_H
 #define ZENI_SHADER_H
 
+#include <Zeni/Color.h>
+#include <Zeni/Coordinate.h>
 #include <Zeni/Core.h>
 #include <Zeni/Hash_Map.h>
+#include <Zeni/Matrix4f.h>
+#include <Zeni/Vector3f.h>
+
+#include <vector>
 
 #ifndef DISABLE_GL
 #if defined(REQUIRE_GL_ES)
@@ -110,11 +133,37 @@ namespace Zeni {
     Program & operator=(const Program &);
 
   public:
+    /// The types of uniform data; Samplers and bools are set as INTs
+    enum Uniform_Type {UNIFORM_INT, UNIFORM_FLOAT, UNIFORM_VEC2, UNIFORM_VEC3, UNIFORM_VEC4, UNIFORM_MAT4};
+
     Program() {}
     virtual ~Program() {}
 
     virtual void attach(Shader &shader) = 0;
     virtual void link() = 0;
+
+    /// Get a handle for a uniform once linked, or -1 if the Program does not use it
+    virtual int get_uniform(const String &name) const;
+    /// Get the location of a vertex attribute once linked, or -1 if the Program does not use it
+    virtual int get_attribute(const String &name) const;
+
+    // Uniforms set to the values they already hold are not uploaded again; Handles of -1 are ignored
+    void set_uniform(const int &uniform, const int &value); ///< Set an int, bool, or sampler
+    void set_uniform(const int &uniform, const float &value); ///< Set a float
+    void set_uniform(const int &uniform, const Point2f &value); ///< Set a vec2
+    void set_uniform(const int &uniform, const Vector3f &value); ///< Set a vec3
+    void set_uniform(const int &uniform, const Color &value); ///< Set a vec4
+    void set_uniform(const int &uniform, const Matrix4f &value); ///< Set a mat4
+    void set_uniform(const int &uniform, const int * const &values, const size_t &count); ///< Set the first 'count' elements of an array
+    void set_uniform(const int &uniform, const float * const &values, const size_t &count); ///< Set the first 'count' elements of an array
+    void set_uniform(const int &uniform, const Point2f * const &values, const size_t &count); ///< Set the first 'count' elements of an array
+    void set_uniform(const int &uniform, const Vector3f * const &values, const size_t &count); ///< Set the first 'count' elements of an array
+    void set_uniform(const int &uniform, const Color * const &values, const size_t &count); ///< Set the first 'count' elements of an array
+    void set_uniform(const int &uniform, const Matrix4f * const &values, const size_t &count); ///< Set the first 'count' elements of an array
+
+  protected:
+    /// Set the first 'count' elements of a uniform from tightly packed ints or floats; Does nothing by default
+    virtual void set_uniform_data(const int &uniform, const Uniform_Type &type, const void * const &data, const size_t &count);
   };
   
 #ifndef DISABLE_GL_FIXED
@@ -164,13 +213,20 @@ namespace Zeni {
     Shader_GL_Shader & operator=(const Shader_GL_Shader &);
 
   public:
-    Shader_GL_Shader(const String &shader_src, const Type &type);
+    Shader_GL_Shader(const String &shader_src, const Type &type); ///< Compiles immediately unless a Program_Cache is enabled
     ~Shader_GL_Shader();
 
+    void compile(); ///< Compile, if not already compiled; Throws Shader_Init_Failure
+
     inline GLuint get() const;
+    inline const String & get_source() const;
+    inline Type get_type() const;
 
   private:
     GLuint m_shader;
+    String m_source;
+    Type m_type;
+    bool m_compiled;
   };
 
   class ZENI_GRAPHICS_DLL Program_GL_Shader : public Program {
@@ -182,20 +238,97 @@ namespace Zeni {
     virtual ~Program_GL_Shader();
 
     void attach(Shader &shader);
-    void link();
+    void link(); ///< Link, or load from a Program_Cache, and find every uniform and attribute; Does nothing if nothing has been attached since the last link
+
+    int get_uniform(const String &name) const;
+    int get_attribute(const String &name) const;
+
+    /// Use the uniform block 'name' from the Uniform_Buffer at 'binding'; Returns false if the Program does not use the block
+    bool bind_uniform_block(const String &name, const GLuint &binding);
+
+    void use(); ///< Link if needed, make current, and upload any uniforms set while not current
+    static void unuse(); ///< Make no Program_GL_Shader current
+    inline static Program_GL_Shader * get_current(); ///< Get the Program_GL_Shader which is current, or 0
 
     inline GLuint get() const;
 
+  protected:
+    void set_uniform_data(const int &uniform, const Uniform_Type &type, const void * const &data, const size_t &count);
+
   private:
+    struct Uniform {
+      GLint location;
+      GLenum type;
+      GLsizei size; ///< Number of array elements
+      size_t components; ///< Per element
+      bool integer; ///< Stored in m_ints rather than m_floats
+      size_t offset; ///< Into m_ints or m_floats
+      bool dirty;
+    };
+
+    void find_uniforms();
+    void upload(const Uniform &uniform) const;
+
 #ifdef _WINDOWS
 #pragma warning( push )
 #pragma warning( disable : 4251 )
 #endif
     std::list<Shader_GL_Shader *> m_shaders;
+
+    std::vector<Uniform> m_uniforms;
+    Unordered_Map<String, int> m_uniform_handles; ///< Into m_uniforms
+    Unordered_Map<String, GLint> m_attributes;
+
+    std::vector<GLint> m_ints; ///< The values last set for all integer uniforms
+    std::vector<GLfloat> m_floats; ///< The values last set for all float uniforms
 #ifdef _WINDOWS
 #pragma warning( pop )
 #endif
     GLuint m_program;
+    bool m_linked;
+    bool m_dirty; ///< Uniforms were set while not current
+
+    static Program_GL_Shader * g_current;
+  };
+
+  class ZENI_GRAPHICS_DLL Uniform_Buffer {
+    Uniform_Buffer(const Uniform_Buffer &);
+    Uniform_Buffer & operator=(const Uniform_Buffer &);
+
+  public:
+    /// Create a buffer of 'size' bytes for the uniform blocks at 'binding'; Throws Uniform_Buffer_Init_Failure if unsupported
+    Uniform_Buffer(const size_t &size, const GLuint &binding);
+    ~Uniform_Buffer();
+
+    static bool is_supported(); ///< Check to see if uniform buffer objects are available
+
+    // std140 offsets, in bytes; Values that do not change are not uploaded again
+    void set(const size_t &offset, const int &value); ///< Set an int or bool
+    void set(const size_t &offset, const float &value); ///< Set a float
+    void set(const size_t &offset, const Point2f &value); ///< Set a vec2
+    void set(const size_t &offset, const Vector3f &value); ///< Set a vec3
+    void set(const size_t &offset, const Color &value); ///< Set a vec4
+    void set(const size_t &offset, const Matrix4f &value); ///< Set a mat4
+    void set(const size_t &offset, const void * const &data, const size_t &size); ///< Set raw bytes
+
+    void apply(); ///< Upload the range changed since the last apply, and bind the buffer to its binding point
+
+    inline GLuint get_binding() const;
+
+  private:
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<unsigned char> m_data;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+    size_t m_dirty_begin;
+    size_t m_dirty_end;
+
+    GLuint m_buffer;
+    GLuint m_binding;
   };
 #endif
   
@@ -249,6 +382,14 @@ namespace Zeni {
     Shader_Link_Failure() : Error("Zeni Shader Failed to Link Correctly") {}
   };
 
+  struct ZENI_GRAPHICS_DLL Shader_Uniform_Type_Mismatch : public Error {
+    Shader_Uniform_Type_Mismatch() : Error("Zeni Shader Uniform Set With the Wrong Type") {}
+  };
+
+  struct ZENI_GRAPHICS_DLL Uniform_Buffer_Init_Failure : public Error {
+    Uniform_Buffer_Init_Failure() : Error("Zeni Uniform Buffer Failed to Initialize Correctly") {}
+  };
+
 }
 
 #endif
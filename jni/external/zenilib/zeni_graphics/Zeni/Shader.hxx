@@ -40,9 +40,25 @@ namespace Zeni {
     return m_shader;
   }
 
+  const String & Shader_GL_Shader::get_source() const {
+    return m_source;
+  }
+
+  Shader::Type Shader_GL_Shader::get_type() const {
+    return m_type;
+  }
+
   GLuint Program_GL_Shader::get() const {
     return m_program;
   }
+
+  Program_GL_Shader * Program_GL_Shader::get_current() {
+    return g_current;
+  }
+
+  GLuint Uniform_Buffer::get_binding() const {
+    return m_binding;
+  }
 #endif
   
 #ifndef DISABLE_DX9
@@ -0,0 +1,136 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Sprite_Animation
+ *
+ * \ingroup zenilib
+ *
+ * \brief Many Animated Instances, Advanced Together in Time
+ *
+ * A clip is a sequence of frames, each a Texture shown for its own
+ * duration, which either loops or stops on its last frame.  Clips may be
+ * taken from a Sprite or listed by Texture name.
+ *
+ * Each instance plays one clip at its own speed.  Their playheads are
+ * kept in parallel arrays and update() advances all of them at once,
+ * four at a time, only stepping through frames for instances whose
+ * current frame has ended.
+ *
+ * Frames are resolved directly to their Textures, and to their regions of
+ * an atlas page if they were atlased, so get_frame() and apply_Texture()
+ * never consult the Textures database.  Frames are resolved again, by
+ * whichever of update(), get_frame(), or apply_Texture() comes first,
+ * whenever Textures has changed.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_SPRITE_ANIMATION_H
+#define ZENI_SPRITE_ANIMATION_H
+
+#include <Zeni/Coordinate.h>
+#include <Zeni/Error.h>
+#include <Zeni/String.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  class Texture;
+  class Texture_Atlas_Region;
+
+  class ZENI_GRAPHICS_DLL Sprite_Animation {
+  public:
+    struct Frame {
+      const Texture * texture; ///< The Texture to apply
+      const Texture_Atlas_Region * region; ///< The same Texture if it was atlased, or 0
+      Point2f upper_left; ///< Texture coordinates within its atlas page, or (0, 0)
+      Point2f lower_right; ///< Texture coordinates within its atlas page, or (1, 1)
+    };
+
+    Sprite_Animation();
+
+    // Clips
+    size_t add_clip(const String &sprite, const float &frame_duration, const bool &loop = true); ///< Add every frame of a Sprite in Textures, returning the clip
+    size_t add_clip(const std::vector<String> &textures, const std::vector<float> &durations, const bool &loop = true); ///< Add a frame for each Texture name with a duration each, returning the clip
+    inline size_t get_num_clips() const;
+    inline size_t get_num_frames(const size_t &clip) const;
+    inline float get_duration(const size_t &clip) const; ///< Get the total duration of a clip, in seconds
+
+    // Instances
+    size_t create(const size_t &clip, const float &speed = 1.0f); ///< Start a new instance playing a clip, returning its handle
+    void destroy(const size_t &instance); ///< Return an instance to the pool
+    inline size_t get_num_instances() const; ///< Get the number of live instances
+
+    void play(const size_t &instance, const size_t &clip); ///< Start playing a clip from its first frame
+    inline size_t get_clip(const size_t &instance) const;
+    inline float get_speed(const size_t &instance) const;
+    void set_speed(const size_t &instance, const float &speed); ///< Set a non-negative multiple of the clip's own timing; 0 pauses
+    inline bool is_finished(const size_t &instance) const; ///< Check to see if a clip that does not loop has reached its last frame
+
+    inline int get_frame_number(const size_t &instance) const; ///< Get the current frame within the instance's clip
+    const Frame & get_frame(const size_t &instance) const; ///< Get the current frame, resolving frames again if Textures has changed
+    void apply_Texture(const size_t &instance) const; ///< Apply the current frame for upcoming polygons
+
+    void update(const float &time_step); ///< Advance every playhead by 'time_step' seconds
+
+  private:
+    enum Instance_Flag {LIVE = 1, FINISHED = 2};
+
+    struct Clip {
+      size_t first; ///< Into m_frames
+      size_t count;
+      float duration;
+      bool loop;
+    };
+
+    void advance(const size_t &instance); ///< Step through frames until the current one has time remaining
+    void resolve(const size_t &first_frame) const; ///< Find the Texture for every frame from 'first_frame' on
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Clip> m_clips;
+    mutable std::vector<Frame> m_frames; ///< Resolved lazily
+    std::vector<String> m_frame_names;
+    std::vector<float> m_frame_durations;
+
+    std::vector<float> m_remaining; ///< Seconds left in the current frame, padded to a multiple of four
+    std::vector<float> m_speeds; ///< Padded to a multiple of four
+    std::vector<size_t> m_instance_frames; ///< Into m_frames
+    std::vector<size_t> m_instance_clips;
+    std::vector<Uint8> m_instance_flags; ///< Instance_Flags
+    std::vector<size_t> m_free_instances;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+
+    size_t m_num_instances;
+    mutable unsigned long m_generation; ///< Of Textures, as of the last resolve()
+  };
+
+  struct ZENI_GRAPHICS_DLL Sprite_Animation_Invalid_Clip : public Error {
+    Sprite_Animation_Invalid_Clip() : Error("Sprite_Animation Clip is Invalid") {}
+  };
+
+}
+
+#endif
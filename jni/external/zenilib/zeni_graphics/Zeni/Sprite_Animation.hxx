@@ -0,0 +1,65 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_SPRITE_ANIMATION_HXX
+#define ZENI_SPRITE_ANIMATION_HXX
+
+#include <Zeni/Sprite_Animation.h>
+
+#include <cassert>
+
+namespace Zeni {
+
+  size_t Sprite_Animation::get_num_clips() const {
+    return m_clips.size();
+  }
+
+  size_t Sprite_Animation::get_num_frames(const size_t &clip) const {
+    return m_clips[clip].count;
+  }
+
+  float Sprite_Animation::get_duration(const size_t &clip) const {
+    return m_clips[clip].duration;
+  }
+
+  size_t Sprite_Animation::get_num_instances() const {
+    return m_num_instances;
+  }
+
+  size_t Sprite_Animation::get_clip(const size_t &instance) const {
+    assert(instance < m_instance_flags.size() && (m_instance_flags[instance] & LIVE));
+    return m_instance_clips[instance];
+  }
+
+  float Sprite_Animation::get_speed(const size_t &instance) const {
+    assert(instance < m_instance_flags.size() && (m_instance_flags[instance] & LIVE));
+    return m_speeds[instance];
+  }
+
+  bool Sprite_Animation::is_finished(const size_t &instance) const {
+    assert(instance < m_instance_flags.size() && (m_instance_flags[instance] & LIVE));
+    return (m_instance_flags[instance] & FINISHED) != 0;
+  }
+
+  int Sprite_Animation::get_frame_number(const size_t &instance) const {
+    assert(instance < m_instance_flags.size() && (m_instance_flags[instance] & LIVE));
+    return int(m_instance_frames[instance] - m_clips[m_instance_clips[instance]].first);
+  }
+
+}
+
+#endif
@@ -53,6 +53,7 @@ struct ID3DXRenderToSurface;
 
 namespace Zeni {
 
+  class Matrix4f;
   class Video;
   class Video_GL_Fixed;
   class Video_GL_Shader;
@@ -67,6 +68,7 @@ namespace Zeni {
     virtual ~Texture() {}
 
     virtual void apply_Texture() const = 0; ///< Apply a Texture to upcoming polygons
+    virtual void apply_Texture_transformed(const Matrix4f &texture_matrix) const; ///< Apply a Texture to upcoming polygons, transforming their texture coordinates by texture_matrix
 
     virtual const Point2i & get_size() const = 0; ///< Get the resolution of the Texture on the GPU
 
@@ -88,6 +90,7 @@ namespace Zeni {
     void remove_frame(const int &frame_number); ///< Remove a frame
 
     int get_num_frames() const; ///< Get the number of frames
+    const String & get_frame_name(const int &frame_number) const; ///< Get the name of the Texture for a frame
     int get_current_frame() const; ///< Get the currently selected frame number
     void set_current_frame(const int &frame_number); ///< Set this frame
 
@@ -118,16 +121,22 @@ namespace Zeni {
   public:
     Texture_GL(const String &filename, const bool &repeat /* otherwise clamp */,
                const bool &lazy_loading = false);
-    Texture_GL(const Image &image);
+    Texture_GL(const Image &image, const int &mip_levels = -1); ///< Sample no more than mip_levels reduced levels, if nonnegative
     Texture_GL(const Point2i &size, const bool &repeat /* otherwise clamp */); ///< For render-to-texture
     virtual ~Texture_GL();
 
     virtual void apply_Texture() const;
+    virtual void apply_Texture_transformed(const Matrix4f &texture_matrix) const;
 
     inline const Point2i & get_size() const;
 
   private:
+    void bind() const;
+
     static GLuint build_from_Image(const Image &image);
+    static GLuint build_from_Image(const Image &image, const std::vector<Image> &mipmaps); ///< Upload mipmaps as given rather than generating them, unless there are none
+
+    static GLuint g_bound_texture_id; ///< Avoids redundant calls to glBindTexture
 
     mutable Point2i m_size;
     mutable GLuint m_texture_id;
@@ -150,18 +159,21 @@ namespace Zeni {
 
   public:
     Texture_DX9(const String &filename, const bool &repeat /* otherwise clamp */);
-    Texture_DX9(const Image &image);
+    Texture_DX9(const Image &image, const int &mip_levels = -1); ///< Sample no more than mip_levels reduced levels, if nonnegative
     Texture_DX9(const Point2i &size, const bool &repeat /* otherwise clamp */); ///< For render-to-texture
     virtual ~Texture_DX9();
 
     virtual void apply_Texture() const;
+    virtual void apply_Texture_transformed(const Matrix4f &texture_matrix) const;
 
     inline const Point2i & get_size() const;
     inline ID3DXRenderToSurface * render_to_surface() const;
 
   private:
+    void bind() const;
+
     static void set_sampler_states(const bool &disable_mipmapping = false);
-    static IDirect3DTexture9 * build_from_Image(const Image &image);
+    static IDirect3DTexture9 * build_from_Image(const Image &image, const int &mip_levels = -1);
 
     mutable Point2i m_size;
     mutable IDirect3DTexture9 *m_texture;
@@ -0,0 +1,146 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Texture_Atlas
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Packer for Many Small Images
+ *
+ * A Texture_Atlas packs Images of any size into power-of-two pages,
+ * surrounding each with a padding of replicated edge texels so that bilinear
+ * filtering does not bleed between neighbors.  The padding is a power of two
+ * and every region is aligned to it, so the first log2(padding) reduced mip
+ * levels stay clean as well; Page Textures sample no further down the mip
+ * chain than that.  Each packed Image is
+ * represented by a Texture_Atlas_Region which binds its page and selects its
+ * sub-rectangle using the texture matrix, so texture coordinates in [0, 1]
+ * continue to work unchanged.
+ *
+ * Pages are uploaded to the GPU on first use (or with a call to upload) and
+ * the Images are retained so that pages can be restored after the rendering
+ * device has been lost.
+ *
+ * \note Regions cannot repeat.  Tileable Images should not be packed.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_TEXTURE_ATLAS_H
+#define ZENI_TEXTURE_ATLAS_H
+
+#include <Zeni/Image.h>
+#include <Zeni/Matrix4f.h>
+#include <Zeni/Texture.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  class Texture_Atlas;
+
+  class ZENI_GRAPHICS_DLL Texture_Atlas_Region : public Texture {
+    Texture_Atlas_Region(const Texture_Atlas_Region &);
+    Texture_Atlas_Region & operator=(const Texture_Atlas_Region &);
+
+  public:
+    Texture_Atlas_Region(const Texture_Atlas &atlas, const size_t &page, const Point2i &upper_left, const Point2i &size);
+
+    virtual void apply_Texture() const; ///< Apply the page and select the sub-rectangle for upcoming polygons
+
+    inline const Point2i & get_size() const; ///< Get the resolution of the region within its page
+
+    inline size_t get_page() const; ///< Get the index of the page containing this region
+    inline const Point2f & get_upper_left_texel() const; ///< Get the upper left texture coordinate within the page
+    inline const Point2f & get_lower_right_texel() const; ///< Get the lower right texture coordinate within the page
+    inline const Matrix4f & get_texture_matrix() const; ///< Get the Matrix4f mapping [0, 1] onto the region
+
+  private:
+    const Texture_Atlas * m_atlas;
+    size_t m_page;
+    Point2i m_size;
+    Point2f m_upper_left_texel;
+    Point2f m_lower_right_texel;
+    Matrix4f m_texture_matrix;
+  };
+
+  class ZENI_GRAPHICS_DLL Texture_Atlas {
+    Texture_Atlas(const Texture_Atlas &);
+    Texture_Atlas & operator=(const Texture_Atlas &);
+
+  public:
+    Texture_Atlas(const Point2i &page_size = Point2i(1024, 1024), const int &padding = 4); ///< padding is rounded up to a power of two
+    ~Texture_Atlas();
+
+    inline const Point2i & get_page_size() const; ///< Get the default dimensions of a page
+    inline int get_padding() const; ///< Get the number of texels surrounding each region
+    inline int get_mip_levels() const; ///< Get the number of reduced mip levels sampled from pages, log2(padding)
+    inline size_t get_num_pages() const; ///< Get the number of pages in use
+    inline const Image & get_page_Image(const size_t &page) const; ///< Get the packed Image for a page
+    float get_occupancy() const; ///< Get the fraction of page area covered by packed Images, including padding
+
+    bool fits(const Point2i &size) const; ///< Determine whether an Image of this size can share a page with others
+
+    Texture_Atlas_Region * pack(const Image &image); ///< Pack an Image into a page, or into a power-of-two page of its own if it does not fit; The caller owns the returned Texture
+
+    void apply_page(const size_t &page) const; ///< Apply a page for upcoming polygons, uploading it if necessary
+    void apply_page(const size_t &page, const Matrix4f &texture_matrix) const; ///< Apply a page for upcoming polygons with a texture Matrix4f, uploading it if necessary
+    void upload() const; ///< Upload any pages which are not current on the GPU
+    void lose_resources(); ///< Release page Textures, keeping Images to restore them later
+
+  private:
+    struct Page {
+      Page(const Point2i &size);
+
+      bool insert(const Point2i &size, Point2i &upper_left); ///< Skyline bottom-left placement
+
+      Image image;
+      std::vector<Point3i> skyline; ///< (x, y, width) of each horizontal segment
+      int used_area;
+      mutable Texture * texture;
+      mutable bool dirty;
+    };
+
+    const Page & get_current_page(const size_t &page) const; ///< Get a page, uploading it if necessary
+    Point2i get_padded_size(const Point2i &size) const; ///< Pad and align a size to a multiple of the padding
+    void upload(const Page &page) const;
+    static void copy_with_padding(Image &dest, const Point2i &upper_left, const Point2i &padded_size, const Image &source, const int &padding);
+
+    Point2i m_page_size;
+    int m_padding;
+    int m_mip_levels;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Page *> m_pages;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+  };
+
+  struct ZENI_GRAPHICS_DLL Texture_Atlas_Page_Out_of_Range : public Error {
+    Texture_Atlas_Page_Out_of_Range() : Error("Texture_Atlas Page Choice is Out of Range") {}
+  };
+
+}
+
+#endif
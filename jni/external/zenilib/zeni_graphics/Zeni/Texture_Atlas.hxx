@@ -0,0 +1,70 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_TEXTURE_ATLAS_HXX
+#define ZENI_TEXTURE_ATLAS_HXX
+
+#include <Zeni/Texture_Atlas.h>
+
+namespace Zeni {
+
+  const Point2i & Texture_Atlas_Region::get_size() const {
+    return m_size;
+  }
+
+  size_t Texture_Atlas_Region::get_page() const {
+    return m_page;
+  }
+
+  const Point2f & Texture_Atlas_Region::get_upper_left_texel() const {
+    return m_upper_left_texel;
+  }
+
+  const Point2f & Texture_Atlas_Region::get_lower_right_texel() const {
+    return m_lower_right_texel;
+  }
+
+  const Matrix4f & Texture_Atlas_Region::get_texture_matrix() const {
+    return m_texture_matrix;
+  }
+
+  const Point2i & Texture_Atlas::get_page_size() const {
+    return m_page_size;
+  }
+
+  int Texture_Atlas::get_padding() const {
+    return m_padding;
+  }
+
+  int Texture_Atlas::get_mip_levels() const {
+    return m_mip_levels;
+  }
+
+  size_t Texture_Atlas::get_num_pages() const {
+    return m_pages.size();
+  }
+
+  const Image & Texture_Atlas::get_page_Image(const size_t &page) const {
+    if(page >= m_pages.size())
+      throw Texture_Atlas_Page_Out_of_Range();
+
+    return m_pages[page]->image;
+  }
+
+}
+
+#endif
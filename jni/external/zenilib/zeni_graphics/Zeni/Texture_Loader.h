@@ -0,0 +1,141 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Texture_Loader
+ *
+ * \ingroup zenilib
+ *
+ * \brief An Asynchronous Texture Loader
+ *
+ * A Texture_Loader decodes Images on a pool of worker Threads.  Decoded
+ * Images wait until upload is called on the rendering thread, which creates
+ * as many Textures as it can within its time budget.
+ *
+ * Until its Image has been uploaded, a Texture_Async applies a 1x1
+ * transparent placeholder.
+ *
+ * \note Textures::set_asynchronous_loading routes Textures through a Texture_Loader.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_TEXTURE_LOADER_H
+#define ZENI_TEXTURE_LOADER_H
+
+#include <Zeni/Image.h>
+#include <Zeni/Texture.h>
+#include <Zeni/Thread.h>
+
+#include <list>
+#include <vector>
+
+namespace Zeni {
+
+  class Texture_Async;
+
+  class ZENI_GRAPHICS_DLL Texture_Loader : private Task {
+    friend class Texture_Async;
+
+    // Undefined
+    Texture_Loader(const Texture_Loader &);
+    Texture_Loader & operator=(const Texture_Loader &);
+
+  public:
+    Texture_Loader(const size_t &num_threads = 0u); ///< Start decoding Threads; 0 uses one fewer than the number of cores, but no less than one
+    ~Texture_Loader(); ///< Stop decoding Threads, abandoning any Textures still pending
+
+    inline size_t get_num_threads() const; ///< Get the number of decoding Threads
+    size_t get_num_pending() const; ///< Get the number of Textures not yet uploaded
+    inline float get_worst_upload_time() const; ///< Get the longest time in seconds spent in a single call to upload
+
+    Texture_Async * load(const String &filename, const bool &repeat); ///< Queue a PNG for decoding; The caller owns the returned Texture
+
+    void upload(const float &budget); ///< Upload decoded Images until 'budget' seconds have passed; At least one is uploaded if any are ready
+    void finish(); ///< Block until every queued Texture has been uploaded
+
+    void lose_resources(); ///< Release the placeholder Texture
+
+  private:
+    struct Job {
+      Job(Texture_Async * const &owner_, const String &filename_, const bool &repeat_);
+      ~Job();
+
+      Texture_Async * owner; ///< 0 once the owner has been destroyed
+      String filename;
+      bool repeat;
+      Image * image; ///< 0 if decoding failed
+    };
+
+    virtual int function(); ///< Decode Jobs until destroyed
+
+    void cancel(Job * const &job);
+    void apply_placeholder() const;
+    static const Point2i & get_placeholder_size();
+
+    mutable Mutex m_mutex;
+    Condition_Variable m_queued_cv;
+    Condition_Variable m_decoded_cv;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::list<Job *> m_queued;
+    std::list<Job *> m_decoded;
+    std::vector<Thread *> m_threads;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+
+    size_t m_num_jobs;
+    bool m_quit;
+
+    mutable Texture * m_placeholder;
+    float m_worst_upload_time;
+  };
+
+  class ZENI_GRAPHICS_DLL Texture_Async : public Texture {
+    friend class Texture_Loader;
+
+    // Undefined
+    Texture_Async(const Texture_Async &);
+    Texture_Async & operator=(const Texture_Async &);
+
+    Texture_Async(Texture_Loader &loader, const bool &repeat);
+
+  public:
+    ~Texture_Async();
+
+    virtual void apply_Texture() const; ///< Apply the Texture, or the placeholder until it is ready
+
+    virtual const Point2i & get_size() const; ///< Get the resolution of the Texture, or of the placeholder until it is ready
+
+    inline bool is_loaded() const; ///< Check to see if the Texture has been uploaded
+
+  private:
+    Texture_Loader * m_loader;
+    Texture_Loader::Job * m_job;
+    Texture * m_texture;
+    bool m_failed;
+  };
+
+}
+
+#endif
@@ -0,0 +1,39 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZENI_TEXTURE_LOADER_HXX
+#define ZENI_TEXTURE_LOADER_HXX
+
+#include <Zeni/Texture_Loader.h>
+
+namespace Zeni {
+
+  size_t Texture_Loader::get_num_threads() const {
+    return m_threads.size();
+  }
+
+  float Texture_Loader::get_worst_upload_time() const {
+    return m_worst_upload_time;
+  }
+
+  bool Texture_Async::is_loaded() const {
+    return m_texture != 0;
+  }
+
+}
+
+#endif
@@ -24,6 +24,12 @@
  *
  * \note Textures will be reloaded automatically if settings are changed with a call to set_texturing_mode.
  *
+ * \note With asynchronous loading enabled, textures which are not atlased are decoded on worker Threads and uploaded a few at a time at the start of each frame.  Placeholders are applied until they are ready.
+ *
+ * \note With caching enabled, decoded textures are stored in an Image_Cache so that PNGs need only be decoded again when they change.
+ *
+ * \note With atlasing enabled, small untiled textures and Sprite frames are packed into shared Texture_Atlas pages.  An entry may override this with an 'atlas' element.
+ *
  * \author bazald
  *
  * Contact: bazald@zenipex.com
@@ -41,7 +47,10 @@
 
 namespace Zeni {
   
+  class Image;
   class Texture;
+  class Texture_Atlas;
+  class Texture_Loader;
   class Textures;
 
 #ifdef _WINDOWS
@@ -109,12 +118,30 @@ namespace Zeni {
     inline static bool get_trilinear_filtering(); ///< Check if trilinear filtering (the combination of bilinear filtering and mipmapping) is in use
     inline static int get_anisotropic_filtering(); ///< Check the current level of anisotropy
     inline static bool get_lazy_loading(); /// Check to see if Textures is set to use lazy loading if possible
+    inline static bool get_atlasing(); ///< Check to see if Textures is set to pack small textures into shared pages
+    inline static bool get_asynchronous_loading(); ///< Check to see if Textures is set to decode textures on worker Threads
+    inline static bool get_caching(); ///< Check to see if Textures is set to cache decoded textures
+    inline static float get_upload_budget(); ///< Get the number of seconds per frame which may be spent uploading asynchronously loaded textures
 
     // Loading Options
     static void set_texturing_mode(const int &anisotropic_filtering_,
                                                     const bool &bilinear_filtering_,
                                                     const bool &mipmapping_); ///< Set the texturing mode
     inline static void set_lazy_loading(const bool &lazy_loading = true); ///< Set whether Textures should use lazy loading if possible, or if it should always load Textures immediately.
+    inline static void set_atlasing(const bool &atlasing = true); ///< Set whether Textures should pack small untiled textures into shared pages; Packed textures are never lazily loaded.
+    inline static void set_asynchronous_loading(const bool &asynchronous_loading = true); ///< Set whether Textures should decode textures on worker Threads, applying placeholders until they are ready; Takes precedence over lazy loading, but not over atlasing.
+    inline static void set_caching(const bool &caching = true); ///< Set whether Textures should cache decoded textures, and their mipmaps, in an Image_Cache.
+    inline static void set_upload_budget(const float &seconds); ///< Set the number of seconds per frame which may be spent uploading asynchronously loaded textures; At least one is uploaded per frame regardless.
+
+    // Asynchronous Loading
+    size_t get_num_pending() const; ///< Get the number of asynchronously loaded textures which are not yet ready
+    inline const Texture_Loader * get_Texture_Loader() const; ///< Get the Texture_Loader; 0 if asynchronous loading has not been used
+    void upload_decoded(); ///< Upload decoded textures within the upload budget (Called by Video::begin_prerender)
+    void finish_loading(); ///< Block until every asynchronously loaded texture is ready
+
+    // Atlas
+    unsigned long pack_Image(const String &name, const Image &image, const bool &keep = false); ///< Pack an Image into a shared page and add it as a Texture
+    inline const Texture_Atlas * get_Texture_Atlas(const bool &keep = false) const; ///< Get the pages shared by entries loaded from files, or by kept entries; 0 if there are none
 
     // Appliers
     void apply_Texture(const String &name); ///< Apply a texture for upcoming polygons (Called by Video::apply_Texture)
@@ -132,12 +159,22 @@ namespace Zeni {
     virtual void on_lose();
 
     virtual Texture * load(XML_Element_c &xml_element, const String &name, const String &filename);
+    Texture * load_Texture(const String &filepath, const bool &tile, const bool &atlas);
+
+    Texture_Atlas * m_atlas; ///< Pages for entries loaded from files
+    Texture_Atlas * m_packed_atlas; ///< Pages for entries from pack_Image which are lost with the rendering device
+    Texture_Atlas * m_kept_atlas; ///< Pages for entries which are kept; Only their Textures are lost
+    Texture_Loader * m_loader;
 
     static bool m_loaded;
     static bool m_bilinear_filtering;
     static bool m_mipmapping;
     static int m_anisotropic_filtering;
     static bool m_lazy_loading;
+    static bool m_atlasing;
+    static bool m_asynchronous_loading;
+    static bool m_caching;
+    static float m_upload_budget;
   };
 
   ZENI_GRAPHICS_DLL Textures & get_Textures(); ///< Get access to the singleton.
@@ -49,6 +49,46 @@ namespace Zeni {
     m_lazy_loading = lazy_loading;
   }
 
+  const Texture_Atlas * Textures::get_Texture_Atlas(const bool &keep) const {
+    return keep ? m_kept_atlas : m_atlas;
+  }
+
+  bool Textures::get_atlasing() {
+    return m_atlasing;
+  }
+
+  void Textures::set_atlasing(const bool &atlasing) {
+    m_atlasing = atlasing;
+  }
+
+  bool Textures::get_asynchronous_loading() {
+    return m_asynchronous_loading;
+  }
+
+  bool Textures::get_caching() {
+    return m_caching;
+  }
+
+  float Textures::get_upload_budget() {
+    return m_upload_budget;
+  }
+
+  void Textures::set_asynchronous_loading(const bool &asynchronous_loading) {
+    m_asynchronous_loading = asynchronous_loading;
+  }
+
+  void Textures::set_caching(const bool &caching) {
+    m_caching = caching;
+  }
+
+  void Textures::set_upload_budget(const float &seconds) {
+    m_upload_budget = seconds;
+  }
+
+  const Texture_Loader * Textures::get_Texture_Loader() const {
+    return m_loader;
+  }
+
 }
 
 #include <Zeni/Texture.hxx>
@@ -30,6 +30,7 @@
 #ifndef ZENI_VERTEX_BUFFER_H
 #define ZENI_VERTEX_BUFFER_H
 
+#include <Zeni/Frustum.h>
 #include <Zeni/Triangle.h>
 #include <Zeni/Quadrilateral.h>
 #include <Zeni/Vertex2f.h>
@@ -104,6 +105,18 @@ namespace Zeni {
 #endif
       size_t start;
       size_t num_elements;
+
+      Point3f lower_bound; ///< The lower corner of the bounding box of the range
+      Point3f upper_bound; ///< The upper corner of the bounding box of the range
+      bool visible; ///< False if culled by the most recent render
+    };
+
+    struct ZENI_GRAPHICS_DLL Cull_Stats {
+      Cull_Stats();
+
+      size_t visible; ///< Ranges sent to the Video back end
+      size_t culled; ///< Ranges skipped for lying outside the Frustum
+      float seconds; ///< Time spent testing bounds
     };
 
     Vertex_Buffer();
@@ -136,10 +149,18 @@ namespace Zeni {
     void give_Macrorenderer(Vertex_Buffer_Macrorenderer * const &macrorenderer); ///< Wraps the final render call
 
     void render(); ///< Render the Vertex_Buffer
+    void render(const Frustum &frustum); ///< Render only the ranges which may lie within 'frustum', given in the space of the Vertex_Buffer
     void lose(); ///< Lose the Vertex_Buffer
 
+    inline const Point3f & get_lower_bound() const; ///< Get the lower corner of the bounding box; Valid once rendered
+    inline const Point3f & get_upper_bound() const; ///< Get the upper corner of the bounding box; Valid once rendered
+
+    static const Cull_Stats & get_cull_stats(); ///< Get the culling totals for the previous frame
+    static void next_cull_frame(); ///< Finish counting a frame; Game calls this once per frame
+
   private:
     void prerender(); ///< Create the vertex buffer in the GPU/VPU
+    void render_ranges(); ///< Render the ranges not culled
 
     inline size_t num_vertices_cm() const;
     inline size_t num_vertices_t() const;
@@ -155,6 +176,9 @@ namespace Zeni {
     // Align normals of similar vertices
     void align_similar_normals();
 
+    // Compute bounding boxes for each range and for the whole Vertex_Buffer
+    void set_bounds();
+
 #ifdef _WINDOWS
 #pragma warning( push )
 #pragma warning( disable : 4251 )
@@ -170,6 +194,10 @@ namespace Zeni {
 
     bool m_align_normals;
 
+    Point3f m_lower_bound;
+    Point3f m_upper_bound;
+    bool m_culled;
+
     Vertex_Buffer_Renderer * m_renderer;
     bool m_prerendered;
 
@@ -30,6 +30,14 @@ namespace Zeni {
     return m_align_normals;
   }
 
+  const Point3f & Vertex_Buffer::get_lower_bound() const {
+    return m_lower_bound;
+  }
+
+  const Point3f & Vertex_Buffer::get_upper_bound() const {
+    return m_upper_bound;
+  }
+
   size_t Vertex_Buffer::num_vertices_cm() const {
     return 3u * m_triangles_cm.size();
   }
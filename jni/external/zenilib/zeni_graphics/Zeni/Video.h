@@ -38,6 +38,7 @@
 #include <Zeni/Core.h>
 #include <Zeni/Color.h>
 #include <Zeni/Coordinate.h>
+#include <Zeni/Frustum.h>
 #include <Zeni/Matrix4f.h>
 #include <Zeni/Singleton.h>
 #include <Zeni/String.h>
@@ -53,6 +54,7 @@ namespace Zeni {
   class Camera;
   struct Fog;
   class Font;
+  class Image;
   struct Light;
   class Material;
   class Program;
@@ -155,6 +157,12 @@ namespace Zeni {
     virtual void apply_Texture(const unsigned long &id) = 0; ///< Apply a texture by id
     virtual void apply_Texture(const Texture &texture) = 0; ///< Apply a texture by id
     virtual void unapply_Texture() = 0; ///< Unapply a texture
+    inline bool is_texture_matrix_set() const; ///< Determine whether a texture Matrix4f other than the identity is in use
+    inline const Matrix4f & get_texture_matrix() const; ///< Get the texture Matrix4f
+    virtual void set_texture_matrix(const Matrix4f &texture_matrix) = 0; ///< Set the texture Matrix4f, transforming upcoming texture coordinates
+    virtual void unset_texture_matrix() = 0; ///< Restore the identity texture Matrix4f
+    virtual void set_distance_field(const float &smoothing); ///< Treat texture alpha as a signed distance field, drawing only what lies inside 0.5; 'smoothing' is the half-width of the antialiased edge in alpha units, where supported
+    virtual void unset_distance_field(); ///< Treat texture alpha as alpha again
 
     // Lighting and Materials
     virtual void set_lighting(const bool &on = true) = 0; ///< Set lighting on/off
@@ -194,6 +202,7 @@ namespace Zeni {
     virtual Point2f get_pixel_offset() const = 0; ///< Get the pixel offset in the 2d view
     inline const Matrix4f & get_view_matrix() const; ///< Get the view Matrix4f
     inline const Matrix4f & get_projection_matrix() const; ///< Get the projection Matrix4f
+    inline const Frustum & get_frustum() const; ///< Get the Frustum of the current 3D view, or one containing everything in 2D
     inline const std::pair<Point2i, Point2i> & get_viewport() const; ///< Get the viewport
     virtual void set_view_matrix(const Matrix4f &view) = 0; ///< Set the view Matrix4f
     virtual void set_projection_matrix(const Matrix4f &projection) = 0; ///< Set the projection Matrix4f
@@ -211,10 +220,11 @@ namespace Zeni {
 
     // Creation Functions
     virtual Texture * load_Texture(const String &filename, const bool &repeat, const bool &lazy_loading = false) = 0; ///< Function for loading a Texture; used internally by Textures
-    virtual Texture * create_Texture(const Image &image) = 0; ///< Function for creating a Texture from an Image
+    virtual Texture * create_Texture(const Image &image, const int &mip_levels = -1) = 0; ///< Function for creating a Texture from an Image; A nonnegative mip_levels limits the reduced levels sampled
     virtual Texture * create_Texture(const Point2i &size, const bool &repeat) = 0; ///< Function for creating a Texture for render-to-texture
     virtual Font * create_Font(const String &filename, 
-      const float &glyph_height, const float &virtual_screen_height) = 0; ///< Function for creating a Font; used internally by Fonts
+      const float &glyph_height, const float &virtual_screen_height,
+      const bool &distance_field = false) = 0; ///< Function for creating a Font; used internally by Fonts
     virtual Vertex_Buffer_Renderer * create_Vertex_Buffer_Renderer(Vertex_Buffer &vertex_buffer) = 0; ///< Function for creating a Vertex_Buffer_Renderer
     virtual Shader * create_Vertex_Shader(const String &filename) = 0; ///< Create a Vertex_Shader from a file
     virtual Shader * create_Fragment_Shader(const String &filename) = 0; ///< Create a Fragment_Shader from a file
@@ -266,9 +276,13 @@ namespace Zeni {
 
     Color m_color;
 
+    Matrix4f m_texture_matrix;
+    bool m_texture_matrix_set;
+
     const Matrix4f m_preview;
     Matrix4f m_view;
     Matrix4f m_projection;
+    Frustum m_frustum;
 #ifdef _WINDOWS
 #pragma warning( push )
 #pragma warning( disable : 4251 )
@@ -285,6 +299,11 @@ namespace Zeni {
     TEST m_alpha_function;
     float m_alpha_value;
 
+    // Alpha test replaced by set_distance_field
+    bool m_distance_field_alpha_test;
+    TEST m_distance_field_alpha_function;
+    float m_distance_field_alpha_value;
+
     bool m_3d;
   };
 
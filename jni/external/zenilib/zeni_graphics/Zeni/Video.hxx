@@ -119,6 +119,14 @@ namespace Zeni {
     apply_Texture(get_Textures().get_id(name));
   }
 
+  bool Video::is_texture_matrix_set() const {
+    return m_texture_matrix_set;
+  }
+
+  const Matrix4f & Video::get_texture_matrix() const {
+    return m_texture_matrix;
+  }
+
   void Video::rotate_scene(const Quaternion &rotation) {
     const std::pair<Vector3f, float> rayngel = rotation.get_rotation();
     rotate_scene(rayngel.first, rayngel.second);
@@ -132,6 +140,10 @@ namespace Zeni {
     return m_projection;
   }
 
+  const Frustum & Video::get_frustum() const {
+    return m_frustum;
+  }
+
   const std::pair<Point2i, Point2i> & Video::get_viewport() const {
     return m_viewport;
   }
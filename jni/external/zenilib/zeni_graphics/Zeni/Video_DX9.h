@@ -147,6 +147,8 @@ namespace Zeni {
     void apply_Texture(const unsigned long &id); ///< Apply a texture by id
     void apply_Texture(const Texture &texture); ///< Apply a texture by id
     void unapply_Texture(); ///< Unapply a texture
+    void set_texture_matrix(const Matrix4f &texture_matrix); ///< Set the texture Matrix4f, transforming upcoming texture coordinates
+    void unset_texture_matrix(); ///< Restore the identity texture Matrix4f
 
     // Lighting and Materials
     void set_lighting(const bool &on = true); ///< Set lighting on/off
@@ -188,10 +190,11 @@ namespace Zeni {
 
     // Creation Functions
     Texture * load_Texture(const String &filename, const bool &repeat, const bool &lazy_loading = false); ///< Function for loading a Texture; used internally by Textures
-    Texture * create_Texture(const Image &image); ///< Function for creating a Texture from an Image
+    Texture * create_Texture(const Image &image, const int &mip_levels = -1); ///< Function for creating a Texture from an Image; A nonnegative mip_levels limits the reduced levels sampled
     Texture * create_Texture(const Point2i &size, const bool &repeat); ///< Function for creating a Texture for render-to-texture
     Font * create_Font(const String &filename, 
-      const float &glyph_height, const float &virtual_screen_height); ///< Function for creating a Font; used internally by Fonts
+      const float &glyph_height, const float &virtual_screen_height,
+      const bool &distance_field = false); ///< Function for creating a Font; used internally by Fonts
     Vertex_Buffer_Renderer * create_Vertex_Buffer_Renderer(Vertex_Buffer &vertex_buffer); ///< Function for creating a Vertex_Buffer_Renderer
     Shader * create_Vertex_Shader(const String &filename); ///< Create a Vertex_Shader from a file
     Shader * create_Fragment_Shader(const String &filename); ///< Create a Fragment_Shader from a file
@@ -66,6 +66,9 @@ typedef int ( * PFNGLXSWAPINTERVALSGIPROC) (int interval);
 namespace Zeni {
 
   class Texture_GL;
+  class Shader_GL_Shader;
+  class Program_GL_Shader;
+  class Light_Clusters;
 
   class ZENI_GRAPHICS_DLL Video_GL_Shader : public Video {
     friend class Video;
@@ -109,12 +112,18 @@ namespace Zeni {
     void apply_Texture(const unsigned long &id); ///< Apply a texture by id
     void apply_Texture(const Texture &texture); ///< Apply a texture by id
     void unapply_Texture(); ///< Unapply a texture
+    void set_texture_matrix(const Matrix4f &texture_matrix); ///< Set the texture Matrix4f, transforming upcoming texture coordinates
+    void unset_texture_matrix(); ///< Restore the identity texture Matrix4f
+    void set_distance_field(const float &smoothing); ///< Treat texture alpha as a signed distance field, drawing only what lies inside 0.5; 'smoothing' is the half-width of the antialiased edge in alpha units
+    void unset_distance_field(); ///< Treat texture alpha as alpha again
 
     // Lighting and Materials
     void set_lighting(const bool &on = true); ///< Set lighting on/off
     void set_ambient_lighting(const Color &color); ///< Set ambient lighting on/off
     void set_Light(const int &number, const Light &light); ///< Set a particular Light
     void unset_Light(const int &number); ///< Unset a particular Light
+    bool set_clustered_lighting(const Light_Clusters &clusters); ///< Light each pixel with every Light in 'clusters' in a single pass, in place of the Lights set with set_Light; Returns false if unsupported
+    void unset_clustered_lighting(); ///< Return to the Lights set with set_Light
     void set_Material(const Material &material); ///< Set a Material
     void unset_Material(const Material &material); ///< Unset a Material
 
@@ -150,10 +159,11 @@ namespace Zeni {
 
     // Creation Functions
     Texture * load_Texture(const String &filename, const bool &repeat, const bool &lazy_loading = false); ///< Function for loading a Texture; used internally by Textures
-    Texture * create_Texture(const Image &image); ///< Function for creating a Texture from an Image
+    Texture * create_Texture(const Image &image, const int &mip_levels = -1); ///< Function for creating a Texture from an Image; A nonnegative mip_levels limits the reduced levels sampled
     Texture * create_Texture(const Point2i &size, const bool &repeat); ///< Function for creating a Texture for render-to-texture
     Font * create_Font(const String &filename, 
-      const float &glyph_height, const float &virtual_screen_height); ///< Function for creating a Font; used internally by Fonts
+      const float &glyph_height, const float &virtual_screen_height,
+      const bool &distance_field = false); ///< Function for creating a Font; used internally by Fonts
     Vertex_Buffer_Renderer * create_Vertex_Buffer_Renderer(Vertex_Buffer &vertex_buffer); ///< Function for creating a Vertex_Buffer_Renderer
     Shader * create_Vertex_Shader(const String &filename); ///< Create a Vertex Shader from a file
     Shader * create_Fragment_Shader(const String &filename); ///< Create a Fragment_Shader from a file
@@ -168,6 +178,9 @@ namespace Zeni {
     void uninit();
 
   private:
+    void init_distance_field();
+    void init_clustered_lighting();
+
 #if SDL_VERSION_ATLEAST(1,3,0)
     SDL_GLContext m_context;
 #endif
@@ -182,6 +195,21 @@ namespace Zeni {
 
     Texture_GL * m_render_target;
 
+    Shader_GL_Shader * m_distance_field_vertex_shader;
+    Shader_GL_Shader * m_distance_field_fragment_shader;
+    Program_GL_Shader * m_distance_field_program; ///< 0 until first used, or if unsupported
+    int m_distance_field_smoothing; ///< Uniform handle
+    Program_GL_Shader * m_distance_field_previous; ///< Current before set_distance_field, to restore after
+    bool m_distance_field_tried;
+
+    Shader_GL_Shader * m_clustered_vertex_shader;
+    Shader_GL_Shader * m_clustered_fragment_shader;
+    Program_GL_Shader * m_clustered_program; ///< 0 until first used, or if unsupported
+    GLuint m_clustered_textures[3]; ///< Lights, clusters, and indices
+    int m_clustered_textured; ///< Uniform handle
+    bool m_clustered_tried;
+    bool m_clustered_active;
+
 #ifdef MANUAL_GL_VSYNC_DELAY
     Zeni::Time m_buffer_swap_end_time;
     float m_time_taken;
@@ -17,18 +17,27 @@
 
 #include <zeni_graphics.h>
 
+#include "Zeni/Command_List.cpp"
 #include "Zeni/EZ2D.cpp"
 #include "Zeni/Fog.cpp"
 #include "Zeni/Font.cpp"
 #include "Zeni/Fonts.cpp"
 #include "Zeni/Image.cpp"
+#include "Zeni/Image_Cache.cpp"
 #include "Zeni/Light.cpp"
+#include "Zeni/Light_Clusters.cpp"
 #include "Zeni/Material.cpp"
 #include "Zeni/Model.cpp"
+#include "Zeni/Particle_System.cpp"
+#include "Zeni/Primitive_Batch.cpp"
+#include "Zeni/Program_Cache.cpp"
 #include "Zeni/Projector.cpp"
 #include "Zeni/Renderable.cpp"
 #include "Zeni/Shader.cpp"
+#include "Zeni/Sprite_Animation.cpp"
 #include "Zeni/Texture.cpp"
+#include "Zeni/Texture_Atlas.cpp"
+#include "Zeni/Texture_Loader.cpp"
 #include "Zeni/Textures.cpp"
 #include "Zeni/Vertex2f.cpp"
 #include "Zeni/Vertex3f.cpp"
@@ -27,20 +27,29 @@
 
 #include <zeni_core.h>
 
+#include <Zeni/Command_List.h>
 #include <Zeni/EZ2D.h>
 #include <Zeni/Fog.h>
 #include <Zeni/Font.h>
 #include <Zeni/Fonts.h>
 #include <Zeni/Image.h>
+#include <Zeni/Image_Cache.h>
 #include <Zeni/Light.h>
+#include <Zeni/Light_Clusters.h>
 #include <Zeni/Line_Segment.h>
 #include <Zeni/Material.h>
 #include <Zeni/Model.h>
+#include <Zeni/Particle_System.h>
+#include <Zeni/Primitive_Batch.h>
+#include <Zeni/Program_Cache.h>
 #include <Zeni/Projector.h>
 #include <Zeni/Quadrilateral.h>
 #include <Zeni/Renderable.h>
 #include <Zeni/Shader.h>
+#include <Zeni/Sprite_Animation.h>
 #include <Zeni/Texture.h>
+#include <Zeni/Texture_Atlas.h>
+#include <Zeni/Texture_Loader.h>
 #include <Zeni/Textures.h>
 #include <Zeni/Triangle.h>
 #include <Zeni/Vertex2f.h>
@@ -52,15 +61,22 @@
 #include <Zeni/Video_GL_Shader.h>
 #include <Zeni/Window.h>
 
+#include <Zeni/Command_List.hxx>
 #include <Zeni/Font.hxx>
 #include <Zeni/Image.hxx>
 #include <Zeni/Light.hxx>
+#include <Zeni/Light_Clusters.hxx>
 #include <Zeni/Material.hxx>
 #include <Zeni/Model.hxx>
+#include <Zeni/Particle_System.hxx>
+#include <Zeni/Program_Cache.hxx>
 #include <Zeni/Projector.hxx>
 #include <Zeni/Renderable.hxx>
 #include <Zeni/Shader.hxx>
+#include <Zeni/Sprite_Animation.hxx>
 #include <Zeni/Texture.hxx>
+#include <Zeni/Texture_Atlas.hxx>
+#include <Zeni/Texture_Loader.hxx>
 #include <Zeni/Textures.hxx>
 #include <Zeni/Vertex2f.hxx>
 #include <Zeni/Vertex3f.hxx>
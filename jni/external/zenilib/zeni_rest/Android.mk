@@ -14,7 +14,9 @@ LOCAL_SRC_FILES := \
   Logo.cpp \
   main.cpp \
   Widget.cpp \
-  Widget_Gamestate.cpp
+  Widget_Gamestate.cpp \
+  Widget_Geometry.cpp \
+  Widget_Grid.cpp
 LOCAL_LDLIBS    := -landroid -llog
 
 $(LOCAL_LIBRARIES_TYPE) := zeni_graphics zeni_core zeni_audio zeni tinyxml
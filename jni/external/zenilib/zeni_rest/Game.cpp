@@ -17,6 +17,8 @@
 
 #include <zeni_rest.h>
 
+#include <cmath>
+
 #include <Zeni/Define.h>
 
 #if defined(_DEBUG) && defined(_WINDOWS)
@@ -42,15 +44,30 @@ namespace Zeni {
     ticks_passed(0),
     fps(END_OF_TIME),
     fps_next(0),
+    m_seconds_per_tick(0.0f),
+    m_max_catch_up_steps(5u),
+    m_accumulated_seconds(0.0l),
+    m_interpolation(0.0f),
+    m_time_scale(1.0f),
+    m_frame_rate_cap(0.0f),
+    m_pipelined(false),
+    m_recorded(0),
     m_popup_menu_state_factory(new Popup_Menu_State_Factory),
     m_popup_pause_state_factory(new Popup_Pause_State_Factory)
 #if !defined(ANDROID) && !defined(NDEBUG)
     , m_console_active(false)
 #endif
   {
+    // Start worker Threads now rather than in the middle of the first perform_logic
+    get_Job_System();
+
+    m_command_lists[0] = new Command_List;
+    m_command_lists[1] = new Command_List;
   }
 
   Game::~Game() {
+    delete m_command_lists[0];
+    delete m_command_lists[1];
     delete m_popup_menu_state_factory;
     delete m_popup_pause_state_factory;
   }
@@ -322,15 +339,36 @@ namespace Zeni {
     return false;
   }
 
+  void Game::set_fixed_timestep(const float &ticks_per_second) {
+    assert(ticks_per_second >= 0.0f);
+    m_seconds_per_tick = ticks_per_second > 0.0f ? 1.0f / ticks_per_second : 0.0f;
+    m_accumulated_seconds = 0.0l;
+    m_interpolation = 0.0f;
+    m_tick_time.update();
+  }
+
+  void Game::set_max_catch_up_steps(const size_t &max_steps) {
+    assert(max_steps);
+    m_max_catch_up_steps = max_steps;
+  }
+
+  void Game::set_frame_rate_cap(const float &frames_per_second) {
+    assert(frames_per_second >= 0.0f);
+    m_frame_rate_cap = frames_per_second;
+  }
+
   void Game::run() {
 #ifdef TEST_NASTY_CONDITIONS
     Random random;
     const float time_scale = NASTY_MIN_RATE + (NASTY_MAX_RATE - NASTY_MIN_RATE) * random.frand_lte();
     Time::Second_Type time_used = Time::Second_Type();
     Time start_time;
+    m_time_scale = time_scale;
 #endif
 
     Time time_processed;
+    m_tick_time.update();
+    m_frame_time.update();
 
     for(;;) {
       const Time time_passed;
@@ -491,57 +529,265 @@ namespace Zeni {
       }
 #endif
 
+      const Time_HQ logic_start;
+      bool recorded = false;
+
+      if(m_pipelined && Window::is_enabled() && is_pipelinable())
+        recorded = perform_pipelined();
+      else {
+        m_recorded = 0;
+
 #ifdef TEST_NASTY_CONDITIONS
-      {
-        const Time current_time;
-        const Time::Second_Type time_passed = time_scale * current_time.get_seconds_since(start_time);
-        size_t step_count = 0u;
-        while(time_used + (1 / 60.0f) < time_passed) {
-          time_used += (1 / 60.0f);
-          perform_logic();
-          if(++step_count == NASTY_RATE_CUTOFF)
-            time_used = time_passed;
+        // Without a fixed timestep, simulate erratic ticks at a scaled 60 Hz; A fixed timestep scales its accumulator instead
+        if(m_seconds_per_tick <= 0.0f) {
+          const Time current_time;
+          const Time::Second_Type time_passed = time_scale * current_time.get_seconds_since(start_time);
+          size_t step_count = 0u;
+          while(time_used + (1 / 60.0f) < time_passed) {
+            time_used += (1 / 60.0f);
+            perform_logic();
+            if(++step_count == NASTY_RATE_CUTOFF)
+              time_used = time_passed;
+          }
+          if(!random.rand_lt(NASTY_ZERO_STEP_FREQUENCY))
+            perform_logic();
         }
-        if(!random.rand_lt(NASTY_ZERO_STEP_FREQUENCY))
-          perform_logic();
-      }
-#else
-      perform_logic();
+        else
 #endif
+          perform_timestep();
+
+        m_frame_stats.logic_seconds = float(logic_start.get_seconds_passed());
+      }
 
       get_Sound().update();
       get_Sound_Source_Pool().update();
 
-      if(Window::is_enabled()) {
-        Video &vr = get_Video();
+      if(Window::is_enabled() && !recorded)
+        render_frame(0, logic_start);
+
+      if(m_frame_rate_cap > 0.0f)
+        limit_frame_rate();
+    }
+  }
+
+  void Game::set_pipelined(const bool &pipelined) {
+    m_pipelined = pipelined;
+    m_recorded = 0;
+  }
+
+  class Game::Logic_Job : public Job {
+  public:
+    Logic_Job(Game &game_, Command_List &commands_)
+      : game(game_),
+      commands(commands_),
+      recorded(false),
+      quit(false),
+      failed(false),
+      failure("Zeni Game Logic Failed on a Worker Thread"),
+      logic_seconds(0.0f)
+    {
+    }
+
+    void function() {
+      const Time_HQ start;
+
+      try {
+        commands.clear();
+        game.perform_timestep();
+        recorded = game.record(commands);
+      }
+      catch(Quit_Event &) {
+        quit = true;
+      }
+      catch(Error &error) {
+        failed = true;
+        failure = error.msg;
+      }
+      catch(...) {
+        failed = true;
+      }
+
+      logic_seconds = float(start.get_seconds_passed());
+    }
+
+    Game &game;
+    Command_List &commands;
+    bool recorded;
+    bool quit;
+    bool failed;
+    String failure;
+    float logic_seconds;
+  };
+
+  void Game::perform_timestep() {
+    if(m_seconds_per_tick > 0.0f)
+      perform_fixed_logic();
+    else
+      perform_logic();
+  }
+
+  bool Game::record(Command_List &commands) {
+    Gamestate gs;
+#if !defined(ANDROID) && !defined(NDEBUG)
+    Gamestate console_child;
+#endif
+
+    {
+      if(m_states.empty())
+        throw Zero_Gamestate();
+
+#if !defined(ANDROID) && !defined(NDEBUG)
+      if(m_console_active) {
+        gs = get_console_instance();
+        console_child = get_console().get_child();
+      }
+      else
+#endif
+      {
+        gs = m_states.top();
+      }
+    }
+
+    return gs.record(commands);
+  }
+
+  bool Game::is_pipelinable() {
+    if(m_states.empty())
+      throw Zero_Gamestate();
+
+#if !defined(ANDROID) && !defined(NDEBUG)
+    if(m_console_active)
+      return false;
+#endif
+
+    return m_states.top().is_pipelinable();
+  }
+
+  bool Game::perform_pipelined() {
+    Command_List &commands = *m_command_lists[m_recorded == m_command_lists[0] ? 1 : 0];
+    const Time_HQ logic_start;
+
+    Logic_Job logic_job(*this, commands);
+    const Job_Handle logic = get_Job_System().run(logic_job);
+
+    if(m_recorded) {
+      try {
+        render_frame(m_recorded, m_recorded_logic_start);
+      }
+      catch(...) {
+        get_Job_System().wait(logic);
+        throw;
+      }
+    }
+
+    get_Job_System().wait(logic);
+
+    m_frame_stats.logic_seconds = logic_job.logic_seconds;
+
+    if(logic_job.quit)
+      throw Quit_Event();
+    if(logic_job.failed)
+      throw Error(logic_job.failure);
+
+    if(logic_job.recorded) {
+      m_recorded = &commands;
+      m_recorded_logic_start = logic_start;
+    }
+    else
+      m_recorded = 0;
+
+    return logic_job.recorded;
+  }
+
+  void Game::render_frame(const Command_List * const &commands, const Time_HQ &logic_start) {
+    const Time_HQ render_start;
+    Video &vr = get_Video();
+
+    Vertex_Buffer::next_cull_frame();
 
 #ifndef DISABLE_DX9
-        try
+    try
 #endif
-        {
-          if(vr.begin_prerender()) {
-            prerender();
-
-            if(vr.begin_render()) {
-              try {
-                render();
-              }
-              catch(...) {
-                vr.end_render();
-                throw;
-              }
-
-              vr.end_render();
+    {
+      if(vr.begin_prerender()) {
+        if(!commands)
+          prerender();
+
+        if(vr.begin_render()) {
+          try {
+            if(commands) {
+              commands->execute(vr);
+              calculate_fps();
             }
+            else
+              render();
           }
+          catch(...) {
+            vr.end_render();
+            throw;
+          }
+
+          vr.end_render();
         }
+      }
+    }
 #ifndef DISABLE_DX9
-        catch(Video_Device_Failure &) {
-          Video::destroy();
-        }
+    catch(Video_Device_Failure &) {
+      Video::destroy();
+    }
 #endif
+
+    const Time_HQ render_end;
+    m_frame_stats.render_seconds = float(render_end.get_seconds_since(render_start));
+    m_frame_stats.frame_seconds = float(render_end.get_seconds_since(m_frame_end));
+    m_frame_stats.latency_seconds = float(render_end.get_seconds_since(logic_start));
+    m_frame_end = render_end;
+  }
+
+  void Game::perform_fixed_logic() {
+    const Time_HQ current_time = get_Timer_HQ().get_time();
+    const long double seconds_passed = current_time.get_seconds_since(m_tick_time);
+    m_tick_time = current_time;
+
+    // A clock which stands still or steps backwards, as across a pause and resume, adds no time but still leaves an interpolation to report
+    if(seconds_passed > 0.0l)
+      m_accumulated_seconds += seconds_passed * m_time_scale;
+
+    for(size_t step_count = 0u; m_accumulated_seconds >= m_seconds_per_tick; ++step_count) {
+      if(step_count == m_max_catch_up_steps) {
+        // Drop the backlog so that slow ticks slow the simulation down rather than falling further behind every frame
+        m_accumulated_seconds = std::fmod(m_accumulated_seconds, static_cast<long double>(m_seconds_per_tick));
+        break;
+      }
+
+      m_accumulated_seconds -= m_seconds_per_tick;
+      perform_logic();
+
+      // perform_logic may have disabled the fixed timestep
+      if(m_seconds_per_tick <= 0.0f) {
+        m_interpolation = 0.0f;
+        return;
       }
     }
+
+    m_interpolation = float(m_accumulated_seconds / m_seconds_per_tick);
+  }
+
+  void Game::limit_frame_rate() {
+    const long double seconds_per_frame = 1.0l / m_frame_rate_cap;
+
+#ifndef ANDROID
+    // Sleep for whole milliseconds while comfortably early, since SDL_Delay may overshoot by about one
+    const long double seconds_remaining = seconds_per_frame - m_frame_time.get_seconds_passed();
+    if(seconds_remaining > 0.002l)
+      SDL_Delay(Uint32((seconds_remaining - 0.001l) * 1000.0l));
+
+    // Yield until the frame is complete
+    while(m_frame_time.get_seconds_passed() < seconds_per_frame)
+      SDL_Delay(0);
+#endif
+
+    m_frame_time.update();
   }
 
   void Game::push_Popup_Menu_State() {
@@ -17,7 +17,7 @@
 
 #include <zeni_rest.h>
 
-#include <list>
+#include <algorithm>
 
 #include <Zeni/Define.h>
 
@@ -28,13 +28,32 @@
 
 namespace Zeni {
 
+  static void render_widget_geometry(const Quadrilateral<Vertex2f_Color> &quad) {
+    if(Widget_Geometry * const geometry = Widget_Geometry::get_capturing())
+      geometry->add(quad);
+    else
+      get_Video().render(quad);
+  }
+
+  static void render_widget_geometry(const Line_Segment<Vertex2f_Color> &line_segment) {
+    if(Widget_Geometry * const geometry = Widget_Geometry::get_capturing())
+      geometry->add(line_segment);
+    else
+      get_Video().render(line_segment);
+  }
+
+  unsigned long Widget::g_revisions = 0u;
+
   Widget::~Widget() {
+    Widget_Grid::forget(*this);
+
     if(delete_m_renderer)
       delete m_renderer;
   }
 
   void Widget::set_editable(const bool &editable_) {
     m_editable = editable_;
+    invalidate();
   }
 
   void Widget::render_impl() const {
@@ -42,12 +61,26 @@ namespace Zeni {
       m_renderer->render_to(*this);
   }
 
+  unsigned long Widget::get_revision() const {
+    return m_revision;
+  }
+
   void Widget_Rectangle::set_upper_left(const Point2f &upper_left_) {
     m_upper_left = upper_left_;
+
+    if(const Widget * const widget = dynamic_cast<const Widget *>(this)) {
+      widget->invalidate();
+      Widget_Grid::invalidate(*widget);
+    }
   }
 
   void Widget_Rectangle::set_lower_right(const Point2f &lower_right_) {
     m_lower_right = lower_right_;
+
+    if(const Widget * const widget = dynamic_cast<const Widget *>(this)) {
+      widget->invalidate();
+      Widget_Grid::invalidate(*widget);
+    }
   }
 
   void Widget_Renderer_Text::render_to(const Widget &widget) {
@@ -61,7 +94,11 @@ namespace Zeni {
     const Point2f center = wrr->get_center();
     const float x = center.x;
     const float y = center.y - 0.5f * font.get_text_height();
-    font.render_text(text, Point2f(x, y), color, ZENI_CENTER);
+
+    if(Widget_Geometry * const geometry = Widget_Geometry::get_capturing())
+      geometry->add_text(font_name, text, Point2f(x, y), color, ZENI_CENTER);
+    else
+      font.render_text(text, Point2f(x, y), color, ZENI_CENTER);
   }
 
   Widget_Renderer_Text * Widget_Renderer_Text::get_duplicate() const {
@@ -79,7 +116,7 @@ namespace Zeni {
                                              Vertex2f_Color(wrr->get_lower_right(), color),
                                              Vertex2f_Color(wrr->get_upper_right(), color));
 
-    get_Video().render(quad);
+    render_widget_geometry(quad);
   }
 
   Widget_Renderer_Color * Widget_Renderer_Color::get_duplicate() const {
@@ -96,6 +133,12 @@ namespace Zeni {
                                          Vertex2f_Texture(wrr->get_lower_left(), tex_coord_ll),
                                          Vertex2f_Texture(wrr->get_lower_right(), tex_coord_lr),
                                          Vertex2f_Texture(wrr->get_upper_right(), tex_coord_ur));
+
+    if(Widget_Geometry * const geometry = Widget_Geometry::get_capturing()) {
+      geometry->add(quad, texture);
+      return;
+    }
+
     Material mat(texture);
     quad.lend_Material(&mat);
 
@@ -149,24 +192,22 @@ namespace Zeni {
     if(!cbr)
       throw Widget_Renderer_Wrong_Type();
 
-    Video &vr = get_Video();
-
     Vertex2f_Color ul(cbr->get_upper_left(), border_color);
     Vertex2f_Color ll(cbr->get_lower_left(), border_color);
     Vertex2f_Color lr(cbr->get_lower_right(), border_color);
     Vertex2f_Color ur(cbr->get_upper_right(), border_color);
 
     Line_Segment<Vertex2f_Color> line_seg(ul, ll);
-    vr.render(line_seg);
+    render_widget_geometry(line_seg);
 
     line_seg.a = lr;
-    vr.render(line_seg);
+    render_widget_geometry(line_seg);
 
     line_seg.b = ur;
-    vr.render(line_seg);
+    render_widget_geometry(line_seg);
 
     line_seg.a = ul;
-    vr.render(line_seg);
+    render_widget_geometry(line_seg);
 
     if(cbr->is_checked() || cbr->is_toggling()) {
       Color cc = check_color;
@@ -184,11 +225,11 @@ namespace Zeni {
 
       line_seg.a = ul;
       line_seg.b = lr;
-      vr.render(line_seg);
+      render_widget_geometry(line_seg);
 
       line_seg.a = ll;
       line_seg.b = ur;
-      vr.render(line_seg);
+      render_widget_geometry(line_seg);
     }
   }
 
@@ -202,8 +243,6 @@ namespace Zeni {
     if(!sr)
       throw Widget_Renderer_Wrong_Type();
 
-    Video &vr = get_Video();
-
     const Point3f p0(sr->get_end_point_a());
     const Point3f p1(sr->get_end_point_b());
     const Vector3f v = p1 - p0;
@@ -215,14 +254,14 @@ namespace Zeni {
     Line_Segment<Vertex2f_Color> line_seg(Vertex2f_Color(Point2f(midpt - n2), slider_color),
                                           Vertex2f_Color(Point2f(midpt + n2), slider_color));
 
-    vr.render(line_seg);
+    render_widget_geometry(line_seg);
 
     line_seg.a.position = Point3f(p0);
     line_seg.a.set_Color(line_color);
     line_seg.b.position = Point3f(p1);
     line_seg.b.set_Color(line_color);
 
-    vr.render(line_seg);
+    render_widget_geometry(line_seg);
   }
 
   Widget_Renderer_Slider * Widget_Renderer_Slider::get_duplicate() const {
@@ -234,6 +273,7 @@ namespace Zeni {
     if(!is_editable() || button != SDL_BUTTON_LEFT)
       return;
 
+    const State prev_state = m_state;
     const bool inside = is_inside(pos);
 
     if(down)
@@ -269,6 +309,9 @@ namespace Zeni {
 
       set_busy(false);
     }
+
+    if(m_state != prev_state)
+      invalidate();
 #endif
   }
   
@@ -277,6 +320,8 @@ namespace Zeni {
     if(!is_editable())
       return;
 
+    const State prev_state = m_state;
+
     if(m_state == UNACTIONABLE && !get_Game().get_mouse_button_state(SDL_BUTTON_LEFT))
       m_state = NORMAL;
 
@@ -304,6 +349,9 @@ namespace Zeni {
         }
       }
     }
+
+    if(m_state != prev_state)
+      invalidate();
 #endif
   }
 
@@ -315,22 +363,27 @@ namespace Zeni {
   void Check_Box::on_accept() {
     m_checked = !m_checked;
     m_toggling = false;
+    invalidate();
   }
 
   void Check_Box::on_click() {
     m_toggling = true;
+    invalidate();
   }
 
   void Check_Box::on_unstray() {
     m_toggling = true;
+    invalidate();
   }
 
   void Check_Box::on_reject() {
     m_toggling = false;
+    invalidate();
   }
 
   void Check_Box::on_stray() {
     m_toggling = false;
+    invalidate();
   }
 
   void Radio_Button::on_accept() {
@@ -349,14 +402,32 @@ namespace Zeni {
 
     for(std::set<Radio_Button *>::iterator it = m_radio_buttons.begin(); it != m_radio_buttons.end(); ++it)
       (*it)->on_mouse_button(pos, down, button);
+
+    m_pointer = pos;
   }
     
   void Radio_Button_Set::on_mouse_motion(const Point2i &pos) {
     if(!is_editable())
       return;
 
-    for(std::set<Radio_Button *>::iterator it = m_radio_buttons.begin(); it != m_radio_buttons.end(); ++it)
-      (*it)->on_mouse_motion(pos);
+    if(!m_grid.is_current()) {
+      /// After a layout change, every Radio_Button must learn where the pointer is
+      for(std::set<Radio_Button *>::iterator it = m_radio_buttons.begin(); it != m_radio_buttons.end(); ++it)
+        (*it)->on_mouse_motion(pos);
+
+      m_indexed.assign(m_radio_buttons.begin(), m_radio_buttons.end());
+      m_grid.build(m_indexed);
+    }
+    else {
+      /// Only Radio_Buttons under the pointer, or just left by it, can change
+      m_hits.clear();
+      m_grid.find(m_hits, pos, m_pointer);
+
+      for(std::vector<size_t>::const_iterator it = m_hits.begin(); it != m_hits.end(); ++it)
+        m_indexed[*it]->on_mouse_motion(pos);
+    }
+
+    m_pointer = pos;
   }
 
   void Radio_Button_Set::render_impl() const {
@@ -364,6 +435,13 @@ namespace Zeni {
       (*it)->render_impl();
   }
 
+  unsigned long Radio_Button_Set::get_revision() const {
+    unsigned long revision = Widget::get_revision();
+    for(std::set<Radio_Button *>::const_iterator it = m_radio_buttons.begin(); it != m_radio_buttons.end(); ++it)
+      revision = std::max(revision, (*it)->get_revision());
+    return revision;
+  }
+
   Slider::Slider(const Point2f &end_point_a_, const Point2f &end_point_b_,
                  const float &slider_radius_,
                  const float &slider_position_)
@@ -390,6 +468,7 @@ namespace Zeni {
         m_down = true;
         m_backup_position = m_slider_position;
         m_slider_position = test.second;
+        invalidate();
         on_slide();
 
         set_busy(true);
@@ -411,14 +490,13 @@ namespace Zeni {
       const Point3f mouse_pos(float(pos.x), float(pos.y), 0.0f);
 
       const std::pair<float, float> test = m_line_segment.nearest_point(mouse_pos);
-      if(test.first < m_slider_radius) {
+      if(test.first < m_slider_radius)
         m_slider_position = test.second;
-        on_slide();
-      }
-      else {
+      else
         m_slider_position = m_backup_position;
-        on_slide();
-      }
+
+      invalidate();
+      on_slide();
     }
   }
   
@@ -431,6 +509,7 @@ namespace Zeni {
       const std::pair<float, float> test = get_line_segment().nearest_point(mouse_pos);
       if(test.first < get_slider_radius()) {
         m_slider_position = std::max(0.0f, std::min(1.0f, m_slider_position + m_mouse_wheel_continuous_rate * up_));
+        invalidate();
 
         on_slide();
       }
@@ -627,6 +706,7 @@ namespace Zeni {
       m_option = size_t(it - m_options.begin());
 
     m_normal_button.text = m_options[m_option];
+    invalidate();
   }
 
   void Selector::on_mouse_button(const Point2i &pos, const bool &down, const int &button) {
@@ -719,6 +799,17 @@ namespace Zeni {
   void Selector::render_impl() const {
     if(!m_selected)
       m_normal_button.render_impl();
+    else if(Widget_Geometry * const geometry = Widget_Geometry::get_capturing()) {
+      geometry->translate(Vector3f(0.0f, -vertical_offset(), 0.0f));
+
+      for(size_t i = view_start; i != view_end; ++i)
+        m_selector_buttons[i]->render_impl();
+
+      geometry->translate(Vector3f(0.0f, vertical_offset(), 0.0f));
+
+      if(view_hidden)
+        m_selector_slider.render_impl();
+    }
     else {
       Video &vr = get_Video();
       vr.push_world_stack();
@@ -734,6 +825,13 @@ namespace Zeni {
     }
   }
 
+  unsigned long Selector::get_revision() const {
+    unsigned long revision = std::max(Widget::get_revision(), m_normal_button.get_revision());
+    for(std::vector<Selector_Button *>::const_iterator it = m_selector_buttons.begin(); it != m_selector_buttons.end(); ++it)
+      revision = std::max(revision, (*it)->get_revision());
+    return std::max(revision, m_selector_slider.get_revision());
+  }
+
   float Selector::button_height() const {
     const Point2f &ul = m_normal_button.get_upper_left();
     const Point2f &lr = m_normal_button.get_lower_right();
@@ -793,6 +891,8 @@ namespace Zeni {
                                                  int(view_offset + needed_below - slots_below)));
       m_selector_slider.set_value(int(view_offset));
     }
+
+    invalidate();
   }
 
   std::pair<Point2f, Point2f> Selector::visible_region() const {
@@ -811,6 +911,7 @@ namespace Zeni {
     m_selector_buttons.push_back(new Selector_Button(*this, option,
                                                      Point2f(ul.x, ul.y + vertical_offset),
                                                      Point2f(lr.x, lr.y + vertical_offset)));
+    invalidate();
   }
 
   void Selector::build_selector_buttons() {
@@ -824,6 +925,7 @@ namespace Zeni {
     for(std::vector<Selector_Button *>::const_iterator it = m_selector_buttons.begin(); it != m_selector_buttons.end(); ++it)
       delete *it;
     m_selector_buttons.clear();
+    invalidate();
   }
 
   Text_Box::Text_Box(const Point2f &upper_left_, const Point2f &lower_right_,
@@ -836,7 +938,8 @@ namespace Zeni {
     m_last_seek(0),
     m_justify(justify_),
     m_tab_spaces(tab_spaces_),
-    m_cursor_index(-1, -1)
+    m_cursor_index(-1, -1),
+    m_cursor_shown(false)
   {
     Fonts::remove_post_reinit(&g_reinit);
 
@@ -878,14 +981,9 @@ namespace Zeni {
         case SDLK_BACKSPACE:
           if(mod_none)
           {
-            const String &t = get_text();
-
             if(m_edit_pos > 0) {
-              String t0 = t.substr(0u, m_edit_pos - 1u);
-              String t1 = t.substr(size_t(m_edit_pos), t.size() - m_edit_pos);
-
-              m_text.text = t0 + t1;
-              format();
+              m_text.text.erase(m_edit_pos - 1u, 1u);
+              reformat(m_edit_pos - 1u, 1u, 0u);
               seek(m_edit_pos - 1);
 
               on_change();
@@ -898,11 +996,8 @@ namespace Zeni {
             const String &t = get_text();
 
             if(m_edit_pos < int(t.size())) {
-              String t0 = t.substr(0u, size_t(m_edit_pos));
-              String t1 = t.substr(m_edit_pos + 1u, t.size() - m_edit_pos - 1);
-
-              m_text.text = t0 + t1;
-              format();
+              m_text.text.erase(size_t(m_edit_pos), 1u);
+              reformat(size_t(m_edit_pos), 1u, 0u);
               seek(m_edit_pos);
 
               on_change();
@@ -967,14 +1062,10 @@ namespace Zeni {
           if(mod_none || mod_shift_only)
           {
             const char c = Gamestate_Base::to_char(keysym);
-            const String &t = get_text();
-            String t0 = t.substr(0u, size_t(m_edit_pos));
-            String t1 = t.substr(size_t(m_edit_pos), t.size() - m_edit_pos);
-            String next = clean_string(t0 + c + t1);
 
-            if(next.size() != t.size()) {
-              m_text.text = next;
-              format();
+            if(!clean_string(String(1u, c)).empty()) {
+              m_text.text.insert(size_t(m_edit_pos), 1u, c);
+              reformat(size_t(m_edit_pos), 0u, 1u);
               seek(m_edit_pos + 1);
 
               on_change();
@@ -1011,8 +1102,15 @@ namespace Zeni {
   }
 
   void Text_Box::on_accept() {
+    /// Binary search for the first line beginning below the cursor
     size_t j = 0, jend = m_lines.size();
-    for(; j != jend && m_cursor_pos.y > m_lines[j].glyph_top; ++j);
+    while(j != jend) {
+      const size_t mid = (j + jend) / 2u;
+      if(m_cursor_pos.y > m_lines[mid].glyph_top)
+        j = mid + 1u;
+      else
+        jend = mid;
+    }
     --j;
 
     /// BEGIN JUSTIFICATION FIX
@@ -1034,8 +1132,9 @@ namespace Zeni {
 
     /// END JUSTIFICATION FIX
 
-    int i = 0, iend = int(m_lines[j].unformatted_glyph_sides.size());
-    for(; i != iend && m_cursor_pos.x > x_pos + m_lines[j].unformatted_glyph_sides[size_t(i)]; ++i);
+    const std::vector<float> &sides = m_lines[j].unformatted_glyph_sides;
+    int i = int(std::lower_bound(sides.begin(), sides.end(), m_cursor_pos.x - x_pos) - sides.begin());
+    const int iend = int(sides.size());
     if(i) // Can be negative if using ZENI_CENTER or ZENI_RIGHT justification
       --i;
 
@@ -1050,6 +1149,8 @@ namespace Zeni {
     for(size_t k = 0; k < j; ++k)
       m_edit_pos += int(m_lines[k].unformatted.size());
 
+    invalidate();
+
 #ifdef _DEBUG
     {
       const size_t size = get_text().size();
@@ -1076,8 +1177,6 @@ namespace Zeni {
   void Text_Box::render_impl() const {
     m_bg_renderer->render_to(*this);
 
-    Video &vr = get_Video();
-
     const Font &f = get_Font();
     const Color &c = m_text.color;
 
@@ -1089,14 +1188,18 @@ namespace Zeni {
     else
       x_pos = (get_upper_left().x + get_lower_right().x) / 2.0f;
 
+    Widget_Geometry * const geometry = Widget_Geometry::get_capturing();
+
     const float &y_offset = get_upper_left().y;
-    for(size_t i = 0u, iend = m_lines.size(); i != iend; ++i)
-      f.render_text(m_lines[i].formatted, Point2f(x_pos, y_offset + m_lines[i].glyph_top), c, m_justify);
+    for(size_t i = 0u, iend = m_lines.size(); i != iend; ++i) {
+      if(geometry)
+        geometry->add_text(m_text.font_name, m_lines[i].formatted, Point2f(x_pos, y_offset + m_lines[i].glyph_top), c, m_justify);
+      else
+        f.render_text(m_lines[i].formatted, Point2f(x_pos, y_offset + m_lines[i].glyph_top), c, m_justify);
+    }
 
-    if(m_cursor_index.x != -1 && m_cursor_index.y != -1
-      && !((get_Timer().get_time().get_ticks_since(m_last_seek) / SDL_DEFAULT_REPEAT_DELAY) & 1) // HACK: render every other second
-       )
-    {
+    m_cursor_shown = is_cursor_shown();
+    if(m_cursor_shown) {
       Point2f p0(x_pos + m_lines[size_t(m_cursor_index.y)].unformatted_glyph_sides[size_t(m_cursor_index.x)],
                  get_upper_left().y + m_lines[size_t(m_cursor_index.y)].glyph_top);
       if(m_justify == ZENI_RIGHT)
@@ -1113,120 +1216,265 @@ namespace Zeni {
       const Vertex2f_Color v3(Point2f(p0.x + epsilon, p0.y), c);
 
       const Quadrilateral<Vertex2f_Color> visible_cursor(v0, v1, v2, v3);
-      vr.render(visible_cursor);
+      render_widget_geometry(visible_cursor);
     }
   }
 
+  unsigned long Text_Box::get_revision() const {
+    /// The blinking of the cursor changes the Text_Box without any event
+    if(m_cursor_shown != is_cursor_shown())
+      invalidate();
+
+    return Widget::get_revision();
+  }
+
+  void Text_Box::Line::swap(Line &rhs) {
+    unformatted.swap(rhs.unformatted);
+    unformatted_glyph_sides.swap(rhs.unformatted_glyph_sides);
+    formatted.swap(rhs.formatted);
+    std::swap(glyph_top, rhs.glyph_top);
+    std::swap(fpsplit, rhs.fpsplit);
+    std::swap(endled, rhs.endled);
+  }
+
   void Text_Box::format() {
+    for(int c = 0; c != 256; ++c)
+      m_advances[c] = -1.0f;
+
     m_lines.clear();
     m_lines.push_back(Line());
 
-    const String t = get_text();
-    const Font &f = get_Font();
-    const float mll = max_line_width();
+    const String &t = get_text();
+    for(size_t pos = 0u; pos != t.size(); ) {
+      const Word word = next_word(pos);
+      append_word(m_lines, word);
+      pos = word.end;
+    }
 
-    if(t.empty())
-      return;
+    finish_lines(m_lines);
+    place_lines(0u);
+  }
 
-    std::list<Word> words;
-    Word next_word;
+  void Text_Box::reformat(const size_t &edit_pos, const size_t &removed, const size_t &inserted) {
+    const String &t = get_text();
 
-    for(unsigned int i = 0, iend = static_cast<unsigned int>(t.size()); i != iend; ++i) {
-      const Word::Type type = isspace(t[i]) ? Word::SPACE : Word::WORD;
+    if(t.empty() || m_lines.empty()) {
+      format();
+      return;
+    }
 
-      if(next_word.type) {
-        if(next_word.type != type || t[i] == '\n') {
-          words.push_back(next_word);
-          next_word = Word(type);
+    /** Lines before the one preceding the edited word cannot change, since
+     *  only the first word of a line decides where the line before it ends.
+     */
+    size_t word_start = edit_pos;
+    while(word_start && !isspace(t[word_start - 1u]))
+      --word_start;
+
+    size_t first = 0u;
+    for(size_t j = 0u, start = 0u; j != m_lines.size() && start <= word_start; ++j) {
+      first = j;
+      start += m_lines[j].unformatted.size();
+    }
+    if(first)
+      --first;
+
+    /// Empty lines, and lines following them, are left by words too narrow to split, so begin before any such line
+    while(first && (m_lines[first].unformatted.empty() || m_lines[first - 1u].unformatted.empty()))
+      --first;
+
+    size_t first_start = 0u;
+    for(size_t j = 0u; j != first; ++j)
+      first_start += m_lines[j].unformatted.size();
+
+    /** Lay out from there until a new line begins, beyond the edit, where an
+     *  old line began.  Everything from that line on is laid out as before.
+     *  For the same reason as above, neither side of a match may be or
+     *  follow an empty line.
+     */
+    std::vector<Line> lines(first && t[first_start] == '\n' ? 0u : 1u); ///< A line beginning with '\n' begins itself
+    size_t resume = m_lines.size();
+    size_t old_line = first;
+    size_t old_start = first_start;
+    size_t counted = 0u;
+    size_t last_start = first_start;
+
+    for(size_t pos = first_start; pos != t.size(); ) {
+      const Word word = next_word(pos);
+      append_word(lines, word);
+      pos = word.end;
+
+      for(; counted + 1u < lines.size(); ++counted)
+        last_start += lines[counted].unformatted.size();
+
+      if(counted && last_start >= edit_pos + inserted && !lines[counted - 1u].unformatted.empty() && !lines[counted].unformatted.empty()) {
+        for(; old_line != m_lines.size() && old_start + inserted < last_start + removed; ++old_line)
+          old_start += m_lines[old_line].unformatted.size();
+
+        if(old_line != m_lines.size() && old_start + inserted == last_start + removed &&
+           !m_lines[old_line].unformatted.empty() && (!old_line || !m_lines[old_line - 1u].unformatted.empty()))
+        {
+          resume = old_line;
+          lines.pop_back();
+          break;
         }
       }
-      else
-        next_word.type = type;
+    }
 
-      next_word.unformatted += t[i];
+    finish_lines(lines);
 
-      const float next_width = get_text_width(f, next_word.unformatted);
-      next_word.unformatted_glyph_sides.push_back(next_width);
-      if(type != Word::SPACE && next_width > mll)
-        next_word.splittable = true;
+    /// Splice the new lines in place of [first, resume), swapping rather than copying
+    const size_t replaced = resume - first;
+    if(lines.size() > replaced) {
+      const size_t grow = lines.size() - replaced;
+      m_lines.resize(m_lines.size() + grow);
+      for(size_t j = m_lines.size() - 1u; j >= resume + grow; --j)
+        m_lines[j].swap(m_lines[j - grow]);
+    }
+    else if(lines.size() < replaced) {
+      const size_t shrink = replaced - lines.size();
+      for(size_t j = resume; j != m_lines.size(); ++j)
+        m_lines[j - shrink].swap(m_lines[j]);
+      m_lines.resize(m_lines.size() - shrink);
     }
-    if(next_word.type != Word::NONSENSE)
-      words.push_back(next_word);
+    for(size_t j = 0u; j != lines.size(); ++j)
+      m_lines[first + j].swap(lines[j]);
 
-    for(std::list<Word>::iterator it = words.begin(); it != words.end(); ++it)
-      append_word(*it);
+    place_lines(first);
+  }
 
-    float glyph_top = 0.0f;
-    for(std::vector<Line>::iterator it = m_lines.begin(); it != m_lines.end(); ++it) {
-      it->formatted = untablinebreak(it->unformatted);
-      if(it->fpsplit)
-        it->formatted += "-";
-      it->glyph_top = glyph_top;
-      if(!it->unformatted.empty() && it->unformatted[0] == '\n')
-        it->endled = true;
+  void Text_Box::replace_text(const String &text_) {
+    const String &t = get_text();
+
+    const size_t shorter = std::min(t.size(), text_.size());
+    size_t prefix = 0u;
+    while(prefix != shorter && t[prefix] == text_[prefix])
+      ++prefix;
+    size_t suffix = 0u;
+    while(prefix + suffix != shorter && t[t.size() - suffix - 1u] == text_[text_.size() - suffix - 1u])
+      ++suffix;
+
+    if(prefix == t.size() && prefix == text_.size())
+      return;
+
+    const size_t removed = t.size() - prefix - suffix;
+    const size_t inserted = text_.size() - prefix - suffix;
 
-      glyph_top += f.get_text_height();
+    m_text.text = text_;
+    reformat(prefix, removed, inserted);
+  }
+
+  Text_Box::Word Text_Box::next_word(const size_t &begin) {
+    const String &t = get_text();
+
+    Word word(isspace(t[begin]) ? Word::SPACE : Word::WORD);
+    word.begin = begin;
+
+    float width = 0.0f;
+    for(word.end = begin; word.end != t.size(); ++word.end) {
+      const char &c = t[word.end];
+      const Word::Type type = isspace(c) ? Word::SPACE : Word::WORD;
+
+      if(word.end != begin && (type != word.type || c == '\n'))
+        break;
+
+      width += get_advance(c);
     }
+
+    word.splittable = word.type != Word::SPACE && width > max_line_width();
+
+    return word;
   }
 
-  void Text_Box::append_word(const Word &word) {
-    const Font &f = get_Font();
+  void Text_Box::append_word(std::vector<Line> &lines, const Word &word) {
+    const String &t = get_text();
     const float mll = max_line_width();
 
-    if(!word.unformatted.empty() && word.unformatted[0] == '\n')
-      m_lines.push_back(Line());
+    if(word.begin != word.end && t[word.begin] == '\n')
+      lines.push_back(Line());
 
-    Line &l = *m_lines.rbegin();
-    float next_sum = get_text_width(f, l.unformatted + word.unformatted);
+    Line &l = *lines.rbegin();
+    const float line_width = *l.unformatted_glyph_sides.rbegin();
+
+    float next_sum = line_width;
+    for(size_t i = word.begin; i != word.end; ++i)
+      next_sum += get_advance(t[i]);
 
     if(word.type != Word::SPACE && next_sum > mll && !word.fpsplit) {
       if(word.splittable) {
-        size_t i = 0u, iend = word.unformatted.size();
-        for(; i != iend && get_text_width(f, l.unformatted + word.unformatted.substr(0u, i) + "-") < mll; ++i);
+        const float hyphen = get_advance('-');
+
+        size_t i = 0u, iend = word.end - word.begin;
+        for(float width = line_width; i != iend && width + hyphen < mll; ++i)
+          width += get_advance(t[word.begin + i]);
         if(!l.unformatted.empty())
           --i;
         if(i != 0u && i != size_t(-1)) {
           {
             Word first_word(word.type);
-            first_word.unformatted = word.unformatted.substr(0, i);
-            for(size_t j = 1u, jend = first_word.unformatted.size(); j <= jend; ++j)
-              first_word.unformatted_glyph_sides.push_back(get_text_width(f, first_word.unformatted.substr(0u, j)));
+            first_word.begin = word.begin;
+            first_word.end = word.begin + i;
             first_word.fpsplit = true;
-            append_word(first_word);
+            append_word(lines, first_word);
           }
 
           {
             Word second_word(word.type);
-            second_word.unformatted = word.unformatted.substr(i, word.unformatted.size() - i);
-            for(size_t j = 1u, jend = second_word.unformatted.size(); j <= jend; ++j)
-              second_word.unformatted_glyph_sides.push_back(get_text_width(f, second_word.unformatted.substr(0u, j)));
-            second_word.splittable = get_text_width(f, second_word.unformatted) > mll;
-            append_word(second_word);
+            second_word.begin = word.begin + i;
+            second_word.end = word.end;
+            float width = 0.0f;
+            for(size_t j = second_word.begin; j != second_word.end; ++j)
+              width += get_advance(t[j]);
+            second_word.splittable = width > mll;
+            append_word(lines, second_word);
           }
         }
         else {
           Word only_word(word);
           only_word.fpsplit = l.unformatted.empty();
-          m_lines.push_back(Line());
-          append_word(only_word);
+          lines.push_back(Line());
+          append_word(lines, only_word);
           return;
         }
       }
       else {
-        m_lines.push_back(Line());
-        append_word(word);
+        lines.push_back(Line());
+        append_word(lines, word);
       }
     }
     else {
-      for(unsigned int i = 0u, iend = static_cast<unsigned int>(word.unformatted.size()); i != iend; ++i) {
-        l.unformatted += word.unformatted[i];
-        l.unformatted_glyph_sides.push_back(get_text_width(f, l.unformatted));
+      float width = line_width;
+      for(size_t i = word.begin; i != word.end; ++i) {
+        width += get_advance(t[i]);
+        l.unformatted += t[i];
+        l.unformatted_glyph_sides.push_back(width);
       }
 
       l.fpsplit = word.fpsplit;
     }
   }
 
+  void Text_Box::finish_lines(std::vector<Line> &lines) const {
+    for(std::vector<Line>::iterator it = lines.begin(); it != lines.end(); ++it) {
+      it->formatted = untablinebreak(it->unformatted);
+      if(it->fpsplit)
+        it->formatted += "-";
+      if(!it->unformatted.empty() && it->unformatted[0] == '\n')
+        it->endled = true;
+    }
+  }
+
+  void Text_Box::place_lines(const size_t &first) {
+    const float text_height = get_Font().get_text_height();
+
+    float glyph_top = first ? m_lines[first - 1u].glyph_top + text_height : 0.0f;
+    for(size_t j = first; j != m_lines.size(); ++j) {
+      m_lines[j].glyph_top = glyph_top;
+      glyph_top += text_height;
+    }
+
+    invalidate();
+  }
+
   void Text_Box::set_editable(const bool &editable_) {
     Widget::set_editable(editable_);
     format();
@@ -1300,6 +1548,7 @@ namespace Zeni {
     m_cursor_index.y = Sint32(j);
 
     m_last_seek = get_Timer().get_time();
+    invalidate();
   }
 
   void Text_Box::seek_cursor(const int &cursor_pos) {
@@ -1329,6 +1578,7 @@ namespace Zeni {
     }
 
     m_last_seek = get_Timer().get_time();
+    invalidate();
   }
   
   void Text_Box::set_focus(const bool &value) {
@@ -1374,20 +1624,29 @@ namespace Zeni {
     return untabbed_text;
   }
 
-  float Text_Box::get_text_width(const Font &font, const String &text) {
-    const String untabbed_text = untablinebreak(text);
+  float Text_Box::get_advance(const char &c) {
+    float &advance = m_advances[static_cast<unsigned char>(c)];
 
-    if(font.get_text_width(" "))
-      return font.get_text_width(untabbed_text);
+    if(advance < 0.0f) {
+      /// As in untablinebreak, with spaces measured as '.' for Fonts that give them no width
+      if(c == '\t')
+        advance = m_tab_spaces * get_advance(' ');
+      else if(c <= 0x1F)
+        advance = 0.0f;
+      else {
+        const Font &font = get_Font();
+        advance = font.get_text_width(String(1u, c));
+        if(c == ' ' && !advance)
+          advance = font.get_text_width(".");
+      }
+    }
 
-    String fake_text;
-    for(String::const_iterator it = untabbed_text.begin(); it != untabbed_text.end(); ++it)
-      if(*it != ' ')
-        fake_text += *it;
-      else
-        fake_text += '.';
+    return advance;
+  }
 
-    return font.get_text_width(fake_text);
+  bool Text_Box::is_cursor_shown() const {
+    return m_cursor_index.x != -1 && m_cursor_index.y != -1
+      && !((get_Timer().get_time().get_ticks_since(m_last_seek) / SDL_DEFAULT_REPEAT_DELAY) & 1); // HACK: render every other second
   }
 
   float Text_Box::max_line_width() const {
@@ -1468,15 +1727,37 @@ namespace Zeni {
     m_widget->render();
   }
 
+  unsigned long Widget_Input_Repeater::get_revision() const {
+    return std::max(Widget::get_revision(), m_widget->get_revision());
+  }
+
   static bool widget_layer_less(const Widget * const &lhs, const Widget * const &rhs) {
     return lhs->get_layer() < rhs->get_layer();
   }
 
+  Widgets::~Widgets() {
+    delete m_geometry;
+  }
+
+  void Widgets::set_retained(const bool &retained) {
+    m_retained = retained;
+
+    if(!m_retained) {
+      delete m_geometry;
+      m_geometry = 0;
+    }
+
+    m_geometry_revision = 0u;
+    m_render_stats = Render_Stats();
+  }
+
 #ifndef ANDROID
   void Widgets::on_key(const SDL_Keysym &keysym, const bool &down) {
     if(!is_editable())
       return;
 
+    flush_motion();
+
     if(m_busy_one) {
       m_busy_one->on_key(keysym, down);
 
@@ -1486,7 +1767,7 @@ namespace Zeni {
       }
     }
     else {
-      std::sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
+      std::stable_sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
 
       for(std::vector<Widget *>::iterator it = m_widgets.begin(); it != m_widgets.end(); ++it) {
         (*it)->on_key(keysym, down);
@@ -1504,6 +1785,9 @@ namespace Zeni {
     if(!is_editable())
       return;
 
+    flush_motion();
+    m_pointer = pos;
+
     if(m_busy_one) {
       m_busy_one->on_mouse_button(pos, down, button);
 
@@ -1513,7 +1797,7 @@ namespace Zeni {
       }
     }
     else {
-      std::sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
+      std::stable_sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
 
       for(std::vector<Widget *>::iterator it = m_widgets.begin(); it != m_widgets.end(); ++it) {
         (*it)->on_mouse_button(pos, down, button);
@@ -1530,26 +1814,12 @@ namespace Zeni {
     if(!is_editable())
       return;
 
-    if(m_busy_one) {
-      m_busy_one->on_mouse_motion(pos);
-
-      if(!m_busy_one->is_busy()) {
-        m_busy_one = 0;
-        set_busy(false);
-      }
-    }
-    else {
-      std::sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
-
-      for(std::vector<Widget *>::iterator it = m_widgets.begin(); it != m_widgets.end(); ++it) {
-        (*it)->on_mouse_motion(pos);
-
-        if(!m_busy_one && (*it)->is_busy()) {
-          m_busy_one = *it;
-          set_busy(true);
-        }
-      }
+    if(m_coalescing) {
+      m_pending_motion = pos;
+      m_motion_pending = true;
     }
+    else
+      dispatch_motion(pos);
   }
 
 #if SDL_VERSION_ATLEAST(2,0,0)
@@ -1557,6 +1827,9 @@ namespace Zeni {
     if(!is_editable())
       return;
 
+    flush_motion();
+    m_pointer = pos;
+
     if(m_busy_one) {
       m_busy_one->on_mouse_wheel(pos, up);
 
@@ -1566,7 +1839,7 @@ namespace Zeni {
       }
     }
     else {
-      std::sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
+      std::stable_sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
 
       for(std::vector<Widget *>::iterator it = m_widgets.begin(); it != m_widgets.end(); ++it) {
         (*it)->on_mouse_wheel(pos, up);
@@ -1581,17 +1854,131 @@ namespace Zeni {
 #endif
 
   void Widgets::perform_logic() {
-    std::sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
+    flush_motion();
+
+    std::stable_sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
 
     for(std::vector<Widget *>::const_reverse_iterator it = m_widgets.rbegin(), iend = m_widgets.rend(); it != iend; ++it)
       (*it)->perform_logic();
   }
 
   void Widgets::render_impl() const {
-    std::sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
+    std::stable_sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
 
-    for(std::vector<Widget *>::const_reverse_iterator it = m_widgets.rbegin(), iend = m_widgets.rend(); it != iend; ++it)
-      (*it)->render();
+    /// Nested Widgets join whatever is capturing them
+    if(!m_retained || Widget_Geometry::get_capturing()) {
+      for(std::vector<Widget *>::const_reverse_iterator it = m_widgets.rbegin(), iend = m_widgets.rend(); it != iend; ++it)
+        (*it)->render();
+      return;
+    }
+
+    unsigned long revision = Widget::get_revision();
+    m_render_stats.dirty = revision > m_geometry_revision;
+    for(std::vector<Widget *>::const_iterator it = m_widgets.begin(), iend = m_widgets.end(); it != iend; ++it) {
+      const unsigned long widget_revision = (*it)->get_revision();
+      if(widget_revision > m_geometry_revision) {
+        ++m_render_stats.dirty;
+        revision = std::max(revision, widget_revision);
+      }
+    }
+
+    if(!m_geometry)
+      m_geometry = new Widget_Geometry;
+
+    m_render_stats.rebuilt = m_render_stats.dirty || !m_geometry->is_current();
+    if(m_render_stats.rebuilt) {
+      m_geometry->begin_capture();
+
+      try {
+        for(std::vector<Widget *>::const_reverse_iterator it = m_widgets.rbegin(), iend = m_widgets.rend(); it != iend; ++it)
+          (*it)->render();
+      }
+      catch(...) {
+        m_geometry->end_capture();
+        m_geometry_revision = 0u;
+        throw;
+      }
+
+      m_geometry->end_capture();
+      m_geometry_revision = revision;
+    }
+
+    if(m_geometry->is_current()) {
+      m_geometry->render();
+      m_render_stats.draws = m_geometry->get_num_draws();
+    }
+    else {
+      /// A Font evicted glyphs mid-capture, or cannot batch at all
+      for(std::vector<Widget *>::const_reverse_iterator it = m_widgets.rbegin(), iend = m_widgets.rend(); it != iend; ++it)
+        (*it)->render();
+      m_render_stats.draws = 0u;
+    }
+  }
+
+  void Widgets::set_coalescing_motion(const bool &coalescing) {
+    if(!coalescing)
+      flush_motion();
+
+    m_coalescing = coalescing;
+  }
+
+  void Widgets::flush_motion() {
+    if(m_motion_pending) {
+      m_motion_pending = false;
+      dispatch_motion(m_pending_motion);
+    }
+  }
+
+  void Widgets::dispatch_motion(const Point2i &pos) {
+    if(m_busy_one) {
+      m_busy_one->on_mouse_motion(pos);
+
+      if(!m_busy_one->is_busy()) {
+        m_busy_one = 0;
+        set_busy(false);
+      }
+    }
+    else {
+      std::stable_sort(m_widgets.begin(), m_widgets.end(), &widget_layer_less);
+
+      if(!m_grid.is_current()) {
+        /// After a layout change, every Widget must learn where the pointer is
+        for(std::vector<Widget *>::iterator it = m_widgets.begin(); it != m_widgets.end(); ++it) {
+          (*it)->on_mouse_motion(pos);
+
+          if(!m_busy_one && (*it)->is_busy()) {
+            m_busy_one = *it;
+            set_busy(true);
+          }
+        }
+
+        m_grid.build(m_widgets);
+      }
+      else {
+        /// Only Widgets under the pointer, or just left by it, can change
+        m_hits.clear();
+        m_grid.find(m_hits, pos, m_pointer);
+
+        for(std::vector<size_t>::const_iterator it = m_hits.begin(); it != m_hits.end() && *it < m_widgets.size(); ++it) {
+          Widget * const widget = m_widgets[*it];
+          widget->on_mouse_motion(pos);
+
+          if(!m_busy_one && widget->is_busy()) {
+            m_busy_one = widget;
+            set_busy(true);
+          }
+        }
+      }
+    }
+
+    m_pointer = pos;
+  }
+
+  unsigned long Widgets::get_revision() const {
+    unsigned long revision = Widget::get_revision();
+    for(std::vector<Widget *>::const_iterator it = m_widgets.begin(), iend = m_widgets.end(); it != iend; ++it)
+      revision = std::max(revision, (*it)->get_revision());
+    return revision;
   }
 
   Text_Box::Reinit Text_Box::g_reinit;
@@ -0,0 +1,244 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_rest.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include <Zeni/Define.h>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  struct Widget_Geometry::Batch {
+    enum Type {COLORED_TRIANGLES, COLORED_LINES, TEXTURED, TEXT};
+
+    Batch() : type(COLORED_TRIANGLES), lines(Primitive_Batch<Vertex2f_Color>::LINES) {}
+
+    void reset(const Type &type_, const String &name_, const Color &color_, const Point2f &lower_, const Point2f &upper_) {
+      type = type_;
+      name = name_;
+      color = color_;
+      lower = lower_;
+      upper = upper_;
+
+      triangles.clear();
+      lines.clear();
+      textured.clear();
+      glyphs.clear();
+
+      if(type == TEXTURED)
+        textured.give_Material(new Material(name));
+    }
+
+    bool overlaps(const Point2f &lower_, const Point2f &upper_) const {
+      return lower.x < upper_.x && lower_.x < upper.x &&
+             lower.y < upper_.y && lower_.y < upper.y;
+    }
+
+    void include(const Point2f &lower_, const Point2f &upper_) {
+      lower.x = std::min(lower.x, lower_.x);
+      lower.y = std::min(lower.y, lower_.y);
+      upper.x = std::max(upper.x, upper_.x);
+      upper.y = std::max(upper.y, upper_.y);
+    }
+
+    Type type;
+    String name; ///< Of the Texture or Font
+    Color color; ///< Of the text
+    Point2f lower, upper; ///< Bounds of everything in the batch
+
+    Primitive_Batch<Vertex2f_Color> triangles;
+    Primitive_Batch<Vertex2f_Color> lines;
+    Primitive_Batch<Vertex2f_Texture> textured;
+    Glyph_Batch glyphs;
+  };
+
+  Widget_Geometry * Widget_Geometry::g_capturing = 0;
+
+  Widget_Geometry::Widget_Geometry()
+    : m_num_batches(0u),
+    m_complete(true)
+  {
+  }
+
+  Widget_Geometry::~Widget_Geometry() {
+    if(g_capturing == this)
+      g_capturing = 0;
+
+    for(std::vector<Batch *>::iterator it = m_batches.begin(); it != m_batches.end(); ++it)
+      delete *it;
+  }
+
+  Widget_Geometry * Widget_Geometry::get_capturing() {
+    return g_capturing;
+  }
+
+  void Widget_Geometry::begin_capture() {
+    assert(!g_capturing);
+
+    m_num_batches = 0u;
+    m_translation = Vector3f();
+    m_complete = true;
+
+    g_capturing = this;
+  }
+
+  void Widget_Geometry::end_capture() {
+    assert(g_capturing == this);
+
+    g_capturing = 0;
+  }
+
+  void Widget_Geometry::translate(const Vector3f &translation) {
+    m_translation += translation;
+  }
+
+  void Widget_Geometry::add(const Quadrilateral<Vertex2f_Color> &quad) {
+    Quadrilateral<Vertex2f_Color> translated(quad);
+    for(int i = 0; i != 4; ++i)
+      translated[i].position += m_translation;
+
+    const Point2f lower(std::min(std::min(translated.a.position.x, translated.b.position.x), std::min(translated.c.position.x, translated.d.position.x)),
+                        std::min(std::min(translated.a.position.y, translated.b.position.y), std::min(translated.c.position.y, translated.d.position.y)));
+    const Point2f upper(std::max(std::max(translated.a.position.x, translated.b.position.x), std::max(translated.c.position.x, translated.d.position.x)),
+                        std::max(std::max(translated.a.position.y, translated.b.position.y), std::max(translated.c.position.y, translated.d.position.y)));
+
+    find_batch(Batch::COLORED_TRIANGLES, String(), Color(), lower, upper).triangles.add(translated);
+  }
+
+  void Widget_Geometry::add(const Line_Segment<Vertex2f_Color> &line_segment) {
+    Line_Segment<Vertex2f_Color> translated(line_segment);
+    translated.a.position += m_translation;
+    translated.b.position += m_translation;
+
+    /// Lines cover a pixel or so to either side
+    const Point2f lower(std::min(translated.a.position.x, translated.b.position.x) - 1.0f,
+                        std::min(translated.a.position.y, translated.b.position.y) - 1.0f);
+    const Point2f upper(std::max(translated.a.position.x, translated.b.position.x) + 1.0f,
+                        std::max(translated.a.position.y, translated.b.position.y) + 1.0f);
+
+    find_batch(Batch::COLORED_LINES, String(), Color(), lower, upper).lines.add(translated);
+  }
+
+  void Widget_Geometry::add(const Quadrilateral<Vertex2f_Texture> &quad, const String &texture) {
+    Quadrilateral<Vertex2f_Texture> translated(quad);
+    for(int i = 0; i != 4; ++i)
+      translated[i].position += m_translation;
+
+    const Point2f lower(std::min(std::min(translated.a.position.x, translated.b.position.x), std::min(translated.c.position.x, translated.d.position.x)),
+                        std::min(std::min(translated.a.position.y, translated.b.position.y), std::min(translated.c.position.y, translated.d.position.y)));
+    const Point2f upper(std::max(std::max(translated.a.position.x, translated.b.position.x), std::max(translated.c.position.x, translated.d.position.x)),
+                        std::max(std::max(translated.a.position.y, translated.b.position.y), std::max(translated.c.position.y, translated.d.position.y)));
+
+    find_batch(Batch::TEXTURED, texture, Color(), lower, upper).textured.add(translated);
+  }
+
+  void Widget_Geometry::add_text(const String &font_name, const String &text, const Point2f &position, const Color &color, const JUSTIFY &justify) {
+    const Font &font = get_Fonts()[font_name];
+    const Point2f translated(position.x + m_translation.i, position.y + m_translation.j);
+
+    const float width = font.get_text_width(text);
+    const float height = font.get_text_height() * (std::count(text.begin(), text.end(), '\n') + 1);
+    const float left = translated.x - (justify == ZENI_CENTER ? 0.5f * width : justify == ZENI_RIGHT ? width : 0.0f);
+
+    /// Glyphs may overhang their advances a little
+    const float margin = 0.5f * font.get_text_height();
+    const Point2f lower(left - margin, translated.y - margin);
+    const Point2f upper(left + width + margin, translated.y + height + margin);
+
+    if(!font.batch_text(find_batch(Batch::TEXT, font_name, color, lower, upper).glyphs, text, translated, justify))
+      m_complete = false;
+  }
+
+  bool Widget_Geometry::is_current() const {
+    if(!m_complete)
+      return false;
+
+    for(size_t i = 0; i != m_num_batches; ++i) {
+      const Batch &batch = *m_batches[i];
+      if(batch.type == Batch::TEXT && !get_Fonts()[batch.name].is_current(batch.glyphs))
+        return false;
+    }
+
+    return true;
+  }
+
+  size_t Widget_Geometry::get_num_draws() const {
+    size_t draws = 0u;
+
+    for(size_t i = 0; i != m_num_batches; ++i) {
+      const Batch &batch = *m_batches[i];
+      switch(batch.type) {
+        case Batch::COLORED_TRIANGLES: draws += !batch.triangles.empty(); break;
+        case Batch::COLORED_LINES:     draws += !batch.lines.empty();     break;
+        case Batch::TEXTURED:          draws += !batch.textured.empty();  break;
+        case Batch::TEXT:              draws += batch.glyphs.get_num_draws(); break;
+        default: break;
+      }
+    }
+
+    return draws;
+  }
+
+  void Widget_Geometry::render() const {
+    assert(is_current());
+
+    Video &vr = get_Video();
+
+    for(size_t i = 0; i != m_num_batches; ++i) {
+      const Batch &batch = *m_batches[i];
+      switch(batch.type) {
+        case Batch::COLORED_TRIANGLES: vr.render(batch.triangles); break;
+        case Batch::COLORED_LINES:     vr.render(batch.lines);     break;
+        case Batch::TEXTURED:          vr.render(batch.textured);  break;
+        case Batch::TEXT:              get_Fonts()[batch.name].render_batch(batch.glyphs, batch.color); break;
+        default: break;
+      }
+    }
+  }
+
+  Widget_Geometry::Batch & Widget_Geometry::find_batch(const int &type, const String &name, const Color &color, const Point2f &lower, const Point2f &upper) {
+    /// Join the latest batch in the same state, provided nothing drawn since overlaps the new geometry
+    for(size_t i = m_num_batches; i; ) {
+      Batch &batch = *m_batches[--i];
+
+      if(batch.type == type && batch.name == name && batch.color == color) {
+        batch.include(lower, upper);
+        return batch;
+      }
+
+      if(batch.overlaps(lower, upper))
+        break;
+    }
+
+    if(m_num_batches == m_batches.size())
+      m_batches.push_back(new Batch);
+
+    Batch &batch = *m_batches[m_num_batches++];
+    batch.reset(Batch::Type(type), name, color, lower, upper);
+    return batch;
+  }
+
+}
+
+#include <Zeni/Undefine.h>
@@ -0,0 +1,209 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <zeni_rest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <Zeni/Define.h>
+
+#if defined(_DEBUG) && defined(_WINDOWS)
+#define DEBUG_NEW new(_NORMAL_BLOCK, __FILE__, __LINE__)
+#define new DEBUG_NEW
+#endif
+
+namespace Zeni {
+
+  Widget_Grid::Widget_Grid()
+    : m_columns(0),
+    m_rows(0),
+    m_current(false)
+  {
+  }
+
+  Widget_Grid::~Widget_Grid() {
+    for(std::vector<Widget *>::iterator it = m_attached.begin(); it != m_attached.end(); ++it) {
+      std::vector<Widget_Grid *> &grids = (*it)->m_grids;
+      grids.erase(std::find(grids.begin(), grids.end(), this));
+    }
+  }
+
+  void Widget_Grid::attach(Widget &widget) {
+    m_attached.push_back(&widget);
+    widget.m_grids.push_back(this);
+    m_current = false;
+  }
+
+  void Widget_Grid::detach(Widget &widget) {
+    std::vector<Widget *>::iterator it = std::find(m_attached.begin(), m_attached.end(), &widget);
+    if(it != m_attached.end()) {
+      m_attached.erase(it);
+      std::vector<Widget_Grid *> &grids = widget.m_grids;
+      grids.erase(std::find(grids.begin(), grids.end(), this));
+    }
+    m_current = false;
+  }
+
+  void Widget_Grid::build(const std::vector<Widget *> &widgets) {
+    m_bounds.clear();
+    m_unbounded.clear();
+
+    bool any_bounded = false;
+    Point2f lower, upper;
+
+    for(size_t i = 0; i != widgets.size(); ++i) {
+      const Widget_Rectangle * const wrr = dynamic_cast<const Widget_Rectangle *>(widgets[i]);
+
+      if(!wrr) {
+        /// Never inside, so only ever found as unbounded
+        m_bounds.push_back(Bounds(Point2f(1.0f, 1.0f), Point2f(-1.0f, -1.0f)));
+        m_unbounded.push_back(i);
+        continue;
+      }
+
+      const Point2f &ul = wrr->get_upper_left();
+      const Point2f &lr = wrr->get_lower_right();
+      const Bounds bounds(Point2f(std::min(ul.x, lr.x), std::min(ul.y, lr.y)),
+                          Point2f(std::max(ul.x, lr.x), std::max(ul.y, lr.y)));
+      m_bounds.push_back(bounds);
+
+      if(any_bounded) {
+        lower.x = std::min(lower.x, bounds.lower.x);
+        lower.y = std::min(lower.y, bounds.lower.y);
+        upper.x = std::max(upper.x, bounds.upper.x);
+        upper.y = std::max(upper.y, bounds.upper.y);
+      }
+      else {
+        lower = bounds.lower;
+        upper = bounds.upper;
+        any_bounded = true;
+      }
+    }
+
+    const size_t num_bounded = m_bounds.size() - m_unbounded.size();
+
+    /// Aim for about one Widget per cell, with square-ish cells
+    const float width = std::max(upper.x - lower.x, 1.0f);
+    const float height = std::max(upper.y - lower.y, 1.0f);
+    const float cells = float(std::max(num_bounded, size_t(1u)));
+    m_columns = std::max(1, std::min(256, int(std::ceil(std::sqrt(cells * width / height)))));
+    m_rows = std::max(1, std::min(256, int(std::ceil(cells / m_columns))));
+    m_lower = lower;
+    m_cell_size = Point2f(width / m_columns, height / m_rows);
+
+    /// Count the entries in each cell, then fill the cells in order of Widget index
+    m_cell_begin.assign(size_t(m_columns * m_rows) + 1u, 0u);
+    m_cell_entries.clear();
+
+    for(int pass = 0; pass != 2; ++pass) {
+      std::vector<size_t> cursor;
+      if(pass) {
+        for(size_t c = 1; c != m_cell_begin.size(); ++c)
+          m_cell_begin[c] += m_cell_begin[c - 1];
+        cursor.assign(m_cell_begin.begin(), m_cell_begin.end() - 1);
+        m_cell_entries.resize(m_cell_begin.back());
+      }
+
+      for(size_t i = 0; i != m_bounds.size(); ++i) {
+        const Bounds &bounds = m_bounds[i];
+        if(bounds.lower.x > bounds.upper.x)
+          continue;
+
+        const int c0 = std::min(m_columns - 1, int((bounds.lower.x - m_lower.x) / m_cell_size.x));
+        const int c1 = std::min(m_columns - 1, int((bounds.upper.x - m_lower.x) / m_cell_size.x));
+        const int r0 = std::min(m_rows - 1, int((bounds.lower.y - m_lower.y) / m_cell_size.y));
+        const int r1 = std::min(m_rows - 1, int((bounds.upper.y - m_lower.y) / m_cell_size.y));
+
+        for(int r = r0; r <= r1; ++r)
+          for(int c = c0; c <= c1; ++c) {
+            const size_t cell = size_t(r * m_columns + c);
+            if(pass)
+              m_cell_entries[cursor[cell]++] = i;
+            else
+              ++m_cell_begin[cell + 1u];
+          }
+      }
+    }
+
+    m_current = true;
+  }
+
+  void Widget_Grid::clear() {
+    m_current = false;
+  }
+
+  bool Widget_Grid::is_current() const {
+    return m_current;
+  }
+
+  void Widget_Grid::find(std::vector<size_t> &indices, const Point2i &pos) const {
+    const size_t first = indices.size();
+
+    find_bounded(indices, pos);
+    indices.insert(indices.end(), m_unbounded.begin(), m_unbounded.end());
+
+    std::inplace_merge(indices.begin() + first, indices.end() - m_unbounded.size(), indices.end());
+  }
+
+  void Widget_Grid::find(std::vector<size_t> &indices, const Point2i &pos0, const Point2i &pos1) const {
+    const size_t first = indices.size();
+
+    find_bounded(indices, pos0);
+    if(pos1.x != pos0.x || pos1.y != pos0.y)
+      find_bounded(indices, pos1);
+    indices.insert(indices.end(), m_unbounded.begin(), m_unbounded.end());
+
+    std::sort(indices.begin() + first, indices.end());
+    indices.erase(std::unique(indices.begin() + first, indices.end()), indices.end());
+  }
+
+  void Widget_Grid::invalidate(const Widget &widget) {
+    for(std::vector<Widget_Grid *>::const_iterator it = widget.m_grids.begin(); it != widget.m_grids.end(); ++it)
+      (*it)->m_current = false;
+  }
+
+  void Widget_Grid::forget(Widget &widget) {
+    while(!widget.m_grids.empty())
+      widget.m_grids.back()->detach(widget);
+  }
+
+  void Widget_Grid::find_bounded(std::vector<size_t> &indices, const Point2i &pos) const {
+    const float x = float(pos.x) - m_lower.x;
+    const float y = float(pos.y) - m_lower.y;
+    if(x < 0.0f || y < 0.0f || m_cell_entries.empty())
+      return;
+
+    const int c = int(x / m_cell_size.x);
+    const int r = int(y / m_cell_size.y);
+    if(c > m_columns || r > m_rows)
+      return;
+
+    /// The far edge of the last cell belongs to it
+    const size_t cell = size_t(std::min(r, m_rows - 1) * m_columns + std::min(c, m_columns - 1));
+
+    for(size_t e = m_cell_begin[cell]; e != m_cell_begin[cell + 1u]; ++e) {
+      const Bounds &bounds = m_bounds[m_cell_entries[e]];
+      if(bounds.lower.x <= pos.x && pos.x <= bounds.upper.x &&
+         bounds.lower.y <= pos.y && pos.y <= bounds.upper.y)
+        indices.push_back(m_cell_entries[e]);
+    }
+  }
+
+}
+
+#include <Zeni/Undefine.h>
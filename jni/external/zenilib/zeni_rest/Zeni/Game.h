@@ -26,6 +26,10 @@
  * continually refers to the Game singleton to get the current 
  * Gamestate.
  *
+ * The Game starts the Job_System, so a Gamestate's perform_logic may
+ * fork work with get_Job_System().run or parallel_for and wait on it
+ * before returning.
+ *
  * \author bazald
  *
  * Contact: bazald@zenipex.com
@@ -39,6 +43,7 @@
 #include <Zeni/Singleton.h>
 #include <Zeni/String.h>
 #include <Zeni/Timer.h>
+#include <Zeni/Timer_HQ.h>
 
 #include <SDL/SDL_gamecontroller.h>
 
@@ -109,6 +114,48 @@ namespace Zeni {
 
     void run();
 
+    /** Fixed Timestep Simulation
+     *
+     *  By default, run() calls perform_logic once per frame.  With a fixed
+     *  timestep, it instead accumulates the time passed and calls
+     *  perform_logic once for every full tick, so logic runs at the same rate
+     *  regardless of the frame rate.  get_interpolation() gives the fraction
+     *  of a tick left over, for blending the previous and current states in
+     *  render().
+     */
+    void set_fixed_timestep(const float &ticks_per_second); ///< Call perform_logic 'ticks_per_second' times per second; 0.0f restores once per frame
+    inline float get_fixed_timestep() const; ///< Get the seconds per tick, or 0.0f if perform_logic is called once per frame
+    void set_max_catch_up_steps(const size_t &max_steps); ///< Limit ticks per frame; time beyond that is dropped rather than caught up
+    inline size_t get_max_catch_up_steps() const; ///< Get the limit on ticks per frame
+    inline float get_interpolation() const; ///< Get the fraction [0.0f, 1.0f) of a tick passed since the last perform_logic
+    void set_frame_rate_cap(const float &frames_per_second); ///< Sleep between frames to render no more than 'frames_per_second'; 0.0f is uncapped
+    inline float get_frame_rate_cap() const; ///< Get the frame rate cap, or 0.0f if uncapped
+
+    /** Pipelined Rendering
+     *
+     *  When pipelined, perform_logic runs as a Job on the Job_System and
+     *  then records the frame with Gamestate_Base::record.  Meanwhile, this
+     *  Thread replays the previous frame's Command_List, so each frame is
+     *  displayed one frame later.  perform_logic must therefore leave Video,
+     *  Window, Fonts, and Sound alone, so only a Gamestate on top that has
+     *  opted in with Gamestate_Base::set_pipelinable is run this way; Others
+     *  run serially on this Thread.  A frame that is not recorded is rendered
+     *  normally once its logic completes.
+     */
+    void set_pipelined(const bool &pipelined); ///< Enable or disable pipelined rendering
+    inline bool is_pipelined() const; ///< Check to see if rendering is pipelined
+
+    struct ZENI_REST_DLL Frame_Stats {
+      Frame_Stats() : logic_seconds(0.0f), render_seconds(0.0f), frame_seconds(0.0f), latency_seconds(0.0f) {}
+
+      float logic_seconds; ///< Time spent in perform_logic and record
+      float render_seconds; ///< Time spent rendering or replaying a Command_List
+      float frame_seconds; ///< Time between the last two frames displayed
+      float latency_seconds; ///< Time from the beginning of a frame's perform_logic to the end of its rendering
+    };
+
+    inline const Frame_Stats & get_frame_stats() const; ///< Get timings for the most recently displayed frame
+
     void push_Popup_Menu_State();
     void push_Popup_Pause_State();
     void replace_Popup_Menu_State_Factory(Popup_Menu_State_Factory * const popup_menu_state_factory);
@@ -144,6 +191,16 @@ namespace Zeni {
 
   private:
     void calculate_fps();
+    void perform_timestep();
+    void perform_fixed_logic();
+    void limit_frame_rate();
+
+    class Logic_Job;
+    friend class Logic_Job;
+    bool record(Command_List &commands);
+    bool is_pipelinable();
+    bool perform_pipelined();
+    void render_frame(const Command_List * const &commands, const Time_HQ &logic_start);
 
 #ifdef _WINDOWS
 #pragma warning( push )
@@ -160,6 +217,24 @@ namespace Zeni {
 
     Time time;
     Time::Tick_Type ticks_passed, fps, fps_next;
+
+    float m_seconds_per_tick;
+    size_t m_max_catch_up_steps;
+    long double m_accumulated_seconds;
+    float m_interpolation;
+    float m_time_scale; ///< Scales time accumulated for ticks; Randomized under TEST_NASTY_CONDITIONS
+    Time_HQ m_tick_time;
+
+    float m_frame_rate_cap;
+    Time_HQ m_frame_time;
+
+    bool m_pipelined;
+    Command_List * m_command_lists[2];
+    Command_List * m_recorded; ///< The frame awaiting replay, if any
+    Time_HQ m_recorded_logic_start;
+
+    Frame_Stats m_frame_stats;
+    Time_HQ m_frame_end;
     
     Popup_Menu_State_Factory * m_popup_menu_state_factory;
     Popup_Pause_State_Factory * m_popup_pause_state_factory;
@@ -42,6 +42,30 @@ namespace Zeni {
     return fps;
   }
 
+  float Game::get_fixed_timestep() const {
+    return m_seconds_per_tick;
+  }
+
+  size_t Game::get_max_catch_up_steps() const {
+    return m_max_catch_up_steps;
+  }
+
+  float Game::get_interpolation() const {
+    return m_interpolation;
+  }
+
+  float Game::get_frame_rate_cap() const {
+    return m_frame_rate_cap;
+  }
+
+  bool Game::is_pipelined() const {
+    return m_pipelined;
+  }
+
+  const Game::Frame_Stats & Game::get_frame_stats() const {
+    return m_frame_stats;
+  }
+
 }
 
 #include <Zeni/Gamestate.hxx>
@@ -76,6 +76,7 @@ struct AInputEvent;
 
 namespace Zeni {
 
+  class ZENI_GRAPHICS_DLL Command_List;
   class ZENI_REST_DLL Gamestate;
 
   // Derive from this class
@@ -86,7 +87,7 @@ namespace Zeni {
     Gamestate_Base & operator=(const Gamestate_Base &rhs);
 
   public:
-    Gamestate_Base() : m_count(0), m_pausable(false) {}
+    Gamestate_Base() : m_count(0), m_pausable(false), m_pipelinable(false) {}
     virtual ~Gamestate_Base() {}
 
     // The control loop
@@ -103,6 +104,11 @@ namespace Zeni {
     virtual void prerender() {}
     /// Then render.  Called by Game as part of the main gameloop.
     virtual void render();
+    /** Or, when Game::is_pipelined, record prerender and render for replay while
+     *  the next perform_logic runs.  Copy everything the Command_List needs, since
+     *  this Gamestate will change before replay.  Return false to render normally.
+     */
+    virtual bool record(Command_List &) {return false;}
 
     /// Called when the Gamestate is pushed onto the stack in Game
     virtual void on_push();
@@ -115,6 +121,10 @@ namespace Zeni {
 
     inline const bool & is_pausable() const;
     inline void set_pausable(const bool &pausable_);
+    /// Check to see if perform_logic may run on a worker Thread when Game::is_pipelined
+    inline const bool & is_pipelinable() const;
+    /// Opt in to pipelining only if perform_logic leaves Video, Window, Fonts, and Sound alone
+    inline void set_pipelinable(const bool &pipelinable_);
 
     // Converters
 
@@ -164,6 +174,7 @@ namespace Zeni {
     int m_count;
 
     bool m_pausable;
+    bool m_pipelinable;
   };
 
   class ZENI_REST_DLL Gamestate {
@@ -183,6 +194,7 @@ namespace Zeni {
     inline void perform_logic();
     inline void prerender();
     inline void render();
+    inline bool record(Command_List &commands);
 
     inline void on_push();
     inline void on_cover();
@@ -190,6 +202,7 @@ namespace Zeni {
     inline void on_pop();
 
     inline const bool & is_pausable() const;
+    inline const bool & is_pipelinable() const;
 
     inline Gamestate_Base & get();
 
@@ -30,6 +30,14 @@ namespace Zeni {
     m_pausable = pausable_;
   }
 
+  const bool & Gamestate_Base::is_pipelinable() const {
+    return m_pipelinable;
+  }
+
+  void Gamestate_Base::set_pipelinable(const bool &pipelinable_) {
+    m_pipelinable = pipelinable_;
+  }
+
   void Gamestate_Base::increment() {
     ++m_count;
   }
@@ -94,6 +102,10 @@ namespace Zeni {
     m_state->render();
   }
 
+  bool Gamestate::record(Command_List &commands) {
+    return m_state->record(commands);
+  }
+
   void Gamestate::on_push() {
     m_state->on_push();
   }
@@ -114,6 +126,10 @@ namespace Zeni {
     return m_state->is_pausable();
   }
 
+  const bool & Gamestate::is_pipelinable() const {
+    return m_state->is_pipelinable();
+  }
+
   Gamestate_Base & Gamestate::get() {
     return *m_state;
   }
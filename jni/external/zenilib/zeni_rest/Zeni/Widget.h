@@ -181,6 +181,11 @@
  * An (optionally) editable text box.  It can behave as a simple text 
  * editor.
  *
+ * Glyph advances are measured once per Font and cached, and an edit lays
+ * out again only from the line before the edited word until the new line
+ * breaks line up with the old ones, so typing into a long text costs
+ * roughly one line of work rather than the whole text.
+ *
  * \author bazald
  *
  * Contact: bazald@zenipex.com
@@ -211,6 +216,17 @@
  * This allows you to batch send events and render commands to many 
  * Widgets at once.
  *
+ * Mouse motion reaches only the Widgets under the pointer, found through a
+ * Widget_Grid, along with the Widgets it has just left.  When coalescing,
+ * only the latest motion is dispatched, by perform_logic or before the
+ * next other event.
+ *
+ * When retained, the Widgets capture their geometry into a Widget_Geometry
+ * and draw it again in a handful of batches until one of them changes.
+ * Widgets notice their own changes, but a Widget drawing through a custom
+ * Widget_Render_Function or altered through a public renderer member
+ * should call invalidate().
+ *
  * \author bazald
  *
  * Contact: bazald@zenipex.com
@@ -230,6 +246,8 @@
 #include <Zeni/Quadrilateral.h>
 #include <Zeni/Vertex2f.h>
 #include <Zeni/Video.h>
+#include <Zeni/Widget_Geometry.h>
+#include <Zeni/Widget_Grid.h>
 
 #include <vector>
 #include <set>
@@ -244,6 +262,8 @@ namespace Zeni {
     Widget(const Widget &);
     Widget & operator=(const Widget &);
 
+    friend class Widget_Grid;
+
   public:
     inline Widget();
     virtual ~Widget();
@@ -287,6 +307,9 @@ namespace Zeni {
 
     virtual void render_impl() const;
 
+    inline void invalidate() const; ///< Note that the Widget will look different when next rendered
+    virtual unsigned long get_revision() const; ///< Get a number that increases whenever the Widget is invalidated
+
   private:
     float m_layer;
     bool m_busy;
@@ -294,6 +317,19 @@ namespace Zeni {
 
     Widget_Render_Function * m_renderer;
     bool delete_m_renderer;
+
+    mutable unsigned long m_revision;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Widget_Grid *> m_grids; ///< The grids indexing this Widget, made stale when its layout changes
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+
+    static unsigned long g_revisions;
   };
 
   class ZENI_REST_DLL Widget_Render_Function {
@@ -541,6 +577,8 @@ namespace Zeni {
 
     virtual void render_impl() const;
 
+    virtual unsigned long get_revision() const;
+
   private:
     inline void lend_Radio_Button(Radio_Button &radio_button);
     inline void unlend_Radio_Button(Radio_Button &radio_button);
@@ -550,9 +588,13 @@ namespace Zeni {
 #pragma warning( disable : 4251 )
 #endif
     std::set<Radio_Button *> m_radio_buttons;
+    std::vector<Widget *> m_indexed; ///< m_radio_buttons as indexed by m_grid
+    std::vector<size_t> m_hits;
 #ifdef _WINDOWS
 #pragma warning( pop )
 #endif
+    Widget_Grid m_grid;
+    Point2i m_pointer; ///< The last position given to the Radio_Buttons
   };
 
   class ZENI_REST_DLL Radio_Button : public Check_Box {
@@ -737,6 +779,8 @@ namespace Zeni {
 
     virtual void render_impl() const;
 
+    virtual unsigned long get_revision() const;
+
     inline const Widget_Render_Function * get_Text_Button_Renderer() const; ///< Get the current Widget_Render_Function
     inline void give_Text_Button_Renderer(Widget_Render_Function * const &renderer); ///< Set the current Widget_Render_Function, giving the Widget ownership
     inline void lend_Text_Button_Renderer(const Widget_Render_Function * const &renderer); ///< Set the current Widget_Render_Function, giving the Widget no ownership
@@ -864,6 +908,8 @@ namespace Zeni {
 
     virtual void render_impl() const;
 
+    virtual unsigned long get_revision() const;
+
     inline const Widget_Render_Function * get_BG_Renderer() const; ///< Get the current Widget_Render_Function
     inline void give_BG_Renderer(Widget_Render_Function * const &renderer); ///< Set the current Widget_Render_Function, giving the Widget ownership
     inline void lend_BG_Renderer(const Widget_Render_Function * const &renderer); ///< Set the current Widget_Render_Function, giving the Widget no ownership
@@ -878,32 +924,42 @@ namespace Zeni {
     struct ZENI_REST_DLL Word {
       enum Type {NONSENSE = 0x0, WORD = 0x1, SPACE = 0x2};
 
-      Word(const Type &type_ = NONSENSE) : unformatted_glyph_sides(1, 0), type(type_), splittable(false), fpsplit(false) {}
+      Word(const Type &type_ = NONSENSE) : begin(0u), end(0u), type(type_), splittable(false), fpsplit(false) {}
+
+      size_t begin; ///< Index of the first character in the text
+      size_t end; ///< Index one past the last character in the text
+      Type type;
+      bool splittable;
+      bool fpsplit; // indicates it has been split already and a '-' should be appended
+    };
+
+    struct ZENI_REST_DLL Line {
+      Line() : unformatted_glyph_sides(1, 0), glyph_top(0), fpsplit(false), endled(false) {}
+
+      void swap(Line &rhs);
 
       String unformatted;
 #ifdef _WINDOWS
 #pragma warning( push )
 #pragma warning( disable : 4251 )
 #endif
-      std::vector<float> unformatted_glyph_sides;
+      std::vector<float> unformatted_glyph_sides; ///< Prefix sums of glyph advances, beginning with 0
 #ifdef _WINDOWS
 #pragma warning( pop )
 #endif
-      Type type;
-      bool splittable;
-      bool fpsplit; // indicates it has been split already and a '-' should be appended
-    };
-
-    struct ZENI_REST_DLL Line : public Word {
-      Line() : glyph_top(0), endled(false) {}
-
       String formatted;
       float glyph_top;
+      bool fpsplit;
       bool endled;
     };
 
-    void format();
-    void append_word(const Word &word);
+    void format(); ///< Lay out all of the text
+    void reformat(const size_t &edit_pos, const size_t &removed, const size_t &inserted); ///< Lay out again after replacing 'removed' characters at 'edit_pos' with 'inserted' characters
+    void replace_text(const String &text_); ///< Set the text, laying out again only what changed
+    Word next_word(const size_t &begin);
+    void append_word(std::vector<Line> &lines, const Word &word);
+    void finish_lines(std::vector<Line> &lines) const;
+    void place_lines(const size_t &first);
 
     Widget_Render_Function * m_bg_renderer;
     bool delete_m_bg_renderer;
@@ -911,10 +967,11 @@ namespace Zeni {
 
     String clean_string(const String &unclean_string) const;
     String untablinebreak(const String &tabbed_text) const;
-    float get_text_width(const Font &font, const String &text); 
+    float get_advance(const char &c); ///< Get the width of a glyph as laid out, measuring it if it has not been already
     float max_line_width() const;
 
     inline void invalidate_edit_pos();
+    bool is_cursor_shown() const; ///< Check to see if the cursor is visible at this point in its blinking
 
 #ifdef _WINDOWS
 #pragma warning( push )
@@ -925,6 +982,7 @@ namespace Zeni {
 #pragma warning( pop )
 #endif
 
+    float m_advances[256]; ///< Negative until measured
     int m_edit_pos;
     Time m_last_seek;
 
@@ -933,6 +991,7 @@ namespace Zeni {
 
     Point2i m_cursor_pos;
     Point2i m_cursor_index;
+    mutable bool m_cursor_shown; ///< As of the last render
 
   public:
     static void reformat_all(); ///< Reformat all Text_Box instances
@@ -1000,6 +1059,8 @@ namespace Zeni {
     // render is simply passed through
     virtual void render_impl() const;
 
+    virtual unsigned long get_revision() const;
+
   private:
     const Widget_Render_Function * get_Renderer() const; ///< Disable
     void give_Renderer(Widget_Render_Function * const &); ///< Disable
@@ -1025,11 +1086,27 @@ namespace Zeni {
     Widgets & operator=(const Widgets &);
 
   public:
+    struct Render_Stats {
+      Render_Stats() : dirty(0u), draws(0u), rebuilt(false) {}
+
+      size_t dirty; ///< Widgets changed since the geometry was last captured
+      size_t draws; ///< Batched draws made by the last render, or 0 if it had to render immediately
+      bool rebuilt; ///< Whether the last render captured the geometry again
+    };
+
     inline Widgets();
+    ~Widgets();
 
     inline void lend_Widget(Widget &widget);
     inline void unlend_Widget(Widget &widget);
 
+    inline const bool & is_coalescing_motion() const; ///< Check to see if mouse motion is held back to be dispatched once per frame
+    void set_coalescing_motion(const bool &coalescing); ///< Dispatch only the latest mouse motion, in perform_logic or before the next other event
+
+    inline const bool & is_retained() const; ///< Check to see if geometry is retained between renders
+    void set_retained(const bool &retained); ///< Retain geometry between renders, capturing it again only when a Widget changes
+    inline const Render_Stats & get_render_stats() const; ///< Get statistics about the last render
+
 #ifndef ANDROID
     virtual void on_key(const SDL_Keysym &keysym, const bool &down);
 #endif
@@ -1044,21 +1121,39 @@ namespace Zeni {
 
     virtual void render_impl() const;
 
+    virtual unsigned long get_revision() const;
+
   private:
     const Widget_Render_Function * get_Renderer() const; ///< Disable
     void give_Renderer(Widget_Render_Function * const &); ///< Disable
     void lend_Renderer(const Widget_Render_Function * const &); ///< Disable
     void fax_Renderer(const Widget_Render_Function * const &); ///< Disable
 
+    void flush_motion(); ///< Dispatch any mouse motion held back
+    void dispatch_motion(const Point2i &pos);
+
 #ifdef _WINDOWS
 #pragma warning( push )
 #pragma warning( disable : 4251 )
 #endif
     mutable std::vector<Widget *> m_widgets;
+    std::vector<size_t> m_hits;
 #ifdef _WINDOWS
 #pragma warning( pop )
 #endif
     Widget * m_busy_one;
+
+    Widget_Grid m_grid;
+    Point2i m_pointer; ///< The last position given to the Widgets
+
+    bool m_coalescing;
+    bool m_motion_pending;
+    Point2i m_pending_motion;
+
+    bool m_retained;
+    mutable Widget_Geometry * m_geometry;
+    mutable unsigned long m_geometry_revision; ///< The latest revision captured in m_geometry
+    mutable Render_Stats m_render_stats;
   };
 
   class ZENI_REST_DLL Widget_Renderer_Wrong_Type : public Error {
@@ -41,7 +41,8 @@ namespace Zeni {
     m_busy(false),
     m_editable(true),
     m_renderer(0),
-    delete_m_renderer(false)
+    delete_m_renderer(false),
+    m_revision(++g_revisions)
   {
   }
 
@@ -63,6 +64,8 @@ namespace Zeni {
 
   void Widget::set_layer(const float &layer_) {
     m_layer = layer_;
+    invalidate();
+    Widget_Grid::invalidate(*this);
   }
 
 #ifndef ANDROID
@@ -109,6 +112,12 @@ namespace Zeni {
 #endif
 
   void Widget::render() const {
+    /// Captured geometry is ordered by layer rather than translated by it
+    if(Widget_Geometry::get_capturing()) {
+      render_impl();
+      return;
+    }
+
     Video &vr = get_Video();
 
     vr.push_world_stack();
@@ -128,6 +137,7 @@ namespace Zeni {
       delete m_renderer;
     m_renderer = renderer;
     delete_m_renderer = true;
+    invalidate();
   }
 
   void Widget::lend_Renderer(const Widget_Render_Function * const &renderer) {
@@ -138,6 +148,10 @@ namespace Zeni {
   void Widget::fax_Renderer(const Widget_Render_Function * const &renderer) {
     give_Renderer(renderer->get_duplicate());
   }
+
+  void Widget::invalidate() const {
+    m_revision = ++g_revisions;
+  }
   
   Widget_Rectangle::Widget_Rectangle(const Point2f &upper_left_, const Point2f &lower_right_)
     : m_upper_left(upper_left_),
@@ -348,7 +362,7 @@ namespace Zeni {
   }
 
   const bool & Check_Box::is_checked() const {return m_checked;}
-  void Check_Box::set_checked(const bool &checked_) {m_checked = checked_;}
+  void Check_Box::set_checked(const bool &checked_) {m_checked = checked_; invalidate();}
   const bool & Check_Box::is_toggling() const {return m_toggling;}
 
   Radio_Button::Radio_Button(Radio_Button_Set &radio_button_set_,
@@ -377,11 +391,15 @@ namespace Zeni {
 
   void Radio_Button_Set::lend_Radio_Button(Radio_Button &radio_button) {
     m_radio_buttons.insert(&radio_button);
+    m_grid.attach(radio_button);
+    invalidate();
   }
 
   void Radio_Button_Set::unlend_Radio_Button(Radio_Button &radio_button) {
     m_radio_buttons.erase(&radio_button);
     radio_button.m_radio_button_set = 0;
+    m_grid.detach(radio_button);
+    invalidate();
   }
 
   Point2f Slider::get_end_point_a() const {
@@ -402,10 +420,12 @@ namespace Zeni {
 
   void Slider::set_end_points(const Point2f &end_point_a_, const Point2f &end_point_b_) {
     m_line_segment = Collision::Line_Segment(Point3f(end_point_a_), Point3f(end_point_b_));
+    invalidate();
   }
 
   void Slider::set_slider_radius(const float &radius_) {
     m_slider_radius = radius_;
+    invalidate();
   }
 
   void Slider::set_slider_position(const float &slider_position_) {
@@ -415,6 +435,7 @@ namespace Zeni {
       m_slider_position = 1.0f;
     else
       m_slider_position = slider_position_;
+    invalidate();
   }
 
   const bool & Slider::is_mouse_wheel_inverted() const {
@@ -464,6 +485,7 @@ namespace Zeni {
       delete m_button_renderer;
     m_button_renderer = renderer;
     delete_m_button_renderer = true;
+    invalidate();
 
     m_normal_button.lend_Renderer(m_button_renderer);
     for(std::vector<Selector_Button *>::iterator it = m_selector_buttons.begin(); it != m_selector_buttons.end(); ++it)
@@ -488,6 +510,7 @@ namespace Zeni {
       delete m_slider_renderer;
     m_slider_renderer = renderer;
     delete_m_slider_renderer = true;
+    invalidate();
 
     m_selector_slider.lend_Renderer(m_slider_renderer);
   }
@@ -510,6 +533,7 @@ namespace Zeni {
       delete m_slider_bg_renderer;
     m_slider_bg_renderer = renderer;
     delete_m_slider_bg_renderer = true;
+    invalidate();
   }
 
   void Selector::lend_Slider_BG_Renderer(const Widget_Render_Function * const &renderer) {
@@ -531,6 +555,8 @@ namespace Zeni {
     m_normal_button.font_name = m_font;
     for(std::vector<Selector_Button *>::iterator it = m_selector_buttons.begin(); it != m_selector_buttons.end(); ++it)
       (*it)->font_name = m_font;
+
+    invalidate();
   }
 
   const String & Text_Box::get_font_name() const {
@@ -568,17 +594,18 @@ namespace Zeni {
   }
 
   void Text_Box::set_text(const String &text_) {
-    m_text.text = text_;
-    format();
+    replace_text(text_);
     seek(std::min(m_edit_pos, this->get_max_seek()));
   }
   
   void Text_Box::set_text_color(const Color &text_color_) {
     m_text.color = text_color_;
+    invalidate();
   }
   
   void Text_Box::set_justify(const JUSTIFY &justify_) {
     m_justify = justify_;
+    invalidate();
   }
 
   void Text_Box::erase_lines(const unsigned int &begin, const unsigned int &end) {
@@ -599,9 +626,7 @@ namespace Zeni {
         new_text += m_lines[i].unformatted;
     }
 
-    m_text.text = new_text;
-
-    format();
+    replace_text(new_text);
     invalidate_edit_pos();
   }
 
@@ -614,6 +639,7 @@ namespace Zeni {
       delete m_bg_renderer;
     m_bg_renderer = renderer;
     delete_m_bg_renderer = true;
+    invalidate();
   }
 
   void Text_Box::lend_BG_Renderer(const Widget_Render_Function * const &renderer) {
@@ -629,6 +655,7 @@ namespace Zeni {
     m_edit_pos = -1;
     m_cursor_index.x = -1;
     m_cursor_index.y = -1;
+    invalidate();
   }
 
   Widget_Input_Repeater::Widget_Input_Repeater(Widget &widget_,
@@ -646,17 +673,24 @@ namespace Zeni {
   const int & Widget_Input_Repeater::get_repeat_delay() const {return m_repeat_delay;}
   const int & Widget_Input_Repeater::get_repeat_interval() const  {return m_repeat_interval;}
 
-  void Widget_Input_Repeater::set_widget(Widget &widget_) {m_widget = &widget_; set_busy(widget_.is_busy());}
+  void Widget_Input_Repeater::set_widget(Widget &widget_) {m_widget = &widget_; set_busy(widget_.is_busy()); invalidate();}
   void Widget_Input_Repeater::set_repeat_delay(const int &repeat_delay_) {m_repeat_delay = repeat_delay_;}
   void Widget_Input_Repeater::set_repeat_interval(const int &repeat_interval_) {m_repeat_interval = repeat_interval_;}
 
   Widgets::Widgets()
-    : m_busy_one(0)
+    : m_busy_one(0),
+    m_coalescing(false),
+    m_motion_pending(false),
+    m_retained(false),
+    m_geometry(0),
+    m_geometry_revision(0u)
   {
   }
 
   void Widgets::lend_Widget(Widget &widget) {
     m_widgets.push_back(&widget);
+    m_grid.attach(widget);
+    invalidate();
 
     if(widget.is_busy()) {
       assert(!m_busy_one);
@@ -669,6 +703,8 @@ namespace Zeni {
     std::vector<Widget *>::iterator it = std::find(m_widgets.begin(), m_widgets.end(), &widget);
     if(it != m_widgets.end())
       m_widgets.erase(it);
+    m_grid.detach(widget);
+    invalidate();
 
     if(m_busy_one == &widget) {
       m_busy_one = 0;
@@ -676,6 +712,18 @@ namespace Zeni {
     }
   }
 
+  const bool & Widgets::is_coalescing_motion() const {
+    return m_coalescing;
+  }
+
+  const bool & Widgets::is_retained() const {
+    return m_retained;
+  }
+
+  const Widgets::Render_Stats & Widgets::get_render_stats() const {
+    return m_render_stats;
+  }
+
 }
 
 #include <Zeni/Font.hxx>
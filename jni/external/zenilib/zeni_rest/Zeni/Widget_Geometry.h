@@ -0,0 +1,101 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Widget_Geometry
+ *
+ * \ingroup zenilib
+ *
+ * \brief Captured Geometry of Retained Widgets
+ *
+ * While a Widget_Geometry is capturing, the stock Widget_Render_Functions
+ * add their geometry to it rather than rendering it.  Geometry sharing a
+ * Texture, or a Font and Color, joins the most recent batch of its kind
+ * unless something else has been drawn over that batch since, so the
+ * captured geometry renders the same picture in a handful of draws.
+ *
+ * \note A Widget rendering by calling Video directly must check get_capturing() and add its geometry instead.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_WIDGET_GEOMETRY_H
+#define ZENI_WIDGET_GEOMETRY_H
+
+#include <Zeni/Color.h>
+#include <Zeni/Coordinate.h>
+#include <Zeni/Font.h>
+#include <Zeni/Line_Segment.h>
+#include <Zeni/Quadrilateral.h>
+#include <Zeni/String.h>
+#include <Zeni/Vector3f.h>
+#include <Zeni/Vertex2f.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  class ZENI_REST_DLL Widget_Geometry {
+    Widget_Geometry(const Widget_Geometry &);
+    Widget_Geometry & operator=(const Widget_Geometry &);
+
+  public:
+    Widget_Geometry();
+    ~Widget_Geometry();
+
+    static Widget_Geometry * get_capturing(); ///< Get the Widget_Geometry currently capturing, or 0 if Widgets should render immediately
+
+    void begin_capture(); ///< Discard all geometry and begin capturing
+    void end_capture(); ///< Stop capturing
+
+    void translate(const Vector3f &translation); ///< Offset all geometry captured from now on, like Video::translate_scene
+
+    void add(const Quadrilateral<Vertex2f_Color> &quad);
+    void add(const Line_Segment<Vertex2f_Color> &line_segment);
+    void add(const Quadrilateral<Vertex2f_Texture> &quad, const String &texture);
+    void add_text(const String &font_name, const String &text, const Point2f &position, const Color &color, const JUSTIFY &justify);
+
+    bool is_current() const; ///< Check to see if everything was captured and no Font has evicted glyphs captured since
+    size_t get_num_draws() const; ///< Get the number of draws render() will make
+    void render() const; ///< Render the captured geometry; Must be current
+
+  private:
+    struct Batch;
+
+    Batch & find_batch(const int &type, const String &name, const Color &color, const Point2f &lower, const Point2f &upper);
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Batch *> m_batches; ///< Kept for reuse beyond m_num_batches
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+    size_t m_num_batches;
+
+    Vector3f m_translation;
+    bool m_complete;
+
+    static Widget_Geometry * g_capturing;
+  };
+
+}
+
+#endif
@@ -0,0 +1,109 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \class Zeni::Widget_Grid
+ *
+ * \ingroup zenilib
+ *
+ * \brief A Uniform Grid over the Rectangles of a Set of Widgets
+ *
+ * Finds the Widgets that might be under a point without testing every
+ * Widget.  Widgets that are not Widget_Rectangles have no bounds and are
+ * found everywhere.  A grid goes stale whenever a Widget attached to it
+ * is moved or changes layer, and must then be built again.  Moving
+ * Widgets indexed by other grids leaves it current.
+ *
+ * \author bazald
+ *
+ * Contact: bazald@zenipex.com
+ */
+
+#ifndef ZENI_WIDGET_GRID_H
+#define ZENI_WIDGET_GRID_H
+
+#include <Zeni/Coordinate.h>
+
+#include <vector>
+
+namespace Zeni {
+
+  class Widget;
+
+  class ZENI_REST_DLL Widget_Grid {
+    // Undefined
+    Widget_Grid(const Widget_Grid &);
+    Widget_Grid & operator=(const Widget_Grid &);
+
+  public:
+    Widget_Grid();
+    ~Widget_Grid();
+
+    void attach(Widget &widget); ///< Go stale whenever 'widget' changes layout; Also makes the grid stale
+    void detach(Widget &widget); ///< Stop following 'widget'; Also makes the grid stale
+
+    /// Index 'widgets', which must stay in the same order until the grid is built again
+    void build(const std::vector<Widget *> &widgets);
+    void clear(); ///< Make the grid stale
+
+    bool is_current() const; ///< Check to see if no layout has changed since the grid was built
+
+    /// Append the indices of all Widgets that might be under 'pos', in increasing order and without duplicates
+    void find(std::vector<size_t> &indices, const Point2i &pos) const;
+    /// Append the indices of all Widgets that might be under either position, in increasing order and without duplicates
+    void find(std::vector<size_t> &indices, const Point2i &pos0, const Point2i &pos1) const;
+
+    static void invalidate(const Widget &widget); ///< Make every grid 'widget' is attached to stale; Called whenever its layout changes
+    static void forget(Widget &widget); ///< Detach 'widget' from every grid; Called as it is destroyed
+
+  private:
+    struct Bounds {
+      Bounds() {}
+      Bounds(const Point2f &lower_, const Point2f &upper_) : lower(lower_), upper(upper_) {}
+
+      Point2f lower;
+      Point2f upper;
+    };
+
+    void find_bounded(std::vector<size_t> &indices, const Point2i &pos) const;
+
+#ifdef _WINDOWS
+#pragma warning( push )
+#pragma warning( disable : 4251 )
+#endif
+    std::vector<Bounds> m_bounds; ///< Indexed by Widget
+    std::vector<size_t> m_unbounded; ///< Indices of Widgets that are not Widget_Rectangles
+
+    std::vector<size_t> m_cell_begin; ///< Offsets into m_cell_entries for each cell, followed by the total
+    std::vector<size_t> m_cell_entries; ///< Widget indices, grouped by cell
+
+    std::vector<Widget *> m_attached;
+#ifdef _WINDOWS
+#pragma warning( pop )
+#endif
+
+    Point2f m_lower;
+    Point2f m_cell_size;
+    int m_columns;
+    int m_rows;
+
+    bool m_current;
+  };
+
+}
+
+#endif
@@ -180,6 +180,9 @@ inline int main2(const int argc, const char * const * const argv) {
     // Load config
     const bool user_config = load_config();
 
+    // Start worker Threads on the main thread before anything can load asynchronously
+    Zeni::get_Job_System();
+
     // Initialize Game
     Zeni::Game &gr = Zeni::get_Game();
 
@@ -208,6 +211,7 @@ inline int main2(const int argc, const char * const * const argv) {
       //Zeni::Net::completely_destroy();
       Zeni::Fonts::completely_destroy();
       Zeni::Textures::completely_destroy();
+      Zeni::Job_System::completely_destroy();
       Zeni::Video::completely_destroy();
       Zeni::Window::completely_destroy();
       Zeni::Sound_Source_Pool::completely_destroy();
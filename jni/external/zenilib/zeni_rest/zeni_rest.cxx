@@ -26,3 +26,5 @@
 #include "Zeni/main.cpp"
 #include "Zeni/Widget.cpp"
 #include "Zeni/Widget_Gamestate.cpp"
+#include "Zeni/Widget_Geometry.cpp"
+#include "Zeni/Widget_Grid.cpp"
@@ -39,6 +39,8 @@
 #include <Zeni/Title_State.h>
 #include <Zeni/Widget.h>
 #include <Zeni/Widget_Gamestate.h>
+#include <Zeni/Widget_Geometry.h>
+#include <Zeni/Widget_Grid.h>
 
 #include <Zeni/Game.hxx>
 #include <Zeni/Gamestate.hxx>
@@ -0,0 +1,152 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/** Check whichever Float4 path was compiled, SSE or not, and the Matrix4f
+ *  operations built on it against plain scalar arithmetic.
+ */
+
+#include <zeni.h>
+
+#include <Zeni/Float4.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Zeni;
+
+namespace Zeni_Test {
+
+  static bool float4_agrees(const float &simd, const float &scalar) {
+    return std::fabs(simd - scalar) <= 0.0001f * (1.0f + std::fabs(scalar));
+  }
+
+  static float float4_scalar_determinant(const Matrix4f &matrix, const int &size, const int * const rows, const int * const columns) {
+    if(size == 1)
+      return matrix[rows[0]][columns[0]];
+
+    /// Laplace expansion along the first remaining row
+    float determinant = 0.0f;
+    for(int i = 0; i != size; ++i) {
+      int minor_columns[3];
+      for(int j = 0, k = 0; j != size; ++j)
+        if(j != i)
+          minor_columns[k++] = columns[j];
+
+      const float term = matrix[rows[0]][columns[i]] * float4_scalar_determinant(matrix, size - 1, rows + 1, minor_columns);
+      determinant += i % 2 ? -term : term;
+    }
+
+    return determinant;
+  }
+
+  bool test_float4() {
+    const float lhs[4] = {1.5f, -2.0f, 0.0f, 3.25f};
+    const float rhs[4] = {0.5f, -2.0f, -1.0f, 4.0f};
+    const Float4 l = Float4::load(lhs);
+    const Float4 r = Float4::load(rhs);
+
+    float sum[4], difference[4], product[4], quotient[4], minimum[4], maximum[4], root[4], selected[4], clamped[4];
+    (l + r).store(sum);
+    (l - r).store(difference);
+    (l * r).store(product);
+    (l / r).store(quotient);
+    float4_min(l, r).store(minimum);
+    float4_max(l, r).store(maximum);
+    float4_sqrt(float4_abs(l)).store(root);
+    float4_select(float4_less(l, r), l, r).store(selected);
+    float4_clamp(l, Float4(-1.0f), Float4(1.0f)).store(clamped);
+    const int bits = float4_mask_bits(float4_less(l, r));
+
+    for(int i = 0; i != 4; ++i) {
+      if(!float4_agrees(sum[i], lhs[i] + rhs[i]) ||
+         !float4_agrees(difference[i], lhs[i] - rhs[i]) ||
+         !float4_agrees(product[i], lhs[i] * rhs[i]) ||
+         !float4_agrees(quotient[i], lhs[i] / rhs[i]) ||
+         !float4_agrees(minimum[i], std::min(lhs[i], rhs[i])) ||
+         !float4_agrees(maximum[i], std::max(lhs[i], rhs[i])) ||
+         !float4_agrees(root[i], std::sqrt(std::fabs(lhs[i]))) ||
+         !float4_agrees(selected[i], lhs[i] < rhs[i] ? lhs[i] : rhs[i]) ||
+         !float4_agrees(clamped[i], std::max(-1.0f, std::min(lhs[i], 1.0f))) ||
+         ((bits >> i) & 1) != (lhs[i] < rhs[i] ? 1 : 0))
+      {
+        return false;
+      }
+    }
+
+    /// Not affine, so that every term of every product matters
+    const Matrix4f a(2.0f, 0.5f, -1.0f, 3.0f,
+                     0.25f, 1.5f, 2.0f, -0.5f,
+                     -1.0f, 0.75f, 3.0f, 1.0f,
+                     0.5f, -0.25f, 0.125f, 2.0f);
+    const Matrix4f b(1.0f, -2.0f, 0.5f, 0.0f,
+                     3.0f, 1.0f, -1.5f, 2.0f,
+                     0.0f, 0.25f, 1.0f, -1.0f,
+                     -0.5f, 1.0f, 2.0f, 1.5f);
+
+    const Matrix4f ab = a * b;
+    const Matrix4f identity = a * a.inverted();
+    const int indices[4] = {0, 1, 2, 3};
+
+    for(int i = 0; i != 4; ++i)
+      for(int j = 0; j != 4; ++j) {
+        float expected = 0.0f;
+        for(int k = 0; k != 4; ++k)
+          expected += a[i][k] * b[k][j];
+
+        if(!float4_agrees(ab[i][j], expected) ||
+           !float4_agrees(identity[i][j], i == j ? 1.0f : 0.0f))
+        {
+          return false;
+        }
+      }
+
+    if(!float4_agrees(a.determinant(), float4_scalar_determinant(a, 4, indices, indices)))
+      return false;
+
+    /// Seven points, so that both the four-wide loop and the remainder run
+    Point3f points[7];
+    for(int i = 0; i != 7; ++i)
+      points[i] = Point3f(float(i) - 3.0f, 0.5f * float(i), 2.0f - float(i * i) / 8.0f);
+
+    Point3f transformed[7];
+    transform_points(a, points, transformed, 7u);
+    transform_points(a, points, points, 7u);
+
+    for(int i = 0; i != 7; ++i) {
+      const float in[3] = {float(i) - 3.0f, 0.5f * float(i), 2.0f - float(i * i) / 8.0f};
+      const Vector3f product = a * Vector3f(in[0], in[1], in[2]);
+      const float out[3] = {transformed[i].x, transformed[i].y, transformed[i].z};
+      const float in_place[3] = {points[i].x, points[i].y, points[i].z};
+      const float multiplied[3] = {product.i, product.j, product.k};
+
+      for(int j = 0; j != 3; ++j) {
+        const float expected = a[j][0] * in[0] + a[j][1] * in[1] + a[j][2] * in[2] + a[j][3];
+        if(!float4_agrees(out[j], expected) ||
+           !float4_agrees(in_place[j], expected) ||
+           !float4_agrees(multiplied[j], expected))
+        {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+
+}
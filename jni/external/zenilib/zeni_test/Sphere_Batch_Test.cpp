@@ -0,0 +1,78 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/** Check every lane of Sphere_Batch::cast against the scalar Ray and Sphere
+ *  functions, over hits, misses, rays starting inside, and spheres behind.
+ */
+
+#include <zeni.h>
+
+#include <cmath>
+
+#include <Zeni/Define.h>
+
+using namespace Zeni;
+using namespace Zeni::Collision;
+
+namespace Zeni_Test {
+
+  static bool sphere_cast_agrees(const Sphere &sphere, const Ray &ray, const float &interpolation) {
+    const Point3f &origin = ray.get_end_point_a();
+    const float tolerance = ZENI_COLLISION_EPSILON + 0.001f * (sphere.get_radius() + (sphere.get_center() - origin).magnitude());
+
+    if(interpolation < 0.0f)
+      return ray.nearest_point(sphere.get_center()).first > sphere.get_radius() - tolerance;
+    if(interpolation == 0.0f)
+      return (sphere.get_center() - origin).magnitude() < sphere.get_radius() + tolerance;
+
+    const Point3f contact = origin + interpolation * ray.get_direction();
+    return sphere.intersects(ray) && std::fabs((contact - sphere.get_center()).magnitude() - sphere.get_radius()) < tolerance;
+  }
+
+  bool test_sphere_batch_cast() {
+    /// Eleven Spheres, so that both full lanes and a partial one are checked
+    Sphere_Batch batch;
+    for(int i = 0; i != 11; ++i)
+      batch.push_back(Sphere(Point3f(float(i % 4) * 3.0f - 4.0f, float(i % 3) - 1.0f, float(i) * 1.5f - 6.0f), 0.5f + 0.25f * float(i % 5)));
+
+    const Ray rays[] = {
+      Ray(Point3f(-10.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f)),
+      Ray(Point3f(0.0f, 0.0f, -20.0f), Vector3f(0.0f, 0.0f, 1.0f)),
+      Ray(Point3f(-4.0f, -1.0f, -6.0f), Vector3f(0.3f, 0.2f, 1.0f)),
+      Ray(Point3f(5.0f, 5.0f, 5.0f), Vector3f(-1.0f, -1.0f, -1.0f)),
+      Ray(Point3f(0.0f, 10.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f))
+    };
+
+    std::vector<float> interpolations;
+    for(size_t r = 0; r != sizeof(rays) / sizeof(rays[0]); ++r) {
+      batch.cast(rays[r], interpolations);
+
+      if(interpolations.size() != batch.size())
+        return false;
+
+      for(size_t i = 0; i != batch.size(); ++i)
+        if(!sphere_cast_agrees(batch[i], rays[r], interpolations[i]))
+          return false;
+    }
+
+    return true;
+  }
+
+}
+
+#include <Zeni/Undefine.h>
@@ -0,0 +1,49 @@
+/* This file is part of the Zenipex Library (zenilib).
+ * Copyright (C) 2011 Mitchell Keith Bloch (bazald).
+ *
+ * zenilib is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * zenilib is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with zenilib.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/** Checks of zeni which are too slow, or too thorough, to run inside the
+ *  library itself.  Exits with the number of failed checks.
+ */
+
+#include <zeni.h>
+
+#include <iostream>
+
+namespace Zeni_Test {
+  bool test_float4(); ///< Float4 and Matrix4f against scalar arithmetic
+  bool test_sphere_batch_cast(); ///< Sphere_Batch::cast against Ray and Sphere
+}
+
+int main() {
+  static const struct {
+    const char * name;
+    bool (*run)();
+  } tests[] = {
+    {"Float4", &Zeni_Test::test_float4},
+    {"Sphere_Batch::cast", &Zeni_Test::test_sphere_batch_cast}
+  };
+
+  int failures = 0;
+  for(size_t i = 0; i != sizeof(tests) / sizeof(tests[0]); ++i) {
+    const bool passed = tests[i].run();
+    std::cout << (passed ? "passed: " : "FAILED: ") << tests[i].name << std::endl;
+    failures += !passed;
+  }
+
+  return failures;
+}
@@ -0,0 +1,13 @@
+project "zeni_test"
+  kind "ConsoleApp"
+  language "C++"
+
+  configuration "linux or macosx"
+    buildoptions { "-ffast-math", "-Wall" }
+
+  configuration "*"
+    flags { "ExtraWarnings" }
+    includedirs { "../zeni", "../../sdl_net", "../../sdl", "../../tinyxml", "../../zlib" }
+
+    files { "**.h", "**.cpp" }
+    links { "zeni" }
@@ -184,4 +184,5 @@ solution "zenilib"
     include "jni/external/zenilib/zeni_graphics"
     include "jni/external/zenilib/zeni_net"
     include "jni/external/zenilib/zeni_rest"
+    include "jni/external/zenilib/zeni_test"
   end